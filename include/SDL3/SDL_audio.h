@@ -450,6 +450,25 @@ typedef struct SDL_AudioSpec
  */
 typedef struct SDL_AudioStream SDL_AudioStream;
 
+/**
+ * The resampling quality of an audio stream.
+ *
+ * Higher quality costs more CPU time for each resampled sample frame. This
+ * only matters when the stream actually resamples, that is, when its input
+ * and output sample rates (or its frequency ratio) differ.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+typedef enum SDL_AudioResampleQuality
+{
+    SDL_AUDIO_RESAMPLE_NEAREST,  /**< nearest sample frame, very fast but aliases badly */
+    SDL_AUDIO_RESAMPLE_LINEAR,   /**< linear interpolation between two sample frames */
+    SDL_AUDIO_RESAMPLE_CUBIC,    /**< cubic (Catmull-Rom) interpolation over four sample frames */
+    SDL_AUDIO_RESAMPLE_SINC      /**< windowed sinc interpolation, the default */
+} SDL_AudioResampleQuality;
+
 
 /* Function prototypes */
 
@@ -1063,6 +1082,25 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
 /**
  * Get the properties associated with an audio stream.
  *
+ * The following properties are understood by SDL:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER`: an
+ *   SDL_AudioResampleQuality value for how the stream resamples audio. This
+ *   can be changed at any time, and takes effect the next time data is
+ *   resampled. Cheaper modes are useful for short sound effects where the
+ *   quality loss isn't audible. This defaults to SDL_AUDIO_RESAMPLE_SINC.
+ * - `SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER`: if set to a number
+ *   of sample frames before the first call to SDL_PutAudioStreamData, the
+ *   stream will put its input into a fixed-size, lock-free ring buffer of
+ *   that many frames, so the thread putting data never waits on the thread
+ *   getting it (such as an audio device's thread), or vice versa. In this
+ *   mode, only one thread may put data at a time, SDL_PutAudioStreamData
+ *   fails instead of growing the buffer when the ring is full, and the
+ *   stream's input format and channel map can't be changed. Data in the ring
+ *   moves into the stream (and the put callback is called) when something
+ *   gets data from the stream, asks how much is available, or flushes it.
+ *   Streams bound to recording devices can't use this mode.
+ *
  * \param stream the SDL_AudioStream to query.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -1073,6 +1111,9 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioStreamProperties(SDL_AudioStream *stream);
 
+#define SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER "SDL.audiostream.resample_quality"
+#define SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER "SDL.audiostream.lockfree_ring_frames"
+
 /**
  * Query the current format of an audio stream.
  *
@@ -2187,6 +2228,126 @@ typedef void (SDLCALL *SDL_AudioPostmixCallback)(void *userdata, const SDL_Audio
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
 
+/**
+ * The number of buckets in SDL_AudioDeviceStats::histogram.
+ *
+ * \since This macro is available since SDL 3.4.0.
+ */
+#define SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS 16
+
+/**
+ * Timing and underrun statistics for an opened audio device.
+ *
+ * An "iteration" is one trip through the device thread: requesting data from
+ * every bound stream, mixing it, and handing the buffer to the platform.
+ * Each iteration has a deadline of one device buffer's worth of audio; an
+ * iteration that takes longer than that is counted as a missed deadline,
+ * which is likely to be heard as a glitch.
+ *
+ * Iteration times are also sorted into a histogram: each bucket covers 1/8th
+ * of the device buffer's duration, so the first eight buckets are iterations
+ * that met their deadline, and the last bucket collects everything that took
+ * twice the deadline or longer.
+ *
+ * When a single stream is bound to a device, already has its data in the
+ * device's format and has no gain applied, some platforms can play that data
+ * without SDL copying it into a device buffer first; `zero_copy_bytes` counts
+ * how much audio went that way.
+ *
+ * All counts accumulate from when the device was opened; compare two
+ * snapshots to measure an interval.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint64 iterations;          /**< Number of times the device thread has processed a buffer. */
+    Uint64 missed_deadlines;    /**< Number of iterations that took longer than `deadline_ns`. */
+    Uint64 short_stream_reads;  /**< Number of times a bound stream had less data than the device asked for. */
+    Uint64 deadline_ns;         /**< The duration of one device buffer, in nanoseconds. */
+    Uint64 last_iteration_ns;   /**< Time spent in the most recent iteration, in nanoseconds. */
+    Uint64 max_iteration_ns;    /**< The longest time spent in an iteration, in nanoseconds. */
+    Uint64 total_iteration_ns;  /**< The total time spent in all iterations, in nanoseconds. */
+    Uint64 histogram[SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS];  /**< Iteration counts, bucketed by duration in 1/8ths of `deadline_ns`. */
+    Uint64 played_bytes;        /**< The total number of bytes handed to the platform. */
+    Uint64 zero_copy_bytes;     /**< How many of `played_bytes` were played straight out of a stream's queued data, without copying them first. */
+    int queued_bytes;           /**< The number of bytes currently queued in all streams bound to the device, in their input formats. */
+} SDL_AudioDeviceStats;
+
+/**
+ * Timing statistics for an audio stream.
+ *
+ * These are updated each time data is requested from the stream, either by
+ * the app with SDL_GetAudioStreamData() or by an audio device the stream is
+ * bound to. The time recorded covers converting and resampling the data into
+ * the stream's output format; time spent in the stream's get callback is not
+ * included.
+ *
+ * All counts accumulate from when the stream was created.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioStreamStats
+ */
+typedef struct SDL_AudioStreamStats
+{
+    Uint64 gets;            /**< Number of times data was requested from the stream. */
+    Uint64 short_gets;      /**< Number of requests that got less data than they asked for. */
+    Uint64 bytes;           /**< Total bytes of converted data obtained from the stream. */
+    Uint64 total_ns;        /**< Total time spent converting data for requests, in nanoseconds. */
+    Uint64 max_ns;          /**< The longest time spent converting data for a single request, in nanoseconds. */
+    int queued_bytes;       /**< The number of bytes currently queued in the stream, in its input format. */
+    int min_queued_bytes;   /**< The fewest bytes left queued in the stream after a request, or -1 if there haven't been any requests. */
+} SDL_AudioStreamStats;
+
+/**
+ * Query timing and underrun statistics for an audio device.
+ *
+ * This can be used to see how close the device thread is to missing its
+ * deadlines, and how often bound streams are running dry, to diagnose audio
+ * glitches. See SDL_AudioDeviceStats for what is reported.
+ *
+ * Statistics belong to the physical device, so querying a logical device
+ * reports on the physical device it is opened on, including the work done
+ * for every other logical device opened on it.
+ *
+ * The hint SDL_HINT_AUDIO_DEVICE_STATS_LOG_INTERVAL can be used to have SDL
+ * log a summary of these statistics periodically.
+ *
+ * \param devid the ID of an opened audio device.
+ * \param stats a pointer filled in with the device's statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioStreamStats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats);
+
+/**
+ * Query timing statistics for an audio stream.
+ *
+ * See SDL_AudioStreamStats for what is reported.
+ *
+ * \param stream the audio stream to query.
+ * \param stats a pointer filled in with the stream's statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioStreamStats(SDL_AudioStream *stream, SDL_AudioStreamStats *stats);
+
+
 
 /**
  * Load the audio data of a WAVE file into memory.
@@ -2304,6 +2465,194 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV_IO(SDL_IOStream *src, bool closeio,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len);
 
+/**
+ * The opaque handle that represents a .WAV file being decoded on demand.
+ *
+ * Unlike SDL_LoadWAV_IO(), which reads and decodes the whole file into memory
+ * before returning, a WAV reader only parses the file's headers when opened,
+ * and decodes audio a block at a time as it is read. This is useful for long
+ * music and ambience tracks, where loading everything up front would cost a
+ * lot of memory and delay playback.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_OpenWAVReader_IO
+ */
+typedef struct SDL_WAVReader SDL_WAVReader;
+
+/**
+ * Open a WAV reader to decode WAVE data on demand from a data source.
+ *
+ * This supports the same formats as SDL_LoadWAV_IO(), and the decoded data is
+ * bit-for-bit what SDL_LoadWAV_IO() would have returned, in the same format.
+ * The same hints that tune SDL_LoadWAV_IO() apply here, too.
+ *
+ * Only the file's headers are read by this function. The data source must
+ * support seeking, and it belongs to the reader until SDL_CloseWAVReader() is
+ * called; the app should not read from or seek in it in the meantime.
+ *
+ * \param src the data source for the WAVE data.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when the reader is
+ *                closed, or before returning if this function fails.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the format of
+ *             the decoded data on successful return.
+ * \param frames a pointer filled in with the total number of sample frames
+ *               the file will decode to. May be NULL.
+ * \returns a new WAV reader on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseWAVReader
+ * \sa SDL_LoadWAV_IO
+ * \sa SDL_OpenWAVReader
+ * \sa SDL_ReadWAVReader
+ * \sa SDL_SeekWAVReader
+ * \sa SDL_SetAudioStreamWAVReader
+ */
+extern SDL_DECLSPEC SDL_WAVReader * SDLCALL SDL_OpenWAVReader_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec, Sint64 *frames);
+
+/**
+ * Open a WAV reader to decode a .WAV file on demand.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_OpenWAVReader_IO(SDL_IOFromFile(path, "rb"), true, spec, frames);
+ * ```
+ *
+ * \param path the file path of the WAV file to open.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the format of
+ *             the decoded data on successful return.
+ * \param frames a pointer filled in with the total number of sample frames
+ *               the file will decode to. May be NULL.
+ * \returns a new WAV reader on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseWAVReader
+ * \sa SDL_OpenWAVReader_IO
+ */
+extern SDL_DECLSPEC SDL_WAVReader * SDLCALL SDL_OpenWAVReader(const char *path, SDL_AudioSpec *spec, Sint64 *frames);
+
+/**
+ * Decode audio from a WAV reader.
+ *
+ * This decodes up to `len` bytes of audio, in the format reported when the
+ * reader was opened, starting at the reader's current position, which then
+ * advances past the data returned. Only whole sample frames are returned.
+ *
+ * \param reader the WAV reader to decode from.
+ * \param buf a buffer to fill with decoded audio.
+ * \param len the maximum number of bytes to fill.
+ * \returns the number of bytes written to `buf`, 0 at the end of the data, or
+ *          -1 on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               single reader should not be used from more than one thread
+ *               at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SeekWAVReader
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_ReadWAVReader(SDL_WAVReader *reader, void *buf, int len);
+
+/**
+ * Move a WAV reader to a specific sample frame.
+ *
+ * The next read from the reader will start at sample frame `frame`. For
+ * compressed formats, this decodes from the start of the block that contains
+ * the frame, so seeking is cheap but not free.
+ *
+ * If the reader is feeding an audio stream (see
+ * SDL_SetAudioStreamWAVReader()), the stream should be locked with
+ * SDL_LockAudioStream() while seeking. Any audio already in the stream will
+ * still be played before the new position, unless the stream is cleared with
+ * SDL_ClearAudioStream().
+ *
+ * \param reader the WAV reader to seek.
+ * \param frame the sample frame to move to, from 0 to the number of frames
+ *              in the file. Seeking to the end is allowed.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               single reader should not be used from more than one thread
+ *               at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_TellWAVReader
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SeekWAVReader(SDL_WAVReader *reader, Sint64 frame);
+
+/**
+ * Get the current position of a WAV reader.
+ *
+ * \param reader the WAV reader to query.
+ * \returns the sample frame the next read will start at, or -1 on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               single reader should not be used from more than one thread
+ *               at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SeekWAVReader
+ */
+extern SDL_DECLSPEC Sint64 SDLCALL SDL_TellWAVReader(SDL_WAVReader *reader);
+
+/**
+ * Feed an audio stream from a WAV reader on demand.
+ *
+ * This sets the stream's input format to the reader's, and sets the stream's
+ * get callback (see SDL_SetAudioStreamGetCallback()) to one that decodes
+ * just as much audio as the stream needs from the reader. When the reader
+ * runs out of data, the stream is flushed, so all of the audio can be played.
+ *
+ * This replaces any get callback the stream already had. Setting a NULL
+ * reader removes the callback.
+ *
+ * The reader must not be closed while it is feeding a stream.
+ *
+ * \param stream the audio stream to feed.
+ * \param reader the WAV reader to decode from, or NULL to stop feeding the
+ *               stream.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_OpenWAVReader_IO
+ * \sa SDL_SeekWAVReader
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamWAVReader(SDL_AudioStream *stream, SDL_WAVReader *reader);
+
+/**
+ * Close a WAV reader.
+ *
+ * If the reader was opened with `closeio` set to true, this also closes its
+ * data source.
+ *
+ * \param reader the WAV reader to close. May be NULL.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_OpenWAVReader_IO
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_CloseWAVReader(SDL_WAVReader *reader);
+
 /**
  * Mix audio data in a specified format.
  *
@@ -322,6 +322,57 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_APP_ICON_NAME "SDL_AUDIO_DEVICE_APP_ICON_NAME"
 
+/**
+ * A variable controlling how many threads mix the streams bound to a
+ * playback device.
+ *
+ * This hint is an integer that represents the total number of threads,
+ * including the device's own audio thread, that pull, convert and resample
+ * bound audio streams. Values less than 2 (the default) keep all mixing on
+ * the audio thread.
+ *
+ * When enabled, logical devices with many bound streams have their streams
+ * split across a small pool of worker threads, and the partial mixes are
+ * summed into the device's buffer once all workers finish. This helps apps
+ * that bind dozens or hundreds of streams to a single device, but adds some
+ * overhead per device iteration, so it isn't worth it for a handful of
+ * streams.
+ *
+ * Note that when this is enabled, callbacks set with
+ * SDL_SetAudioStreamGetCallback() may be called from one of these worker
+ * threads instead of the audio device thread, and the order in which the
+ * streams are mixed is not the same, so results may differ slightly due to
+ * floating point rounding. Mixing clamps samples to the -1.0f to 1.0f range
+ * as it sums each group of streams, so when the mixed output clips, it can
+ * differ from mixing on one thread by more than rounding.
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DEVICE_MIX_THREADS "SDL_AUDIO_DEVICE_MIX_THREADS"
+
+/**
+ * A variable controlling whether playback devices mix common audio streams
+ * in a single pass.
+ *
+ * When a bound stream's data is 16-bit or float, and it either doesn't need
+ * resampling or resamples between two rates with a simple ratio (like 44100
+ * to 48000), SDL can convert, resample, apply gain and mix it into the
+ * device's buffer in one go, instead of staging the data in intermediate
+ * buffers. This saves a lot of memory traffic when mixing many streams.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Always convert and resample into a temporary buffer before mixing.
+ * - "1": Mix suitable streams in a single pass. (default)
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DEVICE_FUSED_MIX "SDL_AUDIO_DEVICE_FUSED_MIX"
+
 /**
  * A variable controlling device buffer size.
  *
@@ -344,6 +395,24 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES "SDL_AUDIO_DEVICE_SAMPLE_FRAMES"
 
+/**
+ * A variable controlling how often audio devices log their timing
+ * statistics.
+ *
+ * If set to a number of milliseconds greater than zero, each opened device
+ * logs a summary of its SDL_AudioDeviceStats, covering just the time since
+ * the last summary, at roughly that interval. The summary is logged from the
+ * device thread with SDL_LOG_CATEGORY_AUDIO at SDL_LOG_PRIORITY_INFO.
+ *
+ * The default value is "0", which disables logging. The statistics are still
+ * collected and can be queried with SDL_GetAudioDeviceStats().
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DEVICE_STATS_LOG_INTERVAL "SDL_AUDIO_DEVICE_STATS_LOG_INTERVAL"
+
 /**
  * Specify an audio stream name for an audio device.
  *
@@ -3038,6 +3107,53 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling whether the software renderer only sends the parts
+ * of the window that changed when presenting.
+ *
+ * The software renderer keeps track of the area each render command draws
+ * to in the window, and SDL_RenderPresent() only updates those parts of the
+ * window with SDL_UpdateWindowSurfaceRects(). Clearing the render target
+ * still updates the whole window.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": The whole window is updated on every present.
+ * - "1": Only the parts of the window that were drawn to are updated.
+ *   (default)
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT "SDL_RENDER_SOFTWARE_PARTIAL_PRESENT"
+
+/**
+ * A variable controlling how many threads the software renderer draws with.
+ *
+ * This hint is an integer that represents the total number of threads,
+ * including the thread that calls into the render API, that rasterize
+ * queued render commands. Values less than 2 (the default) keep all drawing
+ * on the calling thread.
+ *
+ * When enabled, the render target is split into horizontal bands, queued
+ * commands are sorted into the bands they touch, and the bands are drawn in
+ * parallel, each in the order the commands were queued. The output is the
+ * same as drawing on a single thread. Scaled textures are drawn in bands,
+ * too, unless they are stretched wider or taller than 65535 pixels. Lines,
+ * rotated or flipped textures and RLE accelerated textures are still drawn
+ * on the calling thread, after everything queued before them has been
+ * drawn.
+ *
+ * This helps with large render targets on machines with many cores, but
+ * adds some overhead to every flush of the render queue.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -3192,6 +3308,48 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling how many threads large surface operations use.
+ *
+ * This hint is an integer that represents the total number of threads,
+ * including the calling thread, that SDL_BlitSurface(),
+ * SDL_BlitSurfaceScaled(), SDL_ConvertPixels(), SDL_ConvertSurface(),
+ * SDL_FillSurfaceRects() and SDL_StretchSurface() may split their work
+ * across. Values less than 2 (the default) keep all of the work on the
+ * calling thread.
+ *
+ * When enabled, operations that cover at least
+ * SDL_HINT_SURFACE_THREADS_MIN_PIXELS destination pixels are split into
+ * horizontal bands that are processed in parallel, and the call returns
+ * when all of the bands are done. The output is the same as processing the
+ * whole operation on one thread. Blits to indexed surfaces, blits and
+ * stretches where the source and destination pixels overlap, and RLE
+ * accelerated blits always run on the calling thread, as do operations
+ * started while another thread is already using the surface threads.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_THREADS "SDL_SURFACE_THREADS"
+
+/**
+ * A variable controlling how large a surface operation must be before it is
+ * split across threads.
+ *
+ * This hint is an integer number of destination pixels, and defaults to
+ * 65536 (a 256x256 area). Smaller operations run on the calling thread,
+ * where starting other threads would cost more than it saves.
+ *
+ * This hint has no effect unless SDL_HINT_SURFACE_THREADS is set to 2 or
+ * more.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_THREADS_MIN_PIXELS "SDL_SURFACE_THREADS_MIN_PIXELS"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -3969,6 +4127,26 @@ extern "C" {
  */
 #define SDL_HINT_WAVE_CHUNK_LIMIT "SDL_WAVE_CHUNK_LIMIT"
 
+/**
+ * A variable controlling how many threads are used to decode compressed WAVE
+ * files.
+ *
+ * Every block of MS ADPCM and IMA ADPCM data can be decoded on its own, so
+ * large files are split up between threads. Small files, where starting the
+ * threads would take longer than the decoding, always use the calling thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use up to one thread per CPU core. (default)
+ * - "1": Decode everything on the calling thread.
+ * - N: Use up to N threads.
+ *
+ * This hint should be set before calling SDL_LoadWAV() or SDL_LoadWAV_IO()
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_WAVE_DECODE_THREADS "SDL_WAVE_DECODE_THREADS"
+
 /**
  * A variable controlling how the size of the RIFF chunk affects the loading
  * of a WAVE file.
@@ -127,6 +127,19 @@ typedef enum SDL_RendererLogicalPresentation
     SDL_LOGICAL_PRESENTATION_INTEGER_SCALE   /**< The rendered content is scaled up by integer multiples to fit the output resolution */
 } SDL_RendererLogicalPresentation;
 
+/**
+ * The order in which queued draws reach the GPU or other rendering backend.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetRenderBatchMode
+ */
+typedef enum SDL_RenderBatchMode
+{
+    SDL_RENDER_BATCH_ORDERED,   /**< Draws are done in the order they were made, this is the default */
+    SDL_RENDER_BATCH_UNORDERED  /**< Draws within a layer may be reordered so draws with the same texture and state are done together */
+} SDL_RenderBatchMode;
+
 /**
  * A structure representing rendering state
  *
@@ -282,6 +295,18 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  * - `SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER`: non-zero if you want
  *   present synchronized with the refresh rate. This property can take any
  *   value that is supported by SDL_SetRenderVSync() for the renderer.
+ * - `SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN`: true if queued drawing
+ *   should be done on a separate render thread, so the application can build
+ *   the next frame while the last one is drawn, defaults to false. Only the
+ *   software renderer supports this, other renderers ignore it; check
+ *   `SDL_PROP_RENDERER_THREADED_BOOLEAN` to see if it took effect. With a
+ *   render thread, SDL_RenderPresent() returns as soon as the frame is
+ *   queued, and the window is updated on the main thread once the frame is
+ *   drawn, the next time events are pumped or the renderer needs to wait for
+ *   the frame. SDL_UpdateTexture(), SDL_LockTexture() and other functions
+ *   that change a texture wait for any queued drawing that uses it, and
+ *   SDL_RenderReadPixels(), SDL_SetRenderTarget() and SDL_FlushRenderer()
+ *   wait for all of it.
  *
  * With the SDL GPU renderer:
  *
@@ -328,6 +353,7 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRendererWithProperties(SDL_
 #define SDL_PROP_RENDERER_CREATE_SURFACE_POINTER                            "SDL.renderer.create.surface"
 #define SDL_PROP_RENDERER_CREATE_OUTPUT_COLORSPACE_NUMBER                   "SDL.renderer.create.output_colorspace"
 #define SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER                       "SDL.renderer.create.present_vsync"
+#define SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN                           "SDL.renderer.create.threaded"
 #define SDL_PROP_RENDERER_CREATE_GPU_SHADERS_SPIRV_BOOLEAN                  "SDL.renderer.create.gpu.shaders_spirv"
 #define SDL_PROP_RENDERER_CREATE_GPU_SHADERS_DXIL_BOOLEAN                   "SDL.renderer.create.gpu.shaders_dxil"
 #define SDL_PROP_RENDERER_CREATE_GPU_SHADERS_MSL_BOOLEAN                    "SDL.renderer.create.gpu.shaders_msl"
@@ -443,6 +469,8 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  * - `SDL_PROP_RENDERER_SURFACE_POINTER`: the surface where rendering is
  *   displayed, if this is a software renderer without a window
  * - `SDL_PROP_RENDERER_VSYNC_NUMBER`: the current vsync setting
+ * - `SDL_PROP_RENDERER_THREADED_BOOLEAN`: true if drawing is done on a
+ *   render thread, see `SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN`
  * - `SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER`: the maximum texture width
  *   and height
  * - `SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER`: a (const SDL_PixelFormat *)
@@ -464,6 +492,28 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_WINDOW_HDR_STATE_CHANGED is sent.
  *
+ * - `SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER`: the number of commands sent to
+ *   the renderer during the last frame, updated by SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER`: the number of draws that
+ *   were combined with another draw during the last frame, updated by
+ *   SDL_RenderPresent(). See SDL_SetRenderBatchMode().
+ * - `SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER`: the most vertex data, in
+ *   bytes, that was queued at once during the last frame, updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_QUEUED_COMMANDS_NUMBER`: the most commands that
+ *   were queued at once during the last frame, updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_QUEUE_MEMORY_NUMBER`: the number of bytes allocated
+ *   for queuing commands and vertex data, updated by SDL_RenderPresent().
+ *   Memory that hasn't been needed for a while is freed again, so this
+ *   follows the recent high-water marks above.
+ *
+ * With the software renderer:
+ *
+ * - `SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER`: the number of bytes
+ *   of pixel data the most recent call to SDL_RenderPresent() sent to the
+ *   window. See SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT.
+ *
  * With the direct3d renderer:
  *
  * - `SDL_PROP_RENDERER_D3D9_DEVICE_POINTER`: the IDirect3DDevice9 associated
@@ -522,12 +572,19 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_WINDOW_POINTER                            "SDL.renderer.window"
 #define SDL_PROP_RENDERER_SURFACE_POINTER                           "SDL.renderer.surface"
 #define SDL_PROP_RENDERER_VSYNC_NUMBER                              "SDL.renderer.vsync"
+#define SDL_PROP_RENDERER_THREADED_BOOLEAN                          "SDL.renderer.threaded"
 #define SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER                   "SDL.renderer.max_texture_size"
 #define SDL_PROP_RENDERER_TEXTURE_FORMATS_POINTER                   "SDL.renderer.texture_formats"
 #define SDL_PROP_RENDERER_OUTPUT_COLORSPACE_NUMBER                  "SDL.renderer.output_colorspace"
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER                     "SDL.renderer.frame.commands"
+#define SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER                 "SDL.renderer.frame.merged_draws"
+#define SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER                 "SDL.renderer.frame.vertex_bytes"
+#define SDL_PROP_RENDERER_FRAME_QUEUED_COMMANDS_NUMBER              "SDL.renderer.frame.queued_commands"
+#define SDL_PROP_RENDERER_QUEUE_MEMORY_NUMBER                       "SDL.renderer.queue.memory"
+#define SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER           "SDL.renderer.software.presented_bytes"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -2574,6 +2631,80 @@ extern SDL_DECLSPEC void SDLCALL SDL_DestroyRenderer(SDL_Renderer *renderer);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_FlushRenderer(SDL_Renderer *renderer);
 
+/**
+ * Set whether draws may be reordered to batch them together.
+ *
+ * By default, draws are done in the order they were made, and consecutive
+ * draws can only be combined when they use the same texture and state. An
+ * application that interleaves draws with different textures, like sprites
+ * and text, ends up with many small draws.
+ *
+ * In SDL_RENDER_BATCH_UNORDERED mode, draws made between two calls to
+ * SDL_StartRenderLayer() may be done in any order, so SDL can group the ones
+ * that share a texture, blend mode and other state. Draws in a layer are
+ * still done after everything in earlier layers. Changing the viewport or
+ * clip rect, clearing, changing the render target and SDL_FlushRenderer()
+ * also start a new layer.
+ *
+ * Use this mode when the draws in a layer don't overlap, or when it doesn't
+ * matter which of the overlapping draws ends up on top.
+ *
+ * This works with all renderers; the number of commands sent to the
+ * renderer and the number of draws combined in the last frame can be found
+ * in the `SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER` and
+ * `SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER` renderer properties.
+ *
+ * \param renderer the rendering context.
+ * \param mode the SDL_RenderBatchMode to use.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetRenderBatchMode
+ * \sa SDL_StartRenderLayer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetRenderBatchMode(SDL_Renderer *renderer, SDL_RenderBatchMode mode);
+
+/**
+ * Get whether draws may be reordered to batch them together.
+ *
+ * \param renderer the rendering context.
+ * \param mode a pointer filled in with the current SDL_RenderBatchMode.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetRenderBatchMode
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetRenderBatchMode(SDL_Renderer *renderer, SDL_RenderBatchMode *mode);
+
+/**
+ * Start a new layer of draws.
+ *
+ * In SDL_RENDER_BATCH_UNORDERED mode, draws made after this call are done
+ * after all the draws made before it, so they can be used to draw on top
+ * of them. This does nothing in SDL_RENDER_BATCH_ORDERED mode.
+ *
+ * Unlike SDL_FlushRenderer(), this doesn't send anything to the renderer.
+ *
+ * \param renderer the rendering context.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetRenderBatchMode
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_StartRenderLayer(SDL_Renderer *renderer);
+
 /**
  * Get the CAMetalLayer associated with the given Metal renderer.
  *
@@ -2725,6 +2856,12 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetRenderVSync(SDL_Renderer *renderer, int
  * On first use, this will create an internal texture for rendering glyphs.
  * This texture will live until the renderer is destroyed.
  *
+ * Where the renderer supports it, each string is drawn in a single batch
+ * instead of one draw per character. Strings drawn again on later frames are
+ * kept in a small cache, so drawing the same text every frame doesn't have to
+ * look up its glyphs again. Text that never changes can skip the cache with
+ * SDL_CreateDebugTextRun().
+ *
  * The text is drawn in the color specified by SDL_SetRenderDrawColor().
  *
  * \param renderer the renderer which should draw a line of text.
@@ -2771,6 +2908,78 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderDebugText(SDL_Renderer *renderer, flo
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_RenderDebugTextFormat(SDL_Renderer *renderer, float x, float y, SDL_PRINTF_FORMAT_STRING const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(4);
 
+/**
+ * A line of debug text prepared for drawing.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateDebugTextRun
+ * \sa SDL_RenderDebugTextRun
+ * \sa SDL_DestroyDebugTextRun
+ */
+typedef struct SDL_DebugTextRun SDL_DebugTextRun;
+
+/**
+ * Prepare a line of debug text to be drawn many times.
+ *
+ * This looks up the glyphs for a string once, so labels that don't change,
+ * like the names next to values in an overlay, can be drawn every frame with
+ * SDL_RenderDebugTextRun() for less than SDL_RenderDebugText() costs. The
+ * text is copied, so `str` doesn't need to be kept around.
+ *
+ * The same limitations as SDL_RenderDebugText() apply.
+ *
+ * \param renderer the renderer which will draw the text.
+ * \param str the string to prepare.
+ * \returns a text run on success or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderDebugTextRun
+ * \sa SDL_DestroyDebugTextRun
+ */
+extern SDL_DECLSPEC SDL_DebugTextRun * SDLCALL SDL_CreateDebugTextRun(SDL_Renderer *renderer, const char *str);
+
+/**
+ * Draw a line of debug text prepared with SDL_CreateDebugTextRun().
+ *
+ * The text is drawn in the color specified by SDL_SetRenderDrawColor(), just
+ * as SDL_RenderDebugText() would draw it.
+ *
+ * \param renderer the renderer which should draw the text.
+ * \param run the text run to draw, created with this renderer.
+ * \param x the x coordinate where the top-left corner of the text will draw.
+ * \param y the y coordinate where the top-left corner of the text will draw.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateDebugTextRun
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderDebugTextRun(SDL_Renderer *renderer, SDL_DebugTextRun *run, float x, float y);
+
+/**
+ * Destroy a text run.
+ *
+ * This should be called before the renderer it was created with is
+ * destroyed.
+ *
+ * \param run the text run to destroy, may be NULL.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateDebugTextRun
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyDebugTextRun(SDL_DebugTextRun *run);
+
 /**
  * Set default scale mode for new textures for given renderer.
  *
@@ -1389,6 +1389,46 @@ extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurfaceTiledWithScale(SDL_Surface *src,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_width, int right_width, int top_height, int bottom_height, float scale, SDL_ScaleMode scaleMode, SDL_Surface *dst, const SDL_Rect *dstrect);
 
+/**
+ * Statistics about how a surface chooses its blit functions.
+ *
+ * Before blitting, SDL picks a blit function for the source surface, the
+ * destination's format and colorspace, and the source's blend mode, color
+ * key and color and alpha modulation. Changing any of those makes SDL pick
+ * again on the next blit. Each surface remembers the last few choices, so
+ * switching back and forth between a few states, like drawing sprites with
+ * and without a tint, reuses them instead of searching the blitters again.
+ *
+ * All counts accumulate from when the surface was created.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfaceBlitStats
+ */
+typedef struct SDL_SurfaceBlitStats
+{
+    Uint64 cache_hits;      /**< Number of times a remembered blit function was reused. */
+    Uint64 cache_misses;    /**< Number of times a blit function had to be chosen from scratch. */
+} SDL_SurfaceBlitStats;
+
+/**
+ * Query statistics about how a surface chooses its blit functions.
+ *
+ * See SDL_SurfaceBlitStats for what is reported.
+ *
+ * \param surface the source surface to query.
+ * \param stats a pointer filled in with the surface's statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BlitSurface
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfaceBlitStats(SDL_Surface *surface, SDL_SurfaceBlitStats *stats);
+
 /**
  * Map an RGB triple to an opaque pixel value for a surface.
  *
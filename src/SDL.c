@@ -665,6 +665,7 @@ void SDL_Quit(void)
 
     SDL_QuitTimers();
     SDL_QuitAsyncIO();
+    SDL_QuitSurfaceThreads();
 
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
@@ -177,6 +177,16 @@
 #define SDL_HAVE_BLIT_AUTO 1
 #endif
 
+/* Optimized functions from 'SDL_blit_auto.c' for the 16-bit (RGB565, ARGB1555, ARGB4444)
+   and 24-bit (RGB24) formats, paired with each other and with the 32-bit formats.
+   Each set adds a lot of code, define them to 0 to leave them out */
+#ifndef SDL_HAVE_BLIT_AUTO_16BIT
+#define SDL_HAVE_BLIT_AUTO_16BIT 1
+#endif
+#ifndef SDL_HAVE_BLIT_AUTO_24BIT
+#define SDL_HAVE_BLIT_AUTO_24BIT 1
+#endif
+
 /* Run-Length-Encoding
    - SDL_SetSurfaceColorKey() called with SDL_RLEACCEL flag */
 #if !defined(SDL_HAVE_RLE) && !defined(SDL_LEAN_AND_MEAN)
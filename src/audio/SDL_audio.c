@@ -273,6 +273,7 @@ static void UpdateAudioStreamFormatsPhysical(SDL_AudioDevice *device)
             SDL_LockMutex(stream->lock);
             SDL_copyp(streamspec, &spec);
             SetAudioStreamChannelMap(stream, streamspec, streamchmap, device->chmap, device->spec.channels, -1);  // this should be fast for normal cases, though!
+            UpdateAudioStreamResamplerPhases(stream);
             SDL_UnlockMutex(stream->lock);
         }
     }
@@ -1120,6 +1121,364 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
     }
 }
 
+// Pull data from a bound stream and mix it into `mix_buffer`, using `work_buffer` as scratch space. Returns bytes mixed, or -1 on failure.
+static int MixBoundAudioStream(const SDL_LogicalAudioDevice *logdev, SDL_AudioStream *stream, float *mix_buffer, Uint8 *work_buffer, int buffer_size)
+{
+    SDL_AudioDevice *device = logdev->physical_device;
+    const float gain = logdev->gain;
+    const bool chmaps_equal = SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap);
+
+    // generally channel maps will line up, and then the stream can mix itself, in a single pass if possible.
+    if (chmaps_equal && logdev->fused_mix) {
+        const int mixed = SDL_MixAudioStreamData(stream, mix_buffer, work_buffer, buffer_size, gain);
+        if ((mixed >= 0) && (mixed < buffer_size)) {
+            SDL_AddAtomicInt(&device->short_stream_reads, 1);
+        }
+        return mixed;
+    }
+
+    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+       for iterating here because the binding linked list can only change while the device lock is held.
+       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+       the same stream to different devices at the same time, though.) */
+    const int br = SDL_GetAudioStreamDataAdjustGain(stream, work_buffer, buffer_size, gain);
+    if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+        // if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
+        if (!chmaps_equal) {
+            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), work_buffer, device->spec.format, device->spec.channels, NULL,
+                         work_buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+        }
+        MixFloat32Audio(mix_buffer, (const float *) work_buffer, br);
+    }
+    if ((br >= 0) && (br < buffer_size)) {
+        SDL_AddAtomicInt(&device->short_stream_reads, 1);
+    }
+    return br;
+}
+
+
+// Parallel mixing of bound streams. See SDL_HINT_AUDIO_DEVICE_MIX_THREADS.
+
+#define MIX_POOL_MAX_LANES 32
+#define MIX_POOL_MIN_STREAMS_PER_LANE 2  // don't bother waking the workers if each lane would only get a stream or so.
+
+enum
+{
+    MIX_JOB_STREAMS,
+    MIX_JOB_REDUCE
+};
+
+// Each lane mixes every Nth stream into its own partial mix buffer. Streams are assigned statically (not grabbed
+//  from a shared counter) so each lane sums the same streams in the same order every time, which keeps the output
+//  deterministic.
+static void MixLaneStreams(SDL_AudioMixLane *lane)
+{
+    SDL_AudioMixPool *pool = lane->pool;
+    const SDL_LogicalAudioDevice *logdev = pool->logdev;
+    const int buffer_size = pool->job_buffer_size;
+
+    SDL_memset(lane->mix_buffer, '\0', buffer_size);  // start with silence.
+
+    for (int i = lane->index; i < pool->num_streams; i += pool->num_lanes) {
+        SDL_AudioStream *stream = pool->streams[i];
+        if (MixBoundAudioStream(logdev, stream, lane->mix_buffer, lane->work_buffer, buffer_size) < 0) {
+            SDL_SetAtomicInt(&pool->failed, 1);  // Probably OOM. Let the device thread decide what to do about it.
+            break;
+        }
+    }
+}
+
+// Each lane sums one slice of every lane's partial mix, pairwise, then adds it to the output.
+//  Like serial mixing, every sum is clamped to [-1, 1], but the partial mixes are clamped before they're summed, so
+//  output that clips can differ from mixing the streams one after another (see SDL_HINT_AUDIO_DEVICE_MIX_THREADS).
+static void MixLaneReduce(SDL_AudioMixLane *lane)
+{
+    SDL_AudioMixPool *pool = lane->pool;
+    const int num_lanes = pool->num_lanes;
+    const int total_floats = pool->job_buffer_size / (int) sizeof (float);
+    const int slice_floats = (((total_floats + num_lanes - 1) / num_lanes) + 15) & ~15;  // keep slices SIMD-aligned.
+    const int start = lane->index * slice_floats;
+    const int end = SDL_min(start + slice_floats, total_floats);
+
+    if (start >= end) {
+        return;  // not enough data for this lane to have a slice.
+    }
+
+    const int slice_bytes = (end - start) * (int) sizeof (float);
+    for (int stride = 1; stride < num_lanes; stride *= 2) {
+        for (int i = 0; (i + stride) < num_lanes; i += stride * 2) {
+            MixFloat32Audio(pool->lanes[i].mix_buffer + start, pool->lanes[i + stride].mix_buffer + start, slice_bytes);
+        }
+    }
+
+    MixFloat32Audio(pool->job_output + start, pool->lanes[0].mix_buffer + start, slice_bytes);
+}
+
+static void RunMixLane(SDL_AudioMixLane *lane)
+{
+    if (lane->pool->job == MIX_JOB_STREAMS) {
+        MixLaneStreams(lane);
+    } else {
+        SDL_assert(lane->pool->job == MIX_JOB_REDUCE);
+        MixLaneReduce(lane);
+    }
+}
+
+static int SDLCALL MixLaneThread(void *data)
+{
+    SDL_AudioMixLane *lane = (SDL_AudioMixLane *) data;
+    SDL_AudioMixPool *pool = lane->pool;
+
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    while (true) {
+        SDL_WaitSemaphore(lane->go);
+        if (SDL_GetAtomicInt(&pool->quit)) {
+            break;
+        }
+        RunMixLane(lane);
+        SDL_SignalSemaphore(pool->done);
+    }
+
+    return 0;
+}
+
+// Run `job` on every lane, with the calling (device) thread working lane 0, and wait for all of them to finish.
+static void RunMixPoolJob(SDL_AudioMixPool *pool, int job)
+{
+    pool->job = job;
+
+    for (int i = 1; i < pool->num_lanes; i++) {
+        SDL_SignalSemaphore(pool->lanes[i].go);
+    }
+
+    RunMixLane(&pool->lanes[0]);
+
+    for (int i = 1; i < pool->num_lanes; i++) {
+        SDL_WaitSemaphore(pool->done);
+    }
+}
+
+// this expects the device lock to be held. Returns false on allocation failure.
+static bool ResizeAudioMixPool(SDL_AudioMixPool *pool, int buffer_size)
+{
+    if (buffer_size <= pool->buffer_size) {
+        return true;  // already big enough.
+    }
+
+    for (int i = 0; i < pool->num_lanes; i++) {
+        SDL_AudioMixLane *lane = &pool->lanes[i];
+        SDL_aligned_free(lane->work_buffer);
+        SDL_aligned_free(lane->mix_buffer);
+        lane->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), buffer_size);
+        lane->mix_buffer = (float *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), buffer_size);
+        if (!lane->work_buffer || !lane->mix_buffer) {
+            pool->buffer_size = 0;  // make sure we try again next time.
+            return false;
+        }
+    }
+
+    pool->buffer_size = buffer_size;
+    return true;
+}
+
+static void DestroyAudioMixPool(SDL_AudioMixPool *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&pool->quit, 1);
+
+    for (int i = 1; i < pool->num_lanes; i++) {
+        SDL_AudioMixLane *lane = &pool->lanes[i];
+        if (lane->thread) {
+            SDL_SignalSemaphore(lane->go);
+            SDL_WaitThread(lane->thread, NULL);
+        }
+    }
+
+    for (int i = 0; i < pool->num_lanes; i++) {
+        SDL_AudioMixLane *lane = &pool->lanes[i];
+        SDL_DestroySemaphore(lane->go);
+        SDL_aligned_free(lane->work_buffer);
+        SDL_aligned_free(lane->mix_buffer);
+    }
+
+    SDL_DestroySemaphore(pool->done);
+    SDL_free(pool->streams);
+    SDL_free(pool->lanes);
+    SDL_free(pool);
+}
+
+// Returns NULL if parallel mixing isn't requested, or if we failed to set it up (in which case we just mix on the device thread).
+static SDL_AudioMixPool *CreateAudioMixPool(SDL_AudioDevice *device)
+{
+    SDL_assert(!device->recording);
+
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_MIX_THREADS);
+    const int num_lanes = hint ? SDL_min(SDL_atoi(hint), MIX_POOL_MAX_LANES) : 0;
+    if (num_lanes < 2) {
+        return NULL;
+    }
+
+    SDL_AudioMixPool *pool = (SDL_AudioMixPool *)SDL_calloc(1, sizeof (*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->device = device;
+    pool->lanes = (SDL_AudioMixLane *)SDL_calloc(num_lanes, sizeof (*pool->lanes));
+    pool->done = SDL_CreateSemaphore(0);
+    if (!pool->lanes || !pool->done) {
+        DestroyAudioMixPool(pool);
+        return NULL;
+    }
+
+    pool->num_lanes = num_lanes;
+    for (int i = 0; i < num_lanes; i++) {
+        pool->lanes[i].pool = pool;
+        pool->lanes[i].index = i;
+    }
+
+    if (!ResizeAudioMixPool(pool, device->work_buffer_size)) {
+        DestroyAudioMixPool(pool);
+        return NULL;
+    }
+
+    for (int i = 1; i < num_lanes; i++) {
+        SDL_AudioMixLane *lane = &pool->lanes[i];
+        char threadname[64];
+        lane->go = SDL_CreateSemaphore(0);
+        if (!lane->go) {
+            DestroyAudioMixPool(pool);
+            return NULL;
+        }
+        SDL_GetAudioThreadName(device, threadname, sizeof (threadname));
+        SDL_snprintf(threadname + SDL_strlen(threadname), sizeof (threadname) - SDL_strlen(threadname), "-mix%d", i);
+        lane->thread = SDL_CreateThread(MixLaneThread, threadname, lane);
+        if (!lane->thread) {
+            DestroyAudioMixPool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+// this expects the device lock to be held. Returns false if the streams should be mixed serially instead.
+static bool MixLogicalDeviceInParallel(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, float *mix_buffer, int buffer_size, bool *failed)
+{
+    SDL_AudioMixPool *pool = device->mix_pool;
+    if (!pool) {
+        return false;
+    }
+
+    int num_streams = 0;
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        num_streams++;
+    }
+
+    if ((num_streams < (pool->num_lanes * MIX_POOL_MIN_STREAMS_PER_LANE)) || (buffer_size > pool->buffer_size)) {
+        return false;
+    }
+
+    if (num_streams > pool->streams_allocation) {
+        SDL_AudioStream **ptr = (SDL_AudioStream **)SDL_realloc(pool->streams, num_streams * sizeof (*ptr));
+        if (!ptr) {
+            return false;  // just mix serially, then.
+        }
+        pool->streams = ptr;
+        pool->streams_allocation = num_streams;
+    }
+
+    // the binding list can only change while the device lock is held, so this array stays valid for this iteration.
+    int i = 0;
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+        pool->streams[i++] = stream;
+    }
+
+    pool->logdev = logdev;
+    pool->num_streams = num_streams;
+    pool->job_buffer_size = buffer_size;
+    pool->job_output = mix_buffer;
+    SDL_SetAtomicInt(&pool->failed, 0);
+
+    RunMixPoolJob(pool, MIX_JOB_STREAMS);
+    RunMixPoolJob(pool, MIX_JOB_REDUCE);
+
+    if (SDL_GetAtomicInt(&pool->failed)) {
+        *failed = true;
+    }
+
+    pool->logdev = NULL;
+    pool->num_streams = 0;
+    pool->job_output = NULL;
+
+    return true;
+}
+
+
+// Device timing statistics. See SDL_GetAudioDeviceStats.
+
+// this expects the device lock to be held, and is only called from the device thread.
+static void UpdateAudioDeviceStats(SDL_AudioDevice *device, int buffer_size, Uint64 elapsed)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint64 frames = (Uint64) (buffer_size / SDL_AUDIO_FRAMESIZE(device->spec));
+    const Uint64 deadline = (frames * SDL_NS_PER_SECOND) / device->spec.freq;
+
+    stats->iterations++;
+    stats->played_bytes += buffer_size;
+    stats->deadline_ns = deadline;
+    stats->last_iteration_ns = elapsed;
+    stats->max_iteration_ns = SDL_max(stats->max_iteration_ns, elapsed);
+    stats->total_iteration_ns += elapsed;
+    if (elapsed > deadline) {
+        stats->missed_deadlines++;
+    }
+
+    // the difference is taken in 32 bits, so it's right even after the atomic counter wraps.
+    const Uint32 short_reads = (Uint32) SDL_GetAtomicInt(&device->short_stream_reads);
+    stats->short_stream_reads += (Uint32) (short_reads - device->short_stream_reads_counted);
+    device->short_stream_reads_counted = short_reads;
+
+    // each bucket is 1/8th of the deadline; the last one catches everything past that.
+    const Uint64 bucket = deadline ? ((elapsed * 8) / deadline) : (SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS - 1);
+    stats->histogram[SDL_min(bucket, SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS - 1)]++;
+}
+
+// Only the device thread writes to device->stats, so it can read them here without the device lock.
+static void LogAudioDeviceStats(SDL_AudioDevice *device)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    if ((now - device->stats_logged_ticks) < device->stats_log_interval_ns) {
+        return;
+    }
+
+    const SDL_AudioDeviceStats *stats = &device->stats;
+    SDL_AudioDeviceStats *prev = &device->stats_logged;
+    const Uint64 iterations = stats->iterations - prev->iterations;
+
+    if (iterations > 0) {
+        const Uint64 average = (stats->total_iteration_ns - prev->total_iteration_ns) / iterations;
+        char histogram[SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS * 12];
+        size_t len = 0;
+        histogram[0] = '\0';
+        for (int i = 0; i < SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS; i++) {
+            len += SDL_snprintf(histogram + len, sizeof (histogram) - len, "%s%" SDL_PRIu64, i ? " " : "", stats->histogram[i] - prev->histogram[i]);
+            len = SDL_min(len, sizeof (histogram) - 1);
+        }
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO, "%s: %" SDL_PRIu64 " iterations, avg %" SDL_PRIu64 "us (of %" SDL_PRIu64 "us), max since open %" SDL_PRIu64 "us, %" SDL_PRIu64 " missed deadlines, %" SDL_PRIu64 " short stream reads, histogram [%s]",
+                    device->name, iterations, average / 1000, stats->deadline_ns / 1000, stats->max_iteration_ns / 1000,
+                    stats->missed_deadlines - prev->missed_deadlines, stats->short_stream_reads - prev->short_stream_reads, histogram);
+    }
+
+    SDL_copyp(prev, stats);
+    device->stats_logged_ticks = now;
+}
+
 
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
@@ -1140,9 +1499,12 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start = SDL_GetTicksNS();
     bool failed = false;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
+    SDL_AudioStream *zero_copy_stream = NULL;
+    const Uint8 *zero_copy = NULL;  // zero_copy_stream's queued data, played in place of device_buffer. The stream stays locked until it's played.
     if (buffer_size == 0) {
         // WASAPI (maybe others, later) does this to say "just abandon this iteration and try again next time."
     } else if (!device_buffer) {
@@ -1166,7 +1528,13 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     logdev->iteration_start(logdev->iteration_userdata, logdev->instance_id, true);
                 }
 
-                br = SDL_GetAudioStreamDataAdjustGain(stream, device_buffer, buffer_size, logdev->gain);
+                // if the platform can play from any buffer, data that's already in the device format doesn't need to be copied at all.
+                if (current_audio.impl.PlayDeviceAcceptsAnyBuffer && SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
+                    br = SDL_GetAudioStreamDataZeroCopy(stream, device_buffer, buffer_size, logdev->gain, &zero_copy);
+                    zero_copy_stream = stream;
+                } else {
+                    br = SDL_GetAudioStreamDataAdjustGain(stream, device_buffer, buffer_size, logdev->gain);
+                }
 
                 if (logdev->iteration_end) {
                     logdev->iteration_end(logdev->iteration_userdata, logdev->instance_id, false);
@@ -1178,6 +1546,9 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                 SDL_memset(device_buffer, device->silence_value, buffer_size);  // just supply silence to the device before we die.
             } else if (br < buffer_size) {
                 SDL_memset(device_buffer + br, device->silence_value, buffer_size - br);  // silence whatever we didn't write to.
+                if (!SDL_GetAtomicInt(&logdev->paused)) {
+                    SDL_AddAtomicInt(&device->short_stream_reads, 1);
+                }
             }
 
             // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
@@ -1214,25 +1585,16 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
                     logdev->iteration_start(logdev->iteration_userdata, logdev->instance_id, true);
                 }
 
-                for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
-                    // We should have updated this elsewhere if the format changed!
-                    SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, NULL, NULL));
+                // if there's a worker pool and enough streams, the workers handle this logical device's streams; otherwise mix them here.
+                if (!MixLogicalDeviceInParallel(device, logdev, mix_buffer, work_buffer_size, &failed)) {
+                    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                        // We should have updated this elsewhere if the format changed!
+                        SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, NULL, NULL));
 
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
-                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
-                        failed = true;
-                        break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
-                        if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
-                            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), device->work_buffer, device->spec.format, device->spec.channels, NULL,
-                                         device->work_buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+                        if (MixBoundAudioStream(logdev, stream, mix_buffer, device->work_buffer, work_buffer_size) < 0) {
+                            failed = true;  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                            break;
                         }
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
                     }
                 }
 
@@ -1256,13 +1618,24 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         }
 
         // PlayDevice SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice instead!
-        if (!device->PlayDevice(device, device_buffer, buffer_size)) {
+        if (!device->PlayDevice(device, zero_copy ? zero_copy : device_buffer, buffer_size)) {
             failed = true;
         }
+
+        if (zero_copy) {
+            SDL_ReleaseAudioStreamZeroCopy(zero_copy_stream);
+            device->stats.zero_copy_bytes += buffer_size;
+        }
+
+        UpdateAudioDeviceStats(device, buffer_size, SDL_GetTicksNS() - start);
     }
 
     SDL_UnlockMutex(device->lock);
 
+    if (device->stats_log_interval_ns) {
+        LogAudioDeviceStats(device);
+    }
+
     if (failed) {
         SDL_AudioDeviceDisconnected(device);  // doh.
     }
@@ -1320,6 +1693,7 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 start = SDL_GetTicksNS();
     bool failed = false;
 
     if (!device->logical_devices) {
@@ -1378,11 +1752,17 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
                     }
                 }
             }
+
+            UpdateAudioDeviceStats(device, br, SDL_GetTicksNS() - start);
         }
     }
 
     SDL_UnlockMutex(device->lock);
 
+    if (device->stats_log_interval_ns) {
+        LogAudioDeviceStats(device);
+    }
+
     if (failed) {
         SDL_AudioDeviceDisconnected(device);  // doh.
     }
@@ -1587,6 +1967,31 @@ bool SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int
     return result;
 }
 
+bool SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    bool result = false;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        SDL_copyp(stats, &device->stats);
+
+        int queued = 0;
+        for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+            for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                queued += SDL_max(SDL_GetAudioStreamQueued(stream), 0);
+            }
+        }
+        stats->queued_bytes = queued;
+        result = true;
+    }
+    ReleaseAudioDevice(device);
+
+    return result;
+}
+
 int *SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count)
 {
     int *result = NULL;
@@ -1644,6 +2049,9 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_SetAtomicInt(&device->shutdown, 0);  // ready to go again.
     SDL_BroadcastCondition(device->close_cond);  // release anyone waiting in SerializePhysicalDeviceClose; they'll still block until we release device->lock, though.
 
+    DestroyAudioMixPool(device->mix_pool);
+    device->mix_pool = NULL;
+
     SDL_aligned_free(device->work_buffer);
     device->work_buffer = NULL;
 
@@ -1785,6 +2193,14 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
     device->sample_frames = SDL_GetDefaultSampleFramesFromFreq(device->spec.freq);
     SDL_UpdatedAudioDeviceFormat(device);  // start this off sane.
 
+    SDL_zero(device->stats);
+    SDL_zero(device->stats_logged);
+    SDL_SetAtomicInt(&device->short_stream_reads, 0);
+    device->short_stream_reads_counted = 0;
+    const char *stats_log_hint = SDL_GetHint(SDL_HINT_AUDIO_DEVICE_STATS_LOG_INTERVAL);
+    device->stats_log_interval_ns = stats_log_hint ? SDL_MS_TO_NS((Uint64) SDL_max(SDL_atoi(stats_log_hint), 0)) : 0;
+    device->stats_logged_ticks = SDL_GetTicksNS();
+
     device->currently_opened = true;  // mark this true even if impl.OpenDevice fails, so we know to clean up.
     if (!current_audio.impl.OpenDevice(device)) {
         ClosePhysicalAudioDevice(device);  // clean up anything the backend left half-initialized.
@@ -1808,6 +2224,10 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
         }
     }
 
+    if (!device->recording) {
+        device->mix_pool = CreateAudioMixPool(device);  // NULL is fine, it just means we don't mix in parallel.
+    }
+
     // Start the audio thread if necessary
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         char threadname[64];
@@ -1861,6 +2281,7 @@ SDL_AudioDeviceID SDL_OpenAudioDevice(SDL_AudioDeviceID devid, const SDL_AudioSp
             result = logdev->instance_id = AssignAudioDeviceInstanceId(device->recording, /*islogical=*/true);
             logdev->physical_device = device;
             logdev->gain = 1.0f;
+            logdev->fused_mix = !device->recording && SDL_GetHintBoolean(SDL_HINT_AUDIO_DEVICE_FUSED_MIX, true);
             logdev->opened_as_default = wants_default;
             logdev->next = device->logical_devices;
             if (device->logical_devices) {
@@ -2028,6 +2449,8 @@ bool SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream * const *stre
                     result = SDL_SetError("Stream #%d is already bound to a device", i);
                 } else if (stream->simplified) {  // You can get here if you closed the device instead of destroying the stream.
                     result = SDL_SetError("Cannot change binding on a stream created with SDL_OpenAudioDeviceStream");
+                } else if (stream->ring && device->recording) {  // the device would be putting data, and it can't share the ring with the app.
+                    result = SDL_SetError("Stream #%d uses a lock-free ring, and can't be bound to a recording device", i);
                 }
             }
 
@@ -2517,6 +2940,10 @@ bool SDL_AudioDeviceFormatChangedAlreadyLocked(SDL_AudioDevice *device, const SD
                 kill_device = true;
             }
         }
+
+        if (device->mix_pool && !ResizeAudioMixPool(device->mix_pool, device->work_buffer_size)) {
+            kill_device = true;
+        }
     }
 
     // Post an event for the physical device, and each logical device on this physical device.
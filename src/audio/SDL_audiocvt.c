@@ -413,6 +413,33 @@ static Sint64 GetAudioStreamResampleRate(SDL_AudioStream* stream, int src_freq,
     return resample_rate;
 }
 
+// This allocates, so it's only called when the stream's format or frequency ratio is set, never from the
+//  resampling paths. If the rates change some other way (older queued data, say), the phases won't match
+//  the resample rate and the resampler falls back to plain sinc until the next update.
+// this expects the stream lock to be held.
+void UpdateAudioStreamResamplerPhases(SDL_AudioStream *stream)
+{
+    if ((stream->src_spec.freq <= 0) || (stream->dst_spec.freq <= 0)) {
+        return;
+    }
+
+    const int src_freq = (int)((float)stream->src_spec.freq * stream->freq_ratio);
+
+    // If this fails, we just don't get the fast path.
+    stream->resampler_phases = SDL_UpdateResamplerPhases(stream->resampler_phases, src_freq, stream->dst_spec.freq);
+}
+
+static SDL_AudioResampleQuality GetAudioStreamResampleQuality(SDL_AudioStream *stream)
+{
+    if (stream->props) {
+        const Sint64 quality = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, SDL_AUDIO_RESAMPLE_SINC);
+        if ((quality >= SDL_AUDIO_RESAMPLE_NEAREST) && (quality <= SDL_AUDIO_RESAMPLE_SINC)) {
+            return (SDL_AudioResampleQuality)quality;
+        }
+    }
+    return SDL_AUDIO_RESAMPLE_SINC;
+}
+
 static bool UpdateAudioStreamInputSpec(SDL_AudioStream *stream, const SDL_AudioSpec *spec, const int *chmap)
 {
     if (SDL_AudioSpecsEqual(&stream->input_spec, spec, stream->input_chmap, chmap)) {
@@ -448,6 +475,7 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
 
     result->freq_ratio = 1.0f;
     result->gain = 1.0f;
+    result->stats.min_queued_bytes = -1;
     result->queue = SDL_CreateAudioQueue(8192);
 
     if (!result->queue) {
@@ -593,6 +621,11 @@ bool SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_
         }
     }
 
+    if (src_spec && stream->ring && !SDL_AudioSpecsEqual(src_spec, &stream->src_spec, NULL, NULL)) {
+        SDL_UnlockMutex(stream->lock);
+        return SDL_SetError("Can't change the input format of a stream using a lock-free ring");
+    }
+
     if (src_spec) {
         if (src_spec->channels != stream->src_spec.channels) {
             SDL_free(stream->src_chmap);
@@ -609,6 +642,9 @@ bool SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_
         SDL_copyp(&stream->dst_spec, dst_spec);
     }
 
+    // Build the resampler phases now, instead of in the audio thread.
+    UpdateAudioStreamResamplerPhases(stream);
+
     SDL_UnlockMutex(stream->lock);
 
     return true;
@@ -630,6 +666,8 @@ bool SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec
         // already at default, we're good.
     } else if (*stream_chmap && chmap && (SDL_memcmp(*stream_chmap, chmap, sizeof (*chmap) * channels) == 0)) {
         // already have this map, don't allocate/copy it again.
+    } else if ((isinput == 1) && stream->ring) {
+        result = SDL_SetError("Can't change the input channel map of a stream using a lock-free ring");
     } else if (SDL_ChannelMapIsBogus(chmap, channels)) {
         result = SDL_SetError("Invalid channel mapping");
     } else {
@@ -732,6 +770,7 @@ bool SDL_SetAudioStreamFrequencyRatio(SDL_AudioStream *stream, float freq_ratio)
 
     SDL_LockMutex(stream->lock);
     stream->freq_ratio = freq_ratio;
+    UpdateAudioStreamResamplerPhases(stream);
     SDL_UnlockMutex(stream->lock);
 
     return true;
@@ -777,11 +816,85 @@ static bool CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
     return true;
 }
 
+static Sint64 GetAudioStreamAvailableFrames(SDL_AudioStream* stream, Sint64* out_resample_offset);
+
+// you MUST hold `stream->lock` when calling this.
+static int GetAudioStreamAvailableBytes(SDL_AudioStream *stream)
+{
+    Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
+
+    // convert from sample frames to bytes in destination format.
+    count *= SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+
+    // if this overflows an int, just clamp it to a maximum.
+    return (int) SDL_min(count, SDL_INT_MAX);
+}
+
+// Move whatever the producer has written to the lock-free ring into the queue.
+// you MUST hold `stream->lock` when calling this; that's what keeps two threads from consuming at once.
+static bool DrainAudioStreamRing(SDL_AudioStream *stream)
+{
+    if (!stream->ring) {
+        return true;
+    }
+
+    // only take what's there right now; the producer might still be adding more.
+    size_t remaining = SDL_GetAudioRingQueued(stream->ring);
+    if (remaining == 0) {
+        return true;
+    }
+
+    const int prev_available = stream->put_callback ? GetAudioStreamAvailableBytes(stream) : 0;
+
+    while (remaining > 0) {
+        const Uint8 *data = NULL;
+        const size_t len = SDL_min(remaining, SDL_PeekAudioRing(stream->ring, &data));
+        if (!SDL_WriteToAudioQueue(stream->queue, &stream->src_spec, stream->src_chmap, data, len)) {
+            return false;
+        }
+        SDL_ConsumeAudioRing(stream->ring, len);
+        remaining -= len;
+    }
+
+    if (stream->put_callback) {
+        const int newavail = GetAudioStreamAvailableBytes(stream) - prev_available;
+        stream->put_callback(stream->put_callback_userdata, stream, newavail, newavail);
+    }
+
+    return true;
+}
+
+// Switch the stream over to a lock-free ring if the app asked for one. See SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER.
+// you MUST hold `stream->lock` when calling this, and the stream must be fully set up.
+static bool SetupAudioStreamRing(SDL_AudioStream *stream)
+{
+    if (stream->ring || !stream->props) {
+        return true;
+    }
+
+    const Sint64 frames = SDL_GetNumberProperty(stream->props, SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER, 0);
+    if (frames <= 0) {
+        return true;
+    } else if (stream->bound_device && stream->bound_device->physical_device->recording) {
+        return SDL_SetError("Streams bound to recording devices can't use a lock-free ring");
+    } else if (frames > (0x40000000 / SDL_AUDIO_FRAMESIZE(stream->src_spec))) {
+        return SDL_SetError("Lock-free ring is too large");
+    }
+
+    stream->ring = SDL_CreateAudioRing((size_t) frames * SDL_AUDIO_FRAMESIZE(stream->src_spec));
+    return stream->ring != NULL;
+}
+
 // you MUST hold `stream->lock` when calling this, and validate your parameters!
 static bool PutAudioStreamBufferInternal(SDL_AudioStream *stream, const SDL_AudioSpec *spec, const int *chmap, const void *buf, int len, SDL_ReleaseAudioBufferCallback callback, void* userdata)
 {
     SDL_AudioTrack* track = NULL;
 
+    // anything already in the lock-free ring was put first, so it has to go first.
+    if (!DrainAudioStreamRing(stream)) {
+        return false;
+    }
+
     if (callback) {
         track = SDL_CreateAudioTrack(stream->queue, spec, chmap, (Uint8 *)buf, len, len, callback, userdata);
         if (!track) {
@@ -789,7 +902,7 @@ static bool PutAudioStreamBufferInternal(SDL_AudioStream *stream, const SDL_Audi
         }
     }
 
-    const int prev_available = stream->put_callback ? SDL_GetAudioStreamAvailable(stream) : 0;
+    const int prev_available = stream->put_callback ? GetAudioStreamAvailableBytes(stream) : 0;
 
     bool retval = true;
 
@@ -801,7 +914,7 @@ static bool PutAudioStreamBufferInternal(SDL_AudioStream *stream, const SDL_Audi
 
     if (retval) {
         if (stream->put_callback) {
-            const int newavail = SDL_GetAudioStreamAvailable(stream) - prev_available;
+            const int newavail = GetAudioStreamAvailableBytes(stream) - prev_available;
             stream->put_callback(stream->put_callback_userdata, stream, newavail, newavail);
         }
     }
@@ -827,6 +940,11 @@ static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int l
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    if (!SetupAudioStreamRing(stream)) {
+        SDL_UnlockMutex(stream->lock);
+        return false;
+    }
+
     const bool retval = PutAudioStreamBufferInternal(stream, &stream->src_spec, stream->src_chmap, buf, len, callback, userdata);
 
     SDL_UnlockMutex(stream->lock);
@@ -834,6 +952,18 @@ static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int l
     return retval;
 }
 
+// This never takes the stream lock, so the thread putting data never waits on the one getting it.
+static bool PutAudioStreamRing(SDL_AudioStream *stream, const void *buf, int len)
+{
+    // the input format can't change once the ring exists, so it's safe to look at without the lock.
+    if ((len % SDL_AUDIO_FRAMESIZE(stream->src_spec)) != 0) {
+        return SDL_SetError("Can't add partial sample frames");
+    } else if (!SDL_WriteToAudioRing(stream->ring, (const Uint8 *) buf, len)) {
+        return SDL_SetError("Not enough room in the audio stream's lock-free ring");
+    }
+    return true;
+}
+
 static void SDLCALL FreeAllocatedAudioBuffer(void *userdata, const void *buf, int len)
 {
     SDL_free((void*) buf);
@@ -851,6 +981,11 @@ bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return true; // nothing to do.
     }
 
+    // only the thread putting data ever creates the ring, so it doesn't need the lock to check for it.
+    if (stream->ring) {
+        return PutAudioStreamRing(stream, buf, len);
+    }
+
     // When copying in large amounts of data, try and do as much work as possible
     // outside of the stream lock, otherwise the output device is likely to be starved.
     const int large_input_thresh = 64 * 1024;
@@ -1056,10 +1191,11 @@ bool SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    const bool retval = DrainAudioStreamRing(stream);
     SDL_FlushAudioQueue(stream->queue);
     SDL_UnlockMutex(stream->lock);
 
-    return true;
+    return retval;
 }
 
 /* this does not save the previous contents of stream->work_buffer. It's a work buffer!!
@@ -1294,10 +1430,12 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     // Decide where the resampled output goes
     void* resample_buffer = (resample_buffer_offset != -1) ? (work_buffer + resample_buffer_offset) : buf;
 
+    const SDL_AudioResampleQuality quality = GetAudioStreamResampleQuality(stream);
+
     SDL_ResampleAudio(resample_channels,
                   (const float *) input_buffer, input_frames,
                   (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+                  resample_rate, &stream->resample_offset, quality, stream->resampler_phases);
 
     // Convert to the final format, if necessary (src channel map is NULL because SDL_ReadFromAudioQueue already handled this).
     ConvertAudio(output_frames, resample_buffer, resample_format, resample_channels, NULL, buf, dst_format, dst_channels, dst_map, work_buffer, postresample_gain);
@@ -1305,31 +1443,130 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     return true;
 }
 
-// get converted/resampled data from the stream
-int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain)
+// Try to convert, resample, apply gain and mix a chunk into an F32 mix buffer in one pass, without staging
+// the converted or resampled data in the work buffer. Returns 1 if it did, 0 if this chunk needs the general path.
+static int MixAudioStreamDataFused(SDL_AudioStream *stream, float *mix_buffer, int output_frames, float gain)
 {
-    Uint8 *buf = (Uint8 *) voidbuf;
+    const SDL_AudioSpec* src_spec = &stream->input_spec;
+    const SDL_AudioSpec* dst_spec = &stream->dst_spec;
 
-#if DEBUG_AUDIOSTREAM
-    SDL_Log("AUDIOSTREAM: want to get %d converted bytes", len);
-#endif
+    // SDL_ReadFromAudioQueue only swizzles when it converts, and we're asking it not to.
+    if (stream->input_chmap || stream->dst_chmap || (src_spec->channels != dst_spec->channels)) {
+        return 0;
+    }
 
-    if (!stream) {
-        SDL_InvalidParamError("stream");
-        return -1;
-    } else if (!buf) {
-        SDL_InvalidParamError("buf");
+    const Sint64 resample_rate = GetAudioStreamResampleRate(stream, src_spec->freq, stream->resample_offset);
+
+    if (resample_rate == 0) {
+        // Not resampling, so float data can be mixed straight out of the queue.
+        if (src_spec->format != SDL_AUDIO_F32) {
+            return 0;
+        }
+
+        const int bytes = output_frames * SDL_AUDIO_FRAMESIZE(*src_spec);
+        Uint8 *work_buffer = EnsureAudioStreamWorkBufferSize(stream, bytes);
+        if (!work_buffer) {
+            return -1;
+        }
+
+        const Uint8 *input_buffer = SDL_ReadFromAudioQueue(stream->queue, NULL, src_spec->format, src_spec->channels, NULL, 0, output_frames, 0, work_buffer, 1.0f);
+        if (!input_buffer) {
+            SDL_SetError("Not enough data in queue");
+            return -1;
+        }
+
+        SDL_MixAudio((Uint8 *) mix_buffer, input_buffer, SDL_AUDIO_F32, bytes, gain);
+        return 1;
+    }
+
+    if (GetAudioStreamResampleQuality(stream) != SDL_AUDIO_RESAMPLE_SINC) {
+        return 0;
+    }
+
+    if (!SDL_CanResampleAndMixAudio(src_spec->format, src_spec->channels, stream->resampler_phases, resample_rate)) {
+        return 0;
+    }
+
+    const int input_frames = (int) SDL_GetResamplerInputFrames(output_frames, resample_rate, stream->resample_offset);
+    const int padding_frames = SDL_GetResamplerPaddingFrames(resample_rate);
+    const int frame_size = SDL_AUDIO_FRAMESIZE(*src_spec);
+
+    // The work buffer is only needed if the input (plus padding) isn't contiguous in the queue.
+    Uint8 *work_buffer = EnsureAudioStreamWorkBufferSize(stream, (input_frames + (padding_frames * 2)) * frame_size);
+    if (!work_buffer) {
         return -1;
-    } else if (len < 0) {
-        SDL_InvalidParamError("len");
+    }
+
+    const Uint8 *input_buffer = SDL_ReadFromAudioQueue(stream->queue, NULL, src_spec->format, src_spec->channels, NULL,
+                                                       padding_frames, input_frames, padding_frames, work_buffer, 1.0f);
+    if (!input_buffer) {
+        SDL_SetError("Not enough data in queue (resample)");
         return -1;
-    } else if (len == 0) {
-        return 0; // nothing to do.
     }
 
+    input_buffer += padding_frames * frame_size;
+
+    SDL_ResampleAndMixAudio(src_spec->format, input_buffer, input_frames, mix_buffer, output_frames,
+                            gain, stream->resampler_phases, &stream->resample_offset);
+
+    return 1;
+}
+
+// this expects the stream lock to be held.
+static void UpdateAudioStreamStats(SDL_AudioStream *stream, int requested, int total, Uint64 elapsed)
+{
+    SDL_AudioStreamStats *stats = &stream->stats;
+    const int queued = (int) SDL_min(SDL_GetAudioQueueQueued(stream->queue), SDL_INT_MAX);
+
+    stats->gets++;
+    if (total < requested) {
+        stats->short_gets++;
+    }
+    if (total > 0) {
+        stats->bytes += total;
+    }
+    stats->total_ns += elapsed;
+    stats->max_ns = SDL_max(stats->max_ns, elapsed);
+    if ((stats->min_queued_bytes < 0) || (queued < stats->min_queued_bytes)) {
+        stats->min_queued_bytes = queued;
+    }
+}
+
+// If the next `len` bytes of output are already queued exactly as they'd be output, and all in one buffer, consume them and
+// return a pointer to them without copying anything. Otherwise returns NULL and leaves the queue alone.
+static const Uint8 *ReadAudioStreamZeroCopy(SDL_AudioStream *stream, int len, float gain)
+{
+    const SDL_AudioSpec *dst_spec = &stream->dst_spec;
+    const int frames = len / SDL_AUDIO_FRAMESIZE(*dst_spec);
+    SDL_AudioSpec input_spec;
+    int *input_chmap;
+    bool flushed;
+
+    if ((frames <= 0) || (gain != 1.0f) || stream->dst_chmap) {
+        return NULL;
+    }
+
+    const Sint64 available_frames = GetAudioStreamHead(stream, &input_spec, &input_chmap, &flushed);
+    if ((available_frames < frames) || input_chmap || (input_spec.format != dst_spec->format) || (input_spec.channels != dst_spec->channels)) {
+        return NULL;
+    } else if (!UpdateAudioStreamInputSpec(stream, &input_spec, input_chmap)) {
+        return NULL;
+    } else if (GetAudioStreamResampleRate(stream, input_spec.freq, stream->resample_offset) != 0) {
+        return NULL;
+    } else if (!SDL_PeekContiguousAudioQueue(stream->queue, (size_t)len)) {
+        return NULL;
+    }
+
+    return SDL_ReadFromAudioQueue(stream->queue, NULL, dst_spec->format, dst_spec->channels, NULL, 0, frames, 0, NULL, 1.0f);
+}
+
+// get converted/resampled data from the stream. If mix_buffer isn't NULL, the data is mixed into it instead, and buf is just scratch space.
+// If zero_copy isn't NULL, the data might be handed over there instead, see SDL_GetAudioStreamDataZeroCopy.
+static int GetAudioStreamDataCommon(SDL_AudioStream *stream, Uint8 *buf, float *mix_buffer, int len, float extra_gain, const Uint8 **zero_copy)
+{
     SDL_LockMutex(stream->lock);
 
-    if (!CheckAudioStreamIsFullySetup(stream)) {
+    if (!CheckAudioStreamIsFullySetup(stream) || !DrainAudioStreamRing(stream)) {
         SDL_UnlockMutex(stream->lock);
         return -1;
     }
@@ -1361,6 +1598,17 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
     }
 
+    const Uint64 start = SDL_GetTicksNS();  // the get callback's time is the app's, not ours, so don't count it.
+
+    // if the data needs no processing at all, it can be handed over as is. The stream stays locked until it's released.
+    if (zero_copy) {
+        *zero_copy = ReadAudioStreamZeroCopy(stream, len, gain);
+        if (*zero_copy) {
+            UpdateAudioStreamStats(stream, len, len, SDL_GetTicksNS() - start);
+            return len;
+        }
+    }
+
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
     const int chunk_size = 4096;
 
@@ -1396,7 +1644,21 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         output_frames = SDL_min(output_frames, chunk_size);
         output_frames = (int) SDL_min(output_frames, available_frames);
 
-        if (!GetAudioStreamDataInternal(stream, &buf[total], output_frames, gain)) {
+        if (mix_buffer) {
+            float *mix_dst = (float *) (((Uint8 *) mix_buffer) + total);
+            const int rc = MixAudioStreamDataFused(stream, mix_dst, output_frames, gain);
+            if (rc < 0) {
+                total = total ? total : -1;
+                break;
+            } else if (rc == 0) {
+                // the general path; get the data into the scratch buffer, then mix it.
+                if (!GetAudioStreamDataInternal(stream, buf, output_frames, gain)) {
+                    total = total ? total : -1;
+                    break;
+                }
+                SDL_MixAudio((Uint8 *) mix_dst, buf, SDL_AUDIO_F32, output_frames * dst_frame_size, 1.0f);
+            }
+        } else if (!GetAudioStreamDataInternal(stream, &buf[total], output_frames, gain)) {
             total = total ? total : -1;
             break;
         }
@@ -1404,6 +1666,8 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total += output_frames * dst_frame_size;
     }
 
+    UpdateAudioStreamStats(stream, len, total, SDL_GetTicksNS() - start);
+
     SDL_UnlockMutex(stream->lock);
 
 #if DEBUG_AUDIOSTREAM
@@ -1413,6 +1677,65 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
     return total;
 }
 
+int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain)
+{
+    Uint8 *buf = (Uint8 *) voidbuf;
+
+#if DEBUG_AUDIOSTREAM
+    SDL_Log("AUDIOSTREAM: want to get %d converted bytes", len);
+#endif
+
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return -1;
+    } else if (!buf) {
+        SDL_InvalidParamError("buf");
+        return -1;
+    } else if (len < 0) {
+        SDL_InvalidParamError("len");
+        return -1;
+    } else if (len == 0) {
+        return 0; // nothing to do.
+    }
+
+    return GetAudioStreamDataCommon(stream, buf, NULL, len, extra_gain, NULL);
+}
+
+int SDL_GetAudioStreamDataZeroCopy(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain, const Uint8 **zero_copy)
+{
+    SDL_assert(stream != NULL);
+    SDL_assert(voidbuf != NULL);
+    SDL_assert(zero_copy != NULL);
+    SDL_assert(len >= 0);
+
+    *zero_copy = NULL;
+
+    if (len == 0) {
+        return 0; // nothing to do.
+    }
+
+    return GetAudioStreamDataCommon(stream, (Uint8 *) voidbuf, NULL, len, extra_gain, zero_copy);
+}
+
+void SDL_ReleaseAudioStreamZeroCopy(SDL_AudioStream *stream)
+{
+    SDL_UnlockMutex(stream->lock);
+}
+
+int SDL_MixAudioStreamData(SDL_AudioStream *stream, float *mix_buffer, void *scratch, int len, float extra_gain)
+{
+    SDL_assert(stream != NULL);
+    SDL_assert(mix_buffer != NULL);
+    SDL_assert(scratch != NULL);
+    SDL_assert(len >= 0);
+
+    if (len == 0) {
+        return 0; // nothing to do.
+    }
+
+    return GetAudioStreamDataCommon(stream, (Uint8 *) scratch, mix_buffer, len, extra_gain, NULL);
+}
+
 int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 {
     return SDL_GetAudioStreamDataAdjustGain(stream, voidbuf, len, 1.0f);
@@ -1428,20 +1751,16 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
-    if (!CheckAudioStreamIsFullySetup(stream)) {
+    if (!CheckAudioStreamIsFullySetup(stream) || !DrainAudioStreamRing(stream)) {
         SDL_UnlockMutex(stream->lock);
         return 0;
     }
 
-    Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
-
-    // convert from sample frames to bytes in destination format.
-    count *= SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+    const int result = GetAudioStreamAvailableBytes(stream);
 
     SDL_UnlockMutex(stream->lock);
 
-    // if this overflows an int, just clamp it to a maximum.
-    return (int) SDL_min(count, SDL_INT_MAX);
+    return result;
 }
 
 // number of sample frames that are currently queued as input.
@@ -1455,6 +1774,9 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
     SDL_LockMutex(stream->lock);
 
     size_t total = SDL_GetAudioQueueQueued(stream->queue);
+    if (stream->ring) {
+        total += SDL_GetAudioRingQueued(stream->ring);
+    }
 
     SDL_UnlockMutex(stream->lock);
 
@@ -1462,6 +1784,23 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
     return (int) SDL_min(total, SDL_INT_MAX);
 }
 
+// the stream's counters, plus the bytes currently queued as input.
+bool SDL_GetAudioStreamStats(SDL_AudioStream *stream, SDL_AudioStreamStats *stats)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(stream->lock);
+    SDL_copyp(stats, &stream->stats);
+    SDL_UnlockMutex(stream->lock);
+
+    stats->queued_bytes = SDL_GetAudioStreamQueued(stream);
+    return true;
+}
+
 bool SDL_ClearAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -1471,6 +1810,9 @@ bool SDL_ClearAudioStream(SDL_AudioStream *stream)
     SDL_LockMutex(stream->lock);
 
     SDL_ClearAudioQueue(stream->queue);
+    if (stream->ring) {
+        SDL_ClearAudioRing(stream->ring);
+    }
     SDL_zero(stream->input_spec);
     stream->input_chmap = NULL;
     stream->resample_offset = 0;
@@ -1500,7 +1842,9 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_aligned_free(stream->work_buffer);
+    SDL_DestroyResamplerPhases(stream->resampler_phases);
     SDL_DestroyAudioQueue(stream->queue);
+    SDL_DestroyAudioRing(stream->ring);
     SDL_DestroyMutex(stream->lock);
 
     SDL_free(stream);
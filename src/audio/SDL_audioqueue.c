@@ -601,6 +601,17 @@ const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
     return ptr;
 }
 
+const Uint8 *SDL_PeekContiguousAudioQueue(SDL_AudioQueue *queue, size_t len)
+{
+    SDL_AudioTrack *track = queue->head;
+
+    if (!track || (track->tail - track->head) < len) {
+        return NULL;
+    }
+
+    return &track->data[track->head];
+}
+
 size_t SDL_GetAudioQueueQueued(SDL_AudioQueue *queue)
 {
     size_t total = 0;
@@ -650,3 +661,101 @@ bool SDL_ResetAudioQueueHistory(SDL_AudioQueue *queue, int num_frames)
 
     return true;
 }
+
+struct SDL_AudioRing
+{
+    Uint8 *data;
+    Uint32 capacity;  // always a power of two, so the positions can wrap around naturally.
+    SDL_AtomicU32 head;  // read position; only changed by the consumer.
+    SDL_AtomicU32 tail;  // write position; only changed by the producer.
+};
+
+SDL_AudioRing *SDL_CreateAudioRing(size_t capacity)
+{
+    if ((capacity == 0) || (capacity > 0x40000000)) {
+        SDL_InvalidParamError("capacity");
+        return NULL;
+    }
+
+    SDL_AudioRing *ring = (SDL_AudioRing *)SDL_calloc(1, sizeof(*ring));
+    if (!ring) {
+        return NULL;
+    }
+
+    Uint32 pow2 = 1;
+    while (pow2 < capacity) {
+        pow2 <<= 1;
+    }
+
+    ring->data = (Uint8 *)SDL_malloc(pow2);
+    if (!ring->data) {
+        SDL_free(ring);
+        return NULL;
+    }
+
+    ring->capacity = pow2;
+
+    return ring;
+}
+
+void SDL_DestroyAudioRing(SDL_AudioRing *ring)
+{
+    if (ring) {
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+bool SDL_WriteToAudioRing(SDL_AudioRing *ring, const Uint8 *data, size_t len)
+{
+    const Uint32 head = SDL_GetAtomicU32(&ring->head);
+    const Uint32 tail = SDL_GetAtomicU32(&ring->tail);
+
+    if (len > (size_t)(ring->capacity - (tail - head))) {
+        return false;
+    }
+
+    const Uint32 offset = tail & (ring->capacity - 1);
+    const size_t first = SDL_min(len, ring->capacity - offset);
+
+    SDL_memcpy(ring->data + offset, data, first);
+    SDL_memcpy(ring->data, data + first, len - first);
+
+    // Publishing the new tail is what hands the data over, so it must come after the copy.
+    SDL_SetAtomicU32(&ring->tail, tail + (Uint32)len);
+
+    return true;
+}
+
+size_t SDL_PeekAudioRing(SDL_AudioRing *ring, const Uint8 **out_data)
+{
+    const Uint32 head = SDL_GetAtomicU32(&ring->head);
+    const Uint32 tail = SDL_GetAtomicU32(&ring->tail);
+    const Uint32 offset = head & (ring->capacity - 1);
+
+    *out_data = ring->data + offset;
+
+    return SDL_min(tail - head, ring->capacity - offset);
+}
+
+void SDL_ConsumeAudioRing(SDL_AudioRing *ring, size_t len)
+{
+    const Uint32 head = SDL_GetAtomicU32(&ring->head);
+
+    SDL_assert(len <= SDL_GetAudioRingQueued(ring));
+
+    SDL_SetAtomicU32(&ring->head, head + (Uint32)len);
+}
+
+void SDL_ClearAudioRing(SDL_AudioRing *ring)
+{
+    SDL_SetAtomicU32(&ring->head, SDL_GetAtomicU32(&ring->tail));
+}
+
+size_t SDL_GetAudioRingQueued(SDL_AudioRing *ring)
+{
+    const Uint32 head = SDL_GetAtomicU32(&ring->head);
+    const Uint32 tail = SDL_GetAtomicU32(&ring->tail);
+
+    return tail - head;
+}
@@ -71,9 +71,38 @@ extern const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
                                            int past_frames, int present_frames, int future_frames,
                                            Uint8 *scratch, float gain);
 
+// Get a pointer to the next `len` bytes of the queue without removing them, if they are all in one buffer. Returns NULL otherwise.
+extern const Uint8 *SDL_PeekContiguousAudioQueue(SDL_AudioQueue *queue, size_t len);
+
 // Get the total number of bytes currently queued
 extern size_t SDL_GetAudioQueueQueued(SDL_AudioQueue *queue);
 
 extern bool SDL_ResetAudioQueueHistory(SDL_AudioQueue *queue, int num_frames);
 
+// A fixed-size, lock-free ring buffer, for exactly one producer thread and one consumer at a time.
+// The producer writes, and everything else is the consumer's job; if several threads might consume, they must serialize themselves.
+typedef struct SDL_AudioRing SDL_AudioRing;
+
+// Create a new ring buffer, holding at least `capacity` bytes
+extern SDL_AudioRing *SDL_CreateAudioRing(size_t capacity);
+
+// Destroy a ring buffer
+extern void SDL_DestroyAudioRing(SDL_AudioRing *ring);
+
+// Write all of `len` bytes to the ring, or nothing at all if there isn't room. Producer only.
+extern bool SDL_WriteToAudioRing(SDL_AudioRing *ring, const Uint8 *data, size_t len);
+
+// Get the oldest contiguous run of bytes in the ring, without removing them. Consumer only.
+extern size_t SDL_PeekAudioRing(SDL_AudioRing *ring, const Uint8 **out_data);
+
+// Remove bytes from the front of the ring. Consumer only.
+// REQUIRES: `len` is no more than is queued
+extern void SDL_ConsumeAudioRing(SDL_AudioRing *ring, size_t len);
+
+// Drop everything currently in the ring. Consumer only.
+extern void SDL_ClearAudioRing(SDL_AudioRing *ring);
+
+// Get the number of bytes currently in the ring
+extern size_t SDL_GetAudioRingQueued(SDL_AudioRing *ring);
+
 #endif // SDL_audioqueue_h_
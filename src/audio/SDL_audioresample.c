@@ -68,17 +68,11 @@ typedef union Cubic
 
 } Cubic;
 
-static void ResampleFrame_Generic(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+// Multiply an already interpolated filter with the input.
+// These are shared with the polyphase resampler, which precomputes the scales for each phase.
+static void ResamplePhase_Generic(const float *src, float *dst, const float *scales, int chans)
 {
-    const float frac2 = frac * frac;
-    const float frac3 = frac * frac2;
-
     int i, chan;
-    float scales[RESAMPLER_SAMPLES_PER_FRAME];
-
-    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i, ++filter) {
-        scales[i] = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac2) + (filter->v[3] * frac3);
-    }
 
     for (chan = 0; chan < chans; ++chan) {
         float out = 0.0f;
@@ -91,77 +85,72 @@ static void ResampleFrame_Generic(const float *src, float *dst, const Cubic *fil
     }
 }
 
-static void ResampleFrame_Mono(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+static void ResamplePhase_Mono(const float *src, float *dst, const float *scales, int chans)
 {
-    const float frac2 = frac * frac;
-    const float frac3 = frac * frac2;
-
     int i;
     float out = 0.0f;
 
-    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i, ++filter) {
-        // Interpolate between the nearest two filters
-        const float scale = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac2) + (filter->v[3] * frac3);
-
-        out += src[i] * scale;
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+        out += src[i] * scales[i];
     }
 
     dst[0] = out;
 }
 
-static void ResampleFrame_Stereo(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+static void ResamplePhase_Stereo(const float *src, float *dst, const float *scales, int chans)
 {
-    const float frac2 = frac * frac;
-    const float frac3 = frac * frac2;
-
     int i;
     float out0 = 0.0f;
     float out1 = 0.0f;
 
-    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i, ++filter) {
-        // Interpolate between the nearest two filters
-        const float scale = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac2) + (filter->v[3] * frac3);
-
-        out0 += src[i * 2 + 0] * scale;
-        out1 += src[i * 2 + 1] * scale;
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+        out0 += src[i * 2 + 0] * scales[i];
+        out1 += src[i * 2 + 1] * scales[i];
     }
 
     dst[0] = out0;
     dst[1] = out1;
 }
 
-#ifdef SDL_SSE_INTRINSICS
-#define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // Not-so-fused multiply-add
-
-static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+// Interpolate between the nearest two filters
+static void InterpolateFilter(const Cubic *filter, float frac, float *scales)
 {
-#if RESAMPLER_SAMPLES_PER_FRAME != 12
-#error Invalid samples per frame
-#endif
+    const float frac2 = frac * frac;
+    const float frac3 = frac * frac2;
 
-    __m128 f0, f1, f2;
+    int i;
 
-    {
-        const __m128 frac1 = _mm_set1_ps(frac);
-        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
-        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i, ++filter) {
+        scales[i] = filter->v[0] + (filter->v[1] * frac) + (filter->v[2] * frac2) + (filter->v[3] * frac3);
+    }
+}
 
-// Transposed in SetupAudioResampler
-// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
-#define X(out)                                               \
-    out = _mm_load_ps(filter[0].v);                          \
-    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
-    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
-    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
-    filter += 4
+static void ResampleFrame_Generic(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
+    InterpolateFilter(filter, frac, scales);
+    ResamplePhase_Generic(src, dst, scales, chans);
+}
 
-        X(f0);
-        X(f1);
-        X(f2);
+static void ResampleFrame_Mono(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
+    InterpolateFilter(filter, frac, scales);
+    ResamplePhase_Mono(src, dst, scales, chans);
+}
 
-#undef X
-    }
+static void ResampleFrame_Stereo(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    float scales[RESAMPLER_SAMPLES_PER_FRAME];
+    InterpolateFilter(filter, frac, scales);
+    ResamplePhase_Stereo(src, dst, scales, chans);
+}
+
+#ifdef SDL_SSE_INTRINSICS
+#define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // Not-so-fused multiply-add
 
+SDL_FORCE_INLINE void SDL_TARGETING("sse") ApplyFilter_SSE(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
+{
     if (chans == 2) {
         // Duplicate each of the filter elements and multiply by the input
         // Use two accumulators to improve throughput
@@ -261,26 +250,26 @@ static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, flo
     }
 }
 
-#undef sdl_madd_ps
-#endif
-
-#ifdef SDL_NEON_INTRINSICS
-static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
 {
 #if RESAMPLER_SAMPLES_PER_FRAME != 12
 #error Invalid samples per frame
 #endif
 
-    float32x4_t f0, f1, f2;
+    __m128 f0, f1, f2;
 
     {
-        const float32x4_t frac1 = vdupq_n_f32(frac);
-        const float32x4_t frac2 = vmulq_f32(frac1, frac1);
-        const float32x4_t frac3 = vmulq_f32(frac1, frac2);
+        const __m128 frac1 = _mm_set1_ps(frac);
+        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
+        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
 
 // Transposed in SetupAudioResampler
-#define X(out)                                                                                                                  \
-    out = vmlaq_f32(vmlaq_f32(vmlaq_f32(filter[0].v128, filter[1].v128, frac1), filter[2].v128, frac2), filter[3].v128, frac3); \
+// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
+#define X(out)                                               \
+    out = _mm_load_ps(filter[0].v);                          \
+    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
+    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
+    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
     filter += 4
 
         X(f0);
@@ -290,6 +279,21 @@ static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic
 #undef X
     }
 
+    ApplyFilter_SSE(src, dst, f0, f1, f2, chans);
+}
+
+static void SDL_TARGETING("sse") ResamplePhase_SSE(const float *src, float *dst, const float *scales, int chans)
+{
+    // The phase tables are SIMD-aligned.
+    ApplyFilter_SSE(src, dst, _mm_load_ps(scales + 0), _mm_load_ps(scales + 4), _mm_load_ps(scales + 8), chans);
+}
+
+#undef sdl_madd_ps
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+SDL_FORCE_INLINE void ApplyFilter_NEON(const float *src, float *dst, float32x4_t f0, float32x4_t f1, float32x4_t f2, int chans)
+{
     if (chans == 2) {
         float32x4x2_t g0 = vzipq_f32(f0, f0);
         float32x4x2_t g1 = vzipq_f32(f1, f1);
@@ -393,6 +397,140 @@ static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic
         vst1_lane_f32(&dst[chan], sum, 0);
     }
 }
+static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+#if RESAMPLER_SAMPLES_PER_FRAME != 12
+#error Invalid samples per frame
+#endif
+
+    float32x4_t f0, f1, f2;
+
+    {
+        const float32x4_t frac1 = vdupq_n_f32(frac);
+        const float32x4_t frac2 = vmulq_f32(frac1, frac1);
+        const float32x4_t frac3 = vmulq_f32(frac1, frac2);
+
+// Transposed in SetupAudioResampler
+#define X(out)                                                                                                                  \
+    out = vmlaq_f32(vmlaq_f32(vmlaq_f32(filter[0].v128, filter[1].v128, frac1), filter[2].v128, frac2), filter[3].v128, frac3); \
+    filter += 4
+
+        X(f0);
+        X(f1);
+        X(f2);
+
+#undef X
+    }
+
+    ApplyFilter_NEON(src, dst, f0, f1, f2, chans);
+}
+
+static void ResamplePhase_NEON(const float *src, float *dst, const float *scales, int chans)
+{
+    ApplyFilter_NEON(src, dst, vld1q_f32(scales + 0), vld1q_f32(scales + 4), vld1q_f32(scales + 8), chans);
+}
+
+#endif
+
+// Fused resample+mix for stereo input, used when mixing audio streams into a device's float buffer.
+// This applies the filter, scales the result by the gain, and adds it to the output, so the resampled
+// data never has to be written out and read back again. The result is clamped to [-1, 1] just like SDL_MixAudio does.
+typedef void (*MixPhaseFunc)(const float *src, float *dst, const float *scales, float gain);
+static MixPhaseFunc MixPhase;
+
+static float MixClamp(float sample)
+{
+    if (sample > 1.0f) {
+        return 1.0f;
+    } else if (sample < -1.0f) {
+        return -1.0f;
+    }
+    return sample;  // (this lets NaNs through, the same as the SIMD versions.)
+}
+
+static void MixPhase_Scalar(const float *src, float *dst, const float *scales, float gain)
+{
+    float out[2];
+    ResamplePhase_Stereo(src, out, scales, 2);
+    dst[0] = MixClamp(dst[0] + (out[0] * gain));
+    dst[1] = MixClamp(dst[1] + (out[1] * gain));
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// Multiply 12 stereo frames (as 6 pairs of frames) by the filter, sum, scale and mix into dst.
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") MixFilterStereo_SSE2(const __m128 *in, float *dst, const float *scales, float gain)
+{
+    const __m128 f0 = _mm_load_ps(scales + 0);
+    const __m128 f1 = _mm_load_ps(scales + 4);
+    const __m128 f2 = _mm_load_ps(scales + 8);
+
+    // Duplicate each of the filter elements and multiply by the input
+    // Use two accumulators to improve throughput
+    __m128 out0 = _mm_mul_ps(in[0], _mm_unpacklo_ps(f0, f0));
+    __m128 out1 = _mm_mul_ps(in[1], _mm_unpackhi_ps(f0, f0));
+    out0 = _mm_add_ps(out0, _mm_mul_ps(in[2], _mm_unpacklo_ps(f1, f1)));
+    out1 = _mm_add_ps(out1, _mm_mul_ps(in[3], _mm_unpackhi_ps(f1, f1)));
+    out0 = _mm_add_ps(out0, _mm_mul_ps(in[4], _mm_unpacklo_ps(f2, f2)));
+    out1 = _mm_add_ps(out1, _mm_mul_ps(in[5], _mm_unpackhi_ps(f2, f2)));
+
+    // Add the accumulators together, then the lower and upper pairs
+    __m128 out = _mm_add_ps(out0, out1);
+    out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+    out = _mm_mul_ps(out, _mm_set1_ps(gain));
+
+    // Mix into the destination, with the max/min operand order letting NaNs through like the scalar code.
+    __m128 mixed = _mm_add_ps(_mm_castpd_ps(_mm_load_sd((const double *)dst)), out);
+    mixed = _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_set1_ps(-1.0f), mixed));
+    _mm_store_sd((double *)dst, _mm_castps_pd(mixed));
+}
+
+static void SDL_TARGETING("sse2") MixPhase_SSE2(const float *src, float *dst, const float *scales, float gain)
+{
+    __m128 frames[6];
+    int i;
+
+    for (i = 0; i < 6; ++i) {
+        frames[i] = _mm_loadu_ps(src + (i * 4));
+    }
+
+    MixFilterStereo_SSE2(frames, dst, scales, gain);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+SDL_FORCE_INLINE void MixFilterStereo_NEON(const float32x4_t *in, float *dst, const float *scales, float gain)
+{
+    const float32x4x2_t g0 = vzipq_f32(vld1q_f32(scales + 0), vld1q_f32(scales + 0));
+    const float32x4x2_t g1 = vzipq_f32(vld1q_f32(scales + 4), vld1q_f32(scales + 4));
+    const float32x4x2_t g2 = vzipq_f32(vld1q_f32(scales + 8), vld1q_f32(scales + 8));
+
+    float32x4_t out0 = vmulq_f32(in[0], g0.val[0]);
+    float32x4_t out1 = vmulq_f32(in[1], g0.val[1]);
+    out0 = vmlaq_f32(out0, in[2], g1.val[0]);
+    out1 = vmlaq_f32(out1, in[3], g1.val[1]);
+    out0 = vmlaq_f32(out0, in[4], g2.val[0]);
+    out1 = vmlaq_f32(out1, in[5], g2.val[1]);
+
+    out0 = vaddq_f32(out0, out1);
+    float32x2_t out = vadd_f32(vget_low_f32(out0), vget_high_f32(out0));
+    out = vmul_n_f32(out, gain);
+
+    float32x2_t mixed = vadd_f32(vld1_f32(dst), out);
+    mixed = vmin_f32(vdup_n_f32(1.0f), vmax_f32(vdup_n_f32(-1.0f), mixed));  // these propagate NaNs, like the scalar code.
+    vst1_f32(dst, mixed);
+}
+
+static void MixPhase_NEON(const float *src, float *dst, const float *scales, float gain)
+{
+    float32x4_t frames[6];
+    int i;
+
+    for (i = 0; i < 6; ++i) {
+        frames[i] = vld1q_f32(src + (i * 4));
+    }
+
+    MixFilterStereo_NEON(frames, dst, scales, gain);
+}
 #endif
 
 // Calculate the cubic equation which passes through all four points.
@@ -516,6 +654,11 @@ static void GenerateResamplerFilter(void)
 typedef void (*ResampleFrameFunc)(const float *src, float *dst, const Cubic *filter, float frac, int chans);
 static ResampleFrameFunc ResampleFrame[8];
 
+typedef void (*ResamplePhaseFunc)(const float *src, float *dst, const float *scales, int chans);
+static ResamplePhaseFunc ResamplePhase[8];
+
+static bool ResamplerFilterTransposed = false;
+
 // Transpose 4x4 floats
 static void Transpose4x4(Cubic *data)
 {
@@ -541,6 +684,7 @@ static void SetupAudioResampler(void)
     if (SDL_HasSSE()) {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_SSE;
+            ResamplePhase[i] = ResamplePhase_SSE;
         }
         transpose = true;
     } else
@@ -549,6 +693,7 @@ static void SetupAudioResampler(void)
     if (SDL_HasNEON()) {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_NEON;
+            ResamplePhase[i] = ResamplePhase_NEON;
         }
         transpose = true;
     } else
@@ -556,10 +701,13 @@ static void SetupAudioResampler(void)
     {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic;
+            ResamplePhase[i] = ResamplePhase_Generic;
         }
 
         ResampleFrame[0] = ResampleFrame_Mono;
         ResampleFrame[1] = ResampleFrame_Stereo;
+        ResamplePhase[0] = ResamplePhase_Mono;
+        ResamplePhase[1] = ResamplePhase_Stereo;
     }
 
     if (transpose) {
@@ -570,6 +718,22 @@ static void SetupAudioResampler(void)
             }
         }
     }
+
+    ResamplerFilterTransposed = transpose;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        MixPhase = MixPhase_SSE2;
+    } else
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        MixPhase = MixPhase_NEON;
+    } else
+#endif
+    {
+        MixPhase = MixPhase_Scalar;
+    }
 }
 
 void SDL_SetupAudioResampler(void)
@@ -675,8 +839,350 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
     return output_frames;
 }
 
+// Most streams resample between two fixed rates with a simple ratio, like 44100:48000 (147:160).
+// The output frames then only ever land on a small number of distinct positions between two input frames,
+// so we can interpolate the filter for each of those "phases" once, and each output frame becomes a plain dot product.
+#define RESAMPLER_MAX_PHASES 512
+
+struct SDL_ResamplerPhases
+{
+    Sint64 resample_rate;
+    int num_phases;  // The denominator of the reduced ratio
+    int step_frames; // Whole input frames to advance for each output frame
+    int step_phases; // Extra phases to advance for each output frame
+    float *scales;   // RESAMPLER_SAMPLES_PER_FRAME interpolated scales for each phase, SIMD-aligned
+};
+
+static int GreatestCommonDivisor(int a, int b)
+{
+    while (b != 0) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static void GenerateResamplerPhase(float *scales, int phase, int num_phases)
+{
+    // Same filter and fraction that SDL_ResampleAudio would use for `srcfraction = phase / num_phases`
+    const Sint64 pos = (Sint64)phase * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+    const int index = (int)(pos / num_phases);
+    const float frac = (float)(pos % num_phases) / (float)num_phases;
+
+    Cubic filter[RESAMPLER_SAMPLES_PER_FRAME];
+    int i;
+
+    SDL_memcpy(filter, ResamplerFilter[index], sizeof(filter));
+
+    if (ResamplerFilterTransposed) {
+        for (i = 0; i + 4 <= RESAMPLER_SAMPLES_PER_FRAME; i += 4) {
+            Transpose4x4(&filter[i]);
+        }
+    }
+
+    InterpolateFilter(filter, frac, scales);
+}
+
+SDL_ResamplerPhases *SDL_CreateResamplerPhases(int src_rate, int dst_rate)
+{
+    SDL_assert(src_rate > 0);
+    SDL_assert(dst_rate > 0);
+
+    const int divisor = GreatestCommonDivisor(src_rate, dst_rate);
+    const int num = src_rate / divisor;
+    const int den = dst_rate / divisor;
+    int i;
+
+    if ((den > RESAMPLER_MAX_PHASES) || ((num == 1) && (den == 1))) {
+        return NULL;
+    }
+
+    SDL_ResamplerPhases *phases = (SDL_ResamplerPhases *)SDL_calloc(1, sizeof(*phases));
+    if (!phases) {
+        return NULL;
+    }
+
+    phases->scales = (float *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), den * RESAMPLER_SAMPLES_PER_FRAME * sizeof(float));
+    if (!phases->scales) {
+        SDL_free(phases);
+        return NULL;
+    }
+
+    phases->resample_rate = SDL_GetResampleRate(src_rate, dst_rate);
+    phases->num_phases = den;
+    phases->step_frames = num / den;
+    phases->step_phases = num % den;
+
+    for (i = 0; i < den; ++i) {
+        GenerateResamplerPhase(&phases->scales[i * RESAMPLER_SAMPLES_PER_FRAME], i, den);
+    }
+
+    return phases;
+}
+
+void SDL_DestroyResamplerPhases(SDL_ResamplerPhases *phases)
+{
+    if (phases) {
+        SDL_aligned_free(phases->scales);
+        SDL_free(phases);
+    }
+}
+
+SDL_ResamplerPhases *SDL_UpdateResamplerPhases(SDL_ResamplerPhases *phases, int src_rate, int dst_rate)
+{
+    if (phases && (phases->resample_rate == SDL_GetResampleRate(src_rate, dst_rate))) {
+        return phases;
+    }
+
+    SDL_DestroyResamplerPhases(phases);
+    return SDL_CreateResamplerPhases(src_rate, dst_rate);
+}
+
+// Round down to the nearest phase. Since the exact step is never larger than the (rounded up) resample_rate,
+// this never reads further ahead than SDL_GetResamplerInputFrames expects.
+static int GetResamplerPhase(Sint64 srcpos, int num_phases, int *out_srcindex)
+{
+    *out_srcindex = (int)(Sint32)(srcpos >> 32);
+    return (int)(((Uint64)(srcpos & 0xFFFFFFFF) * num_phases) >> 32);
+}
+
+// Round the fraction up, so the next call lands on exactly the same phase.
+static Sint64 GetResamplerPhaseOffset(int srcindex, int phase, int inframes, int num_phases)
+{
+    Sint64 srcpos = (Sint64)(((Uint64)phase << 32) + num_phases - 1) / num_phases;
+    srcpos += (Sint64)(srcindex - inframes) * 0x100000000;
+    return srcpos;
+}
+
+static void ResampleAudioPhases(int chans, const float *src, int inframes, float *dst, int outframes,
+                                const SDL_ResamplerPhases *phases, Sint64 *inout_resample_offset)
+{
+    int i;
+    int srcindex;
+    ResamplePhaseFunc resample_phase = ResamplePhase[chans - 1];
+
+    const int num_phases = phases->num_phases;
+    const int step_frames = phases->step_frames;
+    const int step_phases = phases->step_phases;
+
+    int phase = GetResamplerPhase(*inout_resample_offset, num_phases, &srcindex);
+
+    src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
+
+    for (i = 0; i < outframes; ++i) {
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        resample_phase(&src[srcindex * chans], dst, &phases->scales[phase * RESAMPLER_SAMPLES_PER_FRAME], chans);
+        dst += chans;
+
+        srcindex += step_frames;
+        phase += step_phases;
+
+        if (phase >= num_phases) {
+            phase -= num_phases;
+            ++srcindex;
+        }
+    }
+
+    *inout_resample_offset = GetResamplerPhaseOffset(srcindex, phase, inframes, num_phases);
+}
+
+bool SDL_CanResampleAndMixAudio(SDL_AudioFormat src_format, int chans, const SDL_ResamplerPhases *phases, Sint64 resample_rate)
+{
+    return phases && (phases->resample_rate == resample_rate) && (chans == 2) &&
+           ((src_format == SDL_AUDIO_S16) || (src_format == SDL_AUDIO_F32));
+}
+
+static void ResampleAndMixAudio_Float(const float *src, int inframes, float *dst, int outframes, float gain,
+                                     const SDL_ResamplerPhases *phases, int *inout_srcindex, int *inout_phase)
+{
+    int i;
+    int srcindex = *inout_srcindex;
+    int phase = *inout_phase;
+
+    const int num_phases = phases->num_phases;
+    const int step_frames = phases->step_frames;
+    const int step_phases = phases->step_phases;
+
+    src -= (RESAMPLER_ZERO_CROSSINGS - 1) * 2;
+
+    for (i = 0; i < outframes; ++i) {
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        MixPhase(&src[srcindex * 2], dst, &phases->scales[phase * RESAMPLER_SAMPLES_PER_FRAME], gain);
+        dst += 2;
+
+        srcindex += step_frames;
+        phase += step_phases;
+
+        if (phase >= num_phases) {
+            phase -= num_phases;
+            ++srcindex;
+        }
+    }
+
+    *inout_srcindex = srcindex;
+    *inout_phase = phase;
+}
+
+// How many frames of S16 input get converted to float at a time; small enough to stay in the L1 cache.
+#define RESAMPLER_MIX_BLOCK_FRAMES 256
+
+void SDL_ResampleAndMixAudio(SDL_AudioFormat src_format, const void *src, int inframes, float *dst, int outframes,
+                             float gain, const SDL_ResamplerPhases *phases, Sint64 *inout_resample_offset)
+{
+    int srcindex;
+    int phase = GetResamplerPhase(*inout_resample_offset, phases->num_phases, &srcindex);
+
+    SDL_assert((src_format == SDL_AUDIO_S16) || (src_format == SDL_AUDIO_F32));
+
+    if (src_format == SDL_AUDIO_F32) {
+        ResampleAndMixAudio_Float((const float *)src, inframes, dst, outframes, gain, phases, &srcindex, &phase);
+    } else {
+        // Converting each input frame once per filter tap would cost more than it saves, so convert the input a
+        // block at a time into a small buffer that stays in the cache, and resample and mix from that instead.
+        const Sint16 *input = (const Sint16 *)src;
+        const int num_phases = phases->num_phases;
+        const int stride = (phases->step_frames * num_phases) + phases->step_phases;  // in phases, per output frame.
+        const int max_outframes = 1 + ((((RESAMPLER_MIX_BLOCK_FRAMES - RESAMPLER_SAMPLES_PER_FRAME) * num_phases) - (num_phases - 1)) / stride);
+        float block[RESAMPLER_MIX_BLOCK_FRAMES * 2];
+
+        while (outframes > 0) {
+            const int block_outframes = SDL_min(outframes, max_outframes);
+            const int last = srcindex + ((phase + ((block_outframes - 1) * stride)) / num_phases);  // the last filter center.
+            const int first_frame = srcindex - (RESAMPLER_ZERO_CROSSINGS - 1);
+            const int block_frames = (last + RESAMPLER_ZERO_CROSSINGS + 1) - first_frame;
+            int block_srcindex = 0;
+
+            SDL_assert(block_frames <= RESAMPLER_MIX_BLOCK_FRAMES);
+
+            ConvertAudioToFloat(block, input + (first_frame * 2), block_frames * 2, SDL_AUDIO_S16);
+            ResampleAndMixAudio_Float(block + ((RESAMPLER_ZERO_CROSSINGS - 1) * 2), block_frames - RESAMPLER_SAMPLES_PER_FRAME + 1,
+                                      dst, block_outframes, gain, phases, &block_srcindex, &phase);
+
+            srcindex += block_srcindex;
+            dst += block_outframes * 2;
+            outframes -= block_outframes;
+        }
+    }
+
+    *inout_resample_offset = GetResamplerPhaseOffset(srcindex, phase, inframes, phases->num_phases);
+}
+
+// Cheaper resamplers, for streams that don't need the full quality.
+// These only read from `srcindex - 1` to `srcindex + 2`, which is well within the padding the sinc filter needs.
+// They are force-inlined with a constant channel count for mono and stereo, so the compiler can unroll the inner loop.
+SDL_FORCE_INLINE void ResampleAudioNearest(int chans, const float *src, int inframes, float *dst, int outframes,
+                                           Sint64 resample_rate, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    Sint64 srcpos = *inout_resample_offset;
+
+    for (i = 0; i < outframes; ++i) {
+        // Round to the nearest frame
+        int srcindex = (int)(Sint32)((srcpos + 0x80000000) >> 32);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex <= inframes);
+
+        const float *frame = &src[srcindex * chans];
+
+        for (chan = 0; chan < chans; ++chan) {
+            dst[chan] = frame[chan];
+        }
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
+
+SDL_FORCE_INLINE void ResampleAudioLinear(int chans, const float *src, int inframes, float *dst, int outframes,
+                                          Sint64 resample_rate, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    Sint64 srcpos = *inout_resample_offset;
+
+    for (i = 0; i < outframes; ++i) {
+        int srcindex = (int)(Sint32)(srcpos >> 32);
+        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float *frame = &src[srcindex * chans];
+        const float frac = (float)srcfraction * (1.0f / 4294967296.0f);
+
+        for (chan = 0; chan < chans; ++chan) {
+            const float p0 = frame[chan];
+            const float p1 = frame[chan + chans];
+            dst[chan] = p0 + ((p1 - p0) * frac);
+        }
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
+
+SDL_FORCE_INLINE void ResampleAudioCubic(int chans, const float *src, int inframes, float *dst, int outframes,
+                                         Sint64 resample_rate, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    Sint64 srcpos = *inout_resample_offset;
+
+    for (i = 0; i < outframes; ++i) {
+        int srcindex = (int)(Sint32)(srcpos >> 32);
+        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float *frame = &src[srcindex * chans];
+        const float frac = (float)srcfraction * (1.0f / 4294967296.0f);
+
+        // Catmull-Rom spline through the two frames either side
+        // https://en.wikipedia.org/wiki/Cubic_Hermite_spline#Catmull%E2%80%93Rom_spline
+        for (chan = 0; chan < chans; ++chan) {
+            const float p0 = frame[chan - chans];
+            const float p1 = frame[chan];
+            const float p2 = frame[chan + chans];
+            const float p3 = frame[chan + chans * 2];
+            const float a = (3.0f * (p1 - p2)) + p3 - p0;
+            const float b = (2.0f * p0) - (5.0f * p1) + (4.0f * p2) - p3;
+            const float c = p2 - p0;
+            dst[chan] = p1 + (0.5f * frac * (c + (frac * (b + (frac * a)))));
+        }
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
+
+#define RESAMPLE_INTERPOLATED(fn)                                                                  \
+    static void fn##_Any(int chans, const float *src, int inframes, float *dst, int outframes,     \
+                         Sint64 resample_rate, Sint64 *inout_resample_offset)                      \
+    {                                                                                              \
+        if (chans == 1) {                                                                          \
+            fn(1, src, inframes, dst, outframes, resample_rate, inout_resample_offset);            \
+        } else if (chans == 2) {                                                                   \
+            fn(2, src, inframes, dst, outframes, resample_rate, inout_resample_offset);            \
+        } else {                                                                                   \
+            fn(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset);        \
+        }                                                                                          \
+    }
+
+RESAMPLE_INTERPOLATED(ResampleAudioNearest)
+RESAMPLE_INTERPOLATED(ResampleAudioLinear)
+RESAMPLE_INTERPOLATED(ResampleAudioCubic)
+
+#undef RESAMPLE_INTERPOLATED
+
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset)
+                       Sint64 resample_rate, Sint64 *inout_resample_offset,
+                       SDL_AudioResampleQuality quality, const SDL_ResamplerPhases *phases)
 {
     int i;
     Sint64 srcpos = *inout_resample_offset;
@@ -684,6 +1190,25 @@ void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, in
 
     SDL_assert(resample_rate > 0);
 
+    switch (quality) {
+    case SDL_AUDIO_RESAMPLE_NEAREST:
+        ResampleAudioNearest_Any(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset);
+        return;
+    case SDL_AUDIO_RESAMPLE_LINEAR:
+        ResampleAudioLinear_Any(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset);
+        return;
+    case SDL_AUDIO_RESAMPLE_CUBIC:
+        ResampleAudioCubic_Any(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset);
+        return;
+    default:
+        break;
+    }
+
+    if (phases && (phases->resample_rate == resample_rate)) {
+        ResampleAudioPhases(chans, src, inframes, dst, outframes, phases, inout_resample_offset);
+        return;
+    }
+
     src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
 
     for (i = 0; i < outframes; ++i) {
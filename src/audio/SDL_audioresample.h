@@ -34,10 +34,29 @@ int SDL_GetResamplerPaddingFrames(Sint64 resample_rate);
 Sint64 SDL_GetResamplerInputFrames(Sint64 output_frames, Sint64 resample_rate, Sint64 resample_offset);
 Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, Sint64 *inout_resample_offset);
 
+// Precomputed filter phases for resampling between two fixed rates with a simple ratio.
+// Returns NULL (without setting an error) if the ratio isn't simple enough, or if out of memory.
+// SDL_ResampleAudio works fine without them, it's just slower.
+typedef struct SDL_ResamplerPhases SDL_ResamplerPhases;
+
+SDL_ResamplerPhases *SDL_CreateResamplerPhases(int src_rate, int dst_rate);
+void SDL_DestroyResamplerPhases(SDL_ResamplerPhases *phases);
+
+// Returns `phases` if it already matches the rates, otherwise destroys it and creates new ones.
+SDL_ResamplerPhases *SDL_UpdateResamplerPhases(SDL_ResamplerPhases *phases, int src_rate, int dst_rate);
+
 // Resample some audio.
 // REQUIRES: `inframes >= SDL_GetResamplerInputFrames(outframes)`
 // REQUIRES: At least `SDL_GetResamplerPaddingFrames(...)` extra frames to the left of src, and right of src+inframes
+// `phases` may be NULL, and are only used for SDL_AUDIO_RESAMPLE_SINC if they were created for `resample_rate`.
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset);
+                       Sint64 resample_rate, Sint64 *inout_resample_offset,
+                       SDL_AudioResampleQuality quality, const SDL_ResamplerPhases *phases);
+
+// Resample, apply gain, and mix (clamped, like SDL_MixAudio) straight into an F32 buffer, in a single pass.
+// Only valid if SDL_CanResampleAndMixAudio returns true. Has the same requirements on `src` as SDL_ResampleAudio.
+bool SDL_CanResampleAndMixAudio(SDL_AudioFormat src_format, int chans, const SDL_ResamplerPhases *phases, Sint64 resample_rate);
+void SDL_ResampleAndMixAudio(SDL_AudioFormat src_format, const void *src, int inframes, float *dst, int outframes,
+                             float gain, const SDL_ResamplerPhases *phases, Sint64 *inout_resample_offset);
 
 #endif // SDL_audioresample_h_
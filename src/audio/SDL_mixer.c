@@ -82,10 +82,685 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / MIX_MAXVOLUME) + 128))
 
-// !!! FIXME: This needs some SIMD magic.
-// !!! FIXME: Add fast-path for volume = 1
 // !!! FIXME: Use larger scales for 16-bit/32-bit integers
 
+// start fallback scalar mixers
+
+static SDL_INLINE Sint16 MixSampleS16(Sint16 dst, Sint16 src, int volume)
+{
+    ADJUST_VOLUME(Sint16, src, volume);
+    const int sample = dst + src;
+    return (Sint16)SDL_clamp(sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+}
+
+static SDL_INLINE Sint32 MixSampleS32(Sint32 dst, Sint32 src, int volume)
+{
+    Sint64 src64 = src;
+    ADJUST_VOLUME(Sint64, src64, volume);
+    const Sint64 sample = dst + src64;
+    return (Sint32)SDL_clamp(sample, SDL_MIN_SINT32, SDL_MAX_SINT32);
+}
+
+static SDL_INLINE float MixSampleF32(float dst, float src, float volume)
+{
+    const float sample = (src * volume) + dst;
+    if (sample > 1.0f) {
+        return 1.0f;
+    } else if (sample < -1.0f) {
+        return -1.0f;
+    }
+    return sample;  // (this lets NaNs through, the same as the SIMD versions.)
+}
+
+#define SWAP_S16(x) ((Sint16)SDL_Swap16((Uint16)(x)))
+#define SWAP_S32(x) ((Sint32)SDL_Swap32((Uint32)(x)))
+
+static void SDL_Mix_S16_Scalar(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (i = 0; i < num_samples; ++i) {
+            const int sample = dst[i] + src[i];
+            dst[i] = (Sint16)SDL_clamp(sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+        }
+    } else {
+        for (i = 0; i < num_samples; ++i) {
+            dst[i] = MixSampleS16(dst[i], src[i], volume);
+        }
+    }
+}
+
+static void SDL_Mix_S16_Swapped_Scalar(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        dst[i] = SWAP_S16(MixSampleS16(SWAP_S16(dst[i]), SWAP_S16(src[i]), volume));
+    }
+}
+
+static void SDL_Mix_S32_Scalar(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    int i;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (i = 0; i < num_samples; ++i) {
+            const Sint64 sample = (Sint64)dst[i] + src[i];
+            dst[i] = (Sint32)SDL_clamp(sample, SDL_MIN_SINT32, SDL_MAX_SINT32);
+        }
+    } else {
+        for (i = 0; i < num_samples; ++i) {
+            dst[i] = MixSampleS32(dst[i], src[i], volume);
+        }
+    }
+}
+
+static void SDL_Mix_S32_Swapped_Scalar(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        dst[i] = SWAP_S32(MixSampleS32(SWAP_S32(dst[i]), SWAP_S32(src[i]), volume));
+    }
+}
+
+static void SDL_Mix_F32_Scalar(float *dst, const float *src, int num_samples, float volume)
+{
+    int i;
+
+    if (volume == 1.0f) {
+        for (i = 0; i < num_samples; ++i) {
+            const float sample = src[i] + dst[i];
+            dst[i] = (sample > 1.0f) ? 1.0f : ((sample < -1.0f) ? -1.0f : sample);
+        }
+    } else {
+        for (i = 0; i < num_samples; ++i) {
+            dst[i] = MixSampleF32(dst[i], src[i], volume);
+        }
+    }
+}
+
+static void SDL_Mix_F32_Swapped_Scalar(float *dst, const float *src, int num_samples, float volume)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        dst[i] = SDL_SwapFloat(MixSampleF32(SDL_SwapFloat(dst[i]), SDL_SwapFloat(src[i]), volume));
+    }
+}
+
+// end fallback scalar mixers
+
+/* The SIMD mixers produce exactly the same output as the scalar ones. Volume scaling of integer
+   samples only vectorizes for 0 < volume < MIX_MAXVOLUME, where the scaled sample is guaranteed to
+   fit the sample type; anything else (and the leftover samples at the end) goes to the scalar code. */
+
+#ifdef SDL_SSE2_INTRINSICS
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") Swap16_SSE2(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") Swap32_SSE2(__m128i x)
+{
+    x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    return Swap16_SSE2(x);
+}
+
+// (x * volume) / MIX_MAXVOLUME, rounding toward zero like the scalar code.
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") ScaleS16_SSE2(__m128i x, __m128i volume)
+{
+    const __m128i bias = _mm_set1_epi32(MIX_MAXVOLUME - 1);
+    const __m128i lo = _mm_mullo_epi16(x, volume);
+    const __m128i hi = _mm_mulhi_epi16(x, volume);
+    __m128i x0 = _mm_unpacklo_epi16(lo, hi);
+    __m128i x1 = _mm_unpackhi_epi16(lo, hi);
+    x0 = _mm_srai_epi32(_mm_add_epi32(x0, _mm_and_si128(_mm_srai_epi32(x0, 31), bias)), 7);
+    x1 = _mm_srai_epi32(_mm_add_epi32(x1, _mm_and_si128(_mm_srai_epi32(x1, 31), bias)), 7);
+    return _mm_packs_epi32(x0, x1);
+}
+
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") AddSaturateS32_SSE2(__m128i a, __m128i b)
+{
+    const __m128i sum = _mm_add_epi32(a, b);
+    // it overflowed if a and b have the same sign, but the sum has a different one.
+    const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+    const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(SDL_MAX_SINT32));
+    return _mm_or_si128(_mm_and_si128(overflow, saturated), _mm_andnot_si128(overflow, sum));
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") Mix_S16_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume, bool swap)
+{
+    int i = 0;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (; i + 8 <= num_samples; i += 8) {
+            __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+            __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+            if (swap) {
+                s = Swap16_SSE2(s);
+                d = Swap16_SSE2(d);
+            }
+            d = _mm_adds_epi16(d, s);
+            _mm_storeu_si128((__m128i *)&dst[i], swap ? Swap16_SSE2(d) : d);
+        }
+    } else if ((volume > 0) && (volume < MIX_MAXVOLUME)) {
+        const __m128i vol = _mm_set1_epi16((Sint16)volume);
+        for (; i + 8 <= num_samples; i += 8) {
+            __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+            __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+            if (swap) {
+                s = Swap16_SSE2(s);
+                d = Swap16_SSE2(d);
+            }
+            d = _mm_adds_epi16(d, ScaleS16_SSE2(s, vol));
+            _mm_storeu_si128((__m128i *)&dst[i], swap ? Swap16_SSE2(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S16_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") Mix_S32_SSE2(Sint32 *dst, const Sint32 *src, int num_samples, int volume, bool swap)
+{
+    int i = 0;
+
+    // SSE2 can't multiply 32-bit integers, so only unity gain is vectorized here.
+    if (volume == MIX_MAXVOLUME) {
+        for (; i + 4 <= num_samples; i += 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+            __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+            if (swap) {
+                s = Swap32_SSE2(s);
+                d = Swap32_SSE2(d);
+            }
+            d = AddSaturateS32_SSE2(d, s);
+            _mm_storeu_si128((__m128i *)&dst[i], swap ? Swap32_SSE2(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") Mix_F32_SSE2(float *dst, const float *src, int num_samples, float volume, bool swap)
+{
+    const __m128 vol = _mm_set1_ps(volume);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const bool unity = (volume == 1.0f);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        __m128 s, d;
+        if (swap) {
+            s = _mm_castsi128_ps(Swap32_SSE2(_mm_loadu_si128((const __m128i *)&src[i])));
+            d = _mm_castsi128_ps(Swap32_SSE2(_mm_loadu_si128((const __m128i *)&dst[i])));
+        } else {
+            s = _mm_loadu_ps(&src[i]);
+            d = _mm_loadu_ps(&dst[i]);
+        }
+        if (!unity) {
+            s = _mm_mul_ps(s, vol);
+        }
+        // min/max return their second operand if either is NaN, so this lets NaNs through like the scalar code.
+        d = _mm_min_ps(one, _mm_max_ps(minus_one, _mm_add_ps(s, d)));
+        if (swap) {
+            _mm_storeu_si128((__m128i *)&dst[i], Swap32_SSE2(_mm_castps_si128(d)));
+        } else {
+            _mm_storeu_ps(&dst[i], d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_F32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_F32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_S16_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_SSE2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_S16_Swapped_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_SSE2(dst, src, num_samples, volume, true);
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_S32_SSE2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_SSE2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_S32_Swapped_SSE2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_SSE2(dst, src, num_samples, volume, true);
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_F32_SSE2(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_SSE2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("sse2") SDL_Mix_F32_Swapped_SSE2(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_SSE2(dst, src, num_samples, volume, true);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") Swap16_AVX2(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi16(x, 8), _mm256_srli_epi16(x, 8));
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") Swap32_AVX2(__m256i x)
+{
+    const __m256i shuffle = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                            12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+// (x * volume) / MIX_MAXVOLUME, rounding toward zero like the scalar code.
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") ScaleS16_AVX2(__m256i x, __m256i volume)
+{
+    const __m256i bias = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+    const __m256i lo = _mm256_mullo_epi16(x, volume);
+    const __m256i hi = _mm256_mulhi_epi16(x, volume);
+    __m256i x0 = _mm256_unpacklo_epi16(lo, hi);
+    __m256i x1 = _mm256_unpackhi_epi16(lo, hi);
+    x0 = _mm256_srai_epi32(_mm256_add_epi32(x0, _mm256_and_si256(_mm256_srai_epi32(x0, 31), bias)), 7);
+    x1 = _mm256_srai_epi32(_mm256_add_epi32(x1, _mm256_and_si256(_mm256_srai_epi32(x1, 31), bias)), 7);
+    return _mm256_packs_epi32(x0, x1);  // unpack and pack are both per-lane, so this puts everything back in order.
+}
+
+// (x * volume) / MIX_MAXVOLUME, rounding toward zero like the scalar code, which does this in 64 bits.
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") ScaleS32_AVX2(__m256i x, __m256i volume)
+{
+    const __m256i bias = _mm256_set1_epi64x(MIX_MAXVOLUME - 1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i even = _mm256_mul_epi32(x, volume);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), volume);
+    even = _mm256_add_epi64(even, _mm256_and_si256(_mm256_cmpgt_epi64(zero, even), bias));
+    odd = _mm256_add_epi64(odd, _mm256_and_si256(_mm256_cmpgt_epi64(zero, odd), bias));
+    // the quotients fit in 32 bits, so a logical shift gets the low halves right.
+    even = _mm256_srli_epi64(even, 7);
+    odd = _mm256_slli_epi64(_mm256_srli_epi64(odd, 7), 32);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") AddSaturateS32_AVX2(__m256i a, __m256i b)
+{
+    const __m256i sum = _mm256_add_epi32(a, b);
+    // it overflowed if a and b have the same sign, but the sum has a different one.
+    const __m256i overflow = _mm256_andnot_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, sum));
+    const __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(SDL_MAX_SINT32));
+    return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sum), _mm256_castsi256_ps(saturated), _mm256_castsi256_ps(overflow)));
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") Mix_S16_AVX2(Sint16 *dst, const Sint16 *src, int num_samples, int volume, bool swap)
+{
+    int i = 0;
+
+    if (volume == MIX_MAXVOLUME) {
+        for (; i + 16 <= num_samples; i += 16) {
+            __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+            __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+            if (swap) {
+                s = Swap16_AVX2(s);
+                d = Swap16_AVX2(d);
+            }
+            d = _mm256_adds_epi16(d, s);
+            _mm256_storeu_si256((__m256i *)&dst[i], swap ? Swap16_AVX2(d) : d);
+        }
+    } else if ((volume > 0) && (volume < MIX_MAXVOLUME)) {
+        const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+        for (; i + 16 <= num_samples; i += 16) {
+            __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+            __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+            if (swap) {
+                s = Swap16_AVX2(s);
+                d = Swap16_AVX2(d);
+            }
+            d = _mm256_adds_epi16(d, ScaleS16_AVX2(s, vol));
+            _mm256_storeu_si256((__m256i *)&dst[i], swap ? Swap16_AVX2(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S16_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") Mix_S32_AVX2(Sint32 *dst, const Sint32 *src, int num_samples, int volume, bool swap)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const bool unity = (volume == MIX_MAXVOLUME);
+    int i = 0;
+
+    if (unity || ((volume > 0) && (volume < MIX_MAXVOLUME))) {
+        for (; i + 8 <= num_samples; i += 8) {
+            __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+            __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+            if (swap) {
+                s = Swap32_AVX2(s);
+                d = Swap32_AVX2(d);
+            }
+            if (!unity) {
+                s = ScaleS32_AVX2(s, vol);
+            }
+            d = AddSaturateS32_AVX2(d, s);
+            _mm256_storeu_si256((__m256i *)&dst[i], swap ? Swap32_AVX2(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") Mix_F32_AVX2(float *dst, const float *src, int num_samples, float volume, bool swap)
+{
+    const __m256 vol = _mm256_set1_ps(volume);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minus_one = _mm256_set1_ps(-1.0f);
+    const bool unity = (volume == 1.0f);
+    int i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m256 s, d;
+        if (swap) {
+            s = _mm256_castsi256_ps(Swap32_AVX2(_mm256_loadu_si256((const __m256i *)&src[i])));
+            d = _mm256_castsi256_ps(Swap32_AVX2(_mm256_loadu_si256((const __m256i *)&dst[i])));
+        } else {
+            s = _mm256_loadu_ps(&src[i]);
+            d = _mm256_loadu_ps(&dst[i]);
+        }
+        if (!unity) {
+            s = _mm256_mul_ps(s, vol);
+        }
+        // min/max return their second operand if either is NaN, so this lets NaNs through like the scalar code.
+        d = _mm256_min_ps(one, _mm256_max_ps(minus_one, _mm256_add_ps(s, d)));
+        if (swap) {
+            _mm256_storeu_si256((__m256i *)&dst[i], Swap32_AVX2(_mm256_castps_si256(d)));
+        } else {
+            _mm256_storeu_ps(&dst[i], d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_F32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_F32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_S16_AVX2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_AVX2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_S16_Swapped_AVX2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_AVX2(dst, src, num_samples, volume, true);
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_S32_AVX2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_AVX2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_S32_Swapped_AVX2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_AVX2(dst, src, num_samples, volume, true);
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_F32_AVX2(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_AVX2(dst, src, num_samples, volume, false);
+}
+
+static void SDL_TARGETING("avx2") SDL_Mix_F32_Swapped_AVX2(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_AVX2(dst, src, num_samples, volume, true);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+SDL_FORCE_INLINE int16x8_t Swap16_NEON(int16x8_t x)
+{
+    return vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(x)));
+}
+
+SDL_FORCE_INLINE int32x4_t Swap32_NEON(int32x4_t x)
+{
+    return vreinterpretq_s32_u8(vrev32q_u8(vreinterpretq_u8_s32(x)));
+}
+
+// (x * volume) / MIX_MAXVOLUME, rounding toward zero like the scalar code.
+SDL_FORCE_INLINE int16x8_t ScaleS16_NEON(int16x8_t x, int16x4_t volume)
+{
+    const int32x4_t bias = vdupq_n_s32(MIX_MAXVOLUME - 1);
+    int32x4_t x0 = vmull_s16(vget_low_s16(x), volume);
+    int32x4_t x1 = vmull_s16(vget_high_s16(x), volume);
+    x0 = vshrq_n_s32(vaddq_s32(x0, vandq_s32(vshrq_n_s32(x0, 31), bias)), 7);
+    x1 = vshrq_n_s32(vaddq_s32(x1, vandq_s32(vshrq_n_s32(x1, 31), bias)), 7);
+    return vcombine_s16(vmovn_s32(x0), vmovn_s32(x1));
+}
+
+// (x * volume) / MIX_MAXVOLUME, rounding toward zero like the scalar code, which does this in 64 bits.
+SDL_FORCE_INLINE int32x4_t ScaleS32_NEON(int32x4_t x, int32x2_t volume)
+{
+    const int64x2_t bias = vdupq_n_s64(MIX_MAXVOLUME - 1);
+    int64x2_t x0 = vmull_s32(vget_low_s32(x), volume);
+    int64x2_t x1 = vmull_s32(vget_high_s32(x), volume);
+    x0 = vshrq_n_s64(vaddq_s64(x0, vandq_s64(vshrq_n_s64(x0, 63), bias)), 7);
+    x1 = vshrq_n_s64(vaddq_s64(x1, vandq_s64(vshrq_n_s64(x1, 63), bias)), 7);
+    return vcombine_s32(vmovn_s64(x0), vmovn_s64(x1));
+}
+
+SDL_FORCE_INLINE void Mix_S16_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume, bool swap)
+{
+    const bool unity = (volume == MIX_MAXVOLUME);
+    const int16x4_t vol = vdup_n_s16((Sint16)volume);
+    int i = 0;
+
+    if (unity || ((volume > 0) && (volume < MIX_MAXVOLUME))) {
+        for (; i + 8 <= num_samples; i += 8) {
+            int16x8_t s = vld1q_s16(&src[i]);
+            int16x8_t d = vld1q_s16(&dst[i]);
+            if (swap) {
+                s = Swap16_NEON(s);
+                d = Swap16_NEON(d);
+            }
+            if (!unity) {
+                s = ScaleS16_NEON(s, vol);
+            }
+            d = vqaddq_s16(d, s);
+            vst1q_s16(&dst[i], swap ? Swap16_NEON(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S16_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S16_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void Mix_S32_NEON(Sint32 *dst, const Sint32 *src, int num_samples, int volume, bool swap)
+{
+    const bool unity = (volume == MIX_MAXVOLUME);
+    const int32x2_t vol = vdup_n_s32(volume);
+    int i = 0;
+
+    if (unity || ((volume > 0) && (volume < MIX_MAXVOLUME))) {
+        for (; i + 4 <= num_samples; i += 4) {
+            int32x4_t s = vld1q_s32(&src[i]);
+            int32x4_t d = vld1q_s32(&dst[i]);
+            if (swap) {
+                s = Swap32_NEON(s);
+                d = Swap32_NEON(d);
+            }
+            if (!unity) {
+                s = ScaleS32_NEON(s, vol);
+            }
+            d = vqaddq_s32(d, s);
+            vst1q_s32(&dst[i], swap ? Swap32_NEON(d) : d);
+        }
+    }
+
+    if (swap) {
+        SDL_Mix_S32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_S32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+SDL_FORCE_INLINE void Mix_F32_NEON(float *dst, const float *src, int num_samples, float volume, bool swap)
+{
+    const float32x4_t vol = vdupq_n_f32(volume);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    const bool unity = (volume == 1.0f);
+    int i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        float32x4_t s = vld1q_f32(&src[i]);
+        float32x4_t d = vld1q_f32(&dst[i]);
+        if (swap) {
+            s = vreinterpretq_f32_s32(Swap32_NEON(vreinterpretq_s32_f32(s)));
+            d = vreinterpretq_f32_s32(Swap32_NEON(vreinterpretq_s32_f32(d)));
+        }
+        if (!unity) {
+            s = vmulq_f32(s, vol);
+        }
+        d = vminq_f32(one, vmaxq_f32(minus_one, vaddq_f32(s, d)));  // these propagate NaNs, like the scalar code.
+        if (swap) {
+            d = vreinterpretq_f32_s32(Swap32_NEON(vreinterpretq_s32_f32(d)));
+        }
+        vst1q_f32(&dst[i], d);
+    }
+
+    if (swap) {
+        SDL_Mix_F32_Swapped_Scalar(dst + i, src + i, num_samples - i, volume);
+    } else {
+        SDL_Mix_F32_Scalar(dst + i, src + i, num_samples - i, volume);
+    }
+}
+
+static void SDL_Mix_S16_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_NEON(dst, src, num_samples, volume, false);
+}
+
+static void SDL_Mix_S16_Swapped_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    Mix_S16_NEON(dst, src, num_samples, volume, true);
+}
+
+static void SDL_Mix_S32_NEON(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_NEON(dst, src, num_samples, volume, false);
+}
+
+static void SDL_Mix_S32_Swapped_NEON(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    Mix_S32_NEON(dst, src, num_samples, volume, true);
+}
+
+static void SDL_Mix_F32_NEON(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_NEON(dst, src, num_samples, volume, false);
+}
+
+static void SDL_Mix_F32_Swapped_NEON(float *dst, const float *src, int num_samples, float volume)
+{
+    Mix_F32_NEON(dst, src, num_samples, volume, true);
+}
+#endif
+
+// All of these are in native byte order; the _Swapped versions handle the opposite byte order.
+static void (*SDL_Mix_S16)(Sint16 *dst, const Sint16 *src, int num_samples, int volume) = NULL;
+static void (*SDL_Mix_S16_Swapped)(Sint16 *dst, const Sint16 *src, int num_samples, int volume) = NULL;
+static void (*SDL_Mix_S32)(Sint32 *dst, const Sint32 *src, int num_samples, int volume) = NULL;
+static void (*SDL_Mix_S32_Swapped)(Sint32 *dst, const Sint32 *src, int num_samples, int volume) = NULL;
+static void (*SDL_Mix_F32)(float *dst, const float *src, int num_samples, float volume) = NULL;
+static void (*SDL_Mix_F32_Swapped)(float *dst, const float *src, int num_samples, float volume) = NULL;
+
+static void ChooseAudioMixers(void)
+{
+#define SET_MIXER_FUNCS(fntype) \
+    SDL_Mix_S16 = SDL_Mix_S16_##fntype; \
+    SDL_Mix_S16_Swapped = SDL_Mix_S16_Swapped_##fntype; \
+    SDL_Mix_S32 = SDL_Mix_S32_##fntype; \
+    SDL_Mix_S32_Swapped = SDL_Mix_S32_Swapped_##fntype; \
+    SDL_Mix_F32 = SDL_Mix_F32_##fntype; \
+    SDL_Mix_F32_Swapped = SDL_Mix_F32_Swapped_##fntype;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+    } else
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+    } else
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+    } else
+#endif
+    {
+        SET_MIXER_FUNCS(Scalar);
+    }
+
+#undef SET_MIXER_FUNCS
+}
+
+// SDL_MixAudio() can be called from several threads at once, so the other threads wait until the mixers are chosen.
+static void SDL_ChooseAudioMixers(void)
+{
+    static SDL_InitState init;
+
+    if (SDL_ShouldInit(&init)) {
+        ChooseAudioMixers();
+        SDL_SetInitialized(&init, true);
+    }
+}
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define SDL_Mix_S16LE SDL_Mix_S16
+#define SDL_Mix_S16BE SDL_Mix_S16_Swapped
+#define SDL_Mix_S32LE SDL_Mix_S32
+#define SDL_Mix_S32BE SDL_Mix_S32_Swapped
+#define SDL_Mix_F32LE SDL_Mix_F32
+#define SDL_Mix_F32BE SDL_Mix_F32_Swapped
+#else
+#define SDL_Mix_S16LE SDL_Mix_S16_Swapped
+#define SDL_Mix_S16BE SDL_Mix_S16
+#define SDL_Mix_S32LE SDL_Mix_S32_Swapped
+#define SDL_Mix_S32BE SDL_Mix_S32
+#define SDL_Mix_F32LE SDL_Mix_F32_Swapped
+#define SDL_Mix_F32BE SDL_Mix_F32
+#endif
+
 bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, float fvolume)
 {
     int volume = (int)SDL_roundf(fvolume * MIX_MAXVOLUME);
@@ -94,6 +769,8 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         return true;
     }
 
+    SDL_ChooseAudioMixers();
+
     switch (format) {
 
     case SDL_AUDIO_U8:
@@ -121,7 +798,9 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         dst8 = (Sint8 *)dst;
         while (len--) {
             src_sample = *src8;
-            ADJUST_VOLUME(Sint8, src_sample, volume);
+            if (volume != MIX_MAXVOLUME) {
+                ADJUST_VOLUME(Sint8, src_sample, volume);
+            }
             dst_sample = *dst8 + src_sample;
             if (dst_sample > max_audioval) {
                 dst_sample = max_audioval;
@@ -135,152 +814,28 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
     } break;
 
     case SDL_AUDIO_S16LE:
-    {
-        Sint16 src1, src2;
-        int dst_sample;
-        const int max_audioval = SDL_MAX_SINT16;
-        const int min_audioval = SDL_MIN_SINT16;
-
-        len /= 2;
-        while (len--) {
-            src1 = SDL_Swap16LE(*(Sint16 *)src);
-            ADJUST_VOLUME(Sint16, src1, volume);
-            src2 = SDL_Swap16LE(*(Sint16 *)dst);
-            src += 2;
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(Sint16 *)dst = SDL_Swap16LE((Sint16)dst_sample);
-            dst += 2;
-        }
-    } break;
+        SDL_Mix_S16LE((Sint16 *)dst, (const Sint16 *)src, (int)(len / 2), volume);
+        break;
 
     case SDL_AUDIO_S16BE:
-    {
-        Sint16 src1, src2;
-        int dst_sample;
-        const int max_audioval = SDL_MAX_SINT16;
-        const int min_audioval = SDL_MIN_SINT16;
-
-        len /= 2;
-        while (len--) {
-            src1 = SDL_Swap16BE(*(Sint16 *)src);
-            ADJUST_VOLUME(Sint16, src1, volume);
-            src2 = SDL_Swap16BE(*(Sint16 *)dst);
-            src += 2;
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(Sint16 *)dst = SDL_Swap16BE((Sint16)dst_sample);
-            dst += 2;
-        }
-    } break;
+        SDL_Mix_S16BE((Sint16 *)dst, (const Sint16 *)src, (int)(len / 2), volume);
+        break;
 
     case SDL_AUDIO_S32LE:
-    {
-        const Uint32 *src32 = (Uint32 *)src;
-        Uint32 *dst32 = (Uint32 *)dst;
-        Sint64 src1, src2;
-        Sint64 dst_sample;
-        const Sint64 max_audioval = SDL_MAX_SINT32;
-        const Sint64 min_audioval = SDL_MIN_SINT32;
-
-        len /= 4;
-        while (len--) {
-            src1 = (Sint64)((Sint32)SDL_Swap32LE(*src32));
-            src32++;
-            ADJUST_VOLUME(Sint64, src1, volume);
-            src2 = (Sint64)((Sint32)SDL_Swap32LE(*dst32));
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(dst32++) = SDL_Swap32LE((Uint32)((Sint32)dst_sample));
-        }
-    } break;
+        SDL_Mix_S32LE((Sint32 *)dst, (const Sint32 *)src, (int)(len / 4), volume);
+        break;
 
     case SDL_AUDIO_S32BE:
-    {
-        const Uint32 *src32 = (Uint32 *)src;
-        Uint32 *dst32 = (Uint32 *)dst;
-        Sint64 src1, src2;
-        Sint64 dst_sample;
-        const Sint64 max_audioval = SDL_MAX_SINT32;
-        const Sint64 min_audioval = SDL_MIN_SINT32;
-
-        len /= 4;
-        while (len--) {
-            src1 = (Sint64)((Sint32)SDL_Swap32BE(*src32));
-            src32++;
-            ADJUST_VOLUME(Sint64, src1, volume);
-            src2 = (Sint64)((Sint32)SDL_Swap32BE(*dst32));
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(dst32++) = SDL_Swap32BE((Uint32)((Sint32)dst_sample));
-        }
-    } break;
+        SDL_Mix_S32BE((Sint32 *)dst, (const Sint32 *)src, (int)(len / 4), volume);
+        break;
 
     case SDL_AUDIO_F32LE:
-    {
-        const float *src32 = (float *)src;
-        float *dst32 = (float *)dst;
-        float src1, src2;
-        float dst_sample;
-        const float max_audioval = 1.0f;
-        const float min_audioval = -1.0f;
-
-        len /= 4;
-        while (len--) {
-            src1 = SDL_SwapFloatLE(*src32) * fvolume;
-            src2 = SDL_SwapFloatLE(*dst32);
-            src32++;
-
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(dst32++) = SDL_SwapFloatLE(dst_sample);
-        }
-    } break;
+        SDL_Mix_F32LE((float *)dst, (const float *)src, (int)(len / 4), fvolume);
+        break;
 
     case SDL_AUDIO_F32BE:
-    {
-        const float *src32 = (float *)src;
-        float *dst32 = (float *)dst;
-        float src1, src2;
-        float dst_sample;
-        const float max_audioval = 1.0f;
-        const float min_audioval = -1.0f;
-
-        len /= 4;
-        while (len--) {
-            src1 = SDL_SwapFloatBE(*src32) * fvolume;
-            src2 = SDL_SwapFloatBE(*dst32);
-            src32++;
-
-            dst_sample = src1 + src2;
-            if (dst_sample > max_audioval) {
-                dst_sample = max_audioval;
-            } else if (dst_sample < min_audioval) {
-                dst_sample = min_audioval;
-            }
-            *(dst32++) = SDL_SwapFloatBE(dst_sample);
-        }
-    } break;
+        SDL_Mix_F32BE((float *)dst, (const float *)src, (int)(len / 4), fvolume);
+        break;
 
     default: // If this happens... FIXME!
         return SDL_SetError("SDL_MixAudio(): unknown audio format");
@@ -142,9 +142,24 @@ extern void OnAudioStreamDestroy(SDL_AudioStream *stream);
 // This just lets audio playback apply logical device gain at the same time as audiostream gain, so it's one multiplication instead of thousands.
 extern int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain);
 
+// Like SDL_GetAudioStreamDataAdjustGain, but mixes the data into `mix_buffer` (like SDL_MixAudio), which is what playback devices
+//  want anyhow. Common cases are converted, resampled and mixed in a single pass. The stream's output format must be SDL_AUDIO_F32,
+//  and `scratch` must be at least `len` bytes. Returns the number of bytes mixed, or -1 on error.
+extern int SDL_MixAudioStreamData(SDL_AudioStream *stream, float *mix_buffer, void *scratch, int len, float extra_gain);
+
+// Like SDL_GetAudioStreamDataAdjustGain, but if the next `len` bytes are already queued exactly as they would be output (no
+//  conversion, resampling, gain or channel swizzling) and all in one buffer, they are consumed without being copied, and
+//  `*zero_copy` points to them. In that case, the stream stays locked so they can't be freed, and the caller must call
+//  SDL_ReleaseAudioStreamZeroCopy when it's done with them. Otherwise, `*zero_copy` is NULL and the data is copied to `voidbuf`.
+extern int SDL_GetAudioStreamDataZeroCopy(SDL_AudioStream *stream, void *voidbuf, int len, float extra_gain, const Uint8 **zero_copy);
+extern void SDL_ReleaseAudioStreamZeroCopy(SDL_AudioStream *stream);
+
 // This is the bulk of `SDL_SetAudioStream*putChannelMap`'s work, but it lets you skip the check about changing the device end of a stream if isinput==-1.
 extern bool SetAudioStreamChannelMap(SDL_AudioStream *stream, const SDL_AudioSpec *spec, int **stream_chmap, const int *chmap, int channels, int isinput);
 
+// Rebuilds the stream's resampler phases for its current rates. This allocates, so don't call it from the audio thread.
+extern void UpdateAudioStreamResamplerPhases(SDL_AudioStream *stream);
+
 
 typedef struct SDL_AudioDriverImpl
 {
@@ -153,7 +168,7 @@ typedef struct SDL_AudioDriverImpl
     void (*ThreadInit)(SDL_AudioDevice *device);   // Called by audio thread at start
     void (*ThreadDeinit)(SDL_AudioDevice *device); // Called by audio thread at end
     bool (*WaitDevice)(SDL_AudioDevice *device);
-    bool (*PlayDevice)(SDL_AudioDevice *device, const Uint8 *buffer, int buflen); // buffer and buflen are always from GetDeviceBuf, passed here for convenience.
+    bool (*PlayDevice)(SDL_AudioDevice *device, const Uint8 *buffer, int buflen); // buffer and buflen are always from GetDeviceBuf, passed here for convenience (unless PlayDeviceAcceptsAnyBuffer).
     Uint8 *(*GetDeviceBuf)(SDL_AudioDevice *device, int *buffer_size);
     bool (*WaitRecordingDevice)(SDL_AudioDevice *device);
     int (*RecordDevice)(SDL_AudioDevice *device, void *buffer, int buflen);
@@ -168,6 +183,7 @@ typedef struct SDL_AudioDriverImpl
     bool HasRecordingSupport;
     bool OnlyHasDefaultPlaybackDevice;
     bool OnlyHasDefaultRecordingDevice;   // !!! FIXME: is there ever a time where you'd have a default playback and not a default recording (or vice versa)?
+    bool PlayDeviceAcceptsAnyBuffer;  // PlayDevice is done with `buffer` when it returns, so it can be a stream's queued data instead of GetDeviceBuf's.
 } SDL_AudioDriverImpl;
 
 
@@ -198,6 +214,7 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 struct SDL_AudioQueue; // forward decl.
+struct SDL_ResamplerPhases; // forward decl.
 
 struct SDL_AudioStream
 {
@@ -218,17 +235,21 @@ struct SDL_AudioStream
     float gain;
 
     struct SDL_AudioQueue* queue;
+    struct SDL_AudioRing *ring;  // if non-NULL, SDL_PutAudioStreamData writes here without the lock, and readers move it to `queue`.
 
     SDL_AudioSpec input_spec; // The spec of input data currently being processed
     int *input_chmap;
     int input_chmap_storage[SDL_MAX_CHANNELMAP_CHANNELS];  // !!! FIXME: this needs to grow if SDL ever supports more channels. But if it grows, we should probably be more clever about allocations.
     Sint64 resample_offset;
+    struct SDL_ResamplerPhases *resampler_phases;  // precomputed filter for the current rates, if the ratio is simple. Can be NULL.
 
     Uint8 *work_buffer;    // used for scratch space during data conversion/resampling.
     size_t work_buffer_allocation;
 
     bool simplified;  // true if created via SDL_OpenAudioDeviceStream
 
+    SDL_AudioStreamStats stats;  // for SDL_GetAudioStreamStats, protected by `lock`.
+
     SDL_LogicalAudioDevice *bound_device;
     SDL_AudioStream *next_binding;
     SDL_AudioStream *prev_binding;
@@ -255,6 +276,9 @@ struct SDL_LogicalAudioDevice
     // Volume of the device output.
     float gain;
 
+    // true if bound streams may convert, resample and mix straight into the mix buffer. See SDL_HINT_AUDIO_DEVICE_FUSED_MIX.
+    bool fused_mix;
+
     // double-linked list of all audio streams currently bound to this opened device.
     SDL_AudioStream *bound_streams;
 
@@ -282,6 +306,38 @@ struct SDL_LogicalAudioDevice
     SDL_LogicalAudioDevice *prev;
 };
 
+// One lane of the (optional) parallel mixer. Lane 0 is always run by the device thread itself.
+typedef struct SDL_AudioMixLane
+{
+    struct SDL_AudioMixPool *pool;
+    int index;
+    SDL_Thread *thread;  // NULL for lane 0.
+    SDL_Semaphore *go;   // signaled by the device thread when there's work for this lane. NULL for lane 0.
+    Uint8 *work_buffer;  // scratch space for this lane's stream conversions.
+    float *mix_buffer;   // this lane's partial mix.
+} SDL_AudioMixLane;
+
+// Worker threads that help a playback device mix its bound streams (see SDL_HINT_AUDIO_DEVICE_MIX_THREADS).
+typedef struct SDL_AudioMixPool
+{
+    SDL_AudioDevice *device;
+    SDL_AudioMixLane *lanes;
+    int num_lanes;
+    int buffer_size;  // size of each lane's work_buffer and mix_buffer, in bytes.
+    SDL_Semaphore *done;  // each worker lane signals this once when it finishes a job.
+    SDL_AtomicInt quit;
+
+    // The current job. These are only changed by the device thread while all workers are idle.
+    int job;
+    SDL_LogicalAudioDevice *logdev;
+    SDL_AudioStream **streams;
+    int num_streams;
+    int streams_allocation;
+    int job_buffer_size;  // bytes of float32 data to mix this iteration.
+    float *job_output;  // where the reduction phase accumulates the lanes' partial mixes.
+    SDL_AtomicInt failed;
+} SDL_AudioMixPool;
+
 struct SDL_AudioDevice
 {
     // A mutex for locking access to this struct
@@ -351,9 +407,25 @@ struct SDL_AudioDevice
     // A thread to feed the audio device
     SDL_Thread *thread;
 
+    // Extra threads to help mix bound streams, or NULL if mixing happens entirely on the device thread.
+    SDL_AudioMixPool *mix_pool;
+
     // true if this physical device is currently opened by the backend.
     bool currently_opened;
 
+    // Timing statistics for SDL_GetAudioDeviceStats. Only the device thread writes these, while holding `lock`.
+    SDL_AudioDeviceStats stats;
+
+    // Bound streams that came up short. Atomic because mix threads update it too. This wraps; the device thread
+    //  adds how much it moved since `short_stream_reads_counted` to the 64-bit count in `stats` every iteration.
+    SDL_AtomicInt short_stream_reads;
+    Uint32 short_stream_reads_counted;
+
+    // SDL_HINT_AUDIO_DEVICE_STATS_LOG_INTERVAL in nanoseconds (zero if disabled), and the stats as of the last log.
+    Uint64 stats_log_interval_ns;
+    Uint64 stats_logged_ticks;
+    SDL_AudioDeviceStats stats_logged;
+
     // Data private to this driver
     struct SDL_PrivateAudioData *hidden;
 
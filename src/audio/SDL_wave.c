@@ -101,6 +101,130 @@ typedef struct MS_ADPCM_ChannelState
     Sint16 coeff2;
 } MS_ADPCM_ChannelState;
 
+// Large ADPCM files are decoded on multiple threads, each getting at least this many blocks.
+#define ADPCM_DECODE_MIN_BLOCKS_PER_THREAD 256
+#define ADPCM_DECODE_MAX_THREADS 16
+
+typedef bool (*ADPCM_DecodeBlockFunc)(ADPCM_DecoderState *state);
+
+typedef struct ADPCM_DecodeJob
+{
+    ADPCM_DecoderState state;
+    ADPCM_DecodeBlockFunc decodeblock;
+    size_t numblocks;
+    bool result;
+    char error[128];
+} ADPCM_DecodeJob;
+
+static int SDLCALL ADPCM_DecodeThread(void *data)
+{
+    ADPCM_DecodeJob *job = (ADPCM_DecodeJob *)data;
+    ADPCM_DecoderState *state = &job->state;
+    size_t i;
+
+    job->result = true;
+    for (i = 0; i < job->numblocks; i++) {
+        state->block.data = state->input.data + state->input.pos;
+        state->block.size = state->blocksize;
+        state->block.pos = 0;
+
+        if (!job->decodeblock(state)) {
+            // The error is thread-local, so hand it to the thread that waits for this job.
+            SDL_strlcpy(job->error, SDL_GetError(), sizeof(job->error));
+            job->result = false;
+            break;
+        }
+
+        state->input.pos += state->blocksize;
+    }
+
+    return 0;
+}
+
+/* Decodes the complete blocks at the start of the data on multiple threads,
+ * if there are enough of them to be worth it. Every block starts over with
+ * the decoder state from its header and decodes to a known place in the
+ * output, so they can be decoded in any order. Afterwards, the state points
+ * to the first block that still needs decoding, if any.
+ */
+static bool ADPCM_DecodeCompleteBlocks(ADPCM_DecoderState *state, size_t cstatesize, ADPCM_DecodeBlockFunc decodeblock)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_WAVE_DECODE_THREADS);
+    const size_t blocksleft = (state->input.size - state->input.pos) / state->blocksize;
+    const size_t blockswithframes = (size_t)(state->framesleft / state->samplesperblock);
+    const size_t numblocks = SDL_min(blocksleft, blockswithframes);
+    ADPCM_DecodeJob *jobs;
+    SDL_Thread **threads;
+    Uint8 *cstates;
+    size_t numthreads = 0;
+    size_t first = 0;
+    size_t i;
+    bool result = true;
+
+    if (hint) {
+        numthreads = (size_t)SDL_max(SDL_atoi(hint), 0);
+    }
+    if (numthreads == 0) {
+        numthreads = (size_t)SDL_GetNumLogicalCPUCores();
+    }
+    numthreads = SDL_min(numthreads, numblocks / ADPCM_DECODE_MIN_BLOCKS_PER_THREAD);
+    numthreads = SDL_min(numthreads, ADPCM_DECODE_MAX_THREADS);
+    if (numthreads <= 1) {
+        return true; // Not worth it, the caller decodes everything.
+    }
+
+    jobs = (ADPCM_DecodeJob *)SDL_calloc(numthreads, sizeof(*jobs) + sizeof(*threads) + cstatesize);
+    if (!jobs) {
+        return true; // Fall back to decoding everything on this thread.
+    }
+    threads = (SDL_Thread **)(jobs + numthreads);
+    cstates = (Uint8 *)(threads + numthreads);
+
+    for (i = 0; i < numthreads; i++) {
+        const size_t next = numblocks * (i + 1) / numthreads;
+        ADPCM_DecodeJob *job = &jobs[i];
+
+        job->state = *state;
+        job->state.input.pos += first * state->blocksize;
+        job->state.output.pos += first * state->samplesperblock * state->channels;
+        job->state.framesleft -= (Sint64)(first * state->samplesperblock);
+        job->state.cstate = cstates + i * cstatesize;
+        job->decodeblock = decodeblock;
+        job->numblocks = next - first;
+        first = next;
+
+        // The first job runs on this thread, and so does any job whose thread can't be created.
+        if (i > 0) {
+            threads[i] = SDL_CreateThread(ADPCM_DecodeThread, "SDLWaveDecode", job);
+        }
+    }
+
+    for (i = 0; i < numthreads; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        } else {
+            ADPCM_DecodeThread(&jobs[i]);
+        }
+    }
+
+    for (i = 0; i < numthreads; i++) {
+        if (!jobs[i].result) {
+            SDL_SetError("%s", jobs[i].error);
+            result = false;
+            break;
+        }
+    }
+
+    if (result) {
+        state->input.pos += numblocks * state->blocksize;
+        state->output.pos += numblocks * state->samplesperblock * state->channels;
+        state->framesleft -= (Sint64)(numblocks * state->samplesperblock);
+    }
+
+    SDL_free(jobs);
+    return result;
+}
+
 #ifdef SDL_WAVE_DEBUG_LOG_FORMAT
 static void WaveDebugLogFormat(WaveFile *file)
 {
@@ -491,39 +615,42 @@ static bool MS_ADPCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sample1, Sint32 sample2, Uint8 nybble)
+// The nibbles are signed 4-bit error deltas.
+static const Sint8 MS_ADPCM_ErrorDelta[16] = {
+    0, 1, 2, 3, 4, 5, 6, 7,
+    -8, -7, -6, -5, -4, -3, -2, -1
+};
+
+static const Uint16 MS_ADPCM_Adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+// The decoder state of one channel while decoding a block.
+typedef struct MS_ADPCM_Lane
 {
-    const Sint32 max_audioval = 32767;
-    const Sint32 min_audioval = -32768;
-    const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
-        230, 230, 230, 230, 307, 409, 512, 614,
-        768, 614, 512, 409, 307, 230, 230, 230
-    };
+    Sint32 sample1;
+    Sint32 sample2;
+    Sint32 coeff1;
+    Sint32 coeff2;
+    Uint32 delta;
+} MS_ADPCM_Lane;
+
+static SDL_INLINE Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_Lane *lane, Uint8 nybble)
+{
+    const Uint32 delta = (lane->delta * MS_ADPCM_Adaptive[nybble]) / 256;
     Sint32 new_sample;
-    Sint32 errordelta;
-    Uint32 delta = cstate->delta;
-
-    new_sample = (sample1 * cstate->coeff1 + sample2 * cstate->coeff2) / 256;
-    // The nibble is a signed 4-bit error delta.
-    errordelta = (Sint32)nybble - (nybble >= 0x08 ? 0x10 : 0);
-    new_sample += (Sint32)delta * errordelta;
-    if (new_sample < min_audioval) {
-        new_sample = min_audioval;
-    } else if (new_sample > max_audioval) {
-        new_sample = max_audioval;
-    }
-    delta = (delta * adaptive[nybble]) / 256;
-    if (delta < 16) {
-        delta = 16;
-    } else if (delta > max_deltaval) {
-        /* This issue is not described in the Standards Update and therefore
-         * undefined. It seems sensible to prevent overflows with a limit.
-         */
-        delta = max_deltaval;
-    }
 
-    cstate->delta = (Uint16)delta;
+    new_sample = (lane->sample1 * lane->coeff1 + lane->sample2 * lane->coeff2) / 256;
+    new_sample += (Sint32)lane->delta * MS_ADPCM_ErrorDelta[nybble];
+    new_sample = SDL_clamp(new_sample, -32768, 32767);
+
+    /* The upper limit of the delta is not described in the Standards Update
+     * and therefore undefined. It seems sensible to prevent overflows with it.
+     */
+    lane->delta = SDL_clamp(delta, 16, 65535);
+    lane->sample2 = lane->sample1;
+    lane->sample1 = new_sample;
     return (Sint16)new_sample;
 }
 
@@ -589,49 +716,71 @@ static bool MS_ADPCM_DecodeBlockHeader(ADPCM_DecoderState *state)
  */
 static bool MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
 {
-    Uint16 nybble = 0;
-    Sint16 sample1, sample2;
     const Uint32 channels = state->channels;
-    Uint32 c;
+    const Uint8 *data = state->block.data + state->block.pos;
+    const size_t availableframes = (state->block.size - state->block.pos) * 2 / channels;
     MS_ADPCM_ChannelState *cstate = (MS_ADPCM_ChannelState *)state->cstate;
-
-    size_t blockpos = state->block.pos;
-    size_t blocksize = state->block.size;
-
-    size_t outpos = state->output.pos;
+    MS_ADPCM_Lane lanes[2];
+    Sint16 *output;
+    size_t frames, i;
+    Uint32 c;
+    bool result = true;
 
     Sint64 blockframesleft = state->samplesperblock - 2;
     if (blockframesleft > state->framesleft) {
         blockframesleft = state->framesleft;
     }
+    frames = blockframesleft > 0 ? (size_t)blockframesleft : 0;
+    if (frames > availableframes) {
+        // Out of input data. Drop the incomplete frame.
+        frames = availableframes;
+        result = false;
+    }
 
-    while (blockframesleft > 0) {
-        for (c = 0; c < channels; c++) {
-            if (nybble & 0x4000) {
-                nybble <<= 4;
-            } else if (blockpos < blocksize) {
-                nybble = state->block.data[blockpos++] | 0x4000;
-            } else {
-                // Out of input data. Drop the incomplete frame and return.
-                state->output.pos = outpos - c;
-                return false;
-            }
-
-            // Load previous samples which may come from the block header.
-            sample1 = state->output.data[outpos - channels];
-            sample2 = state->output.data[outpos - channels * 2];
+    // The previous samples come from the block header.
+    for (c = 0; c < channels; c++) {
+        lanes[c].sample1 = state->output.data[state->output.pos + c - channels];
+        lanes[c].sample2 = state->output.data[state->output.pos + c - channels * 2];
+        lanes[c].coeff1 = cstate[c].coeff1;
+        lanes[c].coeff2 = cstate[c].coeff2;
+        lanes[c].delta = cstate[c].delta;
+    }
 
-            sample1 = MS_ADPCM_ProcessNibble(cstate + c, sample1, sample2, (nybble >> 4) & 0x0f);
-            state->output.data[outpos++] = sample1;
+    /* The channels are independent of each other, so each one is decoded in
+     * its own lane. With stereo, every byte has one nibble for each channel.
+     */
+    output = state->output.data + state->output.pos;
+    if (channels == 2) {
+        for (i = 0; i < frames; i++) {
+            const Uint8 nybbles = data[i];
+            output[i * 2] = MS_ADPCM_ProcessNibble(&lanes[0], nybbles >> 4);
+            output[i * 2 + 1] = MS_ADPCM_ProcessNibble(&lanes[1], nybbles & 0x0f);
         }
+    } else {
+        for (i = 0; i + 1 < frames; i += 2) {
+            const Uint8 nybbles = data[i / 2];
+            output[i] = MS_ADPCM_ProcessNibble(&lanes[0], nybbles >> 4);
+            output[i + 1] = MS_ADPCM_ProcessNibble(&lanes[0], nybbles & 0x0f);
+        }
+        if (i < frames) {
+            output[i] = MS_ADPCM_ProcessNibble(&lanes[0], data[i / 2] >> 4);
+        }
+    }
 
-        state->framesleft--;
-        blockframesleft--;
+    for (c = 0; c < channels; c++) {
+        cstate[c].delta = (Uint16)lanes[c].delta;
     }
 
-    state->output.pos = outpos;
+    state->output.pos += frames * channels;
+    state->framesleft -= frames;
 
-    return true;
+    return result;
+}
+
+// Decodes a whole MS ADPCM block, header and data.
+static bool MS_ADPCM_DecodeBlock(ADPCM_DecoderState *state)
+{
+    return MS_ADPCM_DecodeBlockHeader(state) && MS_ADPCM_DecodeBlockData(state);
 }
 
 static bool MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
@@ -689,6 +838,12 @@ static bool MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
 
     state.cstate = cstate;
 
+    // Large files get most of their blocks decoded in parallel, the loop below does the rest.
+    if (!ADPCM_DecodeCompleteBlocks(&state, sizeof(cstate), MS_ADPCM_DecodeBlock)) {
+        SDL_free(state.output.data);
+        return false;
+    }
+
     // Decode block by block. A truncated block will stop the decoding.
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -851,10 +1006,16 @@ static bool IMA_ADPCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 nybble)
+/* For every step index and nibble, the sample delta and the row of the next
+ * step index, packed as delta * 2048 + row. A row is 16 entries, so the next
+ * row offset is in the lower 11 bits and the delta in the upper 21 bits. The
+ * index is already clamped, which makes decoding a nibble a single lookup.
+ */
+static Sint32 IMA_ADPCM_StepTable[89 * 16];
+static SDL_InitState IMA_ADPCM_StepTableInit;
+
+static const Sint32 *IMA_ADPCM_GetStepTable(void)
 {
-    const Sint32 max_audioval = 32767;
-    const Sint32 min_audioval = -32768;
     const Sint8 index_table_4b[16] = {
         -1, -1, -1, -1,
         2, 4, 6, 8,
@@ -871,53 +1032,112 @@ static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 ny
         9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
         22385, 24623, 27086, 29794, 32767
     };
-    Uint32 step;
-    Sint32 sample, delta;
-    Sint8 index = *cindex;
+    int index, nybble;
+
+    if (SDL_ShouldInit(&IMA_ADPCM_StepTableInit)) {
+        for (index = 0; index < 89; index++) {
+            const Sint32 step = step_table[index];
+            for (nybble = 0; nybble < 16; nybble++) {
+                const int next = SDL_clamp(index + index_table_4b[nybble], 0, 88);
+
+                /* This calculation uses shifts and additions because multiplications were
+                 * much slower back then. Sadly, this can't just be replaced with an actual
+                 * multiplication now as the old algorithm drops some bits. The closest
+                 * approximation I could find is something like this:
+                 * (nybble & 0x8 ? -1 : 1) * ((nybble & 0x7) * step / 4 + step / 8)
+                 */
+                Sint32 delta = step >> 3;
+                if (nybble & 0x04) {
+                    delta += step;
+                }
+                if (nybble & 0x02) {
+                    delta += step >> 1;
+                }
+                if (nybble & 0x01) {
+                    delta += step >> 2;
+                }
+                if (nybble & 0x08) {
+                    delta = -delta;
+                }
 
-    // Clamp index into valid range.
-    if (index > 88) {
-        index = 88;
-    } else if (index < 0) {
-        index = 0;
+                IMA_ADPCM_StepTable[index * 16 + nybble] = delta * 2048 + next * 16;
+            }
+        }
+        SDL_SetInitialized(&IMA_ADPCM_StepTableInit, true);
     }
+    return IMA_ADPCM_StepTable;
+}
 
-    // explicit cast to avoid gcc warning about using 'char' as array index
-    step = step_table[(size_t)index];
+static SDL_INLINE Sint16 IMA_ADPCM_ProcessNibble(const Sint32 *steps, Sint32 *row, Sint32 *sample, Uint8 nybble)
+{
+    const Sint32 entry = steps[*row + nybble];
+    *sample = SDL_clamp(*sample + (entry >> 11), -32768, 32767);
+    *row = entry & 0x7ff;
+    return (Sint16)*sample;
+}
 
-    // Update index value
-    *cindex = index + index_table_4b[nybble];
+// Converts a step index from a block header to its row in the step table.
+static Sint32 IMA_ADPCM_IndexToRow(Sint8 index)
+{
+    return SDL_clamp((Sint32)index, 0, 88) * 16;
+}
 
-    /* This calculation uses shifts and additions because multiplications were
-     * much slower back then. Sadly, this can't just be replaced with an actual
-     * multiplication now as the old algorithm drops some bits. The closest
-     * approximation I could find is something like this:
-     * (nybble & 0x8 ? -1 : 1) * ((nybble & 0x7) * step / 4 + step / 8)
-     */
-    delta = step >> 3;
-    if (nybble & 0x04) {
-        delta += step;
-    }
-    if (nybble & 0x02) {
-        delta += step >> 1;
-    }
-    if (nybble & 0x01) {
-        delta += step >> 2;
+/* Decodes the samples of one channel. The nibbles come in 4-byte groups of 8
+ * samples, each group 'stride' bytes after the previous one. Returns the row
+ * of the final step index.
+ */
+static Sint32 IMA_ADPCM_DecodeChannel(const Sint32 *steps, const Uint8 *data, size_t stride, Sint16 *output, size_t channels, Sint32 sample, Sint32 row, size_t frames)
+{
+    size_t i;
+
+    for (; frames >= 8; frames -= 8) {
+        for (i = 0; i < 4; i++) {
+            const Uint8 nybbles = data[i];
+            output[0] = IMA_ADPCM_ProcessNibble(steps, &row, &sample, nybbles & 0x0f);
+            output[channels] = IMA_ADPCM_ProcessNibble(steps, &row, &sample, nybbles >> 4);
+            output += channels * 2;
+        }
+        data += stride;
     }
-    if (nybble & 0x08) {
-        delta = -delta;
+
+    for (i = 0; i < frames; i++) {
+        const Uint8 nybbles = data[i / 2];
+        output[i * channels] = IMA_ADPCM_ProcessNibble(steps, &row, &sample, (i & 1) ? (nybbles >> 4) : (nybbles & 0x0f));
     }
 
-    sample = lastsample + delta;
+    return row;
+}
+
+/* Decodes both channels of a stereo block in lanes. The groups of the left
+ * and right channel alternate, so both are at hand at the same time.
+ */
+static void IMA_ADPCM_DecodeStereo(const Sint32 *steps, const Uint8 *data, Sint16 *output, Sint32 *samples, Sint32 *rows, size_t frames)
+{
+    Sint32 lsample = samples[0], rsample = samples[1];
+    Sint32 lrow = rows[0], rrow = rows[1];
+    size_t i;
+
+    for (; frames >= 8; frames -= 8) {
+        for (i = 0; i < 4; i++) {
+            const Uint8 lnybbles = data[i];
+            const Uint8 rnybbles = data[i + 4];
+            output[0] = IMA_ADPCM_ProcessNibble(steps, &lrow, &lsample, lnybbles & 0x0f);
+            output[1] = IMA_ADPCM_ProcessNibble(steps, &rrow, &rsample, rnybbles & 0x0f);
+            output[2] = IMA_ADPCM_ProcessNibble(steps, &lrow, &lsample, lnybbles >> 4);
+            output[3] = IMA_ADPCM_ProcessNibble(steps, &rrow, &rsample, rnybbles >> 4);
+            output += 4;
+        }
+        data += 8;
+    }
 
-    // Clamp output sample
-    if (sample > max_audioval) {
-        sample = max_audioval;
-    } else if (sample < min_audioval) {
-        sample = min_audioval;
+    for (i = 0; i < frames; i++) {
+        const int shift = (i & 1) ? 4 : 0;
+        output[i * 2] = IMA_ADPCM_ProcessNibble(steps, &lrow, &lsample, (data[i / 2] >> shift) & 0x0f);
+        output[i * 2 + 1] = IMA_ADPCM_ProcessNibble(steps, &rrow, &rsample, (data[i / 2 + 4] >> shift) & 0x0f);
     }
 
-    return (Sint16)sample;
+    rows[0] = lrow;
+    rows[1] = rrow;
 }
 
 static bool IMA_ADPCM_DecodeBlockHeader(ADPCM_DecoderState *state)
@@ -961,18 +1181,18 @@ static bool IMA_ADPCM_DecodeBlockHeader(ADPCM_DecoderState *state)
  */
 static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
 {
-    size_t i;
+    const Sint32 *steps = IMA_ADPCM_GetStepTable();
     const Uint32 channels = state->channels;
     const size_t subblockframesize = (size_t)channels * 4;
+    const Uint8 *data = state->block.data + state->block.pos;
+    Sint8 *cstate = (Sint8 *)state->cstate;
+    Sint16 *output = state->output.data + state->output.pos;
     Uint64 bytesrequired;
+    size_t frames;
     Uint32 c;
     bool result = true;
 
-    size_t blockpos = state->block.pos;
-    size_t blocksize = state->block.size;
-    size_t blockleft = blocksize - blockpos;
-
-    size_t outpos = state->output.pos;
+    size_t blockleft = state->block.size - state->block.pos;
 
     Sint64 blockframesleft = state->samplesperblock - 1;
     if (blockframesleft > state->framesleft) {
@@ -982,52 +1202,59 @@ static bool IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     bytesrequired = (blockframesleft + 7) / 8 * subblockframesize;
     if (blockleft < bytesrequired) {
         // Data truncated. Calculate how many samples we can get out if it.
-        const size_t guaranteedframes = blockleft / subblockframesize;
+        const size_t guaranteedframes = blockleft / subblockframesize * 8;
         const size_t remainingbytes = blockleft % subblockframesize;
-        blockframesleft = guaranteedframes;
+        Sint64 availableframes = guaranteedframes;
         if (remainingbytes > subblockframesize - 4) {
-            blockframesleft += (Sint64)(remainingbytes % 4) * 2;
+            availableframes += (Sint64)(remainingbytes % 4) * 2;
+        }
+        // Never more than the output has room for.
+        if (availableframes < blockframesleft) {
+            blockframesleft = availableframes;
         }
         // Signal the truncation.
         result = false;
     }
+    frames = blockframesleft > 0 ? (size_t)blockframesleft : 0;
 
     /* Each channel has their nibbles packed into 32-bit blocks. These blocks
-     * are interleaved and make up the data part of the ADPCM block. This loop
-     * decodes the samples as they come from the input data and puts them at
-     * the appropriate places in the output data.
+     * are interleaved and make up the data part of the ADPCM block. Every
+     * channel is decoded on its own, starting from the sample in the block
+     * header, and the samples are put at the appropriate places in the output.
+     * A final group with less than 8 samples per channel is still made of
+     * 32-bit blocks, as the encoder pads every channel's nibbles to 32 bits.
      */
-    while (blockframesleft > 0) {
-        const size_t subblocksamples = blockframesleft < 8 ? (size_t)blockframesleft : 8;
-
+    if (channels == 2) {
+        Sint32 samples[2], rows[2];
+        for (c = 0; c < 2; c++) {
+            samples[c] = state->output.data[state->output.pos + c - channels];
+            rows[c] = IMA_ADPCM_IndexToRow(cstate[c]);
+        }
+        IMA_ADPCM_DecodeStereo(steps, data, output, samples, rows, frames);
+        for (c = 0; c < 2; c++) {
+            cstate[c] = (Sint8)(rows[c] / 16);
+        }
+    } else {
         for (c = 0; c < channels; c++) {
-            Uint8 nybble = 0;
-            // Load previous sample which may come from the block header.
-            Sint16 sample = state->output.data[outpos + c - channels];
-
-            for (i = 0; i < subblocksamples; i++) {
-                if (i & 1) {
-                    nybble >>= 4;
-                } else {
-                    nybble = state->block.data[blockpos++];
-                }
-
-                sample = IMA_ADPCM_ProcessNibble((Sint8 *)state->cstate + c, sample, nybble & 0x0f);
-                state->output.data[outpos + c + i * channels] = sample;
-            }
+            const Sint32 sample = state->output.data[state->output.pos + c - channels];
+            const Sint32 row = IMA_ADPCM_DecodeChannel(steps, data + c * 4, subblockframesize, output + c, channels, sample, IMA_ADPCM_IndexToRow(cstate[c]), frames);
+            cstate[c] = (Sint8)(row / 16);
         }
-
-        outpos += channels * subblocksamples;
-        state->framesleft -= subblocksamples;
-        blockframesleft -= subblocksamples;
     }
 
-    state->block.pos = blockpos;
-    state->output.pos = outpos;
+    state->block.pos += SDL_min((frames + 7) / 8 * subblockframesize, blockleft);
+    state->output.pos += frames * channels;
+    state->framesleft -= frames;
 
     return result;
 }
 
+// Decodes a whole IMA ADPCM block, header and data.
+static bool IMA_ADPCM_DecodeBlock(ADPCM_DecoderState *state)
+{
+    return IMA_ADPCM_DecodeBlockHeader(state) && IMA_ADPCM_DecodeBlockData(state);
+}
+
 static bool IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     bool result;
@@ -1085,6 +1312,13 @@ static bool IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_le
     }
     state.cstate = cstate;
 
+    // Large files get most of their blocks decoded in parallel, the loop below does the rest.
+    if (!ADPCM_DecodeCompleteBlocks(&state, state.channels, IMA_ADPCM_DecodeBlock)) {
+        SDL_free(state.output.data);
+        SDL_free(cstate);
+        return false;
+    }
+
     // Decode block by block. A truncated block will stop the decoding.
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
@@ -1159,7 +1393,10 @@ static bool LAW_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* Expands count companded samples from src to 16-bit samples in dst. This works
+ * backwards, so src and dst may point to the same memory for an in-place expansion.
+ */
+static bool LAW_DecodeSamples(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1199,54 +1436,9 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         112, 104, 96, 88, 80, 72, 64, 56, 48, 40, 32, 24, 16, 8, 0
     };
 #endif
+    size_t i = count;
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
-
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return false;
-        }
-    }
-
-    // Nothing to decode, nothing to return.
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return true;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    // 1 to avoid allocating zero bytes, to keep static analysis happy.
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return false;
-    }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
-
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
-    i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1291,10 +1483,61 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+    return true;
+}
+
+static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return false;
+        }
+    }
+
+    // Nothing to decode, nothing to return.
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return true;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    // 1 to avoid allocating zero bytes, to keep static analysis happy.
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return false;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    /* Work backwards, since we're expanding in-place. `format` will
+     * inform the caller about the byte order.
+     */
+    if (!LAW_DecodeSamples(file->format.encoding, src, (Sint16 *)src, sample_count)) {
+        SDL_free(src);
+        return false;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1344,11 +1587,33 @@ static bool PCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
+// Shifts sample_count 24-bit samples at the start of ptr to 32 bits, in-place.
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    // work from end to start, since we're expanding in-place.
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1376,21 +1641,7 @@ static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    // work from end to start, since we're expanding in-place.
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return true;
 }
@@ -1770,7 +2021,11 @@ static bool WaveCheckFormat(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Finds the fmt and data chunks and checks the format. On success, file->chunk
+ * describes the data chunk (without its data loaded) and endposition is set to
+ * where the caller should leave the stream when it's done with the file.
+ */
+static bool WaveParse(SDL_IOStream *src, WaveFile *file, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1778,7 +2033,6 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
     const char *hint;
     Sint64 RIFFstart, RIFFend, lastchunkpos;
     bool RIFFlengthknown = false;
-    WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
     WaveChunk RIFFchunk;
     WaveChunk fmtchunk;
@@ -1981,9 +2235,74 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
 
     WaveFreeChunkData(chunk);
 
-    // Process data chunk.
     *chunk = datachunk;
 
+    // Report the end position back to the cleanup code.
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return true;
+}
+
+// Sets up the spec for the decoded data. All unsupported formats were filtered out by WaveParse.
+static bool WaveGetSpec(WaveFile *file, SDL_AudioSpec *spec)
+{
+    WaveFormat *format = &file->format;
+
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = SDL_AUDIO_UNKNOWN;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        // These can be easily stored in the byte order of the system.
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: // Gets shifted to 32 bits.
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            // Just in case something unexpected happened in the checks.
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    return true;
+}
+
+static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition = 0;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (!WaveParse(src, file, &endposition)) {
+        return false;
+    }
+
+    // Process data chunk.
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result < 0) {
@@ -2027,51 +2346,11 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = SDL_AUDIO_UNKNOWN;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        // These can be easily stored in the byte order of the system.
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: // Has been shifted to 32 bits.
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            // Just in case something unexpected happened in the checks.
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
+    if (!WaveGetSpec(file, spec)) {
+        return false;
     }
 
-    // Report the end position back to the cleanup code.
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return true;
 }
@@ -2149,3 +2428,412 @@ bool SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint3
     return SDL_LoadWAV_IO(stream, true, spec, audio_buf, audio_len);
 }
 
+
+// Streaming WAVE decoding. See SDL_OpenWAVReader_IO.
+
+#define WAVE_READER_FEED_SIZE (16 * 1024) // Bytes decoded at a time when feeding an audio stream.
+
+struct SDL_WAVReader
+{
+    SDL_IOStream *src;
+    bool closeio;
+    WaveFile file;        // file.chunk is the data chunk. Its data is never loaded.
+    SDL_AudioSpec spec;   // Format of the decoded data.
+    size_t framesize;     // Size of a decoded sample frame in bytes.
+    size_t datalength;    // Number of bytes of the data chunk that are actually in the stream.
+    Sint64 position;      // Next sample frame to be decoded.
+    Sint64 endposition;   // Where src is left when the reader is closed.
+
+    // The ADPCM formats are decoded a block at a time.
+    Uint8 *block;         // Raw data of the current block.
+    Sint16 *decoded;      // Decoded data of the current block.
+    Sint64 decodedstart;  // Sample frame at the start of the current block.
+    size_t decodedframes; // Number of sample frames in decoded. Zero if no block is loaded.
+    void *cstate;         // Decoding state for each channel.
+
+    // For SDL_SetAudioStreamWAVReader.
+    Uint8 *feed;
+    bool flushed;
+};
+
+static bool WaveReaderIsADPCM(SDL_WAVReader *reader)
+{
+    const Uint16 encoding = reader->file.format.encoding;
+    return encoding == MS_ADPCM_CODE || encoding == IMA_ADPCM_CODE;
+}
+
+static bool WaveReaderInit(SDL_WAVReader *reader)
+{
+    WaveFile *file = &reader->file;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    const Sint64 size = SDL_GetIOSize(reader->src);
+
+    reader->framesize = SDL_AUDIO_FRAMESIZE(reader->spec);
+    reader->datalength = chunk->length;
+
+    // Nothing is read yet, so look at the size of the stream to catch a truncated data chunk like WaveLoad would.
+    if (size >= 0 && size - chunk->position < (Sint64)chunk->length) {
+        reader->datalength = (size_t)SDL_max(size - chunk->position, 0);
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+        switch (format->encoding) {
+        case MS_ADPCM_CODE:
+            if (!MS_ADPCM_CalculateSampleFrames(file, reader->datalength)) {
+                return false;
+            }
+            break;
+        case IMA_ADPCM_CODE:
+            if (!IMA_ADPCM_CalculateSampleFrames(file, reader->datalength)) {
+                return false;
+            }
+            break;
+        default:
+            file->sampleframes = WaveAdjustToFactValue(file, reader->datalength / format->blockalign);
+            if (file->sampleframes < 0) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    if (WaveReaderIsADPCM(reader)) {
+        const size_t cstatesize = format->encoding == MS_ADPCM_CODE ? sizeof(MS_ADPCM_ChannelState) : sizeof(Sint8);
+        reader->block = (Uint8 *)SDL_malloc(format->blockalign);
+        reader->decoded = (Sint16 *)SDL_malloc((size_t)format->samplesperblock * reader->framesize);
+        reader->cstate = SDL_calloc(format->channels, cstatesize);
+        if (!reader->block || !reader->decoded || !reader->cstate) {
+            return false;
+        }
+    } else if (format->encoding == PCM_CODE || format->encoding == IEEE_FLOAT_CODE) {
+        // Data is read straight into the caller's buffer, so each block has to be exactly one sample frame.
+        if (format->blockalign != format->channels * (format->bitspersample / 8)) {
+            return SDL_SetError("Unsupported block alignment");
+        }
+    }
+
+    return SDL_SeekWAVReader(reader, 0);
+}
+
+// Loads and decodes the ADPCM block that contains sample frame `position`.
+static bool WaveReaderDecodeBlock(SDL_WAVReader *reader)
+{
+    WaveFile *file = &reader->file;
+    WaveFormat *format = &file->format;
+    const Sint64 blockindex = reader->position / format->samplesperblock;
+    const Uint64 offset = (Uint64)blockindex * format->blockalign;
+    ADPCM_DecoderState state;
+    bool result;
+
+    reader->decodedstart = blockindex * format->samplesperblock;
+    reader->decodedframes = 0;
+
+    SDL_zero(state);
+    state.channels = format->channels;
+    state.blocksize = format->blockalign;
+    state.blockheadersize = (size_t)state.channels * (format->encoding == MS_ADPCM_CODE ? 7 : 4);
+    state.samplesperblock = format->samplesperblock;
+    state.framesize = reader->framesize;
+    state.ddata = file->decoderdata;
+    state.framestotal = file->sampleframes;
+    state.framesleft = file->sampleframes - reader->decodedstart;
+    state.cstate = reader->cstate;
+
+    if (offset >= reader->datalength) {
+        return true; // Out of data.
+    } else {
+        const Sint64 position = file->chunk.position + (Sint64)offset;
+        if (SDL_SeekIO(reader->src, position, SDL_IO_SEEK_SET) != position) {
+            return SDL_SetError("Could not seek in WAVE data chunk");
+        }
+        state.block.size = SDL_ReadIO(reader->src, reader->block, SDL_min(state.blocksize, reader->datalength - (size_t)offset));
+    }
+
+    // Like the whole file decoders, a block too short for its header ends the data.
+    if (state.block.size < state.blockheadersize) {
+        return true;
+    }
+
+    state.block.data = reader->block;
+    state.output.data = reader->decoded;
+    state.output.size = state.samplesperblock * state.channels;
+
+    if (format->encoding == MS_ADPCM_CODE) {
+        if (!MS_ADPCM_DecodeBlockHeader(&state)) {
+            return false;
+        }
+        result = MS_ADPCM_DecodeBlockData(&state);
+    } else {
+        result = IMA_ADPCM_DecodeBlockHeader(&state) && IMA_ADPCM_DecodeBlockData(&state);
+    }
+
+    if (!result) {
+        // Truncated block. This is handled the same way the whole file decoders do it.
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Truncated data chunk");
+        } else if (file->trunchint != TruncDropFrame) {
+            state.output.pos -= state.output.pos % (state.samplesperblock * state.channels);
+        }
+    }
+
+    reader->decodedframes = (size_t)SDL_min((Sint64)(state.output.pos / state.channels), file->sampleframes - reader->decodedstart);
+
+    return true;
+}
+
+static int WaveReaderReadADPCM(SDL_WAVReader *reader, Uint8 *buf, Sint64 frames)
+{
+    const size_t channels = reader->file.format.channels;
+    Sint64 total = 0;
+
+    while (total < frames) {
+        Sint64 decodedend = reader->decodedstart + (Sint64)reader->decodedframes;
+        if (reader->decodedframes == 0 || reader->position < reader->decodedstart || reader->position >= decodedend) {
+            if (!WaveReaderDecodeBlock(reader)) {
+                return total ? (int)(total * reader->framesize) : -1;
+            }
+            decodedend = reader->decodedstart + (Sint64)reader->decodedframes;
+            if (reader->position >= decodedend) {
+                // The data ran out before the expected end. Stop here from now on.
+                reader->file.sampleframes = reader->position;
+                break;
+            }
+        }
+
+        const Sint64 count = SDL_min(frames - total, decodedend - reader->position);
+        SDL_memcpy(buf + total * reader->framesize, reader->decoded + (reader->position - reader->decodedstart) * channels, (size_t)count * reader->framesize);
+        reader->position += count;
+        total += count;
+    }
+
+    return (int)(total * reader->framesize);
+}
+
+static int WaveReaderReadPCM(SDL_WAVReader *reader, Uint8 *buf, Sint64 frames)
+{
+    WaveFormat *format = &reader->file.format;
+    const size_t rawsize = (size_t)frames * format->blockalign;
+    const size_t br = SDL_ReadIO(reader->src, buf, rawsize);
+    const size_t count = br / format->blockalign;
+
+    if (br < rawsize) {
+        if (count == 0 && SDL_GetIOStatus(reader->src) == SDL_IO_STATUS_ERROR) {
+            return -1;
+        }
+        // The data ran out before the expected end. Stop here from now on.
+        reader->file.sampleframes = reader->position + (Sint64)count;
+    }
+
+    // The raw data is at the start of buf, and is expanded in-place.
+    if (format->encoding == ALAW_CODE || format->encoding == MULAW_CODE) {
+        if (!LAW_DecodeSamples(format->encoding, buf, (Sint16 *)buf, count * format->channels)) {
+            return -1;
+        }
+    } else if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+        PCM_ExpandSint24ToSint32(buf, count * format->channels);
+    }
+
+    reader->position += (Sint64)count;
+
+    return (int)(count * reader->framesize);
+}
+
+static int WaveReaderRead(SDL_WAVReader *reader, Uint8 *buf, int len)
+{
+    const Sint64 frames = SDL_min((Sint64)(len / reader->framesize), reader->file.sampleframes - reader->position);
+
+    if (frames <= 0) {
+        return 0;
+    } else if (WaveReaderIsADPCM(reader)) {
+        return WaveReaderReadADPCM(reader, buf, frames);
+    }
+    return WaveReaderReadPCM(reader, buf, frames);
+}
+
+SDL_WAVReader *SDL_OpenWAVReader_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec, Sint64 *frames)
+{
+    SDL_WAVReader *reader = NULL;
+
+    if (spec) {
+        SDL_zerop(spec);
+    }
+    if (frames) {
+        *frames = 0;
+    }
+
+    // Make sure we are passed a valid data source
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto done;
+    } else if (!spec) {
+        SDL_InvalidParamError("spec");
+        goto done;
+    }
+
+    reader = (SDL_WAVReader *)SDL_calloc(1, sizeof(*reader));
+    if (!reader) {
+        goto done;
+    }
+
+    reader->src = src;
+    reader->closeio = closeio;
+    reader->file.riffhint = WaveGetRiffSizeHint();
+    reader->file.trunchint = WaveGetTruncationHint();
+    reader->file.facthint = WaveGetFactChunkHint();
+
+    if (!WaveParse(src, &reader->file, &reader->endposition) ||
+        !WaveGetSpec(&reader->file, &reader->spec) ||
+        !WaveReaderInit(reader)) {
+        if (!closeio) {
+            SDL_SeekIO(src, reader->file.chunk.position, SDL_IO_SEEK_SET);
+        }
+        reader->closeio = false;  // closed below.
+        reader->endposition = 0;
+        SDL_CloseWAVReader(reader);
+        reader = NULL;
+        goto done;
+    }
+
+    SDL_copyp(spec, &reader->spec);
+    if (frames) {
+        *frames = reader->file.sampleframes;
+    }
+
+done:
+    if (!reader && closeio && src) {
+        SDL_CloseIO(src);
+    }
+    return reader;
+}
+
+SDL_WAVReader *SDL_OpenWAVReader(const char *path, SDL_AudioSpec *spec, Sint64 *frames)
+{
+    SDL_IOStream *stream = SDL_IOFromFile(path, "rb");
+    if (!stream) {
+        if (spec) {
+            SDL_zerop(spec);
+        }
+        if (frames) {
+            *frames = 0;
+        }
+        return NULL;
+    }
+    return SDL_OpenWAVReader_IO(stream, true, spec, frames);
+}
+
+int SDL_ReadWAVReader(SDL_WAVReader *reader, void *buf, int len)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return -1;
+    } else if (!buf) {
+        SDL_InvalidParamError("buf");
+        return -1;
+    } else if (len < 0) {
+        SDL_InvalidParamError("len");
+        return -1;
+    }
+
+    return WaveReaderRead(reader, (Uint8 *)buf, len);
+}
+
+bool SDL_SeekWAVReader(SDL_WAVReader *reader, Sint64 frame)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (frame < 0 || frame > reader->file.sampleframes) {
+        return SDL_InvalidParamError("frame");
+    }
+
+    // The ADPCM formats seek when the block is decoded.
+    if (!WaveReaderIsADPCM(reader)) {
+        const Sint64 position = reader->file.chunk.position + frame * reader->file.format.blockalign;
+        if (SDL_SeekIO(reader->src, position, SDL_IO_SEEK_SET) != position) {
+            return SDL_SetError("Could not seek in WAVE data chunk");
+        }
+    }
+
+    reader->position = frame;
+    reader->flushed = false;
+
+    return true;
+}
+
+Sint64 SDL_TellWAVReader(SDL_WAVReader *reader)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return -1;
+    }
+    return reader->position;
+}
+
+static void SDLCALL WaveReaderGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    SDL_WAVReader *reader = (SDL_WAVReader *)userdata;
+    const int feedsize = WAVE_READER_FEED_SIZE - (WAVE_READER_FEED_SIZE % (int)reader->framesize);
+
+    while (additional_amount > 0) {
+        // Round up to a whole frame, or a request for less than a frame would decode nothing.
+        const int len = SDL_min(additional_amount + (int)reader->framesize - 1, feedsize);
+        const int br = WaveReaderRead(reader, reader->feed, len);
+        if (br <= 0) {
+            break;
+        }
+        SDL_PutAudioStreamData(stream, reader->feed, br);
+        additional_amount -= br;
+    }
+
+    // Let the stream hand out everything it has, now that nothing else is coming.
+    if (reader->position >= reader->file.sampleframes && !reader->flushed) {
+        SDL_FlushAudioStream(stream);
+        reader->flushed = true;
+    }
+}
+
+bool SDL_SetAudioStreamWAVReader(SDL_AudioStream *stream, SDL_WAVReader *reader)
+{
+    bool result;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!reader) {
+        return SDL_SetAudioStreamGetCallback(stream, NULL, NULL);
+    }
+
+    if (!reader->feed) {
+        reader->feed = (Uint8 *)SDL_malloc(WAVE_READER_FEED_SIZE);
+        if (!reader->feed) {
+            return false;
+        }
+    }
+
+    SDL_LockAudioStream(stream);
+    result = SDL_SetAudioStreamFormat(stream, &reader->spec, NULL) &&
+             SDL_SetAudioStreamGetCallback(stream, WaveReaderGetCallback, reader);
+    reader->flushed = false;
+    SDL_UnlockAudioStream(stream);
+
+    return result;
+}
+
+void SDL_CloseWAVReader(SDL_WAVReader *reader)
+{
+    if (!reader) {
+        return;
+    }
+
+    if (reader->closeio) {
+        SDL_CloseIO(reader->src);
+    } else if (reader->endposition > 0) {
+        SDL_SeekIO(reader->src, reader->endposition, SDL_IO_SEEK_SET);
+    }
+
+    SDL_free(reader->file.decoderdata);
+    SDL_free(reader->block);
+    SDL_free(reader->decoded);
+    SDL_free(reader->cstate);
+    SDL_free(reader->feed);
+    SDL_free(reader);
+}
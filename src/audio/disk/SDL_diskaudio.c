@@ -172,6 +172,7 @@ static bool DISKAUDIO_Init(SDL_AudioDriverImpl *impl)
     impl->DetectDevices = DISKAUDIO_DetectDevices;
 
     impl->HasRecordingSupport = true;
+    impl->PlayDeviceAcceptsAnyBuffer = true;
 
     return true;
 }
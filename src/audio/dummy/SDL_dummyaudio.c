@@ -112,6 +112,7 @@ static bool DUMMYAUDIO_Init(SDL_AudioDriverImpl *impl)
     impl->OnlyHasDefaultPlaybackDevice = true;
     impl->OnlyHasDefaultRecordingDevice = true;
     impl->HasRecordingSupport = true;
+    impl->PlayDeviceAcceptsAnyBuffer = true;
 
     // on Emscripten without threads, we just fire a repeating timer to consume audio.
     #if defined(SDL_PLATFORM_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
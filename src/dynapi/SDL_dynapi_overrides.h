@@ -1279,3 +1279,19 @@
 #define SDL_SetAudioIterationCallbacks SDL_SetAudioIterationCallbacks_REAL
 #define SDL_GetEventDescription SDL_GetEventDescription_REAL
 #define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_GetAudioStreamStats SDL_GetAudioStreamStats_REAL
+#define SDL_OpenWAVReader_IO SDL_OpenWAVReader_IO_REAL
+#define SDL_OpenWAVReader SDL_OpenWAVReader_REAL
+#define SDL_ReadWAVReader SDL_ReadWAVReader_REAL
+#define SDL_SeekWAVReader SDL_SeekWAVReader_REAL
+#define SDL_TellWAVReader SDL_TellWAVReader_REAL
+#define SDL_SetAudioStreamWAVReader SDL_SetAudioStreamWAVReader_REAL
+#define SDL_CloseWAVReader SDL_CloseWAVReader_REAL
+#define SDL_GetSurfaceBlitStats SDL_GetSurfaceBlitStats_REAL
+#define SDL_SetRenderBatchMode SDL_SetRenderBatchMode_REAL
+#define SDL_GetRenderBatchMode SDL_GetRenderBatchMode_REAL
+#define SDL_StartRenderLayer SDL_StartRenderLayer_REAL
+#define SDL_CreateDebugTextRun SDL_CreateDebugTextRun_REAL
+#define SDL_RenderDebugTextRun SDL_RenderDebugTextRun_REAL
+#define SDL_DestroyDebugTextRun SDL_DestroyDebugTextRun_REAL
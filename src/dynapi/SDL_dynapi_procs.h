@@ -1287,3 +1287,19 @@ SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamPlanarData,(SDL_AudioStream *a,const void
 SDL_DYNAPI_PROC(bool,SDL_SetAudioIterationCallbacks,(SDL_AudioDeviceID a,SDL_AudioIterationCallback b,SDL_AudioIterationCallback c,void *d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(int,SDL_GetEventDescription,(const SDL_Event *a,char *b,int c),(a,b,c),return)
 SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamDataNoCopy,(SDL_AudioStream *a,const void *b,int c,SDL_AudioStreamDataCompleteCallback d,void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a,SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetAudioStreamStats,(SDL_AudioStream *a,SDL_AudioStreamStats *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAVReader_IO,(SDL_IOStream *a,bool b,SDL_AudioSpec *c,Sint64 *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAVReader,(const char *a,SDL_AudioSpec *b,Sint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWAVReader,(SDL_WAVReader *a,void *b,int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_SeekWAVReader,(SDL_WAVReader *a,Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_TellWAVReader,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetAudioStreamWAVReader,(SDL_AudioStream *a,SDL_WAVReader *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAVReader,(SDL_WAVReader *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_GetSurfaceBlitStats,(SDL_Surface *a,SDL_SurfaceBlitStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetRenderBatchMode,(SDL_Renderer *a,SDL_RenderBatchMode b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetRenderBatchMode,(SDL_Renderer *a,SDL_RenderBatchMode *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_StartRenderLayer,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_DebugTextRun*,SDL_CreateDebugTextRun,(SDL_Renderer *a,const char *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_RenderDebugTextRun,(SDL_Renderer *a,SDL_DebugTextRun *b,float c,float d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyDebugTextRun,(SDL_DebugTextRun *a),(a),)
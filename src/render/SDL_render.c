@@ -307,8 +307,637 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
-static bool FlushRenderCommands(SDL_Renderer *renderer)
+// Drawing on a render thread, see SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN.
+//
+// Each flushed queue is handed to the render thread along with its vertex buffer, and the next queue is built in
+// the other vertex buffer. Only one queue is handed over at a time, so handing over waits for the last one to be
+// drawn. Presenting updates the window, which has to be done on the main thread, so the render thread asks the main
+// thread to do it, and the application thread does it itself if it has to wait for the render thread first.
+
+// This is called with the render thread lock held.
+static void PresentRenderThreadFrame(SDL_Renderer *renderer)
+{
+    if (renderer->render_thread_present_pending) {
+        renderer->render_thread_present_pending = false;
+        renderer->RenderPresent(renderer);
+    }
+}
+
+static void SDLCALL PresentRenderThreadFrameOnMainThread(void *userdata)
+{
+    SDL_Renderer *renderer = (SDL_Renderer *)userdata;
+
+    if (!SDL_ObjectValid(renderer, SDL_OBJECT_TYPE_RENDERER) || renderer->destroyed || !renderer->render_thread) {
+        return; // it went away in the meantime.
+    }
+    SDL_LockMutex(renderer->render_thread_lock);
+    PresentRenderThreadFrame(renderer);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+}
+
+static int SDLCALL SDL_RenderThread(void *data)
+{
+    SDL_Renderer *renderer = (SDL_Renderer *)data;
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    for (;;) {
+        while (!renderer->render_thread_busy && !renderer->render_thread_quit) {
+            SDL_WaitCondition(renderer->render_thread_cond, renderer->render_thread_lock);
+        }
+        if (!renderer->render_thread_busy) {
+            break;
+        }
+        SDL_UnlockMutex(renderer->render_thread_lock);
+
+        renderer->RunCommandQueue(renderer, renderer->render_thread_commands, renderer->render_thread_vertex_data, renderer->render_thread_vertex_data_used);
+
+        SDL_LockMutex(renderer->render_thread_lock);
+        renderer->render_thread_busy = false;
+        SDL_BroadcastCondition(renderer->render_thread_cond);
+        if (renderer->render_thread_present) {
+            renderer->render_thread_present_pending = true;
+            SDL_RunOnMainThread(PresentRenderThreadFrameOnMainThread, renderer, false);
+        }
+    }
+    SDL_UnlockMutex(renderer->render_thread_lock);
+    return 0;
+}
+
+// Take back the commands the render thread is done with.
+static void ReclaimRenderThreadCommands(SDL_Renderer *renderer)
+{
+    if (renderer->render_thread_commands) {
+        renderer->render_thread_commands_tail->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = renderer->render_thread_commands;
+        renderer->render_thread_commands = NULL;
+        renderer->render_thread_commands_tail = NULL;
+    }
+}
+
+// Wait for the render thread to finish drawing, and present what it drew if that's still pending.
+static void WaitRenderThread(SDL_Renderer *renderer)
+{
+    if (!renderer->render_thread) {
+        return;
+    }
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    while (renderer->render_thread_busy) {
+        SDL_WaitCondition(renderer->render_thread_cond, renderer->render_thread_lock);
+    }
+    ReclaimRenderThreadCommands(renderer);
+    PresentRenderThreadFrame(renderer);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+}
+
+static bool HandOverRenderCommands(SDL_Renderer *renderer, bool present)
+{
+    void *vertex_data;
+    size_t vertex_data_allocation;
+
+    WaitRenderThread(renderer);
+
+    if (!renderer->PrepareCommandQueue(renderer)) {
+        return false;
+    }
+
+    // the render thread draws from this vertex buffer, and the next queue goes in the one it's done with.
+    vertex_data = renderer->render_thread_vertex_data;
+    vertex_data_allocation = renderer->render_thread_vertex_data_allocation;
+    renderer->render_thread_vertex_data = renderer->vertex_data;
+    renderer->render_thread_vertex_data_allocation = renderer->vertex_data_allocation;
+    renderer->render_thread_vertex_data_used = renderer->vertex_data_used;
+    renderer->vertex_data = vertex_data;
+    renderer->vertex_data_allocation = vertex_data_allocation;
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    renderer->render_thread_commands = renderer->render_commands;
+    renderer->render_thread_commands_tail = renderer->render_commands_tail;
+    renderer->render_thread_generation = renderer->render_command_generation;
+    renderer->render_thread_present = present;
+    renderer->render_thread_busy = true;
+    SDL_BroadcastCondition(renderer->render_thread_cond);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    renderer->render_commands = NULL;
+    renderer->render_commands_tail = NULL;
+    return true;
+}
+
+static void StartRenderThread(SDL_Renderer *renderer)
+{
+    renderer->render_thread_lock = SDL_CreateMutex();
+    renderer->render_thread_cond = SDL_CreateCondition();
+    if (renderer->render_thread_lock && renderer->render_thread_cond) {
+        renderer->render_thread = SDL_CreateThread(SDL_RenderThread, "SDLRender", renderer);
+    }
+    if (!renderer->render_thread) {
+        // draw on the application thread instead.
+        SDL_DestroyCondition(renderer->render_thread_cond);
+        renderer->render_thread_cond = NULL;
+        SDL_DestroyMutex(renderer->render_thread_lock);
+        renderer->render_thread_lock = NULL;
+    }
+}
+
+static void StopRenderThread(SDL_Renderer *renderer)
+{
+    if (!renderer->render_thread) {
+        return;
+    }
+
+    SDL_LockMutex(renderer->render_thread_lock);
+    renderer->render_thread_quit = true;
+    SDL_BroadcastCondition(renderer->render_thread_cond);
+    SDL_UnlockMutex(renderer->render_thread_lock);
+
+    SDL_WaitThread(renderer->render_thread, NULL);
+    renderer->render_thread = NULL;
+
+    ReclaimRenderThreadCommands(renderer);
+    renderer->render_thread_present_pending = false;
+
+    SDL_DestroyCondition(renderer->render_thread_cond);
+    renderer->render_thread_cond = NULL;
+    SDL_DestroyMutex(renderer->render_thread_lock);
+    renderer->render_thread_lock = NULL;
+}
+
+// Render commands are handed out from blocks, and the vertex data is one buffer that grows as needed.
+// How much of both each frame needs is tracked, and memory is given back after the queue has needed a quarter
+// or less of it for a while, so a spike of draws doesn't keep its memory forever.
+
+#define SDL_RENDER_COMMAND_BLOCK_MIN 64
+#define SDL_RENDER_VERTEX_DATA_MIN   2048
+#define SDL_RENDER_QUEUE_TRIM_FRAMES 120
+
+static bool AllocateRenderCommandBlock(SDL_Renderer *renderer, int num_commands)
+{
+    SDL_RenderCommandBlock *block;
+    int i;
+
+    block = (SDL_RenderCommandBlock *)SDL_calloc(1, sizeof(*block) + num_commands * sizeof(SDL_RenderCommand));
+    if (!block) {
+        return false;
+    }
+    block->num_commands = num_commands;
+    block->next = renderer->render_command_blocks;
+    renderer->render_command_blocks = block;
+    renderer->render_commands_allocated += num_commands;
+
+    // add them to the pool so they're handed out in order.
+    for (i = num_commands - 1; i >= 0; --i) {
+        block->commands[i].next = renderer->render_commands_pool;
+        renderer->render_commands_pool = &block->commands[i];
+    }
+    return true;
+}
+
+static void FreeRenderCommandBlocks(SDL_Renderer *renderer)
+{
+    SDL_RenderCommandBlock *block = renderer->render_command_blocks;
+
+    while (block) {
+        SDL_RenderCommandBlock *next = block->next;
+        SDL_free(block);
+        block = next;
+    }
+    renderer->render_command_blocks = NULL;
+    renderer->render_commands_allocated = 0;
+    renderer->render_commands_pool = NULL;
+}
+
+// Get an unused render command, without adding it to the queue.
+static SDL_RenderCommand *GetRenderCommand(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *result = renderer->render_commands_pool;
+
+    if (!result) {
+        // double the number of commands, so a busy queue doesn't need many blocks.
+        if (!AllocateRenderCommandBlock(renderer, SDL_max(renderer->render_commands_allocated, SDL_RENDER_COMMAND_BLOCK_MIN))) {
+            return NULL;
+        }
+        result = renderer->render_commands_pool;
+    }
+    renderer->render_commands_pool = result->next;
+    result->next = NULL;
+    return result;
+}
+
+// This is called when the queue is empty, after the frame is presented.
+static void TrimRenderCommandQueue(SDL_Renderer *renderer)
+{
+    SDL_assert(renderer->render_commands == NULL);
+    SDL_assert(renderer->vertex_data_used == 0);
+
+    if (renderer->frame_vertex_data_peak <= renderer->vertex_data_allocation / 4 &&
+        renderer->frame_queued_commands_peak <= renderer->render_commands_allocated / 4) {
+        renderer->quiet_vertex_data_peak = SDL_max(renderer->quiet_vertex_data_peak, renderer->frame_vertex_data_peak);
+        renderer->quiet_queued_commands_peak = SDL_max(renderer->quiet_queued_commands_peak, renderer->frame_queued_commands_peak);
+        ++renderer->quiet_frames;
+    } else {
+        renderer->quiet_vertex_data_peak = 0;
+        renderer->quiet_queued_commands_peak = 0;
+        renderer->quiet_frames = 0;
+    }
+    renderer->frame_vertex_data_peak = 0;
+    renderer->frame_queued_commands_peak = 0;
+
+    if (renderer->quiet_frames < SDL_RENDER_QUEUE_TRIM_FRAMES) {
+        return;
+    }
+
+    // keep room for twice what the quiet frames needed.
+    if (renderer->vertex_data_allocation > SDL_RENDER_VERTEX_DATA_MIN) {
+        size_t newsize = SDL_RENDER_VERTEX_DATA_MIN;
+        void *ptr;
+
+        while (newsize < renderer->quiet_vertex_data_peak * 2) {
+            newsize *= 2;
+        }
+        if (newsize < renderer->vertex_data_allocation) {
+            ptr = SDL_realloc(renderer->vertex_data, newsize);
+            if (ptr) {
+                renderer->vertex_data = ptr;
+                renderer->vertex_data_allocation = newsize;
+            }
+        }
+    }
+    if (renderer->render_commands_allocated > SDL_RENDER_COMMAND_BLOCK_MIN) {
+        // once the render thread is done, every command is in the pool, so the blocks can all go.
+        WaitRenderThread(renderer);
+        FreeRenderCommandBlocks(renderer);
+        AllocateRenderCommandBlock(renderer, SDL_max(renderer->quiet_queued_commands_peak * 2, SDL_RENDER_COMMAND_BLOCK_MIN));
+    }
+
+    // the sort buffers are sized for the queue, so they can be allocated again when needed.
+    SDL_free(renderer->sorted_draws);
+    renderer->sorted_draws = NULL;
+    renderer->sorted_draws_allocation = 0;
+    SDL_free(renderer->sorted_vertex_data);
+    renderer->sorted_vertex_data = NULL;
+    renderer->sorted_vertex_data_allocation = 0;
+
+    renderer->quiet_vertex_data_peak = 0;
+    renderer->quiet_queued_commands_peak = 0;
+    renderer->quiet_frames = 0;
+}
+
+static size_t GetRenderCommandQueueMemory(SDL_Renderer *renderer)
+{
+    return renderer->vertex_data_allocation +
+           renderer->render_thread_vertex_data_allocation +
+           renderer->render_commands_allocated * sizeof(SDL_RenderCommand) +
+           renderer->sorted_draws_allocation +
+           renderer->sorted_vertex_data_allocation;
+}
+
+// Reordering draws in SDL_RENDER_BATCH_UNORDERED mode.
+//
+// The queue is split into runs of draws (and the draw colors they set), ended by anything that changes other state
+// or starts a layer. Each run is sorted by texture and state, and the vertex data of the run is moved into the new
+// order, so backends that combine consecutive draws with the same state find their vertices next to each other.
+// Consecutive geometry with the same state is combined into one command here, and draw colors are queued again
+// wherever the sorted draws need them.
+
+typedef struct SDL_SortedDraw
+{
+    SDL_RenderCommand *cmd;
+    size_t index; // position in the queue, so draws with the same state keep their order.
+    size_t first; // where the vertex data goes.
+} SDL_SortedDraw;
+
+typedef struct SDL_QueuedDrawColor
+{
+    bool valid;
+    SDL_FColor color;
+    float color_scale;
+} SDL_QueuedDrawColor;
+
+static bool IsReorderableDraw(const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_COPY_EX:
+    case SDL_RENDERCMD_GEOMETRY:
+        return (cmd->data.draw.vertex_size != SDL_SIZE_MAX);
+    default:
+        return false;
+    }
+}
+
+// geometry has its colors in the vertices, everything else uses the last SDL_RENDERCMD_SETDRAWCOLOR.
+static bool DrawUsesDrawColor(const SDL_RenderCommand *cmd)
+{
+    return (cmd->command != SDL_RENDERCMD_GEOMETRY);
+}
+
+static bool DrawColorMatches(const SDL_QueuedDrawColor *state, const SDL_FColor *color, float color_scale)
+{
+    return state->valid &&
+           state->color.r == color->r &&
+           state->color.g == color->g &&
+           state->color.b == color->b &&
+           state->color.a == color->a &&
+           state->color_scale == color_scale;
+}
+
+static int CompareDrawState(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+#define COMPARE_DRAW_FIELD(field)                        \
+    if (a->data.draw.field != b->data.draw.field) {      \
+        return (a->data.draw.field < b->data.draw.field) ? -1 : 1; \
+    }
+
+    if (a->data.draw.texture != b->data.draw.texture) {
+        return ((uintptr_t)a->data.draw.texture < (uintptr_t)b->data.draw.texture) ? -1 : 1;
+    }
+    if (a->command != b->command) {
+        return (a->command < b->command) ? -1 : 1;
+    }
+    COMPARE_DRAW_FIELD(blend);
+    if (a->data.draw.texture) {
+        COMPARE_DRAW_FIELD(texture_scale_mode);
+    }
+    COMPARE_DRAW_FIELD(texture_address_mode_u);
+    COMPARE_DRAW_FIELD(texture_address_mode_v);
+    if (a->data.draw.gpu_render_state != b->data.draw.gpu_render_state) {
+        return ((uintptr_t)a->data.draw.gpu_render_state < (uintptr_t)b->data.draw.gpu_render_state) ? -1 : 1;
+    }
+    COMPARE_DRAW_FIELD(color_scale);
+    COMPARE_DRAW_FIELD(color.r);
+    COMPARE_DRAW_FIELD(color.g);
+    COMPARE_DRAW_FIELD(color.b);
+    COMPARE_DRAW_FIELD(color.a);
+    return 0;
+
+#undef COMPARE_DRAW_FIELD
+}
+
+static int SDLCALL CompareSortedDraws(const void *a, const void *b)
+{
+    const SDL_SortedDraw *A = (const SDL_SortedDraw *)a;
+    const SDL_SortedDraw *B = (const SDL_SortedDraw *)b;
+    const int result = CompareDrawState(A->cmd, B->cmd);
+
+    if (result != 0) {
+        return result;
+    }
+    return (A->index < B->index) ? -1 : 1;
+}
+
+static void *GetSortScratch(void **buffer, size_t *allocation, size_t size)
+{
+    if (*allocation < size) {
+        void *ptr = SDL_realloc(*buffer, size);
+        if (!ptr) {
+            return NULL;
+        }
+        *buffer = ptr;
+        *allocation = size;
+    }
+    return *buffer;
+}
+
+static void SetDrawColorCommand(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const SDL_FColor *color, float color_scale)
+{
+    cmd->command = SDL_RENDERCMD_SETDRAWCOLOR;
+    cmd->data.color.first = 0; // render backend will fill this in.
+    cmd->data.color.color_scale = color_scale;
+    cmd->data.color.color = *color;
+    if (!renderer->QueueSetDrawColor(renderer, cmd)) {
+        cmd->command = SDL_RENDERCMD_NO_OP;
+    }
+}
+
+// Sort the commands from run up to end, returning the new first command. state is the draw color before the run, and is updated to the draw color after it.
+static SDL_RenderCommand *SortRenderCommandRun(SDL_Renderer *renderer, SDL_RenderCommand *run, SDL_RenderCommand *end, int num_draws, SDL_QueuedDrawColor *state)
 {
+    SDL_SortedDraw *draws;
+    SDL_RenderCommand *cmd, *prev;
+    SDL_RenderCommand *spare = NULL;
+    SDL_RenderCommand *head = NULL;
+    SDL_RenderCommand **link = &head;
+    SDL_QueuedDrawColor final_state = *state;
+    SDL_QueuedDrawColor current;
+    Uint8 *vertices = (Uint8 *)renderer->vertex_data;
+    Uint8 *scratch = NULL;
+    size_t lo = SDL_SIZE_MAX, hi = 0, offset;
+    int i, n = 0, num_colors = 0, num_spare = 0;
+
+    // the draw color the backend has after the run, in queue order.
+    for (cmd = run; cmd != end; cmd = cmd->next) {
+        if (cmd->command == SDL_RENDERCMD_SETDRAWCOLOR) {
+            final_state.valid = true;
+            final_state.color = cmd->data.color.color;
+            final_state.color_scale = cmd->data.color.color_scale;
+            ++num_spare;
+        }
+    }
+
+    if (num_draws < 2) {
+        goto unsorted;
+    }
+
+    draws = (SDL_SortedDraw *)GetSortScratch(&renderer->sorted_draws, &renderer->sorted_draws_allocation, num_draws * sizeof(*draws));
+    if (!draws) {
+        goto unsorted;
+    }
+    for (cmd = run; cmd != end; cmd = cmd->next) {
+        if (cmd->command != SDL_RENDERCMD_SETDRAWCOLOR) {
+            draws[n].cmd = cmd;
+            draws[n].index = n;
+            if (cmd->data.draw.vertex_size > 0) {
+                lo = SDL_min(lo, cmd->data.draw.first);
+                hi = SDL_max(hi, cmd->data.draw.first + cmd->data.draw.vertex_size);
+            }
+            ++n;
+        }
+    }
+    SDL_assert(n == num_draws);
+
+    SDL_qsort(draws, n, sizeof(*draws), CompareSortedDraws);
+
+    // find where each draw's vertex data goes, with the alignment the backend asked for.
+    offset = lo;
+    for (i = 0; i < n; i++) {
+        const size_t size = draws[i].cmd->data.draw.vertex_size;
+        const size_t alignment = draws[i].cmd->data.draw.vertex_alignment;
+        if (size == 0) {
+            draws[i].first = draws[i].cmd->data.draw.first;
+            continue;
+        }
+        if (alignment && (offset & (alignment - 1)) != 0) {
+            offset += alignment - (offset & (alignment - 1));
+        }
+        draws[i].first = offset;
+        offset += size;
+    }
+    if (hi > lo) {
+        if (offset > hi) {
+            goto unsorted; // the new order needs more padding than there is room for.
+        }
+        scratch = (Uint8 *)GetSortScratch(&renderer->sorted_vertex_data, &renderer->sorted_vertex_data_allocation, hi - lo);
+        if (!scratch) {
+            goto unsorted;
+        }
+    }
+
+    // make sure there are enough commands to set the draw color wherever it changes.
+    current = *state;
+    for (i = 0; i < n; i++) {
+        cmd = draws[i].cmd;
+        if (DrawUsesDrawColor(cmd) && !DrawColorMatches(&current, &cmd->data.draw.color, cmd->data.draw.color_scale)) {
+            current.valid = true;
+            current.color = cmd->data.draw.color;
+            current.color_scale = cmd->data.draw.color_scale;
+            ++num_colors;
+        }
+    }
+    if (final_state.valid && !DrawColorMatches(&current, &final_state.color, final_state.color_scale)) {
+        ++num_colors;
+    }
+    while (num_spare < num_colors) {
+        cmd = GetRenderCommand(renderer);
+        if (!cmd) {
+            break;
+        }
+        cmd->next = spare;
+        spare = cmd;
+        ++num_spare;
+    }
+    if (num_spare < num_colors) {
+        goto unsorted;
+    }
+
+    // everything needed is here, move the vertex data and the commands into the new order.
+    for (cmd = run; cmd != end; cmd = cmd->next) {
+        if (cmd->command == SDL_RENDERCMD_SETDRAWCOLOR) {
+            cmd->command = SDL_RENDERCMD_NO_OP; // it's on the spare list now.
+        }
+    }
+    for (cmd = run; cmd != end;) {
+        SDL_RenderCommand *next = cmd->next;
+        if (cmd->command == SDL_RENDERCMD_NO_OP) {
+            cmd->next = spare;
+            spare = cmd;
+        }
+        cmd = next;
+    }
+    if (scratch) {
+        SDL_memcpy(scratch, vertices + lo, hi - lo);
+        for (i = 0; i < n; i++) {
+            cmd = draws[i].cmd;
+            if (cmd->data.draw.vertex_size > 0) {
+                SDL_memcpy(vertices + draws[i].first, scratch + (cmd->data.draw.first - lo), cmd->data.draw.vertex_size);
+                cmd->data.draw.first = draws[i].first;
+            }
+        }
+    }
+
+    current = *state;
+    prev = NULL;
+    for (i = 0; i < n; i++) {
+        cmd = draws[i].cmd;
+        if (prev && cmd->command == SDL_RENDERCMD_GEOMETRY && CompareDrawState(prev, cmd) == 0 &&
+            prev->data.draw.first + prev->data.draw.vertex_size == cmd->data.draw.first) {
+            prev->data.draw.count += cmd->data.draw.count;
+            prev->data.draw.vertex_size += cmd->data.draw.vertex_size;
+            cmd->next = renderer->render_commands_pool;
+            renderer->render_commands_pool = cmd;
+            ++renderer->frame_merged_draws;
+            continue;
+        }
+        if (DrawUsesDrawColor(cmd) && !DrawColorMatches(&current, &cmd->data.draw.color, cmd->data.draw.color_scale)) {
+            SDL_RenderCommand *color = spare;
+            spare = spare->next;
+            SetDrawColorCommand(renderer, color, &cmd->data.draw.color, cmd->data.draw.color_scale);
+            current.valid = true;
+            current.color = cmd->data.draw.color;
+            current.color_scale = cmd->data.draw.color_scale;
+            *link = color;
+            link = &color->next;
+        }
+        *link = cmd;
+        link = &cmd->next;
+        prev = cmd;
+    }
+    if (final_state.valid && !DrawColorMatches(&current, &final_state.color, final_state.color_scale)) {
+        SDL_RenderCommand *color = spare;
+        spare = spare->next;
+        SetDrawColorCommand(renderer, color, &final_state.color, final_state.color_scale);
+        *link = color;
+        link = &color->next;
+        current = final_state;
+    }
+    *link = end;
+
+    while (spare) {
+        cmd = spare;
+        spare = spare->next;
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+    }
+
+    *state = current;
+    return head;
+
+unsorted:
+    while (spare) {
+        cmd = spare;
+        spare = spare->next;
+        cmd->next = renderer->render_commands_pool;
+        renderer->render_commands_pool = cmd;
+    }
+    *state = final_state;
+    return run;
+}
+
+static void SortRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd = renderer->render_commands;
+    SDL_RenderCommand *prev = NULL;
+    SDL_QueuedDrawColor state;
+
+    SDL_zero(state);
+
+    while (cmd) {
+        if (IsReorderableDraw(cmd) || cmd->command == SDL_RENDERCMD_SETDRAWCOLOR) {
+            SDL_RenderCommand *end = cmd;
+            SDL_RenderCommand *head;
+            int num_draws = 0;
+
+            while (end && (IsReorderableDraw(end) || end->command == SDL_RENDERCMD_SETDRAWCOLOR)) {
+                if (end->command != SDL_RENDERCMD_SETDRAWCOLOR) {
+                    ++num_draws;
+                }
+                end = end->next;
+            }
+
+            head = SortRenderCommandRun(renderer, cmd, end, num_draws, &state);
+            if (prev) {
+                prev->next = head;
+            } else {
+                renderer->render_commands = head;
+            }
+            for (prev = head; prev->next != end; prev = prev->next) {
+            }
+            cmd = end;
+        } else {
+            prev = cmd;
+            cmd = cmd->next;
+        }
+    }
+    renderer->render_commands_tail = prev;
+}
+
+static bool SubmitRenderCommands(SDL_Renderer *renderer, bool present)
+{
+    SDL_RenderCommand *cmd;
+    int num_commands;
     bool result;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -318,9 +947,25 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
         return true;
     }
 
+    if (renderer->batch_mode == SDL_RENDER_BATCH_UNORDERED) {
+        SortRenderCommands(renderer);
+    }
+
     DebugLogRenderCommands(renderer->render_commands);
 
-    result = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    num_commands = 0;
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        ++num_commands;
+    }
+    renderer->frame_commands += num_commands;
+    renderer->frame_queued_commands_peak = SDL_max(renderer->frame_queued_commands_peak, num_commands);
+    renderer->frame_vertex_data_peak = SDL_max(renderer->frame_vertex_data_peak, renderer->vertex_data_used);
+
+    if (renderer->render_thread) {
+        result = HandOverRenderCommands(renderer, present);
+    } else {
+        result = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    }
 
     // Move the whole render command queue to the unused pool so we can reuse them next time.
     if (renderer->render_commands_tail) {
@@ -337,12 +982,31 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
     return result;
 }
 
+static bool FlushRenderCommands(SDL_Renderer *renderer)
+{
+    return SubmitRenderCommands(renderer, false);
+}
+
+// Flush the queue and wait until it's drawn, for anything that needs the results or the backend to itself.
+static bool FinishRenderCommands(SDL_Renderer *renderer)
+{
+    bool result = FlushRenderCommands(renderer);
+    WaitRenderThread(renderer);
+    return result;
+}
+
 static bool FlushRenderCommandsIfTextureNeeded(SDL_Texture *texture)
 {
     SDL_Renderer *renderer = texture->renderer;
     if (texture->last_command_generation == renderer->render_command_generation) {
         // the current command queue depends on this texture, flush the queue now before it changes
-        return FlushRenderCommands(renderer);
+        if (!FlushRenderCommands(renderer)) {
+            return false;
+        }
+    }
+    if (renderer->render_thread && texture->last_command_generation == renderer->render_thread_generation) {
+        // the render thread may still be drawing with it
+        WaitRenderThread(renderer);
     }
     return true;
 }
@@ -359,7 +1023,7 @@ static bool FlushRenderCommandsIfGPURenderStateNeeded(SDL_GPURenderState *state)
 
 bool SDL_FlushRenderer(SDL_Renderer *renderer)
 {
-    if (!FlushRenderCommands(renderer)) {
+    if (!FinishRenderCommands(renderer)) {
         return false;
     }
     renderer->InvalidateCachedState(renderer);
@@ -375,7 +1039,7 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t
     const size_t aligned = current_offset + aligner;
 
     if (renderer->vertex_data_allocation < needed) {
-        const size_t current_allocation = renderer->vertex_data ? renderer->vertex_data_allocation : 1024;
+        const size_t current_allocation = renderer->vertex_data ? renderer->vertex_data_allocation : (SDL_RENDER_VERTEX_DATA_MIN / 2);
         size_t newsize = current_allocation * 2;
         void *ptr;
         while (newsize < needed) {
@@ -396,23 +1060,17 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t
     }
 
     renderer->vertex_data_used += aligner + numbytes;
+    renderer->vertex_data_alignment = SDL_max(renderer->vertex_data_alignment, alignment);
 
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
-    SDL_RenderCommand *result = NULL;
+    SDL_RenderCommand *result = GetRenderCommand(renderer);
 
-    result = renderer->render_commands_pool;
-    if (result) {
-        renderer->render_commands_pool = result->next;
-        result->next = NULL;
-    } else {
-        result = (SDL_RenderCommand *)SDL_calloc(1, sizeof(*result));
-        if (!result) {
-            return NULL;
-        }
+    if (!result) {
+        return NULL;
     }
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -426,6 +1084,59 @@ static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
     return result;
 }
 
+bool SDL_SetRenderBatchMode(SDL_Renderer *renderer, SDL_RenderBatchMode mode)
+{
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (mode != SDL_RENDER_BATCH_ORDERED && mode != SDL_RENDER_BATCH_UNORDERED) {
+        return SDL_InvalidParamError("mode");
+    }
+
+    if (mode != renderer->batch_mode) {
+        // draws already queued keep the ordering they were made with
+        if (!FlushRenderCommands(renderer)) {
+            return false;
+        }
+        renderer->batch_mode = mode;
+    }
+    return true;
+}
+
+bool SDL_GetRenderBatchMode(SDL_Renderer *renderer, SDL_RenderBatchMode *mode)
+{
+    if (mode) {
+        *mode = SDL_RENDER_BATCH_ORDERED;
+    }
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (mode) {
+        *mode = renderer->batch_mode;
+    }
+    return true;
+}
+
+bool SDL_StartRenderLayer(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (renderer->batch_mode != SDL_RENDER_BATCH_UNORDERED ||
+        !renderer->render_commands_tail ||
+        renderer->render_commands_tail->command == SDL_RENDERCMD_NO_OP) {
+        return true; // nothing to keep apart.
+    }
+
+    // draws are never moved across a no-op, so it works as the layer boundary.
+    cmd = AllocateRenderCommand(renderer);
+    if (!cmd) {
+        return false;
+    }
+    cmd->command = SDL_RENDERCMD_NO_OP;
+    return true;
+}
+
 static void UpdatePixelViewport(SDL_Renderer *renderer, SDL_RenderViewState *view)
 {
     view->pixel_viewport.x = (int)SDL_floorf((view->viewport.x * view->current_scale.x) + view->logical_offset.x);
@@ -580,6 +1291,8 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
             cmd->command = cmdtype;
             cmd->data.draw.first = 0; // render backend will fill this in.
             cmd->data.draw.count = 0; // render backend will fill this in.
+            cmd->data.draw.vertex_size = renderer->vertex_data_used; // until FinishQueueCmdDraw(), where the vertex data can start.
+            renderer->vertex_data_alignment = 0;
             cmd->data.draw.color_scale = renderer->color_scale;
             cmd->data.draw.color = *color;
             cmd->data.draw.blend = blendMode;
@@ -598,6 +1311,20 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
     return cmd;
 }
 
+// Remember where the backend put a draw's vertex data, so it can be moved when reordering draws.
+static void FinishQueueCmdDraw(SDL_Renderer *renderer, SDL_RenderCommand *cmd)
+{
+    const size_t start = cmd->data.draw.vertex_size;
+    const size_t first = cmd->data.draw.first;
+
+    if (first >= start && first <= renderer->vertex_data_used) {
+        cmd->data.draw.vertex_size = renderer->vertex_data_used - first;
+    } else {
+        cmd->data.draw.vertex_size = SDL_SIZE_MAX; // not in vertex_data, it can't be moved.
+    }
+    cmd->data.draw.vertex_alignment = renderer->vertex_data_alignment;
+}
+
 static bool QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
@@ -607,6 +1334,7 @@ static bool QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points,
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -620,6 +1348,7 @@ static bool QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points,
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -693,6 +1422,7 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
                 cmd->command = SDL_RENDERCMD_NO_OP;
             }
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -706,6 +1436,7 @@ static bool QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -721,6 +1452,7 @@ static bool QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -748,6 +1480,7 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
         }
+        FinishQueueCmdDraw(renderer, cmd);
     }
     return result;
 }
@@ -853,6 +1586,7 @@ static bool SDL_RendererEventWatch(void *userdata, SDL_Event *event)
     }
 
     if (renderer->WindowEvent) {
+        WaitRenderThread(renderer);
         renderer->WindowEvent(renderer, &event->window);
     }
 
@@ -1149,6 +1883,11 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
     SDL_SetRenderVSync(renderer, vsync);
     SDL_CalculateSimulatedVSyncInterval(renderer, window);
 
+    if (SDL_GetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN, false) && renderer->PrepareCommandQueue) {
+        StartRenderThread(renderer);
+    }
+    SDL_SetBooleanProperty(new_props, SDL_PROP_RENDERER_THREADED_BOOLEAN, renderer->render_thread != NULL);
+
     SDL_LogInfo(SDL_LOG_CATEGORY_RENDER,
                 "Created renderer: %s", renderer->name);
 
@@ -2583,7 +3322,7 @@ bool SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         return true;
     }
 
-    FlushRenderCommands(renderer); // time to send everything to the GPU!
+    FinishRenderCommands(renderer); // time to send everything to the GPU!
 
     SDL_LockMutex(renderer->target_mutex);
 
@@ -5283,7 +6022,7 @@ SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
         return NULL;
     }
 
-    FlushRenderCommands(renderer); // we need to render before we read the results.
+    FinishRenderCommands(renderer); // we need to render before we read the results.
 
     SDL_Rect real_rect = renderer->view->pixel_viewport;
 
@@ -5378,6 +6117,8 @@ static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 bool SDL_RenderPresent(SDL_Renderer *renderer)
 {
     bool presented = true;
+    bool present = true;
+    bool handed_over = false;
 
     CHECK_RENDERER_MAGIC(renderer, false);
 
@@ -5391,8 +6132,30 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
         SDL_RenderApplyWindowShape(renderer);
     }
 
-    FlushRenderCommands(renderer); // time to send everything to the GPU!
+    if (renderer->render_thread && renderer->render_commands) {
+        // the render thread draws the frame and has it presented while the next one is built.
+        present = true;
+#if DONT_DRAW_WHILE_HIDDEN
+        present = !renderer->hidden;
+#endif
+        handed_over = SubmitRenderCommands(renderer, present);
+    } else {
+        FlushRenderCommands(renderer); // time to send everything to the GPU!
+        WaitRenderThread(renderer);
+    }
+
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, (Sint64)renderer->frame_commands);
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER, (Sint64)renderer->frame_merged_draws);
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, (Sint64)renderer->frame_vertex_data_peak);
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_FRAME_QUEUED_COMMANDS_NUMBER, renderer->frame_queued_commands_peak);
+    renderer->frame_commands = 0;
+    renderer->frame_merged_draws = 0;
+    TrimRenderCommandQueue(renderer);
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_QUEUE_MEMORY_NUMBER, (Sint64)GetRenderCommandQueueMemory(renderer));
 
+    if (handed_over) {
+        presented = present;
+    } else
 #if DONT_DRAW_WHILE_HIDDEN
     // Don't present while we're hidden
     if (renderer->hidden) {
@@ -5448,6 +6211,9 @@ static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying)
 #endif
     SDL_free(texture->pixels);
 
+    // the backend may share per-renderer state between its textures and the render thread, even when this texture isn't being drawn
+    WaitRenderThread(renderer);
+
     renderer->DestroyTexture(renderer, texture);
 
     SDL_DestroySurface(texture->locked_surface);
@@ -5469,27 +6235,15 @@ void SDL_DestroyTexture(SDL_Texture *texture)
 
 static void SDL_DiscardAllCommands(SDL_Renderer *renderer)
 {
-    SDL_RenderCommand *cmd;
-
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
-    }
-
-    renderer->render_commands_pool = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
     renderer->vertex_data_used = 0;
 
-    while (cmd) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
-    }
+    FreeRenderCommandBlocks(renderer);
 }
 
+static void ClearDebugTextCache(SDL_Renderer *renderer);
+
 void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 {
     SDL_assert(renderer != NULL);
@@ -5511,8 +6265,10 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         // Make sure all drawing to a surface is complete
         FlushRenderCommands(renderer);
     }
+    StopRenderThread(renderer);
     SDL_DiscardAllCommands(renderer);
 
+    ClearDebugTextCache(renderer);
     if (renderer->debug_char_texture_atlas) {
         SDL_DestroyTexture(renderer->debug_char_texture_atlas);
         renderer->debug_char_texture_atlas = NULL;
@@ -5538,6 +6294,18 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_free(renderer->vertex_data);
         renderer->vertex_data = NULL;
     }
+    if (renderer->render_thread_vertex_data) {
+        SDL_free(renderer->render_thread_vertex_data);
+        renderer->render_thread_vertex_data = NULL;
+    }
+    if (renderer->sorted_vertex_data) {
+        SDL_free(renderer->sorted_vertex_data);
+        renderer->sorted_vertex_data = NULL;
+    }
+    if (renderer->sorted_draws) {
+        SDL_free(renderer->sorted_draws);
+        renderer->sorted_draws = NULL;
+    }
     if (renderer->texture_formats) {
         SDL_free(renderer->texture_formats);
         renderer->texture_formats = NULL;
@@ -5584,7 +6352,7 @@ void *SDL_GetRenderMetalLayer(SDL_Renderer *renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalLayer) {
-        FlushRenderCommands(renderer); // in case the app is going to mess with it.
+        FinishRenderCommands(renderer); // in case the app is going to mess with it.
         return renderer->GetMetalLayer(renderer);
     }
     return NULL;
@@ -5595,7 +6363,7 @@ void *SDL_GetRenderMetalCommandEncoder(SDL_Renderer *renderer)
     CHECK_RENDERER_MAGIC(renderer, NULL);
 
     if (renderer->GetMetalCommandEncoder) {
-        FlushRenderCommands(renderer); // in case the app is going to mess with it.
+        FinishRenderCommands(renderer); // in case the app is going to mess with it.
         return renderer->GetMetalCommandEncoder(renderer);
     }
     return NULL;
@@ -5713,6 +6481,8 @@ bool SDL_SetRenderVSync(SDL_Renderer *renderer, int vsync)
 {
     CHECK_RENDERER_MAGIC(renderer, false);
 
+    WaitRenderThread(renderer);
+
     renderer->wanted_vsync = vsync ? true : false;
 
     // for the software renderer, forward the call to the WindowTexture renderer
@@ -5766,6 +6536,34 @@ bool SDL_GetRenderVSync(SDL_Renderer *renderer, int *vsync)
 
 #define SDL_DEBUG_FONT_GLYPHS_PER_ROW 14
 
+// Strings longer than this aren't kept in the debug text cache
+#define SDL_DEBUG_TEXT_CACHE_MAX_LENGTH 256
+
+// How many entries in the debug text cache a string can go in
+#define SDL_DEBUG_TEXT_CACHE_WAYS 8
+
+// Draws a glyph from the font into a 32-bit surface, with the glyph's top-left corner at linepos.
+static void DrawDebugGlyph(Uint8 *linepos, int pitch, int glyph)
+{
+    const int charWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const int charHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const Uint8 *charpos = SDL_RenderDebugTextFontData + (glyph * 8);
+
+    for (int iy = 0; iy < charHeight; iy++) {
+        Uint32 *curpos = (Uint32 *)linepos;
+        for (int ix = 0; ix < charWidth; ix++) {
+            if ((*charpos) & (1 << ix)) {
+                *curpos = 0xffffffff;
+            } else {
+                *curpos = 0;
+            }
+            ++curpos;
+        }
+        linepos += pitch;
+        ++charpos;
+    }
+}
+
 static bool CreateDebugTextAtlas(SDL_Renderer *renderer)
 {
     SDL_assert(renderer->debug_char_texture_atlas == NULL);  // don't double-create it!
@@ -5788,22 +6586,9 @@ static bool CreateDebugTextAtlas(SDL_Renderer *renderer)
     for (int glyph = 0; glyph < SDL_DEBUG_FONT_NUM_GLYPHS; glyph++) {
         // find top-left of this glyph in destination surface. The +2's account for glyph padding.
         Uint8 *linepos = (((Uint8 *)atlas->pixels) + ((row * (charHeight + 2) + 1) * pitch)) + ((column * (charWidth + 2) + 1) * sizeof (Uint32));
-        const Uint8 *charpos = SDL_RenderDebugTextFontData + (glyph * 8);
 
         // Draw the glyph to the surface...
-        for (int iy = 0; iy < charHeight; iy++) {
-            Uint32 *curpos = (Uint32 *)linepos;
-            for (int ix = 0; ix < charWidth; ix++) {
-                if ((*charpos) & (1 << ix)) {
-                    *curpos = 0xffffffff;
-                } else {
-                    *curpos = 0;
-                }
-                ++curpos;
-            }
-            linepos += pitch;
-            ++charpos;
-        }
+        DrawDebugGlyph(linepos, pitch, glyph);
 
         // move to next position (and if too far, start the next row).
         column++;
@@ -5826,38 +6611,338 @@ static bool CreateDebugTextAtlas(SDL_Renderer *renderer)
     return texture != NULL;
 }
 
-static bool DrawDebugCharacter(SDL_Renderer *renderer, float x, float y, Uint32 c)
+// Returns the glyph used for a character, or -1 if the character is blank.
+static int GetDebugGlyph(Uint32 c)
 {
-    SDL_assert(renderer->debug_char_texture_atlas != NULL);   // should have been created by now!
+    if ((c <= 32) || ((c >= 127) && (c <= 160))) {
+        return -1;  // these are just completely blank chars, don't bother doing anything.
+    } else if (c >= SDL_DEBUG_FONT_NUM_GLYPHS) {
+        return SDL_DEBUG_FONT_NUM_GLYPHS - 1;  // use our "not a valid/supported character" glyph.
+    } else if (c < 127) {
+        return (int)c - 33;     // adjust for the 33 blank glyphs at the start
+    } else {
+        return (int)c - 67;     // adjust for the 33 blank glyphs at the start AND the 34 gap in the middle.
+    }
+}
 
+static void GetDebugGlyphRect(int glyph, SDL_FRect *rect)
+{
     const int charWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
     const int charHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
 
-    // Character index in cache
-    Uint32 ci = c;
-    if ((ci <= 32) || ((ci >= 127) && (ci <= 160))) {
-        return true;  // these are just completely blank chars, don't bother doing anything.
-    } else if (ci >= SDL_DEBUG_FONT_NUM_GLYPHS) {
-        ci = SDL_DEBUG_FONT_NUM_GLYPHS - 1;  // use our "not a valid/supported character" glyph.
-    } else if (ci < 127) {
-        ci -= 33;     // adjust for the 33 blank glyphs at the start
-    } else {
-        ci -= 67;     // adjust for the 33 blank glyphs at the start AND the 34 gap in the middle.
-    }
+    rect->x = (float) (((glyph % SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charWidth + 2)) + 1);
+    rect->y = (float) (((glyph / SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charHeight + 2)) + 1);
+    rect->w = (float) charWidth;
+    rect->h = (float) charHeight;
+}
 
-    const float src_x = (float) (((ci % SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charWidth + 2)) + 1);
-    const float src_y = (float) (((ci / SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charHeight + 2)) + 1);
+static bool DrawDebugCharacter(SDL_Renderer *renderer, float x, float y, int glyph)
+{
+    SDL_assert(renderer->debug_char_texture_atlas != NULL);   // should have been created by now!
 
     // Draw texture onto destination
-    const SDL_FRect srect = { src_x, src_y, (float) charWidth, (float) charHeight };
-    const SDL_FRect drect = { x, y, (float) charWidth, (float) charHeight };
+    SDL_FRect srect;
+    GetDebugGlyphRect(glyph, &srect);
+    const SDL_FRect drect = { x, y, srect.w, srect.h };
     return SDL_RenderTexture(renderer, renderer->debug_char_texture_atlas, &srect, &drect);
 }
 
+// Returns the number of glyphs in the text, and its width in pixels, including blank characters.
+static int CountDebugTextGlyphs(const char *s, int *width)
+{
+    int num_glyphs = 0;
+    int num_chars = 0;
+    Uint32 ch;
+
+    while ((ch = SDL_StepUTF8(&s, NULL)) != 0) {
+        if (GetDebugGlyph(ch) >= 0) {
+            ++num_glyphs;
+        }
+        ++num_chars;
+    }
+    *width = num_chars * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    return num_glyphs;
+}
+
+// Fills in four vertices and six indices for each glyph in the text, with the top-left corner of the text at (x, y).
+static void BuildDebugTextGeometry(SDL_Renderer *renderer, const char *s, float x, float y, float *xy, float *uv, int *indices)
+{
+    const float atlas_w = (float)renderer->debug_char_texture_atlas->w;
+    const float atlas_h = (float)renderer->debug_char_texture_atlas->h;
+    int first = 0;
+    Uint32 ch;
+
+    while ((ch = SDL_StepUTF8(&s, NULL)) != 0) {
+        const int glyph = GetDebugGlyph(ch);
+        if (glyph >= 0) {
+            SDL_FRect srect;
+            GetDebugGlyphRect(glyph, &srect);
+
+            const float minu = srect.x / atlas_w;
+            const float minv = srect.y / atlas_h;
+            const float maxu = (srect.x + srect.w) / atlas_w;
+            const float maxv = (srect.y + srect.h) / atlas_h;
+            const float maxx = x + srect.w;
+            const float maxy = y + srect.h;
+
+            *uv++ = minu;
+            *uv++ = minv;
+            *uv++ = maxu;
+            *uv++ = minv;
+            *uv++ = maxu;
+            *uv++ = maxv;
+            *uv++ = minu;
+            *uv++ = maxv;
+
+            *xy++ = x;
+            *xy++ = y;
+            *xy++ = maxx;
+            *xy++ = y;
+            *xy++ = maxx;
+            *xy++ = maxy;
+            *xy++ = x;
+            *xy++ = maxy;
+
+            for (int i = 0; i < SDL_arraysize(rect_index_order); ++i) {
+                *indices++ = first + rect_index_order[i];
+            }
+            first += 4;
+        }
+        x += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    }
+}
+
+// The software renderer would split the batch back into one copy per glyph, so it draws each line as a texture instead.
+static bool CanBatchDebugText(SDL_Renderer *renderer)
+{
+    return renderer->QueueGeometry && !renderer->software;
+}
+
+static bool QueueDebugTextGeometry(SDL_Renderer *renderer, const float *xy, const float *uv, const int *indices, int num_glyphs)
+{
+    SDL_Texture *texture = renderer->debug_char_texture_atlas;
+    const SDL_RenderViewState *view = renderer->view;
+    SDL_FColor color;
+    Uint8 r, g, b, a;
+
+    if (num_glyphs == 0) {
+        return true;
+    }
+
+    // Use the same color the texture color and alpha mod would have in SDL_RenderTexture()
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    color.r = (float)r / 255.0f;
+    color.g = (float)g / 255.0f;
+    color.b = (float)b / 255.0f;
+    color.a = (float)a / 255.0f;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+    texture->last_command_generation = renderer->render_command_generation;
+
+    return QueueCmdGeometry(renderer, texture,
+                            xy, 2 * sizeof(float), &color, 0 /* color_stride */, uv, 2 * sizeof(float),
+                            num_glyphs * 4, indices, num_glyphs * 6, sizeof(int),
+                            view->current_scale.x, view->current_scale.y,
+                            SDL_TEXTURE_ADDRESS_CLAMP, SDL_TEXTURE_ADDRESS_CLAMP);
+}
+
+static SDL_Texture *CreateDebugTextRunTexture(SDL_Renderer *renderer, const char *s, int width)
+{
+    SDL_Surface *surface = SDL_CreateSurface(width, SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE, SDL_PIXELFORMAT_RGBA8888);
+    if (!surface) {
+        return NULL;
+    }
+    SDL_memset(surface->pixels, '\0', surface->h * surface->pitch);
+
+    Uint8 *linepos = (Uint8 *)surface->pixels;
+    Uint32 ch;
+    while ((ch = SDL_StepUTF8(&s, NULL)) != 0) {
+        const int glyph = GetDebugGlyph(ch);
+        if (glyph >= 0) {
+            DrawDebugGlyph(linepos, surface->pitch, glyph);
+        }
+        linepos += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * sizeof (Uint32);
+    }
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (texture) {
+        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_PIXELART);
+    }
+    SDL_DestroySurface(surface);
+
+    return texture;
+}
+
+static SDL_DebugTextRun *CreateDebugTextRun(SDL_Renderer *renderer, const char *s)
+{
+    SDL_DebugTextRun *run = (SDL_DebugTextRun *)SDL_calloc(1, sizeof(*run));
+    if (!run) {
+        return NULL;
+    }
+    run->renderer = renderer;
+    run->num_glyphs = CountDebugTextGlyphs(s, &run->width);
+
+    if (run->num_glyphs == 0) {
+        // Nothing to draw
+    } else if (CanBatchDebugText(renderer)) {
+        const int num_floats = run->num_glyphs * 8;
+
+        // The vertices and indices all come from a single allocation, freed with xy_origin
+        run->xy_origin = (float *)SDL_malloc(3 * num_floats * sizeof(float) + run->num_glyphs * 6 * sizeof(int));
+        if (!run->xy_origin) {
+            SDL_free(run);
+            return NULL;
+        }
+        run->xy = run->xy_origin + num_floats;
+        run->uv = run->xy + num_floats;
+        run->indices = (int *)(run->uv + num_floats);
+
+        BuildDebugTextGeometry(renderer, s, 0.0f, 0.0f, run->xy_origin, run->uv, run->indices);
+        SDL_memcpy(run->xy, run->xy_origin, num_floats * sizeof(float));
+    } else {
+        run->texture = CreateDebugTextRunTexture(renderer, s, run->width);
+        if (!run->texture) {
+            SDL_free(run);
+            return NULL;
+        }
+    }
+    return run;
+}
+
+static bool DrawDebugTextRun(SDL_Renderer *renderer, SDL_DebugTextRun *run, float x, float y)
+{
+    if (run->num_glyphs == 0) {
+        return true;
+    }
+
+    if (run->texture) {
+        const SDL_FRect drect = { x, y, (float)run->width, (float)SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE };
+        bool result = true;
+
+        Uint8 r, g, b, a;
+        result &= SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+        result &= SDL_SetTextureColorMod(run->texture, r, g, b);
+        result &= SDL_SetTextureAlphaMod(run->texture, a);
+        result &= SDL_RenderTexture(renderer, run->texture, NULL, &drect);
+        return result;
+    }
+
+    // Only move the vertices when the text is drawn somewhere else
+    if (x != run->x || y != run->y) {
+        const int num_floats = run->num_glyphs * 8;
+        for (int i = 0; i < num_floats; i += 2) {
+            run->xy[i + 0] = run->xy_origin[i + 0] + x;
+            run->xy[i + 1] = run->xy_origin[i + 1] + y;
+        }
+        run->x = x;
+        run->y = y;
+    }
+    return QueueDebugTextGeometry(renderer, run->xy, run->uv, run->indices, run->num_glyphs);
+}
+
+static void DestroyDebugTextRun(SDL_DebugTextRun *run)
+{
+    if (run->texture) {
+        SDL_DestroyTexture(run->texture);
+    }
+    SDL_free(run->xy_origin);
+    SDL_free(run);
+}
+
+// Returns the prepared run for text drawn before, or NULL if the text should be drawn directly.
+static SDL_DebugTextRun *GetCachedDebugTextRun(SDL_Renderer *renderer, const char *s)
+{
+    const size_t len = SDL_strlen(s);
+    if (len > SDL_DEBUG_TEXT_CACHE_MAX_LENGTH) {
+        return NULL;
+    }
+
+    if (!renderer->debug_text_cache) {
+        renderer->debug_text_cache = (SDL_DebugTextCacheEntry *)SDL_calloc(SDL_DEBUG_TEXT_CACHE_SIZE, sizeof(*renderer->debug_text_cache));
+        if (!renderer->debug_text_cache) {
+            return NULL;
+        }
+    }
+
+    // Each string can only go in one set of entries, so an overlay with more lines than the cache holds still mostly hits
+    const Uint32 hash = SDL_murmur3_32(s, len, 0);
+    const Uint64 now = ++renderer->debug_text_cache_clock;
+    SDL_DebugTextCacheEntry *set = &renderer->debug_text_cache[(hash % (SDL_DEBUG_TEXT_CACHE_SIZE / SDL_DEBUG_TEXT_CACHE_WAYS)) * SDL_DEBUG_TEXT_CACHE_WAYS];
+    SDL_DebugTextCacheEntry *oldest = NULL;
+    SDL_DebugTextCacheEntry *oldest_unprepared = NULL;
+    for (int i = 0; i < SDL_DEBUG_TEXT_CACHE_WAYS; ++i) {
+        SDL_DebugTextCacheEntry *entry = &set[i];
+        if (entry->text && entry->hash == hash && SDL_strcmp(entry->text, s) == 0) {
+            entry->last_used = now;
+            if (!entry->run) {
+                // It's been drawn before, so it's likely to be drawn again: prepare it now
+                entry->run = CreateDebugTextRun(renderer, s);
+            }
+            return entry->run;
+        }
+        if (!oldest || entry->last_used < oldest->last_used) {
+            oldest = entry;
+        }
+        if (!entry->run && (!oldest_unprepared || entry->last_used < oldest_unprepared->last_used)) {
+            oldest_unprepared = entry;
+        }
+    }
+
+    // Text that is only drawn once isn't worth preparing, just remember it. Prepared text that is still being
+    // drawn is only replaced once there's no text left that was only seen once, so text that changes every frame
+    // doesn't push out the rest.
+    if (oldest->run && oldest_unprepared && (now - oldest->last_used) <= SDL_DEBUG_TEXT_CACHE_SIZE) {
+        oldest = oldest_unprepared;
+    }
+    char *text = (char *)SDL_malloc(len + 1);
+    if (text) {
+        SDL_memcpy(text, s, len + 1);
+        if (oldest->run) {
+            DestroyDebugTextRun(oldest->run);
+        }
+        SDL_free(oldest->text);
+        oldest->hash = hash;
+        oldest->text = text;
+        oldest->run = NULL;
+        oldest->last_used = now;
+    }
+    return NULL;
+}
+
+static void ClearDebugTextCache(SDL_Renderer *renderer)
+{
+    if (!renderer->debug_text_cache) {
+        return;
+    }
+
+    for (int i = 0; i < SDL_DEBUG_TEXT_CACHE_SIZE; ++i) {
+        SDL_DebugTextCacheEntry *entry = &renderer->debug_text_cache[i];
+        if (entry->run) {
+            DestroyDebugTextRun(entry->run);
+        }
+        SDL_free(entry->text);
+    }
+    SDL_free(renderer->debug_text_cache);
+    renderer->debug_text_cache = NULL;
+}
+
 bool SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *s)
 {
     CHECK_RENDERER_MAGIC(renderer, false);
 
+    if (!s) {
+        return SDL_InvalidParamError("str");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
     // Allocate a texture atlas for this renderer if needed.
     if (!renderer->debug_char_texture_atlas) {
         if (!CreateDebugTextAtlas(renderer)) {
@@ -5865,8 +6950,34 @@ bool SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *s
         }
     }
 
+    SDL_DebugTextRun *run = GetCachedDebugTextRun(renderer, s);
+    if (run) {
+        return DrawDebugTextRun(renderer, run, x, y);
+    }
+
     bool result = true;
 
+    if (CanBatchDebugText(renderer)) {
+        int width;
+        const int num_glyphs = CountDebugTextGlyphs(s, &width);
+        if (num_glyphs > 0) {
+            bool xy_isstack, uv_isstack, indices_isstack;
+            float *xy = SDL_small_alloc(float, num_glyphs * 8, &xy_isstack);
+            float *uv = SDL_small_alloc(float, num_glyphs * 8, &uv_isstack);
+            int *indices = SDL_small_alloc(int, num_glyphs * 6, &indices_isstack);
+            if (xy && uv && indices) {
+                BuildDebugTextGeometry(renderer, s, x, y, xy, uv, indices);
+                result = QueueDebugTextGeometry(renderer, xy, uv, indices, num_glyphs);
+            } else {
+                result = false;
+            }
+            SDL_small_free(indices, indices_isstack);
+            SDL_small_free(uv, uv_isstack);
+            SDL_small_free(xy, xy_isstack);
+        }
+        return result;
+    }
+
     Uint8 r, g, b, a;
     result &= SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
     result &= SDL_SetTextureColorMod(renderer->debug_char_texture_atlas, r, g, b);
@@ -5876,7 +6987,10 @@ bool SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *s
     Uint32 ch;
 
     while (result && ((ch = SDL_StepUTF8(&s, NULL)) != 0)) {
-        result &= DrawDebugCharacter(renderer, curx, y, ch);
+        const int glyph = GetDebugGlyph(ch);
+        if (glyph >= 0) {
+            result &= DrawDebugCharacter(renderer, curx, y, glyph);
+        }
         curx += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
     }
 
@@ -5909,6 +7023,54 @@ bool SDL_RenderDebugTextFormat(SDL_Renderer *renderer, float x, float y, SDL_PRI
     return retval;
 }
 
+SDL_DebugTextRun *SDL_CreateDebugTextRun(SDL_Renderer *renderer, const char *str)
+{
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!str) {
+        SDL_InvalidParamError("str");
+        return NULL;
+    }
+
+    if (!renderer->debug_char_texture_atlas) {
+        if (!CreateDebugTextAtlas(renderer)) {
+            return NULL;
+        }
+    }
+
+    return CreateDebugTextRun(renderer, str);
+}
+
+bool SDL_RenderDebugTextRun(SDL_Renderer *renderer, SDL_DebugTextRun *run, float x, float y)
+{
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (!run) {
+        return SDL_InvalidParamError("run");
+    }
+    if (run->renderer != renderer) {
+        return SDL_SetError("Text run was not created with this renderer");
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
+    return DrawDebugTextRun(renderer, run, x, y);
+}
+
+void SDL_DestroyDebugTextRun(SDL_DebugTextRun *run)
+{
+    if (!run) {
+        return;
+    }
+
+    DestroyDebugTextRun(run);
+}
+
 bool SDL_SetDefaultTextureScaleMode(SDL_Renderer *renderer, SDL_ScaleMode scale_mode)
 {
     CHECK_RENDERER_MAGIC(renderer, false);
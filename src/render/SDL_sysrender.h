@@ -140,6 +140,33 @@ struct SDL_GPURenderState
     SDL_GPURenderStateUniformBuffer *uniform_buffers;
 };
 
+// Define the debug text run structure
+struct SDL_DebugTextRun
+{
+    SDL_Renderer *renderer;
+
+    int num_glyphs;     // characters that aren't blank.
+    int width;          // in pixels, including blank characters.
+    float *xy_origin;   // four vertices per glyph, relative to the top-left corner of the text.
+    float *xy;          // the same vertices, placed where the run was last drawn.
+    float *uv;
+    int *indices;
+    float x, y;         // where xy was last placed.
+
+    SDL_Texture *texture;  // the whole line, drawn once, for renderers that can't batch glyphs.
+};
+
+// Strings kept by SDL_RenderDebugText() between frames
+#define SDL_DEBUG_TEXT_CACHE_SIZE 256
+
+typedef struct SDL_DebugTextCacheEntry
+{
+    Uint32 hash;
+    char *text;
+    SDL_DebugTextRun *run;  // NULL until the text is drawn a second time.
+    Uint64 last_used;
+} SDL_DebugTextCacheEntry;
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -182,6 +209,8 @@ typedef struct SDL_RenderCommand
             SDL_TextureAddressMode texture_address_mode_u;
             SDL_TextureAddressMode texture_address_mode_v;
             SDL_GPURenderState *gpu_render_state;
+            size_t vertex_size;      // bytes of vertex data at first, or SDL_SIZE_MAX if the backend keeps them elsewhere.
+            size_t vertex_alignment; // the alignment the backend asked for.
         } draw;
         struct
         {
@@ -193,6 +222,14 @@ typedef struct SDL_RenderCommand
     struct SDL_RenderCommand *next;
 } SDL_RenderCommand;
 
+// Render commands are allocated in blocks, which are kept until the renderer trims its queue or is destroyed.
+typedef struct SDL_RenderCommandBlock
+{
+    struct SDL_RenderCommandBlock *next;
+    int num_commands;
+    SDL_RenderCommand commands[SDL_VARIABLE_LENGTH_ARRAY];
+} SDL_RenderCommandBlock;
+
 typedef struct SDL_VertexSolid
 {
     SDL_FPoint position;
@@ -233,6 +270,14 @@ struct SDL_Renderer
 
     void (*InvalidateCachedState)(SDL_Renderer *renderer);
     bool (*RunCommandQueue)(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
+
+    /* Renderers that set this can run RunCommandQueue() on a render thread, see SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN.
+       It's called on the application thread before each queue is handed over, to set up anything RunCommandQueue()
+       needs from the application thread. While the render thread runs, the queue functions, CreateTexture(),
+       GetOutputSize() and SupportsBlendMode() can be called, and the other texture functions can be called for
+       textures that aren't being drawn, so they must not touch state the render thread uses without locking it.
+       DestroyTexture() and everything else waits for the render thread. */
+    bool (*PrepareCommandQueue)(SDL_Renderer *renderer);
     bool (*UpdateTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
                          const SDL_Rect *rect, const void *pixels,
                          int pitch);
@@ -312,6 +357,8 @@ struct SDL_Renderer
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
     SDL_RenderCommand *render_commands_pool;
+    SDL_RenderCommandBlock *render_command_blocks;
+    int render_commands_allocated;
     Uint32 render_command_generation;
     SDL_FColor last_queued_color;
     float last_queued_color_scale;
@@ -325,6 +372,38 @@ struct SDL_Renderer
     void *vertex_data;
     size_t vertex_data_used;
     size_t vertex_data_allocation;
+    size_t vertex_data_alignment;   // the largest alignment asked for since it was last reset.
+
+    // Reordering draws, see SDL_SetRenderBatchMode()
+    SDL_RenderBatchMode batch_mode;
+    void *sorted_draws;
+    size_t sorted_draws_allocation;
+    void *sorted_vertex_data;
+    size_t sorted_vertex_data_allocation;
+    Uint64 frame_commands;      // commands sent to the backend since the last present.
+    Uint64 frame_merged_draws;  // draws combined with another since the last present.
+
+    // Running the command queue on a render thread, see SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN
+    SDL_Thread *render_thread;
+    SDL_Mutex *render_thread_lock;
+    SDL_Condition *render_thread_cond;
+    SDL_RenderCommand *render_thread_commands;  // the queue handed to the render thread, until it's back in the pool.
+    SDL_RenderCommand *render_thread_commands_tail;
+    void *render_thread_vertex_data;            // the vertex buffer not being filled, swapped at each hand over.
+    size_t render_thread_vertex_data_used;
+    size_t render_thread_vertex_data_allocation;
+    Uint32 render_thread_generation;            // the render_command_generation of the queue handed over.
+    bool render_thread_busy;
+    bool render_thread_present;                 // present after drawing the queue.
+    bool render_thread_present_pending;         // drawn, waiting to be presented on the main thread.
+    bool render_thread_quit;
+
+    // The most the command queue held at once, see SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER
+    size_t frame_vertex_data_peak;
+    int frame_queued_commands_peak;
+    size_t quiet_vertex_data_peak;  // the most used since the queue last needed more than a quarter of its memory.
+    int quiet_queued_commands_peak;
+    int quiet_frames;
 
     // Shaped window support
     bool transparent_window;
@@ -334,6 +413,8 @@ struct SDL_Renderer
     SDL_PropertiesID props;
 
     SDL_Texture *debug_char_texture_atlas;
+    SDL_DebugTextCacheEntry *debug_text_cache;  // SDL_DEBUG_TEXT_CACHE_SIZE entries, allocated on first use.
+    Uint64 debug_text_cache_clock;
 
     bool destroyed;   // already destroyed by SDL_DestroyWindow; just free this struct in SDL_DestroyRenderer.
 
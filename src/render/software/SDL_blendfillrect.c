@@ -25,11 +25,218 @@
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
 
+#ifdef SDL_SSE2_INTRINSICS
+/* The blend modes as per-channel factors, so a row can be blended several pixels at a time:
+ *   dst = DRAW_MUL(dst, mul) + DRAW_MUL(dst, mul2) + add, saturated
+ * The channels are in r, g, b, a order, and the results match the DRAW_SETPIXEL_* macros exactly.
+ */
+typedef struct
+{
+    Uint16 mul[4];
+    Uint16 mul2[4];
+    Uint16 add[4];
+    bool has_mul2;
+} SDL_BlendFillFactors;
+
+static bool SDL_GetBlendFillFactors(SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendFillFactors *factors)
+{
+    const Uint16 inva = 0xff - a;
+    int i;
+
+    SDL_zerop(factors);
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        for (i = 0; i < 4; ++i) {
+            factors->mul[i] = inva;
+        }
+        factors->add[0] = r;
+        factors->add[1] = g;
+        factors->add[2] = b;
+        factors->add[3] = a;
+        return true;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        // DRAW_MUL(dst, 255) is dst, and the alpha is left alone
+        for (i = 0; i < 4; ++i) {
+            factors->mul[i] = 0xff;
+        }
+        factors->add[0] = r;
+        factors->add[1] = g;
+        factors->add[2] = b;
+        return true;
+    case SDL_BLENDMODE_MOD:
+        factors->mul[0] = r;
+        factors->mul[1] = g;
+        factors->mul[2] = b;
+        factors->mul[3] = 0xff;
+        return true;
+    case SDL_BLENDMODE_MUL:
+        factors->mul[0] = r;
+        factors->mul[1] = g;
+        factors->mul[2] = b;
+        factors->mul[3] = 0xff;
+        factors->mul2[0] = inva;
+        factors->mul2[1] = inva;
+        factors->mul2[2] = inva;
+        factors->has_mul2 = true;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// DRAW_MUL(), exact for products up to 255 * 255
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_BlendFillMul_SSE2(__m128i channels, __m128i factors)
+{
+    const __m128i product = _mm_mullo_epi16(channels, factors);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)), _mm_srli_epi16(product, 8)), 8);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_BlendFillChannels_SSE2(__m128i channels, __m128i mul, __m128i mul2, __m128i add, bool has_mul2)
+{
+    __m128i result = _mm_add_epi16(SDL_BlendFillMul_SSE2(channels, mul), add);
+    if (has_mul2) {
+        result = _mm_add_epi16(result, SDL_BlendFillMul_SSE2(channels, mul2));
+    }
+    return result;
+}
+
+// XRGB8888 and ARGB8888, four pixels at a time
+static void SDL_TARGETING("sse2") SDL_BlendFillRect4_SSE2(SDL_Surface *dst, const SDL_Rect *rect, const SDL_BlendFillFactors *factors, Uint32 mask)
+{
+    const Uint16 *m = factors->mul;
+    const Uint16 *m2 = factors->mul2;
+    const Uint16 *c = factors->add;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mul = _mm_set_epi16(m[3], m[0], m[1], m[2], m[3], m[0], m[1], m[2]);
+    const __m128i mul2 = _mm_set_epi16(m2[3], m2[0], m2[1], m2[2], m2[3], m2[0], m2[1], m2[2]);
+    const __m128i add = _mm_set_epi16(c[3], c[0], c[1], c[2], c[3], c[0], c[1], c[2]);
+    const __m128i keep = _mm_set1_epi32((int)mask);
+    const bool has_mul2 = factors->has_mul2;
+    int y;
+
+    for (y = 0; y < rect->h; ++y) {
+        Uint32 *pixels = (Uint32 *)((Uint8 *)dst->pixels + (rect->y + y) * dst->pitch) + rect->x;
+        int n = rect->w;
+
+        for (; n >= 4; n -= 4, pixels += 4) {
+            const __m128i p = _mm_loadu_si128((const __m128i *)pixels);
+            const __m128i lo = SDL_BlendFillChannels_SSE2(_mm_unpacklo_epi8(p, zero), mul, mul2, add, has_mul2);
+            const __m128i hi = SDL_BlendFillChannels_SSE2(_mm_unpackhi_epi8(p, zero), mul, mul2, add, has_mul2);
+            _mm_storeu_si128((__m128i *)pixels, _mm_and_si128(_mm_packus_epi16(lo, hi), keep));
+        }
+        for (; n > 0; --n, ++pixels) {
+            const __m128i p = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)*pixels), zero);
+            const __m128i result = SDL_BlendFillChannels_SSE2(p, mul, mul2, add, has_mul2);
+            *pixels = (Uint32)_mm_cvtsi128_si32(_mm_and_si128(_mm_packus_epi16(result, result), keep));
+        }
+    }
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse2") SDL_BlendFillPixels2_SSE2(__m128i p, const SDL_BlendFillFactors *factors, bool rgb565)
+{
+    const __m128i rshift = _mm_cvtsi32_si128(rgb565 ? 11 : 10);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i c255 = _mm_set1_epi16(0xFF);
+    const Uint16 *m = factors->mul;
+    const Uint16 *m2 = factors->mul2;
+    const Uint16 *c = factors->add;
+    __m128i r, g, b;
+
+    // expand to 8 bits the way SDL_expand_byte[] does, (v * 255) / 31 or (v * 255) / 63
+    r = _mm_mullo_epi16(_mm_and_si128(_mm_srl_epi16(p, rshift), mask5), c255);
+    r = _mm_srli_epi16(_mm_mulhi_epu16(r, _mm_set1_epi16(8457)), 2);
+    if (rgb565) {
+        g = _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F)), c255);
+        g = _mm_srli_epi16(_mm_mulhi_epu16(g, _mm_set1_epi16(8323)), 3);
+    } else {
+        g = _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(p, 5), mask5), c255);
+        g = _mm_srli_epi16(_mm_mulhi_epu16(g, _mm_set1_epi16(8457)), 2);
+    }
+    b = _mm_mullo_epi16(_mm_and_si128(p, mask5), c255);
+    b = _mm_srli_epi16(_mm_mulhi_epu16(b, _mm_set1_epi16(8457)), 2);
+
+    r = _mm_min_epi16(SDL_BlendFillChannels_SSE2(r, _mm_set1_epi16(m[0]), _mm_set1_epi16(m2[0]), _mm_set1_epi16(c[0]), factors->has_mul2), c255);
+    g = _mm_min_epi16(SDL_BlendFillChannels_SSE2(g, _mm_set1_epi16(m[1]), _mm_set1_epi16(m2[1]), _mm_set1_epi16(c[1]), factors->has_mul2), c255);
+    b = _mm_min_epi16(SDL_BlendFillChannels_SSE2(b, _mm_set1_epi16(m[2]), _mm_set1_epi16(m2[2]), _mm_set1_epi16(c[2]), factors->has_mul2), c255);
+
+    r = _mm_sll_epi16(_mm_srli_epi16(r, 3), rshift);
+    if (rgb565) {
+        g = _mm_slli_epi16(_mm_srli_epi16(g, 2), 5);
+    } else {
+        g = _mm_slli_epi16(_mm_srli_epi16(g, 3), 5);
+    }
+    b = _mm_srli_epi16(b, 3);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+// RGB565 and XRGB1555, eight pixels at a time
+static void SDL_TARGETING("sse2") SDL_BlendFillRect2_SSE2(SDL_Surface *dst, const SDL_Rect *rect, const SDL_BlendFillFactors *factors, bool rgb565)
+{
+    int y;
+
+    for (y = 0; y < rect->h; ++y) {
+        Uint16 *pixels = (Uint16 *)((Uint8 *)dst->pixels + (rect->y + y) * dst->pitch) + rect->x;
+        int n = rect->w;
+
+        for (; n >= 8; n -= 8, pixels += 8) {
+            const __m128i p = _mm_loadu_si128((const __m128i *)pixels);
+            _mm_storeu_si128((__m128i *)pixels, SDL_BlendFillPixels2_SSE2(p, factors, rgb565));
+        }
+        if (n > 0) {
+            Uint16 tail[8];
+            SDL_zeroa(tail);
+            SDL_memcpy(tail, pixels, n * sizeof(Uint16));
+            _mm_storeu_si128((__m128i *)tail, SDL_BlendFillPixels2_SSE2(_mm_loadu_si128((const __m128i *)tail), factors, rgb565));
+            SDL_memcpy(pixels, tail, n * sizeof(Uint16));
+        }
+    }
+}
+
+// Narrow rectangles aren't worth setting up for
+#define SDL_BLENDFILL_SSE2_MIN_WIDTH 8
+
+static bool SDL_BlendFillRect_SSE2(SDL_Surface *dst, const SDL_Rect *rect,
+                                   SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_BlendFillFactors factors;
+
+    if (rect->w < SDL_BLENDFILL_SSE2_MIN_WIDTH || !SDL_HasSSE2() ||
+        !SDL_GetBlendFillFactors(blendMode, r, g, b, a, &factors)) {
+        return false;
+    }
+
+    switch (dst->format) {
+    case SDL_PIXELFORMAT_XRGB8888:
+        SDL_BlendFillRect4_SSE2(dst, rect, &factors, 0x00FFFFFF);
+        return true;
+    case SDL_PIXELFORMAT_ARGB8888:
+        SDL_BlendFillRect4_SSE2(dst, rect, &factors, 0xFFFFFFFF);
+        return true;
+    case SDL_PIXELFORMAT_RGB565:
+        SDL_BlendFillRect2_SSE2(dst, rect, &factors, true);
+        return true;
+    case SDL_PIXELFORMAT_XRGB1555:
+        SDL_BlendFillRect2_SSE2(dst, rect, &factors, false);
+        return true;
+    default:
+        return false;
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
 static bool SDL_BlendFillRect_RGB555(SDL_Surface *dst, const SDL_Rect *rect,
                                     SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     unsigned inva = 0xff - a;
 
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_BlendFillRect_SSE2(dst, rect, blendMode, r, g, b, a)) {
+        return true;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_RGB555);
@@ -59,6 +266,12 @@ static bool SDL_BlendFillRect_RGB565(SDL_Surface *dst, const SDL_Rect *rect,
 {
     unsigned inva = 0xff - a;
 
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_BlendFillRect_SSE2(dst, rect, blendMode, r, g, b, a)) {
+        return true;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_RGB565);
@@ -88,6 +301,12 @@ static bool SDL_BlendFillRect_XRGB8888(SDL_Surface *dst, const SDL_Rect *rect,
 {
     unsigned inva = 0xff - a;
 
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_BlendFillRect_SSE2(dst, rect, blendMode, r, g, b, a)) {
+        return true;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_XRGB8888);
@@ -117,6 +336,12 @@ static bool SDL_BlendFillRect_ARGB8888(SDL_Surface *dst, const SDL_Rect *rect,
 {
     unsigned inva = 0xff - a;
 
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_BlendFillRect_SSE2(dst, rect, blendMode, r, g, b, a)) {
+        return true;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888);
@@ -23,6 +23,7 @@
 #ifdef SDL_VIDEO_RENDER_SW
 
 #include "SDL_draw.h"
+#include "SDL_blendfillrect.h"
 #include "SDL_blendline.h"
 #include "SDL_blendpoint.h"
 
@@ -974,6 +975,22 @@ bool SDL_BlendLines(SDL_Surface *dst, const SDL_Point *points, int count, SDL_Bl
         // Draw the end if it was clipped
         draw_end = (x2 != points[i].x || y2 != points[i].y);
 
+        if (y1 == y2) {
+            // Horizontal lines are spans, which are filled several pixels at a time
+            SDL_Rect span;
+            span.x = (x1 <= x2) ? x1 : (draw_end ? x2 : x2 + 1);
+            span.y = y1;
+            span.w = (x1 <= x2) ? (x2 - x1) : (x1 - x2);
+            span.h = 1;
+            if (draw_end) {
+                ++span.w;
+            }
+            if (span.w > 0) {
+                SDL_BlendFillRect(dst, &span, blendMode, r, g, b, a);
+            }
+            continue;
+        }
+
         func(dst, x1, y1, x2, y2, blendMode, r, g, b, a, draw_end);
     }
     if (points[0].x != points[count - 1].x || points[0].y != points[count - 1].y) {
@@ -234,6 +234,122 @@ static bool SDL_BlendPoint_RGBA(SDL_Surface *dst, int x, int y, SDL_BlendMode bl
     }
 }
 
+static bool SDL_BlendPoints_RGB555(SDL_Surface *dst, const SDL_Point *points, int count, SDL_BlendMode blendMode,
+                                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned inva = 0xff - a;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_BLEND_RGB555);
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_BLEND_CLAMPED_RGB555);
+        break;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_ADD_RGB555);
+        break;
+    case SDL_BLENDMODE_MOD:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_MOD_RGB555);
+        break;
+    case SDL_BLENDMODE_MUL:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_MUL_RGB555);
+        break;
+    default:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_RGB555);
+        break;
+    }
+    return true;
+}
+
+static bool SDL_BlendPoints_RGB565(SDL_Surface *dst, const SDL_Point *points, int count, SDL_BlendMode blendMode,
+                                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned inva = 0xff - a;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_BLEND_RGB565);
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_BLEND_CLAMPED_RGB565);
+        break;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_ADD_RGB565);
+        break;
+    case SDL_BLENDMODE_MOD:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_MOD_RGB565);
+        break;
+    case SDL_BLENDMODE_MUL:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_MUL_RGB565);
+        break;
+    default:
+        DRAWPOINTS(Uint16, DRAW_SETPIXEL_RGB565);
+        break;
+    }
+    return true;
+}
+
+static bool SDL_BlendPoints_XRGB8888(SDL_Surface *dst, const SDL_Point *points, int count, SDL_BlendMode blendMode,
+                                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned inva = 0xff - a;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_BLEND_XRGB8888);
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_BLEND_CLAMPED_XRGB8888);
+        break;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_ADD_XRGB8888);
+        break;
+    case SDL_BLENDMODE_MOD:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_MOD_XRGB8888);
+        break;
+    case SDL_BLENDMODE_MUL:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_MUL_XRGB8888);
+        break;
+    default:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_XRGB8888);
+        break;
+    }
+    return true;
+}
+
+static bool SDL_BlendPoints_ARGB8888(SDL_Surface *dst, const SDL_Point *points, int count, SDL_BlendMode blendMode,
+                                  Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned inva = 0xff - a;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888);
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_BLEND_CLAMPED_ARGB8888);
+        break;
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_ADD_PREMULTIPLIED:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_ADD_ARGB8888);
+        break;
+    case SDL_BLENDMODE_MOD:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_MOD_ARGB8888);
+        break;
+    case SDL_BLENDMODE_MUL:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_MUL_ARGB8888);
+        break;
+    default:
+        DRAWPOINTS(Uint32, DRAW_SETPIXEL_ARGB8888);
+        break;
+    }
+    return true;
+}
+
 bool SDL_BlendPoint(SDL_Surface *dst, int x, int y, SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     if (!SDL_SurfaceValid(dst)) {
@@ -317,43 +433,39 @@ bool SDL_BlendPoints(SDL_Surface *dst, const SDL_Point *points, int count, SDL_B
         b = DRAW_MUL(b, a);
     }
 
-    // FIXME: Does this function pointer slow things down significantly?
+    // The common formats clip and draw all the points in one loop
     switch (dst->fmt->bits_per_pixel) {
     case 15:
         switch (dst->fmt->Rmask) {
         case 0x7C00:
-            func = SDL_BlendPoint_RGB555;
-            break;
+            return SDL_BlendPoints_RGB555(dst, points, count, blendMode, r, g, b, a);
         }
         break;
     case 16:
         switch (dst->fmt->Rmask) {
         case 0xF800:
-            func = SDL_BlendPoint_RGB565;
-            break;
+            return SDL_BlendPoints_RGB565(dst, points, count, blendMode, r, g, b, a);
         }
         break;
     case 32:
         switch (dst->fmt->Rmask) {
         case 0x00FF0000:
             if (!dst->fmt->Amask) {
-                func = SDL_BlendPoint_XRGB8888;
+                return SDL_BlendPoints_XRGB8888(dst, points, count, blendMode, r, g, b, a);
             } else {
-                func = SDL_BlendPoint_ARGB8888;
+                return SDL_BlendPoints_ARGB8888(dst, points, count, blendMode, r, g, b, a);
             }
-            break;
+            // break; -Wunreachable-code-break
         }
         break;
     default:
         break;
     }
 
-    if (!func) {
-        if (!dst->fmt->Amask) {
-            func = SDL_BlendPoint_RGB;
-        } else {
-            func = SDL_BlendPoint_RGBA;
-        }
+    if (!dst->fmt->Amask) {
+        func = SDL_BlendPoint_RGB;
+    } else {
+        func = SDL_BlendPoint_RGBA;
     }
 
     minx = dst->clip_rect.x;
@@ -685,6 +685,29 @@
     BLINE(x1, y1, x2, y2, opaque_op, draw_end)
 #endif
 
+/*
+ * Define point drawing macro, clipping and drawing all the points in one pass
+ */
+
+#define DRAWPOINTS(type, op)                                                        \
+    do {                                                                            \
+        const unsigned minx = (unsigned)dst->clip_rect.x;                           \
+        const unsigned miny = (unsigned)dst->clip_rect.y;                           \
+        /* a clip rect that misses the surface can have a negative size */          \
+        const unsigned clipw = (unsigned)SDL_max(dst->clip_rect.w, 0);              \
+        const unsigned cliph = (unsigned)SDL_max(dst->clip_rect.h, 0);              \
+        int i;                                                                      \
+        for (i = 0; i < count; ++i) {                                               \
+            const int x = points[i].x;                                              \
+            const int y = points[i].y;                                              \
+            /* one unsigned compare per axis rejects points on either side */      \
+            if ((unsigned)x - minx < clipw && (unsigned)y - miny < cliph) {         \
+                type *pixels = (type *)((Uint8 *)dst->pixels + y * dst->pitch) + x; \
+                op;                                                                 \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
 /*
  * Define fill rect macro
  */
@@ -61,11 +61,6 @@ bool SDL_DrawPoint(SDL_Surface *dst, int x, int y, Uint32 color)
 
 bool SDL_DrawPoints(SDL_Surface *dst, const SDL_Point *points, int count, Uint32 color)
 {
-    int minx, miny;
-    int maxx, maxy;
-    int i;
-    int x, y;
-
     if (!SDL_SurfaceValid(dst)) {
         return SDL_InvalidParamError("SDL_DrawPoints(): dst");
     }
@@ -75,32 +70,18 @@ bool SDL_DrawPoints(SDL_Surface *dst, const SDL_Point *points, int count, Uint32
         return SDL_SetError("SDL_DrawPoints(): Unsupported surface format");
     }
 
-    minx = dst->clip_rect.x;
-    maxx = dst->clip_rect.x + dst->clip_rect.w - 1;
-    miny = dst->clip_rect.y;
-    maxy = dst->clip_rect.y + dst->clip_rect.h - 1;
-
-    for (i = 0; i < count; ++i) {
-        x = points[i].x;
-        y = points[i].y;
-
-        if (x < minx || x > maxx || y < miny || y > maxy) {
-            continue;
-        }
-
-        switch (dst->fmt->bytes_per_pixel) {
-        case 1:
-            DRAW_FASTSETPIXELXY1(x, y);
-            break;
-        case 2:
-            DRAW_FASTSETPIXELXY2(x, y);
-            break;
-        case 3:
-            return SDL_Unsupported();
-        case 4:
-            DRAW_FASTSETPIXELXY4(x, y);
-            break;
-        }
+    switch (dst->fmt->bytes_per_pixel) {
+    case 1:
+        DRAWPOINTS(Uint8, DRAW_FASTSETPIXEL1);
+        break;
+    case 2:
+        DRAWPOINTS(Uint16, DRAW_FASTSETPIXEL2);
+        break;
+    case 3:
+        return SDL_Unsupported();
+    case 4:
+        DRAWPOINTS(Uint32, DRAW_FASTSETPIXEL4);
+        break;
     }
     return true;
 }
@@ -45,10 +45,19 @@ typedef struct
     SDL_Color color;
 } SW_DrawStateCache;
 
+struct SW_TilePool;
+
+#define SW_MAX_DIRTY_RECTS 16
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    struct SW_TilePool *tiles;
+    bool partial_present;  // SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT
+    bool dirty_all;        // the whole window surface has to be presented
+    int num_dirty;
+    SDL_Rect dirty[SW_MAX_DIRTY_RECTS];  // the parts of the window surface drawn since the last present
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -62,6 +71,7 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->dirty_all = true;
         }
     }
     return data->surface;
@@ -74,6 +84,11 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED ||
+               event->type == SDL_EVENT_WINDOW_SHOWN ||
+               event->type == SDL_EVENT_WINDOW_RESTORED) {
+        // the window may have lost what was presented before.
+        data->dirty_all = true;
     }
 }
 
@@ -667,293 +682,1164 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 }
 
 
-static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+static void SW_RunCommand(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    switch (cmd->command) {
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+    {
+        drawstate->color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        drawstate->color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        break;
+    }
 
-    if (!SDL_SurfaceValid(surface)) {
-        return false;
+    case SDL_RENDERCMD_SETVIEWPORT:
+    {
+        drawstate->viewport = &cmd->data.viewport.rect;
+        drawstate->surface_cliprect_dirty = true;
+        break;
     }
 
-    drawstate.viewport = NULL;
-    drawstate.cliprect = NULL;
-    drawstate.surface_cliprect_dirty = true;
-    drawstate.color.r = 0;
-    drawstate.color.g = 0;
-    drawstate.color.b = 0;
-    drawstate.color.a = 0;
+    case SDL_RENDERCMD_SETCLIPRECT:
+    {
+        drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+        drawstate->surface_cliprect_dirty = true;
+        break;
+    }
 
-    while (cmd) {
-        switch (cmd->command) {
-        case SDL_RENDERCMD_SETDRAWCOLOR:
-        {
-            drawstate.color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
-            break;
+    case SDL_RENDERCMD_CLEAR:
+    {
+        const Uint8 r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        // By definition the clear ignores the clip rect
+        SDL_SetSurfaceClipRect(surface, NULL);
+        SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        drawstate->surface_cliprect_dirty = true;
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
         }
 
-        case SDL_RENDERCMD_SETVIEWPORT:
-        {
-            drawstate.viewport = &cmd->data.viewport.rect;
-            drawstate.surface_cliprect_dirty = true;
-            break;
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
         }
+        break;
+    }
 
-        case SDL_RENDERCMD_SETCLIPRECT:
-        {
-            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-            drawstate.surface_cliprect_dirty = true;
-            break;
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
         }
 
-        case SDL_RENDERCMD_CLEAR:
-        {
-            const Uint8 r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
-            // By definition the clear ignores the clip rect
-            SDL_SetSurfaceClipRect(surface, NULL);
-            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            drawstate.surface_cliprect_dirty = true;
-            break;
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const Uint8 r = drawstate->color.r;
+        const Uint8 g = drawstate->color.g;
+        const Uint8 b = drawstate->color.b;
+        const Uint8 a = drawstate->color.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
         }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_Rect *srcrect = verts;
+        SDL_Rect *dstrect = verts + 1;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        SDL_Surface *src = (SDL_Surface *)texture->internal;
 
-        case SDL_RENDERCMD_DRAW_POINTS:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+        SetDrawState(surface, drawstate);
+
+        PrepTextureForCopy(cmd, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            dstrect->x += drawstate->viewport->x;
+            dstrect->y += drawstate->viewport->y;
+        }
+
+        if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
+            SDL_BlitSurface(src, srcrect, surface, dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+
+            /* The scaled blit samples the whole source rectangle and only writes the visible part,
+             * so copies crossing the viewport or surface edges keep their proportions.
+             */
+            SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, cmd->data.draw.texture_scale_mode);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY_EX:
+    {
+        CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        SetDrawState(surface, drawstate);
+        PrepTextureForCopy(cmd, drawstate);
+
+        // Apply viewport
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            copydata->dstrect.x += drawstate->viewport->x;
+            copydata->dstrect.y += drawstate->viewport->y;
+        }
+
+        SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+                        &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                        copydata->scale_x, copydata->scale_y, cmd->data.draw.texture_scale_mode);
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        int i;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const int count = (int)cmd->data.draw.count;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+
+        SetDrawState(surface, drawstate);
+
+        if (texture) {
+            SDL_Surface *src = (SDL_Surface *)texture->internal;
+
+            GeometryCopyData *ptr = (GeometryCopyData *)verts;
+
+            PrepTextureForCopy(cmd, drawstate);
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
                 }
             }
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_BlitTriangle(
+                    src,
+                    &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
+                    surface,
+                    &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                    ptr[0].color, ptr[1].color, ptr[2].color,
+                    cmd->data.draw.texture_address_mode_u,
+                    cmd->data.draw.texture_address_mode_v);
             }
-            break;
-        }
-
-        case SDL_RENDERCMD_DRAW_LINES:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)verts;
 
             // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
                 for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
                 }
             }
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
             }
-            break;
         }
+        break;
+    }
 
-        case SDL_RENDERCMD_FILL_RECTS:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+    case SDL_RENDERCMD_NO_OP:
+        break;
+    }
+}
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+// Drawing on several threads. See SDL_HINT_RENDER_SOFTWARE_THREADS.
+//
+// Commands that can be clipped without changing which pixels they produce are sorted into horizontal bands of the
+// render target (every row they might touch, after clipping), and each band then replays its commands, in queue
+// order, with its own copy of the target clipped to the band. Bands span the whole width of the target, so every
+// row a blitter touches is still done in one call, the same way it is when drawing on one thread. Scaled copies
+// sample the source the same way however they're clipped, so they can be split too. Anything else (lines, rotated
+// or flipped copies) waits for the bands to finish and is drawn on the calling thread.
+
+#define SW_TILE_ROWS 32
+#define SW_MAX_THREADS 64
+
+typedef struct SW_TiledCommand
+{
+    SDL_RenderCommand *cmd;
+    SDL_Rect clip;  // where the command may draw, already clipped to the viewport and the target.
+    SDL_Color color;
+    Uint32 pixel;   // `color` mapped to the target, for commands that don't blend.
+    int texture;    // the texture's slot in the pool, or -1.
+} SW_TiledCommand;
+
+typedef struct SW_Tile
+{
+    int *commands;  // indices into the pool's commands, in queue order.
+    int num_commands;
+    int max_commands;
+} SW_Tile;
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+typedef struct SW_TileWorker
+{
+    struct SW_TilePool *pool;
+    SDL_Thread *thread;
+    SDL_Semaphore *go;
+    SDL_Surface *surface;    // this thread's view of the render target, so it can have its own clip rect.
+    SDL_Surface **textures;  // this thread's views of texture surfaces, by slot, so it can have its own blit state.
+} SW_TileWorker;
+
+typedef struct SW_TilePool
+{
+    SDL_AtomicInt quit;
+    SDL_AtomicInt next_tile;
+    SDL_Semaphore *done;
+    SDL_Mutex *lock;  // held while workers create texture views.
+    int num_workers;
+    SW_TileWorker *workers;
+
+    // the commands waiting to be drawn.
+    SDL_Surface *surface;
+    void *vertices;
+    SW_TiledCommand *commands;
+    int num_commands;
+    int max_commands;
+    SW_Tile *tiles;
+    int num_tiles;
+    int max_tiles;
+
+    // texture surfaces the workers may have views of. NULL entries are free slots.
+    SDL_HashTable *texture_slots;
+    SDL_Surface **textures;
+    int num_textures;
+} SW_TilePool;
+
+// a surface sharing another's pixels, with its own clip rect and blit state.
+static SDL_Surface *SW_CreateSurfaceView(SDL_Surface *surface)
+{
+    SDL_Surface *view = SDL_CreateSurfaceFrom(surface->w, surface->h, surface->format, surface->pixels, surface->pitch);
+    if (view) {
+        SDL_SetSurfaceColorspace(view, surface->colorspace);
+        if (surface->palette) {
+            SDL_SetSurfacePalette(view, surface->palette);
+        }
+        SDL_SetSurfaceRLE(view, SDL_SurfaceHasRLE(surface));
+    }
+    return view;
+}
+
+static SDL_Surface *SW_GetTileWorkerTexture(SW_TileWorker *worker, int slot)
+{
+    if (!worker->textures[slot]) {
+        SW_TilePool *pool = worker->pool;
+        SDL_LockMutex(pool->lock);
+        worker->textures[slot] = SW_CreateSurfaceView(pool->textures[slot]);
+        SDL_UnlockMutex(pool->lock);
+    }
+    return worker->textures[slot];
+}
+
+static void SW_RunTiledCommand(SW_TileWorker *worker, const SW_TiledCommand *tiled, const SDL_Rect *tilerect)
+{
+    SW_TilePool *pool = worker->pool;
+    SDL_Surface *surface = worker->surface;
+    SDL_RenderCommand *cmd = tiled->cmd;
+    const Uint8 r = tiled->color.r;
+    const Uint8 g = tiled->color.g;
+    const Uint8 b = tiled->color.b;
+    const Uint8 a = tiled->color.a;
+    SDL_BlendMode blend;
+    int count;
+    void *verts;
+    SDL_Surface *src = NULL;
+    SDL_Rect clip;
+
+    if (!SDL_GetRectIntersection(&tiled->clip, tilerect, &clip)) {
+        return;
+    }
+    SDL_SetSurfaceClipRect(surface, &clip);
+
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        SDL_FillSurfaceRect(surface, &clip, tiled->pixel);
+        return;
+    }
+
+    blend = cmd->data.draw.blend;
+    count = (int)cmd->data.draw.count;
+    verts = ((Uint8 *)pool->vertices) + cmd->data.draw.first;
+
+    if (tiled->texture >= 0) {
+        src = SW_GetTileWorkerTexture(worker, tiled->texture);
+        if (!src) {
+            return;
+        }
+        SDL_SetSurfaceColorMod(src, r, g, b);
+        SDL_SetSurfaceAlphaMod(src, a);
+        SDL_SetSurfaceBlendMode(src, blend);
+    }
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(surface, (const SDL_Point *)verts, count, tiled->pixel);
+        } else {
+            SDL_BlendPoints(surface, (const SDL_Point *)verts, count, blend, r, g, b, a);
+        }
+        break;
+
+    case SDL_RENDERCMD_FILL_RECTS:
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(surface, (const SDL_Rect *)verts, count, tiled->pixel);
+        } else {
+            SDL_BlendFillRects(surface, (const SDL_Rect *)verts, count, blend, r, g, b, a);
+        }
+        break;
+
+    case SDL_RENDERCMD_COPY:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts;
+        if (rects[0].w == rects[1].w && rects[0].h == rects[1].h) {
+            SDL_BlitSurface(src, &rects[0], surface, &rects[1]);
+        } else {
+            SDL_BlitSurfaceScaled(src, &rects[0], surface, &rects[1], cmd->data.draw.texture_scale_mode);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        int i;
+        for (i = 0; i < count; i += 3) {
+            SDL_Point d[3];
+            SDL_Rect bounds;
+            if (src) {
+                const GeometryCopyData *ptr = ((const GeometryCopyData *)verts) + i;
+                SDL_Point s[3];
+                SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &bounds);
+                if (bounds.y >= clip.y + clip.h || bounds.y + bounds.h <= clip.y) {
+                    continue;  // not in this tile.
+                }
+                // the blitter may adjust the texture coordinates, so give it a copy; other tiles need them, too.
+                s[0] = ptr[0].src;
+                s[1] = ptr[1].src;
+                s[2] = ptr[2].src;
+                d[0] = ptr[0].dst;
+                d[1] = ptr[1].dst;
+                d[2] = ptr[2].dst;
+                SDL_SW_BlitTriangle(src, &s[0], &s[1], &s[2], surface, &d[0], &d[1], &d[2],
+                                    ptr[0].color, ptr[1].color, ptr[2].color,
+                                    cmd->data.draw.texture_address_mode_u, cmd->data.draw.texture_address_mode_v);
             } else {
-                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+                const GeometryFillData *ptr = ((const GeometryFillData *)verts) + i;
+                SDL_SW_GetTriangleBounds(&ptr[0].dst, &ptr[1].dst, &ptr[2].dst, &bounds);
+                if (bounds.y >= clip.y + clip.h || bounds.y + bounds.h <= clip.y) {
+                    continue;  // not in this tile.
+                }
+                d[0] = ptr[0].dst;
+                d[1] = ptr[1].dst;
+                d[2] = ptr[2].dst;
+                SDL_SW_FillTriangle(surface, &d[0], &d[1], &d[2], blend, ptr[0].color, ptr[1].color, ptr[2].color);
             }
+        }
+        break;
+    }
+
+    default:
+        SDL_assert(!"Unexpected tiled render command");
+        break;
+    }
+}
+
+static void SW_RunTileWorker(SW_TileWorker *worker)
+{
+    SW_TilePool *pool = worker->pool;
+    const int w = pool->surface->w;
+    const int h = pool->surface->h;
+    int t;
+
+    while ((t = SDL_AddAtomicInt(&pool->next_tile, 1)) < pool->num_tiles) {
+        const SW_Tile *tile = &pool->tiles[t];
+        SDL_Rect tilerect;
+        int i;
+
+        tilerect.x = 0;
+        tilerect.y = t * SW_TILE_ROWS;
+        tilerect.w = w;
+        tilerect.h = SDL_min(SW_TILE_ROWS, h - tilerect.y);
+
+        for (i = 0; i < tile->num_commands; i++) {
+            SW_RunTiledCommand(worker, &pool->commands[tile->commands[i]], &tilerect);
+        }
+    }
+}
+
+static int SDLCALL SW_TileWorkerThread(void *data)
+{
+    SW_TileWorker *worker = (SW_TileWorker *)data;
+    SW_TilePool *pool = worker->pool;
+
+    while (true) {
+        SDL_WaitSemaphore(worker->go);
+        if (SDL_GetAtomicInt(&pool->quit)) {
             break;
         }
+        SW_RunTileWorker(worker);
+        SDL_SignalSemaphore(pool->done);
+    }
 
-        case SDL_RENDERCMD_COPY:
-        {
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_Rect *srcrect = verts;
-            SDL_Rect *dstrect = verts + 1;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->internal;
+    return 0;
+}
 
-            SetDrawState(surface, &drawstate);
+// Draw everything that has been sorted into tiles, with the calling thread working too, and wait for it to finish.
+static void SW_RunTiles(SW_TilePool *pool)
+{
+    int i;
 
-            PrepTextureForCopy(cmd, &drawstate);
+    if (pool->num_commands == 0) {
+        return;
+    }
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
+    SDL_SetAtomicInt(&pool->next_tile, 0);
+    for (i = 1; i < pool->num_workers; i++) {
+        SDL_SignalSemaphore(pool->workers[i].go);
+    }
+
+    SW_RunTileWorker(&pool->workers[0]);
+
+    for (i = 1; i < pool->num_workers; i++) {
+        SDL_WaitSemaphore(pool->done);
+    }
+
+    for (i = 0; i < pool->num_tiles; i++) {
+        pool->tiles[i].num_commands = 0;
+    }
+    pool->num_commands = 0;
+}
+
+// Returns the slot of a texture surface that workers can make views of, or -1 on failure.
+static int SW_GetTileTextureSlot(SW_TilePool *pool, SDL_Surface *surface)
+{
+    const void *value;
+    int slot;
+    int i;
+
+    if (SDL_FindInHashTable(pool->texture_slots, surface, &value)) {
+        return (int)(intptr_t)value;
+    }
+
+    for (slot = 0; slot < pool->num_textures; slot++) {
+        if (!pool->textures[slot]) {
+            break;
+        }
+    }
+
+    if (slot == pool->num_textures) {
+        const int num_textures = pool->num_textures ? (pool->num_textures * 2) : 16;
+        SDL_Surface **textures = (SDL_Surface **)SDL_realloc(pool->textures, num_textures * sizeof(*textures));
+        if (!textures) {
+            return -1;
+        }
+        pool->textures = textures;
+        for (i = 0; i < pool->num_workers; i++) {
+            SW_TileWorker *worker = &pool->workers[i];
+            textures = (SDL_Surface **)SDL_realloc(worker->textures, num_textures * sizeof(*textures));
+            if (!textures) {
+                return -1;
             }
+            SDL_memset(textures + pool->num_textures, 0, (num_textures - pool->num_textures) * sizeof(*textures));
+            worker->textures = textures;
+        }
+        SDL_memset(pool->textures + pool->num_textures, 0, (num_textures - pool->num_textures) * sizeof(*textures));
+        pool->num_textures = num_textures;
+    }
 
-            if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
-                SDL_BlitSurface(src, srcrect, surface, dstrect);
-            } else {
-                /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                 * to avoid potentially frequent RLE encoding/decoding.
-                 */
-                SDL_SetSurfaceRLE(surface, 0);
-
-                // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
-                if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                    SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                    // Scale to an intermediate surface, then blit
-                    if (tmp) {
-                        SDL_Rect r;
-                        SDL_BlendMode blendmode;
-                        Uint8 alphaMod, rMod, gMod, bMod;
-
-                        SDL_GetSurfaceBlendMode(src, &blendmode);
-                        SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                        SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                        r.x = 0;
-                        r.y = 0;
-                        r.w = dstrect->w;
-                        r.h = dstrect->h;
-
-                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                        SDL_SetSurfaceAlphaMod(src, 255);
-
-                        SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, cmd->data.draw.texture_scale_mode);
-
-                        SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                        SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                        SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                        SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                        SDL_DestroySurface(tmp);
-                        // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
-                    }
-                } else {
-                    SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, cmd->data.draw.texture_scale_mode);
+    if (!SDL_InsertIntoHashTable(pool->texture_slots, surface, (const void *)(intptr_t)slot, false)) {
+        return -1;
+    }
+    pool->textures[slot] = surface;
+    return slot;
+}
+
+// Forget a texture surface that is going away, along with any views of it.
+static void SW_RemoveTileTexture(SW_TilePool *pool, SDL_Surface *surface)
+{
+    const void *value;
+    int slot;
+    int i;
+
+    if (!SDL_FindInHashTable(pool->texture_slots, surface, &value)) {
+        return;
+    }
+    slot = (int)(intptr_t)value;
+
+    for (i = 0; i < pool->num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        SDL_DestroySurface(worker->textures[slot]);
+        worker->textures[slot] = NULL;
+    }
+    pool->textures[slot] = NULL;
+    SDL_RemoveFromHashTable(pool->texture_slots, surface);
+}
+
+// Get ready to sort commands for `surface` into tiles. Returns false if the commands should be drawn on this thread.
+static bool SW_BeginTiles(SW_TilePool *pool, SDL_Surface *surface, void *vertices)
+{
+    const int num_tiles = (surface->h + SW_TILE_ROWS - 1) / SW_TILE_ROWS;
+    int i;
+
+    if (SDL_MUSTLOCK(surface) || !surface->pixels) {
+        return false;
+    }
+
+    if (num_tiles > pool->max_tiles) {
+        SW_Tile *tiles = (SW_Tile *)SDL_realloc(pool->tiles, num_tiles * sizeof(*tiles));
+        if (!tiles) {
+            return false;
+        }
+        SDL_memset(tiles + pool->max_tiles, 0, (num_tiles - pool->max_tiles) * sizeof(*tiles));
+        pool->tiles = tiles;
+        pool->max_tiles = num_tiles;
+    }
+
+    for (i = 0; i < pool->num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        worker->surface = SW_CreateSurfaceView(surface);
+        if (!worker->surface) {
+            while (i--) {
+                SDL_DestroySurface(pool->workers[i].surface);
+                pool->workers[i].surface = NULL;
+            }
+            return false;
+        }
+    }
+
+    pool->surface = surface;
+    pool->vertices = vertices;
+    pool->num_tiles = num_tiles;
+    pool->num_commands = 0;
+    return true;
+}
+
+// Draw whatever is still waiting in the tiles.
+static void SW_EndTiles(SW_TilePool *pool)
+{
+    int i;
+
+    SW_RunTiles(pool);
+
+    for (i = 0; i < pool->num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        SDL_DestroySurface(worker->surface);
+        worker->surface = NULL;
+    }
+    pool->surface = NULL;
+    pool->vertices = NULL;
+}
+
+// Sort a command into every tile with rows between `y0` and `y1`, inclusive.
+static bool SW_AddTiledCommand(SW_TilePool *pool, const SW_TiledCommand *tiled, int y0, int y1)
+{
+    const int index = pool->num_commands;
+    int t;
+
+    y0 = SDL_max(y0, tiled->clip.y);
+    y1 = SDL_min(y1, tiled->clip.y + tiled->clip.h - 1);
+    if (y0 > y1) {
+        return true;  // nothing to draw.
+    }
+
+    if (index == pool->max_commands) {
+        const int max_commands = pool->max_commands ? (pool->max_commands * 2) : 256;
+        SW_TiledCommand *commands = (SW_TiledCommand *)SDL_realloc(pool->commands, max_commands * sizeof(*commands));
+        if (!commands) {
+            return false;
+        }
+        pool->commands = commands;
+        pool->max_commands = max_commands;
+    }
+
+    for (t = y0 / SW_TILE_ROWS; t <= y1 / SW_TILE_ROWS; t++) {
+        SW_Tile *tile = &pool->tiles[t];
+        if (tile->num_commands == tile->max_commands) {
+            const int max_commands = tile->max_commands ? (tile->max_commands * 2) : 64;
+            int *commands = (int *)SDL_realloc(tile->commands, max_commands * sizeof(*commands));
+            if (!commands) {
+                // undo this command in the tiles it already went into.
+                while (t-- > y0 / SW_TILE_ROWS) {
+                    pool->tiles[t].num_commands--;
                 }
+                return false;
             }
-            break;
+            tile->commands = commands;
+            tile->max_commands = max_commands;
         }
+        tile->commands[tile->num_commands++] = index;
+    }
 
-        case SDL_RENDERCMD_COPY_EX:
-        {
-            CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
+    SDL_copyp(&pool->commands[index], tiled);
+    pool->num_commands++;
+    return true;
+}
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
+// the surface clip rect SetDrawState() would set up.
+static void SW_GetDrawClipRect(SDL_Surface *surface, const SW_DrawStateCache *drawstate, SDL_Rect *clip)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_Rect rect;
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = surface->w;
+    rect.h = surface->h;
+
+    if (cliprect) {
+        SDL_Rect clip_rect;
+        clip_rect.x = cliprect->x + viewport->x;
+        clip_rect.y = cliprect->y + viewport->y;
+        clip_rect.w = cliprect->w;
+        clip_rect.h = cliprect->h;
+        SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
+        SDL_GetRectIntersection(&clip_rect, &rect, clip);
+    } else {
+        SDL_GetRectIntersection(viewport, &rect, clip);
+    }
+}
+
+/* Sort a command into tiles, or take care of it if it only changes the draw state. Returns false if it has to be
+   drawn on this thread, after everything already in the tiles. */
+static bool SW_QueueTiledCommand(SDL_Renderer *renderer, SW_TilePool *pool, SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+{
+    SDL_Surface *surface = pool->surface;
+    const SDL_Rect *viewport;
+    SW_TiledCommand tiled;
+    void *verts;
+    int count;
+    int y0 = SDL_MAX_SINT32, y1 = SDL_MIN_SINT32;
+    int i;
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+    case SDL_RENDERCMD_SETVIEWPORT:
+    case SDL_RENDERCMD_SETCLIPRECT:
+    case SDL_RENDERCMD_NO_OP:
+        SW_RunCommand(renderer, surface, cmd, pool->vertices, drawstate);
+        return true;
+
+    case SDL_RENDERCMD_CLEAR:
+        tiled.cmd = cmd;
+        tiled.clip.x = 0;
+        tiled.clip.y = 0;
+        tiled.clip.w = surface->w;
+        tiled.clip.h = surface->h;
+        tiled.color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        tiled.color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        tiled.color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+        tiled.color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+        tiled.pixel = SDL_MapSurfaceRGBA(surface, tiled.color.r, tiled.color.g, tiled.color.b, tiled.color.a);
+        tiled.texture = -1;
+        return SW_AddTiledCommand(pool, &tiled, 0, surface->h - 1);
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_GEOMETRY:
+        break;
+
+    default:
+        return false;
+    }
+
+    viewport = drawstate->viewport;
+    SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
+
+    verts = ((Uint8 *)pool->vertices) + cmd->data.draw.first;
+    count = (int)cmd->data.draw.count;
+    if (count <= 0) {
+        return true;  // nothing to draw.
+    }
+
+    tiled.cmd = cmd;
+    SW_GetDrawClipRect(surface, drawstate, &tiled.clip);
+    tiled.color = drawstate->color;
+    tiled.pixel = SDL_MapSurfaceRGBA(surface, tiled.color.r, tiled.color.g, tiled.color.b, tiled.color.a);
+    tiled.texture = -1;
+
+    if (cmd->data.draw.texture) {
+        SDL_Surface *src = (SDL_Surface *)cmd->data.draw.texture->internal;
+        if (src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+            return false;  // the encoded data can't be shared between threads.
+        }
+        if (cmd->command == SDL_RENDERCMD_COPY) {
+            const SDL_Rect *rects = (const SDL_Rect *)verts;
+            if (rects[1].w > SDL_MAX_UINT16 || rects[1].h > SDL_MAX_UINT16) {
+                return false;  // scaling this large comes out differently when clipped.
             }
+        }
+        tiled.texture = SW_GetTileTextureSlot(pool, src);
+        if (tiled.texture < 0) {
+            return false;
+        }
+    }
 
-            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
-                            copydata->scale_x, copydata->scale_y, cmd->data.draw.texture_scale_mode);
-            break;
+    // find the rows the command can touch, and once it's safely in the tiles, apply the viewport.
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        SDL_Point *points = (SDL_Point *)verts;
+        for (i = 0; i < count; i++) {
+            y0 = SDL_min(y0, points[i].y);
+            y1 = SDL_max(y1, points[i].y);
+        }
+        if (!SW_AddTiledCommand(pool, &tiled, y0 + viewport->y, y1 + viewport->y)) {
+            return false;
         }
+        for (i = 0; i < count; i++) {
+            points[i].x += viewport->x;
+            points[i].y += viewport->y;
+        }
+        break;
+    }
 
-        case SDL_RENDERCMD_GEOMETRY:
-        {
-            int i;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const int count = (int)cmd->data.draw.count;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            const SDL_BlendMode blend = cmd->data.draw.blend;
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        SDL_Rect *rects = (SDL_Rect *)verts;
+        for (i = 0; i < count; i++) {
+            y0 = SDL_min(y0, rects[i].y);
+            y1 = SDL_max(y1, rects[i].y + rects[i].h - 1);
+        }
+        if (!SW_AddTiledCommand(pool, &tiled, y0 + viewport->y, y1 + viewport->y)) {
+            return false;
+        }
+        for (i = 0; i < count; i++) {
+            rects[i].x += viewport->x;
+            rects[i].y += viewport->y;
+        }
+        break;
+    }
 
-            SetDrawState(surface, &drawstate);
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *dstrect = ((SDL_Rect *)verts) + 1;
+        y0 = dstrect->y;
+        y1 = dstrect->y + dstrect->h - 1;
+        if (!SW_AddTiledCommand(pool, &tiled, y0 + viewport->y, y1 + viewport->y)) {
+            return false;
+        }
+        dstrect->x += viewport->x;
+        dstrect->y += viewport->y;
+        break;
+    }
 
-            if (texture) {
-                SDL_Surface *src = (SDL_Surface *)texture->internal;
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        const size_t stride = cmd->data.draw.texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+        const size_t offset = cmd->data.draw.texture ? offsetof(GeometryCopyData, dst) : offsetof(GeometryFillData, dst);
+        Uint8 *dsts = ((Uint8 *)verts) + offset;
+        SDL_Point vp;
+        vp.x = viewport->x;
+        vp.y = viewport->y;
+        trianglepoint_2_fixedpoint(&vp);
+        for (i = 0; i < count; i += 3) {
+            SDL_Point d[3];
+            SDL_Rect bounds;
+            int j;
+            for (j = 0; j < 3; j++) {
+                d[j] = *(SDL_Point *)(dsts + (i + j) * stride);
+                d[j].x += vp.x;
+                d[j].y += vp.y;
+            }
+            SDL_SW_GetTriangleBounds(&d[0], &d[1], &d[2], &bounds);
+            y0 = SDL_min(y0, bounds.y);
+            y1 = SDL_max(y1, bounds.y + bounds.h - 1);
+        }
+        if (!SW_AddTiledCommand(pool, &tiled, y0, y1)) {
+            return false;
+        }
+        for (i = 0; i < count; i++) {
+            SDL_Point *dst = (SDL_Point *)(dsts + i * stride);
+            dst->x += vp.x;
+            dst->y += vp.y;
+        }
+        break;
+    }
 
-                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+    default:
+        break;
+    }
 
-                PrepTextureForCopy(cmd, &drawstate);
+    return true;
+}
 
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
+static void SW_DestroyTilePool(SW_TilePool *pool)
+{
+    int i, j;
 
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_BlitTriangle(
-                        src,
-                        &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
-                        surface,
-                        &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
-                        ptr[0].color, ptr[1].color, ptr[2].color,
-                        cmd->data.draw.texture_address_mode_u,
-                        cmd->data.draw.texture_address_mode_v);
-                }
-            } else {
-                GeometryFillData *ptr = (GeometryFillData *)verts;
-
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
+    if (!pool) {
+        return;
+    }
 
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
-                }
+    SDL_SetAtomicInt(&pool->quit, 1);
+
+    for (i = 1; i < pool->num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        if (worker->thread) {
+            SDL_SignalSemaphore(worker->go);
+            SDL_WaitThread(worker->thread, NULL);
+        }
+    }
+
+    for (i = 0; i < pool->num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        for (j = 0; j < pool->num_textures; j++) {
+            SDL_DestroySurface(worker->textures[j]);
+        }
+        SDL_free(worker->textures);
+        SDL_DestroySemaphore(worker->go);
+    }
+
+    for (i = 0; i < pool->max_tiles; i++) {
+        SDL_free(pool->tiles[i].commands);
+    }
+
+    SDL_DestroyHashTable(pool->texture_slots);
+    SDL_DestroySemaphore(pool->done);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool->textures);
+    SDL_free(pool->tiles);
+    SDL_free(pool->commands);
+    SDL_free(pool->workers);
+    SDL_free(pool);
+}
+
+// Returns NULL if drawing on several threads isn't requested, or if we failed to set it up.
+static SW_TilePool *SW_CreateTilePool(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    const int num_workers = hint ? SDL_min(SDL_atoi(hint), SW_MAX_THREADS) : 0;
+    SW_TilePool *pool;
+    int i;
+
+    if (num_workers < 2) {
+        return NULL;
+    }
+
+    pool = (SW_TilePool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->workers = (SW_TileWorker *)SDL_calloc(num_workers, sizeof(*pool->workers));
+    pool->done = SDL_CreateSemaphore(0);
+    pool->lock = SDL_CreateMutex();
+    pool->texture_slots = SDL_CreateHashTable(0, false, SDL_HashPointer, SDL_KeyMatchPointer, NULL, NULL);
+    if (!pool->workers || !pool->done || !pool->lock || !pool->texture_slots) {
+        SW_DestroyTilePool(pool);
+        return NULL;
+    }
+
+    pool->num_workers = num_workers;
+    for (i = 0; i < num_workers; i++) {
+        pool->workers[i].pool = pool;
+    }
+
+    for (i = 1; i < num_workers; i++) {
+        SW_TileWorker *worker = &pool->workers[i];
+        worker->go = SDL_CreateSemaphore(0);
+        if (!worker->go) {
+            SW_DestroyTilePool(pool);
+            return NULL;
+        }
+        worker->thread = SDL_CreateThread(SW_TileWorkerThread, "SDLSWRender", worker);
+        if (!worker->thread) {
+            SW_DestroyTilePool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+// Partial present. See SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT.
+//
+// While commands draw into the window surface, the area each one can touch is added to a short list of rectangles,
+// which are merged whenever that doesn't increase the number of pixels to send. SW_RenderPresent() sends only those
+// rectangles to the window, or the whole surface if something (a clear, a resize, an expose) touched all of it.
+
+static Sint64 SW_GetRectArea(const SDL_Rect *rect)
+{
+    return (Sint64)rect->w * rect->h;
+}
+
+static void SW_AddDirtyRect(SW_RenderData *data, const SDL_Rect *rect)
+{
+    SDL_Rect merged = *rect;
+    int i = 0;
+
+    if (data->dirty_all || SDL_RectEmpty(&merged)) {
+        return;
+    }
+
+    while (i < data->num_dirty) {
+        SDL_Rect both;
+        SDL_GetRectUnion(&data->dirty[i], &merged, &both);
+        if (SW_GetRectArea(&both) <= SW_GetRectArea(&data->dirty[i]) + SW_GetRectArea(&merged)) {
+            // sending the union costs no more than sending both, and it might now overlap others.
+            merged = both;
+            data->dirty[i] = data->dirty[--data->num_dirty];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (data->num_dirty == SW_MAX_DIRTY_RECTS) {
+        // out of room, merge with the rectangle that grows the least.
+        Sint64 best_growth = SDL_MAX_SINT64;
+        int best = 0;
+        for (i = 0; i < data->num_dirty; i++) {
+            SDL_Rect both;
+            Sint64 growth;
+            SDL_GetRectUnion(&data->dirty[i], &merged, &both);
+            growth = SW_GetRectArea(&both) - SW_GetRectArea(&data->dirty[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
             }
-            break;
         }
+        SDL_GetRectUnion(&data->dirty[best], &merged, &merged);
+        data->dirty[best] = data->dirty[--data->num_dirty];
+        SW_AddDirtyRect(data, &merged);
+        return;
+    }
 
-        case SDL_RENDERCMD_NO_OP:
-            break;
+    data->dirty[data->num_dirty++] = merged;
+}
+
+// Add the area a command can draw to, before SW_RunCommand() or SW_QueueTiledCommand() applies the viewport to it.
+static void SW_AddDirtyCommand(SW_RenderData *data, SDL_Surface *surface, const SDL_RenderCommand *cmd, const void *vertices, const SW_DrawStateCache *drawstate)
+{
+    const void *verts = ((const Uint8 *)vertices) + cmd->data.draw.first;
+    const int count = (int)cmd->data.draw.count;
+    const SDL_Rect *viewport = drawstate->viewport;
+    SDL_Rect clip, bounds;
+    int i;
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_CLEAR:
+        data->dirty_all = true;
+        return;
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_COPY_EX:
+    case SDL_RENDERCMD_GEOMETRY:
+        break;
+
+    default:
+        return;
+    }
+
+    if (count <= 0 || data->dirty_all) {
+        return;
+    }
+    SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
+
+    SW_GetDrawClipRect(surface, drawstate, &clip);
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        const SDL_Point *points = (const SDL_Point *)verts;
+        int x0 = points[0].x, y0 = points[0].y, x1 = points[0].x, y1 = points[0].y;
+        for (i = 1; i < count; i++) {
+            x0 = SDL_min(x0, points[i].x);
+            y0 = SDL_min(y0, points[i].y);
+            x1 = SDL_max(x1, points[i].x);
+            y1 = SDL_max(y1, points[i].y);
+        }
+        bounds.x = x0 + viewport->x;
+        bounds.y = y0 + viewport->y;
+        bounds.w = x1 - x0 + 1;
+        bounds.h = y1 - y0 + 1;
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts;
+        bounds = rects[0];
+        for (i = 1; i < count; i++) {
+            SDL_GetRectUnion(&bounds, &rects[i], &bounds);
+        }
+        bounds.x += viewport->x;
+        bounds.y += viewport->y;
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+        bounds = ((const SDL_Rect *)verts)[1];
+        bounds.x += viewport->x;
+        bounds.y += viewport->y;
+        break;
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        const size_t stride = cmd->data.draw.texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+        const size_t offset = cmd->data.draw.texture ? offsetof(GeometryCopyData, dst) : offsetof(GeometryFillData, dst);
+        const Uint8 *dsts = ((const Uint8 *)verts) + offset;
+        SDL_Point vp;
+        vp.x = viewport->x;
+        vp.y = viewport->y;
+        trianglepoint_2_fixedpoint(&vp);
+        SDL_zero(bounds);
+        for (i = 0; i < count; i += 3) {
+            SDL_Point d[3];
+            SDL_Rect triangle;
+            int j;
+            for (j = 0; j < 3; j++) {
+                d[j] = *(const SDL_Point *)(dsts + (i + j) * stride);
+                d[j].x += vp.x;
+                d[j].y += vp.y;
+            }
+            SDL_SW_GetTriangleBounds(&d[0], &d[1], &d[2], &triangle);
+            SDL_GetRectUnion(&bounds, &triangle, &bounds);
+        }
+        break;
+    }
+
+    default:
+        // rotated and scaled copies can land anywhere in the clip rect.
+        bounds = clip;
+        break;
+    }
+
+    if (SDL_GetRectIntersection(&bounds, &clip, &bounds)) {
+        SW_AddDirtyRect(data, &bounds);
+    }
+}
+
+static bool SW_PrepareCommandQueue(SDL_Renderer *renderer)
+{
+    // Get the window surface now, the queue might be run on the render thread.
+    return SW_ActivateRenderer(renderer) != NULL;
+}
+
+static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
+    bool track_dirty;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return false;
+    }
+
+    track_dirty = (data->partial_present && renderer->window && surface == data->window);
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = true;
+    drawstate.color.r = 0;
+    drawstate.color.g = 0;
+    drawstate.color.b = 0;
+    drawstate.color.a = 0;
+
+    if (data->tiles && SW_BeginTiles(data->tiles, surface, vertices)) {
+        while (cmd) {
+            if (track_dirty) {
+                SW_AddDirtyCommand(data, surface, cmd, vertices, &drawstate);
+            }
+            if (!SW_QueueTiledCommand(renderer, data->tiles, cmd, &drawstate)) {
+                SW_RunTiles(data->tiles);
+                SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
+            }
+            cmd = cmd->next;
         }
+        SW_EndTiles(data->tiles);
+        return true;
+    }
 
+    while (cmd) {
+        if (track_dirty) {
+            SW_AddDirtyCommand(data, surface, cmd, vertices, &drawstate);
+        }
+        SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
         cmd = cmd->next;
     }
 
@@ -988,18 +1874,44 @@ static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
 
 static bool SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Window *window = renderer->window;
+    Sint64 presented = 0;
+    bool result;
+    int i;
 
     if (!window) {
         return false;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    if (data->partial_present && !data->dirty_all && data->window) {
+        result = SDL_UpdateWindowSurfaceRects(window, data->dirty, data->num_dirty);
+        for (i = 0; i < data->num_dirty; i++) {
+            presented += SW_GetRectArea(&data->dirty[i]) * data->window->fmt->bytes_per_pixel;
+        }
+    } else {
+        result = SDL_UpdateWindowSurface(window);
+        if (data->window) {
+            presented = (Sint64)data->window->h * data->window->w * data->window->fmt->bytes_per_pixel;
+        }
+    }
+    SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, presented);
+
+    if (result) {
+        data->dirty_all = false;
+        data->num_dirty = 0;
+    }
+    return result;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Surface *surface = (SDL_Surface *)texture->internal;
 
+    if (data->tiles) {
+        SW_RemoveTileTexture(data->tiles, surface);
+    }
     SDL_DestroySurface(surface);
 }
 
@@ -1011,6 +1923,7 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    SW_DestroyTilePool(data->tiles);
     SDL_free(data);
 }
 
@@ -1125,6 +2038,9 @@ bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, S
     }
     data->surface = surface;
     data->window = surface;
+    data->tiles = SW_CreateTilePool();
+    data->partial_present = SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT, true);
+    data->dirty_all = true;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -1142,6 +2058,7 @@ bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, S
     renderer->QueueCopyEx = SW_QueueCopyEx;
     renderer->QueueGeometry = SW_QueueGeometry;
     renderer->InvalidateCachedState = SW_InvalidateCachedState;
+    renderer->PrepareCommandQueue = SW_PrepareCommandQueue;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
     renderer->RenderPresent = SW_RenderPresent;
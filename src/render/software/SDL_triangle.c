@@ -162,70 +162,477 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     r->h = (max_y - min_y);
 }
 
+// the pixels a triangle (in fixed point) can touch, before clipping
+void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect)
+{
+    bounding_rect_fixedpoint(d0, d1, d2, rect);
+}
+
 /* Triangle rendering, using Barycentric coordinates (w0, w1, w2)
  *
- * The cross product isn't computed from scratch at each iteration,
- * but optimized using constant step increments
+ * The cross products are linear in x, so for each row the first and last
+ * pixel inside all three edges are solved for directly, and only that span
+ * is walked.
  *
+ * Texture coordinates and colors are (w0 * a + w1 * b + w2 * c) / area.
+ * The numerator is linear too, so it is kept as a quotient and a remainder
+ * and stepped along the span without dividing, with the same result as the
+ * division.
+ */
+
+// floor(n / d), for d > 0
+static Sint64 floor_div(Sint64 n, Sint64 d)
+{
+    Sint64 q = n / d;
+    if ((n % d) != 0 && n < 0) {
+        q--;
+    }
+    return q;
+}
+
+// narrow [x0, x1) to the pixels where (w + x * step + bias >= 0)
+static void clip_span_to_edge(Sint64 w, int step, int bias, int *x0, int *x1)
+{
+    if (step > 0) {
+        Sint64 first = -floor_div(w + bias, step);
+        if (first > *x0) {
+            *x0 = (first < *x1) ? (int)first : *x1;
+        }
+    } else if (step < 0) {
+        Sint64 end = floor_div(w + bias, -step) + 1;
+        if (end < *x1) {
+            *x1 = (end > *x0) ? (int)end : *x0;
+        }
+    } else if (w + bias < 0) {
+        *x1 = *x0;
+    }
+}
+
+// a value interpolated along a span: numerator == value * area + frac
+typedef struct
+{
+    int value;        // floor(numerator / area)
+    Sint64 frac;      // in [0, area)
+    int step;         // floor(numerator step / area)
+    Sint64 step_frac; // in [0, area)
+} TriangleInterp;
+
+static void interp_start(TriangleInterp *t, Sint64 numerator, Sint64 area)
+{
+    const Sint64 value = floor_div(numerator, area);
+    t->value = (int)value;
+    t->frac = numerator - value * area;
+}
+
+static void interp_set_step(TriangleInterp *t, Sint64 numerator_step, Sint64 area)
+{
+    const Sint64 step = floor_div(numerator_step, area);
+    t->step = (int)step;
+    t->step_frac = numerator_step - step * area;
+}
+
+static SDL_INLINE void interp_step(TriangleInterp *t, Sint64 area)
+{
+    t->value += t->step;
+    t->frac += t->step_frac;
+    if (t->frac >= area) {
+        t->frac -= area;
+        t->value++;
+    }
+}
+
+// the numerator divided by area, rounded toward zero like the C division
+#define INTERP_TRUNC(t) ((t).value + ((t).value < 0 && (t).frac != 0))
+
+/* What is interpolated along the spans: TRIANGLE_STEPS_x declares the values and
+ * their steps, TRIANGLE_START_x sets them at the start of a span, and
+ * TRIANGLE_STEP_x moves them to the next pixel.
  */
+#define TRIANGLE_STEPS_NONE
+#define TRIANGLE_START_NONE
+#define TRIANGLE_STEP_NONE
+
+#define TRIANGLE_STEPS_TEXTCOORD                                                         \
+    TriangleInterp interp_u, interp_v;                                                   \
+    interp_set_step(&interp_u, (Sint64)d2d1_y * s2s0_x + (Sint64)d0d2_y * s2s1_x, area); \
+    interp_set_step(&interp_v, (Sint64)d2d1_y * s2s0_y + (Sint64)d0d2_y * s2s1_y, area);
+
+#define TRIANGLE_START_TEXTCOORD                                                \
+    interp_start(&interp_u, w0 * s2s0_x + w1 * s2s1_x + s2_x_area.x, area);     \
+    interp_start(&interp_v, w0 * s2s0_y + w1 * s2s1_y + s2_x_area.y, area);
+
+#define TRIANGLE_STEP_TEXTCOORD      \
+    interp_step(&interp_u, area);    \
+    interp_step(&interp_v, area);
+
+#define TRIANGLE_SET_COLOR_STEP(t, C) \
+    interp_set_step(&(t), (Sint64)d2d1_y * c0.C + (Sint64)d0d2_y * c1.C + (Sint64)d1d0_y * c2.C, area)
+
+#define TRIANGLE_START_COLOR_CHANNEL(t, C) \
+    interp_start(&(t), w0 * c0.C + w1 * c1.C + w2 * c2.C, area)
+
+#define TRIANGLE_STEPS_COLOR                                 \
+    TriangleInterp interp_r, interp_g, interp_b, interp_a;   \
+    SDL_zero(interp_r);                                      \
+    SDL_zero(interp_g);                                      \
+    SDL_zero(interp_b);                                      \
+    SDL_zero(interp_a);                                      \
+    TRIANGLE_SET_COLOR_STEP(interp_r, r);                    \
+    TRIANGLE_SET_COLOR_STEP(interp_g, g);                    \
+    TRIANGLE_SET_COLOR_STEP(interp_b, b);                    \
+    TRIANGLE_SET_COLOR_STEP(interp_a, a);
+
+#define TRIANGLE_START_COLOR                       \
+    TRIANGLE_START_COLOR_CHANNEL(interp_r, r);     \
+    TRIANGLE_START_COLOR_CHANNEL(interp_g, g);     \
+    TRIANGLE_START_COLOR_CHANNEL(interp_b, b);     \
+    TRIANGLE_START_COLOR_CHANNEL(interp_a, a);
+
+#define TRIANGLE_STEP_COLOR          \
+    interp_step(&interp_r, area);    \
+    interp_step(&interp_g, area);    \
+    interp_step(&interp_b, area);    \
+    interp_step(&interp_a, area);
+
+// texture coordinates, and the colors too unless 'is_uniform'
+#define TRIANGLE_STEPS_TEXTCOORD_COLOR \
+    TRIANGLE_STEPS_TEXTCOORD           \
+    TRIANGLE_STEPS_COLOR
+
+#define TRIANGLE_START_TEXTCOORD_COLOR \
+    TRIANGLE_START_TEXTCOORD           \
+    if (!is_uniform) {                 \
+        TRIANGLE_START_COLOR           \
+    }
+
+#define TRIANGLE_STEP_TEXTCOORD_COLOR \
+    TRIANGLE_STEP_TEXTCOORD           \
+    if (!is_uniform) {                \
+        TRIANGLE_STEP_COLOR           \
+    }
 
-#define TRIANGLE_BEGIN_LOOP                                                        \
-    {                                                                              \
-        int x, y;                                                                  \
-        for (y = 0; y < dstrect.h; y++) {                                          \
-            /* y start */                                                          \
-            Sint64 w0 = w0_row;                                                    \
-            Sint64 w1 = w1_row;                                                    \
-            Sint64 w2 = w2_row;                                                    \
-            for (x = 0; x < dstrect.w; x++) {                                      \
-                /* In triangle */                                                  \
-                if (w0 + bias_w0 >= 0 && w1 + bias_w1 >= 0 && w2 + bias_w2 >= 0) { \
-                    Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
-
-// Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles
-#define TRIANGLE_GET_TEXTCOORD                                                          \
-    int srcx = (int)(((Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x) / area); \
-    int srcy = (int)(((Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y) / area); \
-    if (texture_address_mode_u == SDL_TEXTURE_ADDRESS_WRAP) {                           \
-        srcx %= src_surface->w;                                                         \
-        if (srcx < 0) {                                                                 \
-            srcx += (src_surface->w - 1);                                               \
-        }                                                                               \
-    }                                                                                   \
-    if (texture_address_mode_v == SDL_TEXTURE_ADDRESS_WRAP) {                           \
-        srcy %= src_surface->h;                                                         \
-        if (srcy < 0) {                                                                 \
-            srcy += (src_surface->h - 1);                                               \
-        }                                                                               \
-    }
-
-#define TRIANGLE_GET_MAPPED_COLOR                                                      \
-    Uint8 r = (Uint8)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    Uint8 g = (Uint8)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    Uint8 b = (Uint8)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    Uint8 a = (Uint8)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area); \
+/* Walk the spans of the triangle, one row at a time.
+ * Inside a span, 'x' is the first pixel and 'x_end' one past the last one.
+ */
+#define TRIANGLE_BEGIN_SPANS(INTERP)                                    \
+    {                                                                   \
+        int x, y, x_end;                                                \
+        TRIANGLE_STEPS_##INTERP                                         \
+        for (y = 0; y < dstrect.h; y++) {                               \
+            x = 0;                                                      \
+            x_end = dstrect.w;                                          \
+            clip_span_to_edge(w0_row, d2d1_y, bias_w0, &x, &x_end);     \
+            clip_span_to_edge(w1_row, d0d2_y, bias_w1, &x, &x_end);     \
+            clip_span_to_edge(w2_row, d1d0_y, bias_w2, &x, &x_end);     \
+            if (x < x_end) {                                            \
+                const Sint64 w0 = w0_row + (Sint64)x * d2d1_y;          \
+                const Sint64 w1 = w1_row + (Sint64)x * d0d2_y;          \
+                const Sint64 w2 = w2_row + (Sint64)x * d1d0_y;          \
+                (void)w0;                                               \
+                (void)w1;                                               \
+                (void)w2;                                               \
+                TRIANGLE_START_##INTERP
+
+#define TRIANGLE_END_SPANS \
+    }                      \
+    /* y += 1 */           \
+    w0_row += d1d2_x;      \
+    w1_row += d2d0_x;      \
+    w2_row += d0d1_x;      \
+    dst_ptr += dst_pitch;  \
+    }                      \
+    }
+
+// Visit each pixel of the spans. The body may 'continue' to skip a pixel.
+#define TRIANGLE_BEGIN_LOOP(INTERP)                     \
+    TRIANGLE_BEGIN_SPANS(INTERP)                        \
+    for (; x < x_end; x++) {                            \
+        Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;    \
+        do {
+
+#define TRIANGLE_END_LOOP(INTERP) \
+    } while (0);                  \
+    /* x += 1 */                  \
+    TRIANGLE_STEP_##INTERP        \
+    }                             \
+    TRIANGLE_END_SPANS
+
+// Coordinates already inside the texture are left as they are, which avoids the modulo
+#define TRIANGLE_GET_TEXTCOORD                                                  \
+    int srcx = INTERP_TRUNC(interp_u);                                          \
+    int srcy = INTERP_TRUNC(interp_v);                                          \
+    if (texture_address_mode_u == SDL_TEXTURE_ADDRESS_WRAP &&                   \
+        (unsigned int)srcx >= (unsigned int)src_surface->w) {                   \
+        srcx %= src_surface->w;                                                 \
+        if (srcx < 0) {                                                         \
+            srcx += (src_surface->w - 1);                                       \
+        }                                                                       \
+    }                                                                           \
+    if (texture_address_mode_v == SDL_TEXTURE_ADDRESS_WRAP &&                   \
+        (unsigned int)srcy >= (unsigned int)src_surface->h) {                   \
+        srcy %= src_surface->h;                                                 \
+        if (srcy < 0) {                                                         \
+            srcy += (src_surface->h - 1);                                       \
+        }                                                                       \
+    }
+
+// Inside the triangle w0, w1 and w2 are not negative, so the colors are in [0, 255]
+#define TRIANGLE_GET_MAPPED_COLOR                              \
+    Uint8 r = (Uint8)interp_r.value;                           \
+    Uint8 g = (Uint8)interp_g.value;                           \
+    Uint8 b = (Uint8)interp_b.value;                           \
+    Uint8 a = (Uint8)interp_a.value;                           \
     Uint32 color = SDL_MapRGBA(format, palette, r, g, b, a);
 
-#define TRIANGLE_GET_COLOR                                                             \
-    int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    int g = (int)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    int b = (int)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    int a = (int)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area);
-
-#define TRIANGLE_END_LOOP \
-    }                     \
-    /* x += 1 */          \
-    w0 += d2d1_y;         \
-    w1 += d0d2_y;         \
-    w2 += d1d0_y;         \
-    }                     \
-    /* y += 1 */          \
-    w0_row += d1d2_x;     \
-    w1_row += d2d0_x;     \
-    w2_row += d0d1_x;     \
-    dst_ptr += dst_pitch; \
-    }                     \
+#define TRIANGLE_GET_COLOR       \
+    int r = interp_r.value;      \
+    int g = interp_g.value;      \
+    int b = interp_b.value;      \
+    int a = interp_a.value;
+
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE int hasSSE2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasSSE2();
+    return val;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE int hasNEON(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
     }
+    val = SDL_HasNEON();
+    return val;
+}
+#endif
+
+// Fill a span with a 2 or 4 byte pixel value
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") fill_span_SSE2(Uint8 *dst, int count, int bpp, Uint32 color)
+{
+    const __m128i c128 = _mm_set1_epi32((int)color);
+    while (count > 0 && ((uintptr_t)dst & 15)) {
+        if (bpp == 4) {
+            *(Uint32 *)dst = color;
+        } else {
+            *(Uint16 *)dst = (Uint16)color;
+        }
+        dst += bpp;
+        count--;
+    }
+    // a 2 byte pixel always starts on an even address, so the pattern still lines up
+    while (count * bpp >= 16) {
+        _mm_store_si128((__m128i *)dst, c128);
+        dst += 16;
+        count -= 16 / bpp;
+    }
+    while (count > 0) {
+        if (bpp == 4) {
+            *(Uint32 *)dst = color;
+        } else {
+            *(Uint16 *)dst = (Uint16)color;
+        }
+        dst += bpp;
+        count--;
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void fill_span_NEON(Uint8 *dst, int count, int bpp, Uint32 color)
+{
+    const uint32x4_t c128 = vdupq_n_u32(color);
+    while (count * bpp >= 16) {
+        vst1q_u8(dst, vreinterpretq_u8_u32(c128));
+        dst += 16;
+        count -= 16 / bpp;
+    }
+    while (count > 0) {
+        if (bpp == 4) {
+            *(Uint32 *)dst = color;
+        } else {
+            *(Uint16 *)dst = (Uint16)color;
+        }
+        dst += bpp;
+        count--;
+    }
+}
+#endif
+
+static void fill_span(Uint8 *dst, int count, int bpp, Uint32 color)
+{
+    if (bpp == 2) {
+        color |= color << 16;
+    }
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        fill_span_SSE2(dst, count, bpp, color);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        fill_span_NEON(dst, count, bpp, color);
+        return;
+    }
+#endif
+    if (bpp == 4) {
+        SDL_memset4(dst, color, count);
+    } else {
+        Uint16 *p = (Uint16 *)dst;
+        while (count--) {
+            *p++ = (Uint16)color;
+        }
+    }
+}
+
+/* Fill a span of gradient colors into a format with 8 bits per channel,
+ * four pixels at a time, with one pixel per lane.
+ * 'color' holds the red, green, blue and alpha values at the first pixel,
+ * 'step4' the steps for four pixels, and area must be below 2^30.
+ */
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") fill_span_gradient_SSE2(Uint32 *dst, int count, const TriangleInterp *color, const TriangleInterp *step4, int area, const SDL_PixelFormatDetails *format)
+{
+    const Uint8 shifts[4] = { format->Rshift, format->Gshift, format->Bshift, format->Ashift };
+    const __m128i v_area = _mm_set1_epi32(area);
+    const __m128i v_area_minus_1 = _mm_set1_epi32(area - 1);
+    const __m128i amask = _mm_set1_epi32((int)format->Amask);
+    __m128i value[4], frac[4], step[4], step_frac[4], shift[4];
+    int i, k;
+
+    for (i = 0; i < 4; i++) {
+        TriangleInterp t = color[i];
+        int v[4], f[4];
+        for (k = 0; k < 4; k++) {
+            v[k] = t.value;
+            f[k] = (int)t.frac;
+            interp_step(&t, area);
+        }
+        value[i] = _mm_setr_epi32(v[0], v[1], v[2], v[3]);
+        frac[i] = _mm_setr_epi32(f[0], f[1], f[2], f[3]);
+        step[i] = _mm_set1_epi32(step4[i].step);
+        step_frac[i] = _mm_set1_epi32((int)step4[i].step_frac);
+        shift[i] = _mm_cvtsi32_si128(shifts[i]);
+    }
+
+    while (count > 0) {
+        __m128i pixels = _mm_or_si128(_mm_sll_epi32(value[0], shift[0]), _mm_sll_epi32(value[1], shift[1]));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi32(value[2], shift[2]));
+        pixels = _mm_or_si128(pixels, _mm_and_si128(_mm_sll_epi32(value[3], shift[3]), amask));
+        if (count >= 4) {
+            _mm_storeu_si128((__m128i *)dst, pixels);
+        } else {
+            Uint32 tail[4];
+            _mm_storeu_si128((__m128i *)tail, pixels);
+            SDL_memcpy(dst, tail, count * sizeof(Uint32));
+            break;
+        }
+        dst += 4;
+        count -= 4;
+
+        for (i = 0; i < 4; i++) {
+            __m128i carry;
+            value[i] = _mm_add_epi32(value[i], step[i]);
+            frac[i] = _mm_add_epi32(frac[i], step_frac[i]);
+            carry = _mm_cmpgt_epi32(frac[i], v_area_minus_1);
+            frac[i] = _mm_sub_epi32(frac[i], _mm_and_si128(carry, v_area));
+            value[i] = _mm_sub_epi32(value[i], carry);
+        }
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void fill_span_gradient_NEON(Uint32 *dst, int count, const TriangleInterp *color, const TriangleInterp *step4, int area, const SDL_PixelFormatDetails *format)
+{
+    const int shifts[4] = { format->Rshift, format->Gshift, format->Bshift, format->Ashift };
+    const int32x4_t v_area = vdupq_n_s32(area);
+    const uint32x4_t amask = vdupq_n_u32(format->Amask);
+    int32x4_t value[4], frac[4], step[4], step_frac[4], shift[4];
+    int i, k;
+
+    for (i = 0; i < 4; i++) {
+        TriangleInterp t = color[i];
+        int32_t v[4], f[4];
+        for (k = 0; k < 4; k++) {
+            v[k] = t.value;
+            f[k] = (int32_t)t.frac;
+            interp_step(&t, area);
+        }
+        value[i] = vld1q_s32(v);
+        frac[i] = vld1q_s32(f);
+        step[i] = vdupq_n_s32(step4[i].step);
+        step_frac[i] = vdupq_n_s32((int32_t)step4[i].step_frac);
+        shift[i] = vdupq_n_s32(shifts[i]);
+    }
+
+    while (count > 0) {
+        uint32x4_t pixels = vorrq_u32(vshlq_u32(vreinterpretq_u32_s32(value[0]), shift[0]),
+                                      vshlq_u32(vreinterpretq_u32_s32(value[1]), shift[1]));
+        pixels = vorrq_u32(pixels, vshlq_u32(vreinterpretq_u32_s32(value[2]), shift[2]));
+        pixels = vorrq_u32(pixels, vandq_u32(vshlq_u32(vreinterpretq_u32_s32(value[3]), shift[3]), amask));
+        if (count >= 4) {
+            vst1q_u32((uint32_t *)dst, pixels);
+        } else {
+            Uint32 tail[4];
+            vst1q_u32((uint32_t *)tail, pixels);
+            SDL_memcpy(dst, tail, count * sizeof(Uint32));
+            break;
+        }
+        dst += 4;
+        count -= 4;
+
+        for (i = 0; i < 4; i++) {
+            uint32x4_t carry;
+            value[i] = vaddq_s32(value[i], step[i]);
+            frac[i] = vaddq_s32(frac[i], step_frac[i]);
+            carry = vcgeq_s32(frac[i], v_area);
+            frac[i] = vsubq_s32(frac[i], vandq_s32(vreinterpretq_s32_u32(carry), v_area));
+            value[i] = vsubq_s32(value[i], vreinterpretq_s32_u32(carry));
+        }
+    }
+}
+#endif
+
+static bool has_fill_span_gradient(void)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        return true;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+static void fill_span_gradient(Uint32 *dst, int count, const TriangleInterp *color, const TriangleInterp *step4, int area, const SDL_PixelFormatDetails *format)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        fill_span_gradient_SSE2(dst, count, color, step4, area, format);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        fill_span_gradient_NEON(dst, count, color, step4, area, format);
+        return;
+    }
+#endif
+}
 
 bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
@@ -378,33 +785,27 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
             color = SDL_MapSurfaceRGBA(dst, c0.r, c0.g, c0.b, c0.a);
         }
 
-        if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+        if (dstbpp == 4 || dstbpp == 2) {
+            TRIANGLE_BEGIN_SPANS(NONE)
             {
-                *(Uint32 *)dptr = color;
+                fill_span(dst_ptr + x * dstbpp, x_end - x, dstbpp, color);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPANS
         } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(NONE)
             {
                 Uint8 *s = (Uint8 *)&color;
                 dptr[0] = s[0];
                 dptr[1] = s[1];
                 dptr[2] = s[2];
             }
-            TRIANGLE_END_LOOP
-        } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
-            {
-                *(Uint16 *)dptr = (Uint16)color;
-            }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_LOOP(NONE)
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_SPANS(NONE)
             {
-                *dptr = (Uint8)color;
+                SDL_memset(dst_ptr + x, (Uint8)color, x_end - x);
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_SPANS
         }
     } else {
         const SDL_PixelFormatDetails *format;
@@ -416,15 +817,36 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
             format = dst->fmt;
             palette = dst->palette;
         }
-        if (dstbpp == 4) {
-            TRIANGLE_BEGIN_LOOP
+        if (dstbpp == 4 && area < (1 << 30) &&
+            format->Rbits == 8 && format->Gbits == 8 && format->Bbits == 8 &&
+            (format->Abits == 8 || format->Abits == 0) &&
+            has_fill_span_gradient()) {
+            // 8 bits per channel, with SIMD: the colors are just shifted into place
+            TriangleInterp step4[4];
+            interp_set_step(&step4[0], 4 * ((Sint64)d2d1_y * c0.r + (Sint64)d0d2_y * c1.r + (Sint64)d1d0_y * c2.r), area);
+            interp_set_step(&step4[1], 4 * ((Sint64)d2d1_y * c0.g + (Sint64)d0d2_y * c1.g + (Sint64)d1d0_y * c2.g), area);
+            interp_set_step(&step4[2], 4 * ((Sint64)d2d1_y * c0.b + (Sint64)d0d2_y * c1.b + (Sint64)d1d0_y * c2.b), area);
+            interp_set_step(&step4[3], 4 * ((Sint64)d2d1_y * c0.a + (Sint64)d0d2_y * c1.a + (Sint64)d1d0_y * c2.a), area);
+
+            TRIANGLE_BEGIN_SPANS(COLOR)
+            {
+                TriangleInterp colors[4];
+                colors[0] = interp_r;
+                colors[1] = interp_g;
+                colors[2] = interp_b;
+                colors[3] = interp_a;
+                fill_span_gradient((Uint32 *)dst_ptr + x, x_end - x, colors, step4, (int)area, format);
+            }
+            TRIANGLE_END_SPANS
+        } else if (dstbpp == 4) {
+            TRIANGLE_BEGIN_LOOP(COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *(Uint32 *)dptr = color;
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_LOOP(COLOR)
         } else if (dstbpp == 3) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 Uint8 *s = (Uint8 *)&color;
@@ -432,21 +854,21 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
                 dptr[1] = s[1];
                 dptr[2] = s[2];
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_LOOP(COLOR)
         } else if (dstbpp == 2) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *(Uint16 *)dptr = (Uint16)color;
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_LOOP(COLOR)
         } else if (dstbpp == 1) {
-            TRIANGLE_BEGIN_LOOP
+            TRIANGLE_BEGIN_LOOP(COLOR)
             {
                 TRIANGLE_GET_MAPPED_COLOR
                 *dptr = (Uint8)color;
             }
-            TRIANGLE_END_LOOP
+            TRIANGLE_END_LOOP(COLOR)
         }
     }
 
@@ -731,15 +1153,15 @@ bool SDL_SW_BlitTriangle(
     }
 
     if (dstbpp == 4) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint32 *sptr = (Uint32 *)((Uint8 *)src_ptr + srcy * src_pitch);
             *(Uint32 *)dptr = sptr[srcx];
         }
-        TRIANGLE_END_LOOP
+        TRIANGLE_END_LOOP(TEXTCOORD)
     } else if (dstbpp == 3) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
@@ -747,23 +1169,23 @@ bool SDL_SW_BlitTriangle(
             dptr[1] = sptr[3 * srcx + 1];
             dptr[2] = sptr[3 * srcx + 2];
         }
-        TRIANGLE_END_LOOP
+        TRIANGLE_END_LOOP(TEXTCOORD)
     } else if (dstbpp == 2) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint16 *sptr = (Uint16 *)((Uint8 *)src_ptr + srcy * src_pitch);
             *(Uint16 *)dptr = sptr[srcx];
         }
-        TRIANGLE_END_LOOP
+        TRIANGLE_END_LOOP(TEXTCOORD)
     } else if (dstbpp == 1) {
-        TRIANGLE_BEGIN_LOOP
+        TRIANGLE_BEGIN_LOOP(TEXTCOORD)
         {
             TRIANGLE_GET_TEXTCOORD
             Uint8 *sptr = (Uint8 *)src_ptr + srcy * src_pitch;
             *dptr = sptr[srcx];
         }
-        TRIANGLE_END_LOOP
+        TRIANGLE_END_LOOP(TEXTCOORD)
     }
 
 end:
@@ -826,7 +1248,7 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     srcfmt_val = detect_format(src_fmt);
     dstfmt_val = detect_format(dst_fmt);
 
-    TRIANGLE_BEGIN_LOOP
+    TRIANGLE_BEGIN_LOOP(TEXTCOORD_COLOR)
     {
         Uint8 *src;
         Uint8 *dst = dptr;
@@ -950,7 +1372,7 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
             *(Uint32 *)dst = pixelvalue;
         }
     }
-    TRIANGLE_END_LOOP
+    TRIANGLE_END_LOOP(TEXTCOORD_COLOR)
 }
 
 #endif // SDL_VIDEO_RENDER_SW
@@ -36,6 +36,8 @@ extern bool SDL_SW_BlitTriangle(SDL_Surface *src,
                                 SDL_TextureAddressMode texture_address_mode_u,
                                 SDL_TextureAddressMode texture_address_mode_v);
 
+extern void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect);
+
 extern void trianglepoint_2_fixedpoint(SDL_Point *a);
 
 #endif // SDL_triangle_h_
@@ -101,6 +101,74 @@
 #define OPAQUE_BLIT(to, from, length, bpp, alpha) \
     PIXEL_COPY(to, from, length, bpp)
 
+#ifdef SDL_SSE2_INTRINSICS
+/*
+ * The blenders below multiply 32-bit words holding several components by
+ * alpha and rely on the bits that wrap around. SSE2 can't multiply 32-bit
+ * lanes, but alpha fits in 16 bits, so the low 32 bits of the product are
+ * the low halves of the two 16-bit products plus the high half of the
+ * lower one. alpha16 must hold alpha in both halves of every lane.
+ */
+static SDL_INLINE __m128i SDL_TARGETING("sse2") MulAlphaSSE2(__m128i x, __m128i alpha16)
+{
+    return _mm_add_epi32(_mm_mullo_epi16(x, alpha16), _mm_slli_epi32(_mm_mulhi_epu16(x, alpha16), 16));
+}
+
+// Load 4 16-bit pixels into the low halves of 32-bit lanes
+static SDL_INLINE __m128i SDL_TARGETING("sse2") Load4x16SSE2(const Uint16 *p)
+{
+    return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+}
+
+// Store the low halves of 4 32-bit lanes as 16-bit pixels
+static SDL_INLINE void SDL_TARGETING("sse2") Store4x16SSE2(Uint16 *p, __m128i v)
+{
+    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+    _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(v, v));
+}
+
+// Blend 0x00rrggbb pixels with a per-surface alpha, returning the number of pixels done
+static int SDL_TARGETING("sse2") BlitAlphaSpan888SSE2(Uint32 *dst, const Uint32 *src, int n, unsigned alpha)
+{
+    const __m128i rb_mask = _mm_set1_epi32(0xff00ff);
+    const __m128i g_mask = _mm_set1_epi32(0xff00);
+    const __m128i alpha16 = _mm_set1_epi16((short)alpha);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i s1 = _mm_and_si128(s, rb_mask);
+        __m128i d1 = _mm_and_si128(d, rb_mask);
+        __m128i s2 = _mm_and_si128(s, g_mask);
+        __m128i d2 = _mm_and_si128(d, g_mask);
+        d1 = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s1, d1), alpha16), 8)), rb_mask);
+        d2 = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s2, d2), alpha16), 8)), g_mask);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(d1, d2));
+    }
+    return i;
+}
+
+// Blend 16-bit pixels spread out with mask to 0x0g0r0b form with a 5-bit per-surface alpha
+static int SDL_TARGETING("sse2") BlitAlphaSpan16SSE2(Uint16 *dst, const Uint16 *src, int n, unsigned alpha, Uint32 mask)
+{
+    const __m128i vmask = _mm_set1_epi32((int)mask);
+    const __m128i alpha16 = _mm_set1_epi16((short)alpha);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i s = Load4x16SSE2(src + i);
+        __m128i d = Load4x16SSE2(dst + i);
+        s = _mm_and_si128(_mm_or_si128(s, _mm_slli_epi32(s, 16)), vmask);
+        d = _mm_and_si128(_mm_or_si128(d, _mm_slli_epi32(d, 16)), vmask);
+        d = _mm_add_epi32(d, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s, d), alpha16), 5));
+        d = _mm_and_si128(d, vmask);
+        Store4x16SSE2(dst + i, _mm_or_si128(d, _mm_srli_epi32(d, 16)));
+    }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
 /*
  * For 32bpp pixels on the form 0x00rrggbb:
  * If we treat the middle component separately, we can process the two
@@ -108,23 +176,30 @@
  * of each component, so the bits from the multiplication don't collide.
  * This can be used for any RGB permutation of course.
  */
-#define ALPHA_BLIT32_888(to, from, length, bpp, alpha)       \
-    do {                                                     \
-        int i;                                               \
-        Uint32 *src = (Uint32 *)(from);                      \
-        Uint32 *dst = (Uint32 *)(to);                        \
-        for (i = 0; i < (int)(length); i++) {                \
-            Uint32 s = *src++;                               \
-            Uint32 d = *dst;                                 \
-            Uint32 s1 = s & 0xff00ff;                        \
-            Uint32 d1 = d & 0xff00ff;                        \
-            d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff; \
-            s &= 0xff00;                                     \
-            d &= 0xff00;                                     \
-            d = (d + ((s - d) * alpha >> 8)) & 0xff00;       \
-            *dst++ = d1 | d;                                 \
-        }                                                    \
-    } while (0)
+static void BlitAlphaSpan888(Uint32 *dst, const Uint32 *src, int n, unsigned alpha)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && SDL_HasSSE2()) {
+        i = BlitAlphaSpan888SSE2(dst, src, n, alpha);
+    }
+#endif
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        Uint32 s1 = s & 0xff00ff;
+        Uint32 d1 = d & 0xff00ff;
+        d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+        s &= 0xff00;
+        d &= 0xff00;
+        d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+        dst[i] = d1 | d;
+    }
+}
+
+#define ALPHA_BLIT32_888(to, from, length, bpp, alpha) \
+    BlitAlphaSpan888((Uint32 *)(to), (const Uint32 *)(from), (int)(length), alpha)
 
 /*
  * For 16bpp pixels we can go a step further: put the middle component
@@ -132,39 +207,32 @@
  * components at the same time. Since the smallest gap is here just
  * 5 bits, we have to scale alpha down to 5 bits as well.
  */
+static void BlitAlphaSpan16(Uint16 *dst, const Uint16 *src, int n, unsigned alpha, Uint32 mask)
+{
+    const Uint32 ALPHA = alpha >> 3;
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && SDL_HasSSE2()) {
+        i = BlitAlphaSpan16SSE2(dst, src, n, ALPHA, mask);
+    }
+#endif
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        s = (s | s << 16) & mask;
+        d = (d | d << 16) & mask;
+        d += (s - d) * ALPHA >> 5;
+        d &= mask;
+        dst[i] = (Uint16)(d | d >> 16);
+    }
+}
+
 #define ALPHA_BLIT16_565(to, from, length, bpp, alpha) \
-    do {                                               \
-        int i;                                         \
-        Uint16 *src = (Uint16 *)(from);                \
-        Uint16 *dst = (Uint16 *)(to);                  \
-        Uint32 ALPHA = alpha >> 3;                     \
-        for (i = 0; i < (int)(length); i++) {          \
-            Uint32 s = *src++;                         \
-            Uint32 d = *dst;                           \
-            s = (s | s << 16) & 0x07e0f81f;            \
-            d = (d | d << 16) & 0x07e0f81f;            \
-            d += (s - d) * ALPHA >> 5;                 \
-            d &= 0x07e0f81f;                           \
-            *dst++ = (Uint16)(d | d >> 16);            \
-        }                                              \
-    } while (0)
+    BlitAlphaSpan16((Uint16 *)(to), (const Uint16 *)(from), (int)(length), alpha, 0x07e0f81f)
 
 #define ALPHA_BLIT16_555(to, from, length, bpp, alpha) \
-    do {                                               \
-        int i;                                         \
-        Uint16 *src = (Uint16 *)(from);                \
-        Uint16 *dst = (Uint16 *)(to);                  \
-        Uint32 ALPHA = alpha >> 3;                     \
-        for (i = 0; i < (int)(length); i++) {          \
-            Uint32 s = *src++;                         \
-            Uint32 d = *dst;                           \
-            s = (s | s << 16) & 0x03e07c1f;            \
-            d = (d | d << 16) & 0x03e07c1f;            \
-            d += (s - d) * ALPHA >> 5;                 \
-            d &= 0x03e07c1f;                           \
-            *dst++ = (Uint16)(d | d >> 16);            \
-        }                                              \
-    } while (0)
+    BlitAlphaSpan16((Uint16 *)(to), (const Uint16 *)(from), (int)(length), alpha, 0x03e07c1f)
 
 /*
  * The general slow catch-all function, for remaining depths and formats
@@ -558,51 +626,111 @@ done:
  * These use the same techniques as the per-surface blitting macros
  */
 
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") BlitTranslSpan888SSE2(Uint32 *dst, const Uint32 *src, int n)
+{
+    const __m128i rb_mask = _mm_set1_epi32(0xff00ff);
+    const __m128i g_mask = _mm_set1_epi32(0xff00);
+    const __m128i a_mask = _mm_set1_epi32((int)0xff000000);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        const __m128i alpha = _mm_srli_epi32(s, 24);
+        const __m128i alpha16 = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        __m128i s1 = _mm_and_si128(s, rb_mask);
+        __m128i d1 = _mm_and_si128(d, rb_mask);
+        __m128i s2 = _mm_and_si128(s, g_mask);
+        __m128i d2 = _mm_and_si128(d, g_mask);
+        d1 = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s1, d1), alpha16), 8)), rb_mask);
+        d2 = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s2, d2), alpha16), 8)), g_mask);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_or_si128(d1, d2), a_mask));
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") BlitTranslSpan16SSE2(Uint16 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    const __m128i vmask = _mm_set1_epi32((int)mask);
+    const __m128i alpha_mask = _mm_set1_epi32(0x3e0);
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = Load4x16SSE2(dst + i);
+        const __m128i alpha = _mm_srli_epi32(_mm_and_si128(s, alpha_mask), 5);
+        const __m128i alpha16 = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        s = _mm_and_si128(s, vmask);
+        d = _mm_and_si128(_mm_or_si128(d, _mm_slli_epi32(d, 16)), vmask);
+        d = _mm_add_epi32(d, _mm_srli_epi32(MulAlphaSSE2(_mm_sub_epi32(s, d), alpha16), 5));
+        d = _mm_and_si128(d, vmask);
+        Store4x16SSE2(dst + i, _mm_or_si128(d, _mm_srli_epi32(d, 16)));
+    }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
 /*
  * For 32bpp pixels, we have made sure the alpha is stored in the top
  * 8 bits, so proceed as usual
  */
-#define BLIT_TRANSL_888(src, dst)                        \
-    do {                                                 \
-        Uint32 s = src;                                  \
-        Uint32 d = dst;                                  \
-        unsigned alpha = s >> 24;                        \
-        Uint32 s1 = s & 0xff00ff;                        \
-        Uint32 d1 = d & 0xff00ff;                        \
-        d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff; \
-        s &= 0xff00;                                     \
-        d &= 0xff00;                                     \
-        d = (d + ((s - d) * alpha >> 8)) & 0xff00;       \
-        dst = d1 | d | 0xff000000;                       \
-    } while (0)
+static void BlitTranslSpan888(Uint32 *dst, const Uint32 *src, int n)
+{
+    int i = 0;
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && SDL_HasSSE2()) {
+        i = BlitTranslSpan888SSE2(dst, src, n);
+    }
+#endif
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        unsigned alpha = s >> 24;
+        Uint32 s1 = s & 0xff00ff;
+        Uint32 d1 = d & 0xff00ff;
+        d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+        s &= 0xff00;
+        d &= 0xff00;
+        d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+        dst[i] = d1 | d | 0xff000000;
+    }
+}
 
 /*
  * For 16bpp pixels, we have stored the 5 most significant alpha bits in
  * bits 5-10. As before, we can process all 3 RGB components at the same time.
  */
-#define BLIT_TRANSL_565(src, dst)          \
-    do {                                   \
-        Uint32 s = src;                    \
-        Uint32 d = dst;                    \
-        unsigned alpha = (s & 0x3e0) >> 5; \
-        s &= 0x07e0f81f;                   \
-        d = (d | d << 16) & 0x07e0f81f;    \
-        d += (s - d) * alpha >> 5;         \
-        d &= 0x07e0f81f;                   \
-        dst = (Uint16)(d | d >> 16);       \
-    } while (0)
+static void BlitTranslSpan16(Uint16 *dst, const Uint32 *src, int n, Uint32 mask)
+{
+    int i = 0;
 
-#define BLIT_TRANSL_555(src, dst)          \
-    do {                                   \
-        Uint32 s = src;                    \
-        Uint32 d = dst;                    \
-        unsigned alpha = (s & 0x3e0) >> 5; \
-        s &= 0x03e07c1f;                   \
-        d = (d | d << 16) & 0x03e07c1f;    \
-        d += (s - d) * alpha >> 5;         \
-        d &= 0x03e07c1f;                   \
-        dst = (Uint16)(d | d >> 16);       \
-    } while (0)
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && SDL_HasSSE2()) {
+        i = BlitTranslSpan16SSE2(dst, src, n, mask);
+    }
+#endif
+    for (; i < n; i++) {
+        Uint32 s = src[i];
+        Uint32 d = dst[i];
+        unsigned alpha = (s & 0x3e0) >> 5;
+        s &= mask;
+        d = (d | d << 16) & mask;
+        d += (s - d) * alpha >> 5;
+        d &= mask;
+        dst[i] = (Uint16)(d | d >> 16);
+    }
+}
+
+#define BLIT_TRANSL_888(dst, src, n) \
+    BlitTranslSpan888((Uint32 *)(dst), src, (int)(n))
+
+#define BLIT_TRANSL_565(dst, src, n) \
+    BlitTranslSpan16((Uint16 *)(dst), src, (int)(n), 0x07e0f81f)
+
+#define BLIT_TRANSL_555(dst, src, n) \
+    BlitTranslSpan16((Uint16 *)(dst), src, (int)(n), 0x03e07c1f)
 
 // blit a pixel-alpha RLE surface clipped at the right and/or left edges
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
@@ -612,7 +740,7 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
     /*
      * clipped blitter: Ptype is the destination pixel type,
      * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * to blend a span of pixels.
      */
 #define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
     do {                                                                  \
@@ -667,13 +795,9 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     }                                                     \
                     if (crun > right - cofs)                              \
                         crun = right - cofs;                              \
-                    if (crun > 0) {                                       \
-                        Ptype *dst = (Ptype *)dstbuf + cofs;              \
-                        Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
-                    }                                                     \
+                    if (crun > 0)                                         \
+                        do_blend((Ptype *)dstbuf + cofs,                  \
+                                 (Uint32 *)srcbuf + (cofs - ofs), crun);  \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
                 }                                                         \
@@ -783,7 +907,7 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
          * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * macro to blend a span of pixels.
          */
 #define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
     do {                                                             \
@@ -815,14 +939,9 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
                 run = ((Uint16 *)srcbuf)[1];                         \
                 srcbuf += 4;                                         \
                 if (run) {                                           \
-                    Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    do_blend((Ptype *)dstbuf + ofs,                  \
+                             (Uint32 *)srcbuf, run);                 \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -858,22 +977,120 @@ done:
  * return the number of bytes copied to the destination.
  * The decoding functions copy to 32bpp rgb + a, and
  * return the number of bytes copied from the source.
- * These are only used in the encoder and un-RLE code and are therefore not
- * highly optimised.
+ * These are only used in the encoder and un-RLE code. The encoding
+ * functions have SSE2 paths for sources with 8-bit components, since
+ * sprites are often re-encoded whenever they're blitted to a new format.
  */
 
+#ifdef SDL_SSE2_INTRINSICS
+// Shifts and masks moving the 8-bit RGB components of a pixel into a destination format
+typedef struct
+{
+    __m128i rshift[3];
+    __m128i lshift[3];
+    __m128i mask[3];
+} RLEComponentsSSE2;
+
+static bool CanCopyRLEComponentsSSE2(const SDL_PixelFormatDetails *sfmt)
+{
+    return sfmt->Rbits == 8 && sfmt->Gbits == 8 && sfmt->Bbits == 8 && sfmt->Abits == 8 && SDL_HasSSE2();
+}
+
+static void SDL_TARGETING("sse2") InitRLEComponentsSSE2(RLEComponentsSSE2 *c, const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
+{
+    c->rshift[0] = _mm_cvtsi32_si128(sfmt->Rshift + 8 - dfmt->Rbits);
+    c->rshift[1] = _mm_cvtsi32_si128(sfmt->Gshift + 8 - dfmt->Gbits);
+    c->rshift[2] = _mm_cvtsi32_si128(sfmt->Bshift + 8 - dfmt->Bbits);
+    c->lshift[0] = _mm_cvtsi32_si128(dfmt->Rshift);
+    c->lshift[1] = _mm_cvtsi32_si128(dfmt->Gshift);
+    c->lshift[2] = _mm_cvtsi32_si128(dfmt->Bshift);
+    c->mask[0] = _mm_set1_epi32((int)dfmt->Rmask);
+    c->mask[1] = _mm_set1_epi32((int)dfmt->Gmask);
+    c->mask[2] = _mm_set1_epi32((int)dfmt->Bmask);
+}
+
+// Equivalent to RGBA_FROM_8888 followed by PIXEL_FROM_RGB without the alpha mask
+static SDL_INLINE __m128i SDL_TARGETING("sse2") RLEComponentsFromPixelsSSE2(const RLEComponentsSSE2 *c, __m128i p)
+{
+    const __m128i r = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, c->rshift[0]), c->lshift[0]), c->mask[0]);
+    const __m128i g = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, c->rshift[1]), c->lshift[1]), c->mask[1]);
+    const __m128i b = _mm_and_si128(_mm_sll_epi32(_mm_srl_epi32(p, c->rshift[2]), c->lshift[2]), c->mask[2]);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+static int SDL_TARGETING("sse2") CopyOpaque16SSE2(Uint16 *dst, const Uint32 *src, int n,
+                                                  const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
+{
+    const __m128i amask = _mm_set1_epi32((int)dfmt->Amask);
+    RLEComponentsSSE2 c;
+    int i;
+
+    InitRLEComponentsSSE2(&c, sfmt, dfmt);
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(src + i));
+        Store4x16SSE2(dst + i, _mm_or_si128(RLEComponentsFromPixelsSSE2(&c, p), amask));
+    }
+    return i;
+}
+
+// gmask is the green mask of the 16-bit destination, which is moved to the top half
+static int SDL_TARGETING("sse2") CopyTransl16SSE2(Uint32 *dst, const Uint32 *src, int n,
+                                                  const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt, Uint32 gmask)
+{
+    const __m128i amask = _mm_set1_epi32((int)dfmt->Amask);
+    const __m128i src_amask = _mm_set1_epi32((int)sfmt->Amask);
+    const __m128i ashift = _mm_cvtsi32_si128(sfmt->Ashift);
+    const __m128i vgmask = _mm_set1_epi32((int)gmask);
+    const __m128i rbmask = _mm_set1_epi32((int)(~gmask & 0xffff));
+    RLEComponentsSSE2 c;
+    int i;
+
+    InitRLEComponentsSSE2(&c, sfmt, dfmt);
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i pix = _mm_or_si128(RLEComponentsFromPixelsSSE2(&c, p), amask);
+        const __m128i a = _mm_srl_epi32(_mm_and_si128(p, src_amask), ashift);
+        __m128i d = _mm_slli_epi32(_mm_and_si128(pix, vgmask), 16);
+        d = _mm_or_si128(d, _mm_and_si128(pix, rbmask));
+        d = _mm_or_si128(d, _mm_and_si128(_mm_slli_epi32(a, 2), vgmask));
+        _mm_storeu_si128((__m128i *)(dst + i), d);
+    }
+    return i;
+}
+
+static int SDL_TARGETING("sse2") Copy32SSE2(Uint32 *dst, const Uint32 *src, int n,
+                                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
+{
+    const __m128i src_amask = _mm_set1_epi32((int)sfmt->Amask);
+    const __m128i ashift = _mm_cvtsi32_si128(sfmt->Ashift);
+    RLEComponentsSSE2 c;
+    int i;
+
+    InitRLEComponentsSSE2(&c, sfmt, dfmt);
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i a = _mm_slli_epi32(_mm_srl_epi32(_mm_and_si128(p, src_amask), ashift), 24);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(RLEComponentsFromPixelsSSE2(&c, p), a));
+    }
+    return i;
+}
+#endif // SDL_SSE2_INTRINSICS
+
 // encode 32bpp rgb + a into 16bpp rgb, losing alpha
 static int copy_opaque_16(void *dst, const Uint32 *src, int n,
                           const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
 {
-    int i;
+    int i = 0;
     Uint16 *d = (Uint16 *)dst;
-    for (i = 0; i < n; i++) {
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && CanCopyRLEComponentsSSE2(sfmt)) {
+        i = CopyOpaque16SSE2(d, src, n, sfmt, dfmt);
+    }
+#endif
+    for (; i < n; i++) {
         unsigned r, g, b;
-        RGB_FROM_PIXEL(*src, sfmt, r, g, b);
-        PIXEL_FROM_RGB(*d, dfmt, r, g, b);
-        src++;
-        d++;
+        RGB_FROM_PIXEL(src[i], sfmt, r, g, b);
+        PIXEL_FROM_RGB(d[i], dfmt, r, g, b);
     }
     return n * 2;
 }
@@ -899,16 +1116,19 @@ static int uncopy_opaque_16(Uint32 *dst, const void *src, int n,
 static int copy_transl_565(void *dst, const Uint32 *src, int n,
                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
 {
-    int i;
+    int i = 0;
     Uint32 *d = (Uint32 *)dst;
-    for (i = 0; i < n; i++) {
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && CanCopyRLEComponentsSSE2(sfmt)) {
+        i = CopyTransl16SSE2(d, src, n, sfmt, dfmt, 0x7e0);
+    }
+#endif
+    for (; i < n; i++) {
         unsigned r, g, b, a;
         Uint16 pix;
-        RGBA_FROM_8888(*src, sfmt, r, g, b, a);
+        RGBA_FROM_8888(src[i], sfmt, r, g, b, a);
         PIXEL_FROM_RGB(pix, dfmt, r, g, b);
-        *d = ((pix & 0x7e0) << 16) | (pix & 0xf81f) | ((a << 2) & 0x7e0);
-        src++;
-        d++;
+        d[i] = ((pix & 0x7e0) << 16) | (pix & 0xf81f) | ((a << 2) & 0x7e0);
     }
     return n * 4;
 }
@@ -917,16 +1137,19 @@ static int copy_transl_565(void *dst, const Uint32 *src, int n,
 static int copy_transl_555(void *dst, const Uint32 *src, int n,
                            const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
 {
-    int i;
+    int i = 0;
     Uint32 *d = (Uint32 *)dst;
-    for (i = 0; i < n; i++) {
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && CanCopyRLEComponentsSSE2(sfmt)) {
+        i = CopyTransl16SSE2(d, src, n, sfmt, dfmt, 0x3e0);
+    }
+#endif
+    for (; i < n; i++) {
         unsigned r, g, b, a;
         Uint16 pix;
-        RGBA_FROM_8888(*src, sfmt, r, g, b, a);
+        RGBA_FROM_8888(src[i], sfmt, r, g, b, a);
         PIXEL_FROM_RGB(pix, dfmt, r, g, b);
-        *d = ((pix & 0x3e0) << 16) | (pix & 0xfc1f) | ((a << 2) & 0x3e0);
-        src++;
-        d++;
+        d[i] = ((pix & 0x3e0) << 16) | (pix & 0xfc1f) | ((a << 2) & 0x3e0);
     }
     return n * 4;
 }
@@ -953,14 +1176,17 @@ static int uncopy_transl_16(Uint32 *dst, const void *src, int n,
 static int copy_32(void *dst, const Uint32 *src, int n,
                    const SDL_PixelFormatDetails *sfmt, const SDL_PixelFormatDetails *dfmt)
 {
-    int i;
+    int i = 0;
     Uint32 *d = (Uint32 *)dst;
-    for (i = 0; i < n; i++) {
+#ifdef SDL_SSE2_INTRINSICS
+    if (n >= 4 && CanCopyRLEComponentsSSE2(sfmt)) {
+        i = Copy32SSE2(d, src, n, sfmt, dfmt);
+    }
+#endif
+    for (; i < n; i++) {
         unsigned r, g, b, a;
-        RGBA_FROM_8888(*src, sfmt, r, g, b, a);
-        RLEPIXEL_FROM_RGBA(*d, dfmt, r, g, b, a);
-        d++;
-        src++;
+        RGBA_FROM_8888(src[i], sfmt, r, g, b, a);
+        RLEPIXEL_FROM_RGBA(d[i], dfmt, r, g, b, a);
     }
     return n * 4;
 }
@@ -987,6 +1213,54 @@ static int uncopy_32(Uint32 *dst, const void *src, int n,
 #define ISTRANSL(pixel, fmt) \
     ((unsigned)((((pixel)&fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
 
+#ifdef SDL_SSE2_INTRINSICS
+// With 8 bits of alpha, opaque pixels have all alpha bits set and translucent ones some
+static int SDL_TARGETING("sse2") FindAlphaRunEndSSE2(const Uint32 *src, int x, int w, Uint32 Amask, bool transl, bool match)
+{
+    const __m128i amask = _mm_set1_epi32((int)Amask);
+    const __m128i zero = _mm_setzero_si128();
+    const int match_bits = match ? 0xf : 0;
+
+    for (; x + 4 <= w; x += 4) {
+        const __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + x)), amask);
+        const __m128i opaque = _mm_cmpeq_epi32(a, amask);
+        int bits;
+        if (transl) {
+            bits = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(opaque, _mm_cmpeq_epi32(a, zero)))) & 0xf;
+        } else {
+            bits = _mm_movemask_ps(_mm_castsi128_ps(opaque));
+        }
+        // Set for the pixels that end the run
+        bits ^= match_bits;
+        if (bits) {
+            return x + SDL_MostSignificantBitIndex32((Uint32)(bits & -bits));
+        }
+    }
+    return x;
+}
+#endif
+
+/* Find where a run of pixels starting at x ends, where the pixels in the run
+   are opaque (or translucent if transl is set) if match is set, or not. */
+static int FindAlphaRunEnd(const Uint32 *src, int x, int w, const SDL_PixelFormatDetails *sf, bool transl, bool match)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (sf->Abits == 8 && SDL_HasSSE2()) {
+        x = FindAlphaRunEndSSE2(src, x, w, sf->Amask, transl, match);
+    }
+#endif
+    if (transl) {
+        while (x < w && (bool)ISTRANSL(src[x], sf) == match) {
+            x++;
+        }
+    } else {
+        while (x < w && (bool)ISOPAQUE(src[x], sf) == match) {
+            x++;
+        }
+    }
+    return x;
+}
+
 // convert surface to be quickly alpha-blittable onto dest, if possible
 static bool RLEAlphaSurface(SDL_Surface *surface)
 {
@@ -1099,13 +1373,9 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
+                x = FindAlphaRunEnd(src, x, w, sf, false, false);
                 runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf)) {
-                    x++;
-                }
+                x = FindAlphaRunEnd(src, x, w, sf, false, true);
                 skip = runstart - skipstart;
                 if (skip == w) {
                     blankline = 1;
@@ -1137,13 +1407,9 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf)) {
-                    x++;
-                }
+                x = FindAlphaRunEnd(src, x, w, sf, true, false);
                 runstart = x;
-                while (x < w && ISTRANSL(src[x], sf)) {
-                    x++;
-                }
+                x = FindAlphaRunEnd(src, x, w, sf, true, true);
                 skip = runstart - skipstart;
                 blankline &= (skip == w);
                 run = x - runstart;
@@ -1230,6 +1496,72 @@ static const getpix_func getpixes[4] = {
     getpix_8, getpix_16, getpix_24, getpix_32
 };
 
+#ifdef SDL_SSE2_INTRINSICS
+// Compare 16 bytes of 8, 16 or 32-bit pixels against the color key at a time
+static int SDL_TARGETING("sse2") FindColorkeyRunEndSSE2(const Uint8 *srcbuf, int x, int w, int bpp,
+                                                        Uint32 ckey, Uint32 rgbmask, bool keyed)
+{
+    const int step = 16 / bpp;
+    const int keyed_bits = keyed ? 0xffff : 0;
+    __m128i vkey, vmask;
+
+    switch (bpp) {
+    case 1:
+        if (ckey > 0xff) {
+            return x;
+        }
+        vkey = _mm_set1_epi8((char)ckey);
+        vmask = _mm_set1_epi8((char)rgbmask);
+        break;
+    case 2:
+        if (ckey > 0xffff) {
+            return x;
+        }
+        vkey = _mm_set1_epi16((short)ckey);
+        vmask = _mm_set1_epi16((short)rgbmask);
+        break;
+    default:
+        vkey = _mm_set1_epi32((int)ckey);
+        vmask = _mm_set1_epi32((int)rgbmask);
+        break;
+    }
+
+    for (; x + step <= w; x += step) {
+        const __m128i p = _mm_and_si128(_mm_loadu_si128((const __m128i *)(srcbuf + x * bpp)), vmask);
+        int bits;
+        if (bpp == 1) {
+            bits = _mm_movemask_epi8(_mm_cmpeq_epi8(p, vkey));
+        } else if (bpp == 2) {
+            bits = _mm_movemask_epi8(_mm_cmpeq_epi16(p, vkey));
+        } else {
+            bits = _mm_movemask_epi8(_mm_cmpeq_epi32(p, vkey));
+        }
+        // Set for the bytes of the pixels that end the run
+        bits ^= keyed_bits;
+        if (bits) {
+            return x + (int)SDL_MostSignificantBitIndex32((Uint32)(bits & -bits)) / bpp;
+        }
+    }
+    return x;
+}
+#endif
+
+/* Find where a run of pixels starting at x ends, where the pixels in the run
+   match the color key if keyed is set, or don't match it otherwise. */
+static int FindColorkeyRunEnd(const Uint8 *srcbuf, int x, int w, int bpp, getpix_func getpix,
+                              Uint32 ckey, Uint32 rgbmask, bool keyed)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (bpp != 3 && SDL_HasSSE2()) {
+        x = FindColorkeyRunEndSSE2(srcbuf, x, w, bpp, ckey, rgbmask, keyed);
+    }
+#endif
+    while (x < w && ((getpix(srcbuf + x * bpp) & rgbmask) == ckey) == keyed) {
+        x++;
+    }
+    return x;
+}
+
 static bool RLEColorkeySurface(SDL_Surface *surface)
 {
     SDL_Surface *dest;
@@ -1309,13 +1641,9 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
             int skipstart = x;
 
             // find run of transparent, then opaque pixels
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
-            }
+            x = FindColorkeyRunEnd(srcbuf, x, w, bpp, getpix, ckey, rgbmask, true);
             runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
-            }
+            x = FindColorkeyRunEnd(srcbuf, x, w, bpp, getpix, ckey, rgbmask, false);
             skip = runstart - skipstart;
             if (skip == w) {
                 blankline = 1;
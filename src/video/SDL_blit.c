@@ -28,9 +28,87 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
-// The general purpose software blit routine
-static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
-                                SDL_Surface *dst, const SDL_Rect *dstrect)
+// A blit split into row bands, see SDL_RunSurfaceBands()
+typedef struct
+{
+    const SDL_BlitInfo *info;
+    SDL_BlitFunc blit;
+    int first_row;
+} SDL_BlitBandData;
+
+static void SDL_SetupBlitBand(SDL_BlitInfo *band, const SDL_BlitInfo *info, int y, int h)
+{
+    *band = *info;
+    band->dst += (size_t)y * band->dst_pitch;
+    band->dst_h = h;
+    if (band->flags & SDL_COPY_NEAREST) {
+        band->scale_posy += (Uint64)y * band->scale_incy;
+    } else {
+        band->src += (size_t)y * band->src_pitch;
+        band->src_h = h;
+    }
+}
+
+static void SDL_RunBlitBand(void *userdata, int y, int h)
+{
+    const SDL_BlitBandData *data = (const SDL_BlitBandData *)userdata;
+    SDL_BlitInfo band;
+
+    SDL_SetupBlitBand(&band, data->info, data->first_row + y, h);
+    data->blit(&band);
+}
+
+static bool SDL_CanBlitInBands(SDL_Surface *src, SDL_Surface *dst)
+{
+    // Blits to indexed surfaces add the colors they look up to the shared palette map
+    if (SDL_ISPIXELFORMAT_INDEXED(dst->format)) {
+        return false;
+    }
+    // Bands reading rows that other bands write would depend on which band runs first
+    if (SDL_SurfacePixelsOverlap(src, dst)) {
+        return false;
+    }
+    return true;
+}
+
+static void SDL_RunBlit(SDL_Surface *src, SDL_Surface *dst, SDL_BlitFunc RunBlit, SDL_BlitInfo *info)
+{
+    SDL_BlitBandData data;
+
+    if (!SDL_UseSurfaceThreads(info->dst_w, info->dst_h) || !SDL_CanBlitInBands(src, dst)) {
+        RunBlit(info);
+        return;
+    }
+
+    data.info = info;
+    data.blit = RunBlit;
+    data.first_row = 0;
+
+    if (RunBlit == SDL_Blit_Slow_Float) {
+        /* The first rows run alone, to build the transfer tables and set the destination headroom
+           for the whole blit. The other bands only read them. */
+        SDL_BlitInfo band;
+
+        data.first_row = SDL_min(info->dst_h, (SDL_BLIT_TRANSFER_TABLE_MIN_PIXELS + info->dst_w - 1) / info->dst_w);
+        SDL_SetupBlitBand(&band, info, 0, data.first_row);
+        RunBlit(&band);
+        info->transfer_tables = band.transfer_tables;
+        if (data.first_row == info->dst_h) {
+            return;
+        }
+    }
+
+    if (!SDL_RunSurfaceBands(info->dst_w, info->dst_h - data.first_row, SDL_RunBlitBand, &data)) {
+        SDL_RunBlitBand(&data, 0, info->dst_h - data.first_row);
+    }
+}
+
+/* The general purpose software blit routine
+ * This draws the part of dstrect inside cliprect, as if all of srcrect had
+ * been scaled to dstrect.
+ */
+static bool SDL_SoftBlitClipped(SDL_Surface *src, const SDL_Rect *srcrect,
+                                SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect)
 {
     bool okay;
     int src_locked;
@@ -73,17 +151,24 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         info->src_skip =
             info->src_pitch - info->src_w * info->src_fmt->bytes_per_pixel;
         info->dst =
-            (Uint8 *)dst->pixels + (Uint16)dstrect->y * dst->pitch +
-            (Uint16)dstrect->x * info->dst_fmt->bytes_per_pixel;
-        info->dst_w = dstrect->w;
-        info->dst_h = dstrect->h;
+            (Uint8 *)dst->pixels + (Uint16)cliprect->y * dst->pitch +
+            (Uint16)cliprect->x * info->dst_fmt->bytes_per_pixel;
+        info->dst_w = cliprect->w;
+        info->dst_h = cliprect->h;
         info->dst_pitch = dst->pitch;
         info->dst_skip =
             info->dst_pitch - info->dst_w * info->dst_fmt->bytes_per_pixel;
+        if (dstrect->w > 0 && dstrect->h > 0) {
+            // start at the middle of the first visible pixel
+            info->scale_incx = ((Uint64)srcrect->w << 16) / dstrect->w;
+            info->scale_incy = ((Uint64)srcrect->h << 16) / dstrect->h;
+            info->scale_posx = info->scale_incx / 2 + (Uint64)(cliprect->x - dstrect->x) * info->scale_incx;
+            info->scale_posy = info->scale_incy / 2 + (Uint64)(cliprect->y - dstrect->y) * info->scale_incy;
+        }
         RunBlit = (SDL_BlitFunc)src->map.data;
 
         // Run the actual software blit
-        RunBlit(info);
+        SDL_RunBlit(src, dst, RunBlit, info);
     }
 
     // We need to unlock the surfaces if they're locked
@@ -97,6 +182,27 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     return okay;
 }
 
+static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
+                                SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    return SDL_SoftBlitClipped(src, srcrect, dst, dstrect, dstrect);
+}
+
+bool SDL_BlitSurfaceUncheckedClipped(SDL_Surface *src, const SDL_Rect *srcrect,
+                                     SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect)
+{
+    // Check to make sure the blit mapping is valid
+    if (!SDL_ValidateMap(src, dst)) {
+        return false;
+    }
+    if (src->map.blit != SDL_SoftBlit) {
+        // RLE blits can't scale, so they're never partial
+        SDL_assert(SDL_RectsEqual(dstrect, cliprect));
+        return src->map.blit(src, srcrect, dst, cliprect);
+    }
+    return SDL_SoftBlitClipped(src, srcrect, dst, dstrect, cliprect);
+}
+
 #ifdef SDL_HAVE_BLIT_AUTO
 
 #ifdef SDL_PLATFORM_MACOS
@@ -176,8 +282,65 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(SDL_PixelFormat src_format, SDL_PixelForm
 #endif // SDL_HAVE_BLIT_AUTO
 
 // Figure out which of many blit routines to set up on a surface
+static void SDL_GetBlitCacheKey(SDL_Surface *surface, SDL_Surface *dst, SDL_BlitCacheEntry *key)
+{
+    SDL_zerop(key);
+    key->dst_fmt = dst->fmt;
+    key->src_colorspace = surface->colorspace;
+    key->dst_colorspace = dst->colorspace;
+    key->flags = surface->map.info.flags;
+    key->identity = surface->map.identity;
+    key->src_pal = (surface->palette != NULL);
+    key->dst_pal = (dst->palette != NULL);
+}
+
+static SDL_BlitFunc SDL_LookupBlitCache(SDL_BlitMap *map, const SDL_BlitCacheEntry *key)
+{
+    int i;
+
+    for (i = 0; i < SDL_BLITMAP_CACHE_SIZE; ++i) {
+        const SDL_BlitCacheEntry *entry = &map->cache[i];
+        if (entry->func &&
+            entry->dst_fmt == key->dst_fmt &&
+            entry->src_colorspace == key->src_colorspace &&
+            entry->dst_colorspace == key->dst_colorspace &&
+            entry->flags == key->flags &&
+            entry->identity == key->identity &&
+            entry->src_pal == key->src_pal &&
+            entry->dst_pal == key->dst_pal) {
+            return entry->func;
+        }
+    }
+    return NULL;
+}
+
+static void SDL_AddBlitCache(SDL_BlitMap *map, const SDL_BlitCacheEntry *key, SDL_BlitFunc func)
+{
+    SDL_BlitCacheEntry *entry = &map->cache[map->cache_next];
+
+    *entry = *key;
+    entry->func = func;
+    map->cache_next = (map->cache_next + 1) % SDL_BLITMAP_CACHE_SIZE;
+}
+
+bool SDL_GetSurfaceBlitStats(SDL_Surface *surface, SDL_SurfaceBlitStats *stats)
+{
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_zerop(stats);
+    stats->cache_hits = surface->map.cache_hits;
+    stats->cache_misses = surface->map.cache_misses;
+    return true;
+}
+
 bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
 {
+    SDL_BlitCacheEntry key;
     SDL_BlitFunc blit = NULL;
     SDL_BlitMap *map = &surface->map;
     SDL_Colorspace src_colorspace = surface->colorspace;
@@ -213,6 +376,16 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
     }
 #endif
 
+    // See if we've chosen a blit function for this before
+    SDL_GetBlitCacheKey(surface, dst, &key);
+    blit = SDL_LookupBlitCache(map, &key);
+    if (blit) {
+        ++map->cache_hits;
+        map->data = (void *)blit;
+        return true;
+    }
+    ++map->cache_misses;
+
     // Choose a standard blit function
     if (!blit) {
         if (src_colorspace != dst_colorspace ||
@@ -286,5 +459,6 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         return SDL_SetError("Blit combination not supported");
     }
 
+    SDL_AddBlitCache(map, &key, blit);
     return true;
 }
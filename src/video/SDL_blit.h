@@ -65,12 +65,17 @@ typedef struct
     int dst_w, dst_h;
     int dst_pitch;
     int dst_skip;
+    // Scaled blits step through the source in 16.16 fixed point, starting at scale_pos
+    Uint64 scale_incx, scale_incy;
+    Uint64 scale_posx, scale_posy;
     const SDL_PixelFormatDetails *src_fmt;
     const SDL_Palette *src_pal;
     const SDL_PixelFormatDetails *dst_fmt;
     const SDL_Palette *dst_pal;
     Uint8 *table;
     SDL_HashTable *palette_map;
+    // Transfer function tables built by SDL_Blit_Slow_Float(), kept until the map is invalidated
+    struct SDL_BlitTransferTables *transfer_tables;
     int flags;
     Uint32 colorkey;
     Uint8 r, g, b, a;
@@ -89,6 +94,22 @@ typedef struct
 
 typedef bool (SDLCALL *SDL_Blit) (struct SDL_Surface *src, const SDL_Rect *srcrect, struct SDL_Surface *dst, const SDL_Rect *dstrect);
 
+// The number of blit functions each surface remembers
+#define SDL_BLITMAP_CACHE_SIZE 4
+
+// A blit function chosen by SDL_CalculateBlit(), and what it was chosen for
+typedef struct
+{
+    const SDL_PixelFormatDetails *dst_fmt;
+    SDL_Colorspace src_colorspace;
+    SDL_Colorspace dst_colorspace;
+    int flags;
+    int identity;
+    bool src_pal;
+    bool dst_pal;
+    SDL_BlitFunc func;
+} SDL_BlitCacheEntry;
+
 // Blit mapping definition
 typedef struct SDL_BlitMap
 {
@@ -101,10 +122,18 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* recently chosen blit functions, kept when the mapping is invalidated
+       so switching between a few blend and modulation states is cheap */
+    SDL_BlitCacheEntry cache[SDL_BLITMAP_CACHE_SIZE];
+    int cache_next;
+    Uint64 cache_hits;
+    Uint64 cache_misses;
 } SDL_BlitMap;
 
 // Functions found in SDL_blit.c
 extern bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst);
+extern bool SDL_BlitSurfaceUncheckedClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface *surface);
@@ -852,6 +852,439 @@ static void BlitARGBto555PixelAlpha(SDL_BlitInfo *info)
     }
 }
 
+/* Fast 16-bit blending with pixel alpha, for ARGB4444 and ARGB1555 sources
+   blended into RGB565 or into a surface of the same format.
+
+   These produce exactly what BlitNtoNPixelAlpha does: the channels are expanded
+   to 8 bits, blended with ALPHA_BLEND_CHANNEL() and truncated again. A 1-bit alpha
+   blend is either the destination or the source, so the 1555 blitters only copy.
+
+   The color key is handled in the same loop: pixels matching it are treated as
+   fully transparent. Without SDL_COPY_COLORKEY the key can't match any pixel. */
+static Uint32 Get16PixelAlphaColorKey(SDL_BlitInfo *info, Uint32 rgbmask)
+{
+    if (info->flags & SDL_COPY_COLORKEY) {
+        return info->colorkey & rgbmask;
+    }
+    return 0xffff;
+}
+
+static SDL_INLINE Uint16 Blend4444to565(Uint32 s, Uint32 d)
+{
+    const unsigned sA = (s >> 12) * 0x11;
+
+    if (sA == 0) {
+        return (Uint16)d;
+    } else {
+        unsigned sR = ((s >> 8) & 0xf) * 0x11;
+        unsigned sG = ((s >> 4) & 0xf) * 0x11;
+        unsigned sB = (s & 0xf) * 0x11;
+        if (sA < SDL_ALPHA_OPAQUE) {
+            unsigned dR, dG, dB;
+            RGB_FROM_RGB565(d, dR, dG, dB);
+            ALPHA_BLEND_RGB(sR, sG, sB, sA, dR, dG, dB);
+            sR = dR;
+            sG = dG;
+            sB = dB;
+        }
+        return (Uint16)(((sR >> 3) << 11) | ((sG >> 2) << 5) | (sB >> 3));
+    }
+}
+
+static SDL_INLINE Uint16 Blend4444to4444(Uint32 s, Uint32 d)
+{
+    const unsigned sA = (s >> 12) * 0x11;
+
+    if (sA == 0) {
+        return (Uint16)d;
+    } else if (sA == SDL_ALPHA_OPAQUE) {
+        return (Uint16)s;
+    } else {
+        unsigned sR = ((s >> 8) & 0xf) * 0x11;
+        unsigned sG = ((s >> 4) & 0xf) * 0x11;
+        unsigned sB = (s & 0xf) * 0x11;
+        unsigned dR = ((d >> 8) & 0xf) * 0x11;
+        unsigned dG = ((d >> 4) & 0xf) * 0x11;
+        unsigned dB = (d & 0xf) * 0x11;
+        unsigned dA = (d >> 12) * 0x11;
+        ALPHA_BLEND_RGBA(sR, sG, sB, sA, dR, dG, dB, dA);
+        return (Uint16)(((dA >> 4) << 12) | ((dR >> 4) << 8) | ((dG >> 4) << 4) | (dB >> 4));
+    }
+}
+
+// The 5-bit green is expanded to 8 bits and truncated to 6, as RGB565_FROM_RGB() would
+static SDL_INLINE Uint16 Convert1555to565(Uint32 s)
+{
+    return (Uint16)(((s & 0x7c00) << 1) | ((SDL_expand_byte[5][(s >> 5) & 0x1f] >> 2) << 5) | (s & 0x001f));
+}
+
+// fast ARGB4444->RGB565 blending with pixel alpha
+static void Blit4444to565PixelAlpha(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x0fff);
+
+    while (height--) {
+        int i;
+
+        for (i = 0; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x0fff) != ckey) {
+                dstp[i] = Blend4444to565(s, dstp[i]);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+// fast ARGB4444->ARGB4444 blending with pixel alpha
+static void Blit4444to4444PixelAlpha(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x0fff);
+
+    while (height--) {
+        int i;
+
+        for (i = 0; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x0fff) != ckey) {
+                dstp[i] = Blend4444to4444(s, dstp[i]);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+// fast ARGB1555->RGB565 blending with pixel alpha
+static void Blit1555to565PixelAlpha(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x7fff);
+
+    while (height--) {
+        int i;
+
+        for (i = 0; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x8000) && (s & 0x7fff) != ckey) {
+                dstp[i] = Convert1555to565(s);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+// fast ARGB1555->ARGB1555 blending with pixel alpha
+static void Blit1555to1555PixelAlpha(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x7fff);
+
+    while (height--) {
+        int i;
+
+        for (i = 0; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x8000) && (s & 0x7fff) != ckey) {
+                dstp[i] = (Uint16)s;
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+
+// Expands 8 channels of 4, 5 or 6 bits to 8 bits, giving the same values as SDL_expand_byte
+#define EXPAND4_SSE2(c) _mm_or_si128(_mm_slli_epi16(c, 4), c)
+#define EXPAND5_SSE2(c) _mm_srli_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(1053)), 7)
+#define EXPAND6_SSE2(c) _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(259)), _mm_set1_epi16(3)), 6)
+
+// ALPHA_BLEND_CHANNEL() on 8 channels at a time
+static SDL_INLINE __m128i SDL_TARGETING("sse2") AlphaBlendChannelSSE2(__m128i sC, __m128i dC, __m128i sA)
+{
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(sC, dC), sA),
+                              _mm_sub_epi16(_mm_slli_epi16(dC, 8), dC));
+    x = _mm_add_epi16(x, _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static void SDL_TARGETING("sse2") Blit4444to565PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x0fff);
+    const __m128i ckey128 = _mm_set1_epi16((short)ckey);
+    const __m128i rgbmask = _mm_set1_epi16(0x0fff);
+    const __m128i mask4 = _mm_set1_epi16(0x000f);
+    const __m128i mask5 = _mm_set1_epi16(0x001f);
+    const __m128i mask6 = _mm_set1_epi16(0x003f);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            __m128i s = _mm_loadu_si128((__m128i *)(srcp + i));
+            __m128i sA = _mm_srli_epi16(s, 12);
+            __m128i d, sR, sG, sB, dR, dG, dB;
+
+            // Keyed pixels are transparent
+            sA = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(s, rgbmask), ckey128), sA);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(sA, _mm_setzero_si128())) == 0xffff) {
+                continue;
+            }
+            sA = EXPAND4_SSE2(sA);
+
+            d = _mm_loadu_si128((__m128i *)(dstp + i));
+            sR = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(s, 8), mask4));
+            sG = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(s, 4), mask4));
+            sB = EXPAND4_SSE2(_mm_and_si128(s, mask4));
+            dR = EXPAND5_SSE2(_mm_srli_epi16(d, 11));
+            dG = EXPAND6_SSE2(_mm_and_si128(_mm_srli_epi16(d, 5), mask6));
+            dB = EXPAND5_SSE2(_mm_and_si128(d, mask5));
+
+            dR = AlphaBlendChannelSSE2(sR, dR, sA);
+            dG = AlphaBlendChannelSSE2(sG, dG, sA);
+            dB = AlphaBlendChannelSSE2(sB, dB, sA);
+
+            d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(dR, 3), 11),
+                                          _mm_slli_epi16(_mm_srli_epi16(dG, 2), 5)),
+                             _mm_srli_epi16(dB, 3));
+            _mm_storeu_si128((__m128i *)(dstp + i), d);
+        }
+
+        for (; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x0fff) != ckey) {
+                dstp[i] = Blend4444to565(s, dstp[i]);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse2") Blit4444to4444PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x0fff);
+    const __m128i ckey128 = _mm_set1_epi16((short)ckey);
+    const __m128i rgbmask = _mm_set1_epi16(0x0fff);
+    const __m128i mask4 = _mm_set1_epi16(0x000f);
+    const __m128i opaque = _mm_set1_epi16(SDL_ALPHA_OPAQUE);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            __m128i s = _mm_loadu_si128((__m128i *)(srcp + i));
+            __m128i sA = _mm_srli_epi16(s, 12);
+            __m128i d, sR, sG, sB, dR, dG, dB, dA;
+
+            // Keyed pixels are transparent
+            sA = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(s, rgbmask), ckey128), sA);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(sA, _mm_setzero_si128())) == 0xffff) {
+                continue;
+            }
+            sA = EXPAND4_SSE2(sA);
+
+            d = _mm_loadu_si128((__m128i *)(dstp + i));
+            sR = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(s, 8), mask4));
+            sG = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(s, 4), mask4));
+            sB = EXPAND4_SSE2(_mm_and_si128(s, mask4));
+            dA = EXPAND4_SSE2(_mm_srli_epi16(d, 12));
+            dR = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(d, 8), mask4));
+            dG = EXPAND4_SSE2(_mm_and_si128(_mm_srli_epi16(d, 4), mask4));
+            dB = EXPAND4_SSE2(_mm_and_si128(d, mask4));
+
+            dR = AlphaBlendChannelSSE2(sR, dR, sA);
+            dG = AlphaBlendChannelSSE2(sG, dG, sA);
+            dB = AlphaBlendChannelSSE2(sB, dB, sA);
+            dA = AlphaBlendChannelSSE2(opaque, dA, sA);
+
+            d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(dA, 4), 12),
+                                          _mm_slli_epi16(_mm_srli_epi16(dR, 4), 8)),
+                             _mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(dG, 4), 4),
+                                          _mm_srli_epi16(dB, 4)));
+            _mm_storeu_si128((__m128i *)(dstp + i), d);
+        }
+
+        for (; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x0fff) != ckey) {
+                dstp[i] = Blend4444to4444(s, dstp[i]);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse2") Blit1555to565PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x7fff);
+    const __m128i ckey128 = _mm_set1_epi16((short)ckey);
+    const __m128i rgbmask = _mm_set1_epi16(0x7fff);
+    const __m128i rmask = _mm_set1_epi16(0x7c00);
+    const __m128i mask5 = _mm_set1_epi16(0x001f);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            __m128i s = _mm_loadu_si128((__m128i *)(srcp + i));
+            __m128i mask = _mm_srai_epi16(s, 15);
+            __m128i d;
+            int bits;
+
+            // Keyed pixels are transparent
+            mask = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(s, rgbmask), ckey128), mask);
+            bits = _mm_movemask_epi8(mask);
+            if (bits == 0) {
+                continue;
+            }
+
+            // Green goes through 8 bits like Convert1555to565()
+            s = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_and_si128(s, rmask), 1),
+                                          _mm_slli_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(s, 5), mask5), _mm_set1_epi16(1053)), 9), 5)),
+                             _mm_and_si128(s, mask5));
+            if (bits != 0xffff) {
+                d = _mm_loadu_si128((__m128i *)(dstp + i));
+                s = _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, d));
+            }
+            _mm_storeu_si128((__m128i *)(dstp + i), s);
+        }
+
+        for (; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x8000) && (s & 0x7fff) != ckey) {
+                dstp[i] = Convert1555to565(s);
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse2") Blit1555to1555PixelAlphaSSE2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint16 *srcp = (Uint16 *)info->src;
+    int srcskip = info->src_skip >> 1;
+    Uint16 *dstp = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const Uint32 ckey = Get16PixelAlphaColorKey(info, 0x7fff);
+    const __m128i ckey128 = _mm_set1_epi16((short)ckey);
+    const __m128i rgbmask = _mm_set1_epi16(0x7fff);
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            __m128i s = _mm_loadu_si128((__m128i *)(srcp + i));
+            __m128i mask = _mm_srai_epi16(s, 15);
+            __m128i d;
+            int bits;
+
+            // Keyed pixels are transparent
+            mask = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(s, rgbmask), ckey128), mask);
+            bits = _mm_movemask_epi8(mask);
+            if (bits == 0) {
+                continue;
+            }
+            if (bits != 0xffff) {
+                d = _mm_loadu_si128((__m128i *)(dstp + i));
+                s = _mm_or_si128(_mm_and_si128(mask, s), _mm_andnot_si128(mask, d));
+            }
+            _mm_storeu_si128((__m128i *)(dstp + i), s);
+        }
+
+        for (; i < width; ++i) {
+            Uint32 s = srcp[i];
+            if ((s & 0x8000) && (s & 0x7fff) != ckey) {
+                dstp[i] = (Uint16)s;
+            }
+        }
+        srcp += width + srcskip;
+        dstp += width + dstskip;
+    }
+}
+
+#endif // SDL_SSE2_INTRINSICS
+
+// Chooses one of the 16-bit pixel alpha blitters above, or returns NULL if none of them fit
+static SDL_BlitFunc Calculate16to16PixelAlpha(const SDL_PixelFormatDetails *sf, const SDL_PixelFormatDetails *df)
+{
+    // ARGB and ABGR are handled alike, the blitters don't care which of the outer channels is red
+    const bool to565 = (df->Gmask == 0x07e0 && !df->Amask && (sf->Bmask < sf->Rmask) == (df->Bmask < df->Rmask));
+    const bool same = (sf->format == df->format);
+
+    if (sf->bytes_per_pixel != 2 || df->bytes_per_pixel != 2) {
+        return NULL;
+    }
+
+    if (sf->Amask == 0xf000 && sf->Gmask == 0x00f0 && (to565 || same)) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return to565 ? Blit4444to565PixelAlphaSSE2 : Blit4444to4444PixelAlphaSSE2;
+        }
+#endif
+        return to565 ? Blit4444to565PixelAlpha : Blit4444to4444PixelAlpha;
+    }
+
+    if (sf->Amask == 0x8000 && sf->Gmask == 0x03e0 && (to565 || same)) {
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return to565 ? Blit1555to565PixelAlphaSSE2 : Blit1555to1555PixelAlphaSSE2;
+        }
+#endif
+        return to565 ? Blit1555to565PixelAlpha : Blit1555to1555PixelAlpha;
+    }
+
+    return NULL;
+}
+
 // General (slow) N->N blending with per-surface alpha
 static void BlitNtoNSurfaceAlpha(SDL_BlitInfo *info)
 {
@@ -1380,6 +1813,12 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
             }
 
         case 2:
+            if (sf->bytes_per_pixel == 2) {
+                SDL_BlitFunc blit = Calculate16to16PixelAlpha(sf, df);
+                if (blit) {
+                    return blit;
+                }
+            }
             if (sf->bytes_per_pixel == 4 && sf->Amask == 0xff000000 && sf->Gmask == 0xff00 && ((sf->Rmask == 0xff && df->Rmask == 0x1f) || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
                 if (df->Gmask == 0x7e0) {
                     return BlitARGBto565PixelAlpha;
@@ -1479,6 +1918,10 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
         }
         break;
 
+    case SDL_COPY_COLORKEY | SDL_COPY_BLEND:
+        // Per-pixel alpha blits with a color key
+        return Calculate16to16PixelAlpha(sf, df);
+
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
             if (df->bytes_per_pixel == 1) {
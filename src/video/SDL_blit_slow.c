@@ -85,15 +85,15 @@ void SDL_Blit_Slow(SDL_BlitInfo *info)
         last_index = SDL_LookupRGBAColor(palette_map, last_pixel, dst_pal);
     }
 
-    incy = ((Uint64)info->src_h << 16) / info->dst_h;
-    incx = ((Uint64)info->src_w << 16) / info->dst_w;
-    posy = incy / 2; // start at the middle of pixel
+    incy = info->scale_incy;
+    incx = info->scale_incx;
+    posy = info->scale_posy;
 
     while (info->dst_h--) {
         Uint8 *src = 0;
         Uint8 *dst = info->dst;
         int n = info->dst_w;
-        posx = incx / 2; // start at the middle of pixel
+        posx = info->scale_posx;
         srcy = posy >> 16;
         while (n--) {
             srcx = posx >> 16;
@@ -421,6 +421,38 @@ static Uint16 float_to_half(float a)
     return ir;
 }
 
+static float TransferToLinear(SDL_TransferCharacteristics transfer, float SDR_white_point, float v)
+{
+    // Convert to nits so src and dst are guaranteed to be linear and in the same units
+    switch (transfer) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        return SDL_sRGBtoLinear(v);
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        return SDL_PQtoNits(v) / SDR_white_point;
+    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        return v / SDR_white_point;
+    default:
+        // Unknown, leave it alone
+        return v;
+    }
+}
+
+static float TransferFromLinear(SDL_TransferCharacteristics transfer, float SDR_white_point, float v)
+{
+    // We converted to nits so src and dst are guaranteed to be linear and in the same units
+    switch (transfer) {
+    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
+        return SDL_sRGBfromLinear(v);
+    case SDL_TRANSFER_CHARACTERISTICS_PQ:
+        return SDL_PQfromNits(v * SDR_white_point);
+    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
+        return v * SDR_white_point;
+    default:
+        // Unknown, leave it alone
+        return v;
+    }
+}
+
 static void ReadFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, SDL_Colorspace colorspace, float SDR_white_point,
                            float *outR, float *outG, float *outB, float *outA)
 {
@@ -555,31 +587,9 @@ static void ReadFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_
         break;
     }
 
-    // Convert to nits so src and dst are guaranteed to be linear and in the same units
-    switch (SDL_COLORSPACETRANSFER(colorspace)) {
-    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
-        fR = SDL_sRGBtoLinear(fR);
-        fG = SDL_sRGBtoLinear(fG);
-        fB = SDL_sRGBtoLinear(fB);
-        break;
-    case SDL_TRANSFER_CHARACTERISTICS_PQ:
-        fR = SDL_PQtoNits(fR) / SDR_white_point;
-        fG = SDL_PQtoNits(fG) / SDR_white_point;
-        fB = SDL_PQtoNits(fB) / SDR_white_point;
-        break;
-    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
-        fR /= SDR_white_point;
-        fG /= SDR_white_point;
-        fB /= SDR_white_point;
-        break;
-    default:
-        // Unknown, leave it alone
-        break;
-    }
-
-    *outR = fR;
-    *outG = fG;
-    *outB = fB;
+    *outR = TransferToLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fR);
+    *outG = TransferToLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fG);
+    *outB = TransferToLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fB);
     *outA = fA;
 }
 
@@ -590,27 +600,9 @@ static void WriteFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL
     Uint32 pixelvalue;
     float v[4];
 
-    // We converted to nits so src and dst are guaranteed to be linear and in the same units
-    switch (SDL_COLORSPACETRANSFER(colorspace)) {
-    case SDL_TRANSFER_CHARACTERISTICS_SRGB:
-        fR = SDL_sRGBfromLinear(fR);
-        fG = SDL_sRGBfromLinear(fG);
-        fB = SDL_sRGBfromLinear(fB);
-        break;
-    case SDL_TRANSFER_CHARACTERISTICS_PQ:
-        fR = SDL_PQfromNits(fR * SDR_white_point);
-        fG = SDL_PQfromNits(fG * SDR_white_point);
-        fB = SDL_PQfromNits(fB * SDR_white_point);
-        break;
-    case SDL_TRANSFER_CHARACTERISTICS_LINEAR:
-        fR *= SDR_white_point;
-        fG *= SDR_white_point;
-        fB *= SDR_white_point;
-        break;
-    default:
-        // Unknown, leave it alone
-        break;
-    }
+    fR = TransferFromLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fR);
+    fG = TransferFromLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fG);
+    fB = TransferFromLinear(SDL_COLORSPACETRANSFER(colorspace), SDR_white_point, fB);
 
     switch (access) {
     case SlowBlitPixelAccess_Index8:
@@ -728,6 +720,279 @@ static void WriteFloatPixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL
     }
 }
 
+/* Transfer function tables for 8-bit and 10-bit components, so SDL_Blit_Slow_Float() doesn't
+ * need SDL_powf() for every channel of every pixel. They're kept in the blit map and rebuilt
+ * when the transfer characteristics or SDR white points change.
+ */
+#define TRANSFER_TABLE_SIZE 1024
+
+typedef struct
+{
+    SDL_TransferCharacteristics transfer;
+    float white_point;
+    int bits;
+    bool valid;
+} SDL_TransferTableKey;
+
+typedef struct SDL_BlitTransferTables
+{
+    SDL_TransferTableKey src_key;
+    SDL_TransferTableKey dst_key;
+    SDL_TransferTableKey dst_encode_key;
+
+    // The linear value of each source and destination component
+    float src_to_linear[TRANSFER_TABLE_SIZE];
+    float dst_to_linear[TRANSFER_TABLE_SIZE];
+
+    // The smallest linear value that is stored as more than each destination component
+    float dst_from_linear[TRANSFER_TABLE_SIZE - 1];
+} SDL_BlitTransferTables;
+
+static Uint32 QuantizeFromLinear(SDL_TransferCharacteristics transfer, float SDR_white_point, float v, Uint32 max)
+{
+    return (Uint32)SDL_roundf(SDL_clamp(TransferFromLinear(transfer, SDR_white_point, v), 0.0f, 1.0f) * (float)max);
+}
+
+static float FloatFromBits(Uint32 bits)
+{
+    float v;
+    SDL_memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static Uint32 BitsFromFloat(float v)
+{
+    Uint32 bits;
+    SDL_memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+static void BuildToLinearTable(float *table, SDL_TransferCharacteristics transfer, float SDR_white_point, Uint32 max)
+{
+    Uint32 i;
+
+    for (i = 0; i <= max; ++i) {
+        table[i] = TransferToLinear(transfer, SDR_white_point, (float)i / (float)max);
+    }
+}
+
+/* Each threshold is found by searching the bit patterns of the positive floats, which sort
+ * the same way as their values, so the table gives the same results as quantizing the
+ * transfer function directly. That only works if the quantized transfer function never
+ * goes down as the value goes up. PQ does, here and there across its whole range in single
+ * precision, so it doesn't get a table and is always encoded directly.
+ * The search starts from the inverse transfer function, which is usually within a few
+ * steps of the answer.
+ */
+static bool BuildFromLinearTable(float *table, SDL_TransferCharacteristics transfer, float SDR_white_point, Uint32 max)
+{
+    const Uint32 infinity = 0x7F800000;
+    Uint32 lo = 0, hi, step;
+    Uint32 i;
+
+    if (transfer == SDL_TRANSFER_CHARACTERISTICS_PQ) {
+        return false;
+    }
+    if (!(SDR_white_point > 0.0f) || QuantizeFromLinear(transfer, SDR_white_point, 0.0f, max) != 0) {
+        return false;
+    }
+
+    for (i = 0; i < max; ++i) {
+        if (QuantizeFromLinear(transfer, SDR_white_point, FloatFromBits(lo), max) > i) {
+            // The previous threshold skips this value too
+            table[i] = FloatFromBits(lo);
+            continue;
+        }
+
+        // lo quantizes to i or less, look for the first value after it that quantizes to more
+        hi = BitsFromFloat(TransferToLinear(transfer, SDR_white_point, ((float)i + 0.5f) / (float)max));
+        if (!(hi > lo && hi < infinity)) {
+            hi = lo + 1;
+        }
+        step = 1;
+        if (QuantizeFromLinear(transfer, SDR_white_point, FloatFromBits(hi), max) > i) {
+            while (hi - lo > step && QuantizeFromLinear(transfer, SDR_white_point, FloatFromBits(hi - step), max) > i) {
+                hi -= step;
+                step *= 2;
+            }
+            if (hi - lo > step) {
+                lo = hi - step;
+            }
+        } else {
+            lo = hi;
+            for (;;) {
+                if (infinity - lo <= step) {
+                    hi = infinity;
+                    break;
+                }
+                hi = lo + step;
+                if (QuantizeFromLinear(transfer, SDR_white_point, FloatFromBits(hi), max) > i) {
+                    break;
+                }
+                lo = hi;
+                step *= 2;
+            }
+        }
+        while (hi - lo > 1) {
+            const Uint32 mid = lo + (hi - lo) / 2;
+            if (QuantizeFromLinear(transfer, SDR_white_point, FloatFromBits(mid), max) > i) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        table[i] = FloatFromBits(hi);
+        lo = hi;
+    }
+    return true;
+}
+
+// Counts the thresholds at or below v, with a fixed number of steps so there's nothing to mispredict
+static SDL_INLINE Uint32 EncodeFromTable(const float *table, Uint32 max, float v)
+{
+    Uint32 value = 0;
+    Uint32 step;
+
+    for (step = (max + 1) / 2; step; step /= 2) {
+        value += (v >= table[value + step - 1]) ? step : 0;
+    }
+    return value;
+}
+
+static int GetTransferTableBits(SlowBlitPixelAccess access)
+{
+    switch (access) {
+    case SlowBlitPixelAccess_Index8:
+    case SlowBlitPixelAccess_RGB:
+    case SlowBlitPixelAccess_RGBA:
+        return 8;
+    case SlowBlitPixelAccess_10Bit:
+        return 10;
+    default:
+        return 0;
+    }
+}
+
+static SDL_BlitTransferTables *GetTransferTables(SDL_BlitInfo *info, bool build)
+{
+    if (!info->transfer_tables && build) {
+        info->transfer_tables = (SDL_BlitTransferTables *)SDL_calloc(1, sizeof(*info->transfer_tables));
+    }
+    return info->transfer_tables;
+}
+
+static const float *UpdateTransferTable(SDL_TransferTableKey *key, float *table, bool encode, SDL_TransferCharacteristics transfer, float SDR_white_point, int bits, bool build)
+{
+    if (key->bits != bits || key->transfer != transfer || key->white_point != SDR_white_point) {
+        if (!build || !bits) {
+            return NULL;
+        }
+        key->transfer = transfer;
+        key->white_point = SDR_white_point;
+        key->bits = bits;
+        if (encode) {
+            key->valid = BuildFromLinearTable(table, transfer, SDR_white_point, (1u << bits) - 1);
+        } else {
+            BuildToLinearTable(table, transfer, SDR_white_point, (1u << bits) - 1);
+            key->valid = true;
+        }
+    }
+    return key->valid ? table : NULL;
+}
+
+static void ReadTablePixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const SDL_Palette *pal, const float *to_linear,
+                           float *outR, float *outG, float *outB, float *outA)
+{
+    Uint32 pixelvalue;
+    Uint32 R, G, B, A;
+
+    switch (access) {
+    case SlowBlitPixelAccess_Index8:
+        pixelvalue = *pixels;
+        *outR = to_linear[pal->colors[pixelvalue].r];
+        *outG = to_linear[pal->colors[pixelvalue].g];
+        *outB = to_linear[pal->colors[pixelvalue].b];
+        *outA = (float)pal->colors[pixelvalue].a / 255.0f;
+        break;
+    case SlowBlitPixelAccess_RGB:
+        DISEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, pixelvalue, R, G, B);
+        *outR = to_linear[R];
+        *outG = to_linear[G];
+        *outB = to_linear[B];
+        *outA = 1.0f;
+        break;
+    case SlowBlitPixelAccess_RGBA:
+        DISEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, pixelvalue, R, G, B, A);
+        *outR = to_linear[R];
+        *outG = to_linear[G];
+        *outB = to_linear[B];
+        *outA = (float)A / 255.0f;
+        break;
+    case SlowBlitPixelAccess_10Bit:
+        pixelvalue = *((Uint32 *)pixels);
+        if (fmt->format == SDL_PIXELFORMAT_XBGR2101010 || fmt->format == SDL_PIXELFORMAT_ABGR2101010) {
+            *outR = to_linear[(pixelvalue >> 0) & 0x3FF];
+            *outB = to_linear[(pixelvalue >> 20) & 0x3FF];
+        } else {
+            *outR = to_linear[(pixelvalue >> 20) & 0x3FF];
+            *outB = to_linear[(pixelvalue >> 0) & 0x3FF];
+        }
+        *outG = to_linear[(pixelvalue >> 10) & 0x3FF];
+        if (SDL_ISPIXELFORMAT_ALPHA(fmt->format)) {
+            *outA = (float)(pixelvalue >> 30) / 3.0f;
+        } else {
+            *outA = 1.0f;
+        }
+        break;
+    default:
+        // Large formats aren't read with tables
+        *outR = *outG = *outB = *outA = 0.0f;
+        break;
+    }
+}
+
+static void WriteTablePixel(Uint8 *pixels, SlowBlitPixelAccess access, const SDL_PixelFormatDetails *fmt, const float *from_linear,
+                            float fR, float fG, float fB, float fA)
+{
+    Uint32 R, G, B, A;
+    Uint32 pixelvalue;
+
+    switch (access) {
+    case SlowBlitPixelAccess_RGB:
+        R = EncodeFromTable(from_linear, 255, fR);
+        G = EncodeFromTable(from_linear, 255, fG);
+        B = EncodeFromTable(from_linear, 255, fB);
+        ASSEMBLE_RGB(pixels, fmt->bytes_per_pixel, fmt, R, G, B);
+        break;
+    case SlowBlitPixelAccess_RGBA:
+        R = EncodeFromTable(from_linear, 255, fR);
+        G = EncodeFromTable(from_linear, 255, fG);
+        B = EncodeFromTable(from_linear, 255, fB);
+        A = (Uint8)SDL_roundf(SDL_clamp(fA, 0.0f, 1.0f) * 255.0f);
+        ASSEMBLE_RGBA(pixels, fmt->bytes_per_pixel, fmt, R, G, B, A);
+        break;
+    case SlowBlitPixelAccess_10Bit:
+        R = EncodeFromTable(from_linear, 1023, fR);
+        G = EncodeFromTable(from_linear, 1023, fG);
+        B = EncodeFromTable(from_linear, 1023, fB);
+        if (SDL_ISPIXELFORMAT_ALPHA(fmt->format)) {
+            A = (Uint32)SDL_roundf(SDL_clamp(fA, 0.0f, 1.0f) * 3.0f);
+        } else {
+            A = 3;
+        }
+        if (fmt->format == SDL_PIXELFORMAT_XBGR2101010 || fmt->format == SDL_PIXELFORMAT_ABGR2101010) {
+            pixelvalue = (A << 30) | (B << 20) | (G << 10) | R;
+        } else {
+            pixelvalue = (A << 30) | (R << 20) | (G << 10) | B;
+        }
+        *(Uint32 *)pixels = pixelvalue;
+        break;
+    default:
+        // Indexed and large formats aren't written with tables
+        break;
+    }
+}
+
 typedef enum
 {
     SDL_TONEMAP_NONE,
@@ -785,23 +1050,88 @@ static void TonemapChrome(float *r, float *g, float *b, float tonemap_a, float t
     }
 }
 
-static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
+typedef void (*ConvertColorPrimariesSpanFunc)(float *r, float *g, float *b, int n, const float *matrix);
+
+// The same as SDL_ConvertColorPrimaries(), for a span of pixels with the channels in separate arrays
+static void ConvertColorPrimariesSpan(float *r, float *g, float *b, int n, const float *matrix)
+{
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        const float v0 = r[i];
+        const float v1 = g[i];
+        const float v2 = b[i];
+
+        r[i] = matrix[0 * 3 + 0] * v0 + matrix[0 * 3 + 1] * v1 + matrix[0 * 3 + 2] * v2;
+        g[i] = matrix[1 * 3 + 0] * v0 + matrix[1 * 3 + 1] * v1 + matrix[1 * 3 + 2] * v2;
+        b[i] = matrix[2 * 3 + 0] * v0 + matrix[2 * 3 + 1] * v1 + matrix[2 * 3 + 2] * v2;
+    }
+}
+
+#ifdef SDL_SSE_INTRINSICS
+static void SDL_TARGETING("sse") ConvertColorPrimariesSpanSSE(float *r, float *g, float *b, int n, const float *matrix)
+{
+    const __m128 m00 = _mm_set1_ps(matrix[0 * 3 + 0]);
+    const __m128 m01 = _mm_set1_ps(matrix[0 * 3 + 1]);
+    const __m128 m02 = _mm_set1_ps(matrix[0 * 3 + 2]);
+    const __m128 m10 = _mm_set1_ps(matrix[1 * 3 + 0]);
+    const __m128 m11 = _mm_set1_ps(matrix[1 * 3 + 1]);
+    const __m128 m12 = _mm_set1_ps(matrix[1 * 3 + 2]);
+    const __m128 m20 = _mm_set1_ps(matrix[2 * 3 + 0]);
+    const __m128 m21 = _mm_set1_ps(matrix[2 * 3 + 1]);
+    const __m128 m22 = _mm_set1_ps(matrix[2 * 3 + 2]);
+    int i;
+
+    // Multiplied and added in the same order as the scalar version, so the results are identical
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128 v0 = _mm_loadu_ps(&r[i]);
+        const __m128 v1 = _mm_loadu_ps(&g[i]);
+        const __m128 v2 = _mm_loadu_ps(&b[i]);
+
+        _mm_storeu_ps(&r[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, v0), _mm_mul_ps(m01, v1)), _mm_mul_ps(m02, v2)));
+        _mm_storeu_ps(&g[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, v0), _mm_mul_ps(m11, v1)), _mm_mul_ps(m12, v2)));
+        _mm_storeu_ps(&b[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, v0), _mm_mul_ps(m21, v1)), _mm_mul_ps(m22, v2)));
+    }
+    ConvertColorPrimariesSpan(&r[i], &g[i], &b[i], n - i, matrix);
+}
+#endif // SDL_SSE_INTRINSICS
+
+static ConvertColorPrimariesSpanFunc GetConvertColorPrimariesSpanFunc(void)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        return ConvertColorPrimariesSpanSSE;
+    }
+#endif
+    return ConvertColorPrimariesSpan;
+}
+
+static void ApplyTonemap(SDL_TonemapContext *ctx, ConvertColorPrimariesSpanFunc convert_primaries, float *r, float *g, float *b, int n)
 {
+    int i;
+
     switch (ctx->op) {
     case SDL_TONEMAP_LINEAR:
-        TonemapLinear(r, g, b, ctx->data.linear.scale);
+        for (i = 0; i < n; ++i) {
+            TonemapLinear(&r[i], &g[i], &b[i], ctx->data.linear.scale);
+        }
         break;
     case SDL_TONEMAP_CHROME:
         if (ctx->data.chrome.color_primaries_matrix) {
-            SDL_ConvertColorPrimaries(r, g, b, ctx->data.chrome.color_primaries_matrix);
+            convert_primaries(r, g, b, n, ctx->data.chrome.color_primaries_matrix);
+        }
+        for (i = 0; i < n; ++i) {
+            TonemapChrome(&r[i], &g[i], &b[i], ctx->data.chrome.a, ctx->data.chrome.b);
         }
-        TonemapChrome(r, g, b, ctx->data.chrome.a, ctx->data.chrome.b);
         break;
     default:
         break;
     }
 }
 
+// The number of pixels SDL_Blit_Slow_Float() converts to linear colors at a time
+#define FLOAT_BLIT_SPAN 64
+
 /* The SECOND TRUE BLITTER
  * This one is even slower than the first, but also handles large pixel formats and colorspace conversion
  */
@@ -836,6 +1166,13 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     float dst_headroom;
     float src_headroom;
     SDL_TonemapContext tonemap;
+    ConvertColorPrimariesSpanFunc convert_primaries;
+    SDL_BlitTransferTables *tables;
+    bool build_tables;
+    const float *src_to_linear = NULL;
+    const float *dst_to_linear = NULL;
+    const float *dst_from_linear = NULL;
+    float spanR[FLOAT_BLIT_SPAN], spanG[FLOAT_BLIT_SPAN], spanB[FLOAT_BLIT_SPAN], spanA[FLOAT_BLIT_SPAN];
     Uint32 last_pixel = 0;
     Uint8 last_index = 0;
 
@@ -892,102 +1229,148 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
         last_index = SDL_LookupRGBAColor(palette_map, last_pixel, dst_pal);
     }
 
-    incy = ((Uint64)info->src_h << 16) / info->dst_h;
-    incx = ((Uint64)info->src_w << 16) / info->dst_w;
-    posy = incy / 2; // start at the middle of pixel
+    build_tables = (info->dst_w * info->dst_h >= SDL_BLIT_TRANSFER_TABLE_MIN_PIXELS);
+    tables = GetTransferTables(info, build_tables);
+    if (tables) {
+        src_to_linear = UpdateTransferTable(&tables->src_key, tables->src_to_linear, false, SDL_COLORSPACETRANSFER(src_colorspace), src_white_point, GetTransferTableBits(src_access), build_tables);
+        if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+            dst_to_linear = UpdateTransferTable(&tables->dst_key, tables->dst_to_linear, false, SDL_COLORSPACETRANSFER(dst_colorspace), dst_white_point, GetTransferTableBits(dst_access), build_tables);
+        }
+        if (dst_access == SlowBlitPixelAccess_Index8) {
+            // Colors are looked up in the palette as sRGB
+            dst_from_linear = UpdateTransferTable(&tables->dst_encode_key, tables->dst_from_linear, true, SDL_TRANSFER_CHARACTERISTICS_SRGB, 1.0f, 8, build_tables);
+        } else {
+            dst_from_linear = UpdateTransferTable(&tables->dst_encode_key, tables->dst_from_linear, true, SDL_COLORSPACETRANSFER(dst_colorspace), dst_white_point, GetTransferTableBits(dst_access), build_tables);
+        }
+    }
+    convert_primaries = GetConvertColorPrimariesSpanFunc();
+
+    incy = info->scale_incy;
+    incx = info->scale_incx;
+    posy = info->scale_posy;
 
     while (info->dst_h--) {
         Uint8 *src = 0;
         Uint8 *dst = info->dst;
         int n = info->dst_w;
-        posx = incx / 2; // start at the middle of pixel
+        posx = info->scale_posx;
         srcy = posy >> 16;
-        while (n--) {
-            srcx = posx >> 16;
-            src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
+        while (n > 0) {
+            const int count = SDL_min(n, FLOAT_BLIT_SPAN);
+            int i;
 
-            ReadFloatPixel(src, src_access, src_fmt, src_pal, src_colorspace, src_white_point, &srcR, &srcG, &srcB, &srcA);
+            // Convert a span of source pixels, so the color math runs over whole arrays
+            for (i = 0; i < count; ++i) {
+                srcx = posx >> 16;
+                src = (info->src + (srcy * info->src_pitch) + (srcx * srcbpp));
+                if (src_to_linear) {
+                    ReadTablePixel(src, src_access, src_fmt, src_pal, src_to_linear, &spanR[i], &spanG[i], &spanB[i], &spanA[i]);
+                } else {
+                    ReadFloatPixel(src, src_access, src_fmt, src_pal, src_colorspace, src_white_point, &spanR[i], &spanG[i], &spanB[i], &spanA[i]);
+                }
+                posx += incx;
+            }
 
             if (tonemap.op) {
-                ApplyTonemap(&tonemap, &srcR, &srcG, &srcB);
+                ApplyTonemap(&tonemap, convert_primaries, spanR, spanG, spanB, count);
             }
 
             if (color_primaries_matrix) {
-                SDL_ConvertColorPrimaries(&srcR, &srcG, &srcB, color_primaries_matrix);
+                convert_primaries(spanR, spanG, spanB, count, color_primaries_matrix);
             }
 
-            if (flags & SDL_COPY_COLORKEY) {
-                // colorkey isn't supported
-            }
-            if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
-                ReadFloatPixel(dst, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, &dstR, &dstG, &dstB, &dstA);
-            } else {
-                // don't care
-                dstR = dstG = dstB = dstA = 0.0f;
-            }
+            for (i = 0; i < count; ++i) {
+                srcR = spanR[i];
+                srcG = spanG[i];
+                srcB = spanB[i];
+                srcA = spanA[i];
 
-            if (flags & SDL_COPY_MODULATE_COLOR) {
-                srcR = (srcR * modulateR) / 255;
-                srcG = (srcG * modulateG) / 255;
-                srcB = (srcB * modulateB) / 255;
-            }
-            if (flags & SDL_COPY_MODULATE_ALPHA) {
-                srcA = (srcA * modulateA) / 255;
-            }
-            if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
-                if (srcA < 1.0f) {
-                    srcR = (srcR * srcA);
-                    srcG = (srcG * srcA);
-                    srcB = (srcB * srcA);
+                if (flags & SDL_COPY_COLORKEY) {
+                    // colorkey isn't supported
+                }
+                if ((flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL))) {
+                    if (dst_to_linear) {
+                        ReadTablePixel(dst, dst_access, dst_fmt, dst_pal, dst_to_linear, &dstR, &dstG, &dstB, &dstA);
+                    } else {
+                        ReadFloatPixel(dst, dst_access, dst_fmt, dst_pal, dst_colorspace, dst_white_point, &dstR, &dstG, &dstB, &dstA);
+                    }
+                } else {
+                    // don't care
+                    dstR = dstG = dstB = dstA = 0.0f;
                 }
-            }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
-            case 0:
-                dstR = srcR;
-                dstG = srcG;
-                dstB = srcB;
-                dstA = srcA;
-                break;
-            case SDL_COPY_BLEND:
-                dstR = srcR + ((1.0f - srcA) * dstR);
-                dstG = srcG + ((1.0f - srcA) * dstG);
-                dstB = srcB + ((1.0f - srcA) * dstB);
-                dstA = srcA + ((1.0f - srcA) * dstA);
-                break;
-            case SDL_COPY_ADD:
-                dstR = srcR + dstR;
-                dstG = srcG + dstG;
-                dstB = srcB + dstB;
-                break;
-            case SDL_COPY_MOD:
-                dstR = (srcR * dstR);
-                dstG = (srcG * dstG);
-                dstB = (srcB * dstB);
-                break;
-            case SDL_COPY_MUL:
-                dstR = ((srcR * dstR) + (dstR * (1.0f - srcA)));
-                dstG = ((srcG * dstG) + (dstG * (1.0f - srcA)));
-                dstB = ((srcB * dstB) + (dstB * (1.0f - srcA)));
-                break;
-            }
 
-            if (dst_access == SlowBlitPixelAccess_Index8) {
-                Uint32 R = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstR), 0.0f, 1.0f) * 255.0f);
-                Uint32 G = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstG), 0.0f, 1.0f) * 255.0f);
-                Uint32 B = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstB), 0.0f, 1.0f) * 255.0f);
-                Uint32 A = (Uint8)SDL_roundf(SDL_clamp(dstA, 0.0f, 1.0f) * 255.0f);
-                Uint32 dstpixel = ((R << 24) | (G << 16) | (B << 8) | A);
-                if (dstpixel != last_pixel) {
-                    last_pixel = dstpixel;
-                    last_index = SDL_LookupRGBAColor(palette_map, dstpixel, dst_pal);
+                if (flags & SDL_COPY_MODULATE_COLOR) {
+                    srcR = (srcR * modulateR) / 255;
+                    srcG = (srcG * modulateG) / 255;
+                    srcB = (srcB * modulateB) / 255;
+                }
+                if (flags & SDL_COPY_MODULATE_ALPHA) {
+                    srcA = (srcA * modulateA) / 255;
+                }
+                if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
+                    if (srcA < 1.0f) {
+                        srcR = (srcR * srcA);
+                        srcG = (srcG * srcA);
+                        srcB = (srcB * srcA);
+                    }
+                }
+                switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+                case 0:
+                    dstR = srcR;
+                    dstG = srcG;
+                    dstB = srcB;
+                    dstA = srcA;
+                    break;
+                case SDL_COPY_BLEND:
+                    dstR = srcR + ((1.0f - srcA) * dstR);
+                    dstG = srcG + ((1.0f - srcA) * dstG);
+                    dstB = srcB + ((1.0f - srcA) * dstB);
+                    dstA = srcA + ((1.0f - srcA) * dstA);
+                    break;
+                case SDL_COPY_ADD:
+                    dstR = srcR + dstR;
+                    dstG = srcG + dstG;
+                    dstB = srcB + dstB;
+                    break;
+                case SDL_COPY_MOD:
+                    dstR = (srcR * dstR);
+                    dstG = (srcG * dstG);
+                    dstB = (srcB * dstB);
+                    break;
+                case SDL_COPY_MUL:
+                    dstR = ((srcR * dstR) + (dstR * (1.0f - srcA)));
+                    dstG = ((srcG * dstG) + (dstG * (1.0f - srcA)));
+                    dstB = ((srcB * dstB) + (dstB * (1.0f - srcA)));
+                    break;
                 }
-                *dst = last_index;
-            } else {
-                WriteFloatPixel(dst, dst_access, dst_fmt, dst_colorspace, dst_white_point, dstR, dstG, dstB, dstA);
-            }
 
-            posx += incx;
-            dst += dstbpp;
+                if (dst_access == SlowBlitPixelAccess_Index8) {
+                    Uint32 R, G, B, A, dstpixel;
+                    if (dst_from_linear) {
+                        R = EncodeFromTable(dst_from_linear, 255, dstR);
+                        G = EncodeFromTable(dst_from_linear, 255, dstG);
+                        B = EncodeFromTable(dst_from_linear, 255, dstB);
+                    } else {
+                        R = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstR), 0.0f, 1.0f) * 255.0f);
+                        G = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstG), 0.0f, 1.0f) * 255.0f);
+                        B = (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(dstB), 0.0f, 1.0f) * 255.0f);
+                    }
+                    A = (Uint8)SDL_roundf(SDL_clamp(dstA, 0.0f, 1.0f) * 255.0f);
+                    dstpixel = ((R << 24) | (G << 16) | (B << 8) | A);
+                    if (dstpixel != last_pixel) {
+                        last_pixel = dstpixel;
+                        last_index = SDL_LookupRGBAColor(palette_map, dstpixel, dst_pal);
+                    }
+                    *dst = last_index;
+                } else if (dst_from_linear) {
+                    WriteTablePixel(dst, dst_access, dst_fmt, dst_from_linear, dstR, dstG, dstB, dstA);
+                } else {
+                    WriteFloatPixel(dst, dst_access, dst_fmt, dst_colorspace, dst_white_point, dstR, dstG, dstB, dstA);
+                }
+
+                dst += dstbpp;
+            }
+            n -= count;
         }
         posy += incy;
         info->dst += info->dst_pitch;
@@ -24,6 +24,10 @@
 
 #include "SDL_internal.h"
 
+/* SDL_Blit_Slow_Float() builds transfer function tables for blits of at least this many pixels,
+   building them takes about as long as converting a few thousand pixels directly */
+#define SDL_BLIT_TRANSFER_TABLE_MIN_PIXELS 4096
+
 extern void SDL_Blit_Slow(SDL_BlitInfo *info);
 extern void SDL_Blit_Slow_Float(SDL_BlitInfo *info);
 
@@ -254,6 +254,23 @@ bool SDL_FillSurfaceRect(SDL_Surface *dst, const SDL_Rect *rect, Uint32 color)
     return SDL_FillSurfaceRects(dst, rect, 1, color);
 }
 
+// A fill split into row bands, see SDL_RunSurfaceBands()
+typedef struct
+{
+    void (*fill_function)(Uint8 *pixels, int pitch, Uint32 color, int w, int h);
+    Uint8 *pixels;
+    int pitch;
+    Uint32 color;
+    int w;
+} SDL_FillBandData;
+
+static void SDL_FillSurfaceBand(void *userdata, int y, int h)
+{
+    const SDL_FillBandData *data = (const SDL_FillBandData *)userdata;
+
+    data->fill_function(data->pixels + (size_t)y * data->pitch, data->pitch, data->color, data->w, h);
+}
+
 bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Uint32 color)
 {
     SDL_Rect clipped;
@@ -361,6 +378,18 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
                  rect->x * SDL_BYTESPERPIXEL(dst->format);
 
+        if (SDL_UseSurfaceThreads(rect->w, rect->h)) {
+            SDL_FillBandData data;
+
+            data.fill_function = fill_function;
+            data.pixels = pixels;
+            data.pitch = dst->pitch;
+            data.color = color;
+            data.w = rect->w;
+            if (SDL_RunSurfaceBands(rect->w, rect->h, SDL_FillSurfaceBand, &data)) {
+                continue;
+            }
+        }
         fill_function(pixels, dst->pitch, color, rect->w, rect->h);
     }
 
@@ -1478,6 +1478,10 @@ void SDL_InvalidateMap(SDL_BlitMap *map)
         SDL_DestroyHashTable(map->info.palette_map);
         map->info.palette_map = NULL;
     }
+    if (map->info.transfer_tables) {
+        SDL_free(map->info.transfer_tables);
+        map->info.transfer_tables = NULL;
+    }
 }
 
 bool SDL_MapSurface(SDL_Surface *src, SDL_Surface *dst)
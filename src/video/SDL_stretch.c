@@ -22,16 +22,55 @@
 
 #include "SDL_surface_c.h"
 
-static bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
-static bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *clip);
+static bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *clip);
+
+// A stretch split into row bands, see SDL_RunSurfaceBands()
+typedef struct
+{
+    SDL_Surface *src;
+    const SDL_Rect *srcrect;
+    SDL_Surface *dst;
+    const SDL_Rect *dstrect;
+    const SDL_Rect *clip;
+    SDL_ScaleMode scaleMode;
+    SDL_AtomicInt failed;
+} SDL_StretchBandData;
+
+static void SDL_StretchSurfaceBand(void *userdata, int y, int h)
+{
+    SDL_StretchBandData *data = (SDL_StretchBandData *)userdata;
+    SDL_Rect clip;
+    bool result;
+
+    clip.x = data->clip->x;
+    clip.y = data->clip->y + y;
+    clip.w = data->clip->w;
+    clip.h = h;
+    if (data->scaleMode == SDL_SCALEMODE_NEAREST) {
+        result = SDL_StretchSurfaceUncheckedNearest(data->src, data->srcrect, data->dst, data->dstrect, &clip);
+    } else {
+        result = SDL_StretchSurfaceUncheckedLinear(data->src, data->srcrect, data->dst, data->dstrect, &clip);
+    }
+    if (!result) {
+        SDL_SetAtomicInt(&data->failed, 1);
+    }
+}
 
 bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    return SDL_StretchSurfaceClipped(src, srcrect, dst, dstrect, NULL, scaleMode);
+}
+
+bool SDL_StretchSurfaceClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect, SDL_ScaleMode scaleMode)
 {
     bool result;
+    bool banded;
     int src_locked;
     int dst_locked;
     SDL_Rect full_src;
     SDL_Rect full_dst;
+    SDL_Rect clip;
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -46,7 +85,7 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         if (!src_tmp) {
             return false;
         }
-        result = SDL_StretchSurface(src_tmp, srcrect, dst, dstrect, scaleMode);
+        result = SDL_StretchSurfaceClipped(src_tmp, srcrect, dst, dstrect, cliprect, scaleMode);
         SDL_DestroySurface(src_tmp);
         return result;
     }
@@ -61,16 +100,26 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
             dstrect = &full_dst;
         }
 
+        if (!cliprect) {
+            cliprect = dstrect;
+        }
+
+        // Only the visible part goes through the temporary surface
         SDL_Surface *src_tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_XRGB8888);
-        SDL_Surface *dst_tmp = SDL_CreateSurface(dstrect->w, dstrect->h, SDL_PIXELFORMAT_XRGB8888);
+        SDL_Surface *dst_tmp = SDL_CreateSurface(cliprect->w, cliprect->h, SDL_PIXELFORMAT_XRGB8888);
         if (src_tmp && dst_tmp) {
-            result = SDL_StretchSurface(src_tmp, srcrect, dst_tmp, NULL, scaleMode);
+            SDL_Rect tmp_dstrect;
+            tmp_dstrect.x = dstrect->x - cliprect->x;
+            tmp_dstrect.y = dstrect->y - cliprect->y;
+            tmp_dstrect.w = dstrect->w;
+            tmp_dstrect.h = dstrect->h;
+            result = SDL_StretchSurfaceClipped(src_tmp, srcrect, dst_tmp, &tmp_dstrect, &dst_tmp->clip_rect, scaleMode);
             if (result) {
-                result = SDL_ConvertPixelsAndColorspace(dstrect->w, dstrect->h,
+                result = SDL_ConvertPixelsAndColorspace(cliprect->w, cliprect->h,
                             dst_tmp->format, SDL_COLORSPACE_SRGB, 0,
                             dst_tmp->pixels, dst_tmp->pitch,
                             dst->format, dst->colorspace, SDL_GetSurfaceProperties(dst),
-                            (Uint8 *)dst->pixels + dstrect->y * dst->pitch + dstrect->x * SDL_BYTESPERPIXEL(dst->format), dst->pitch);
+                            (Uint8 *)dst->pixels + cliprect->y * dst->pitch + cliprect->x * SDL_BYTESPERPIXEL(dst->format), dst->pitch);
             }
         } else {
             result = false;
@@ -112,21 +161,24 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         full_src.h = src->h;
         srcrect = &full_src;
     }
-    if (dstrect) {
-        if ((dstrect->x < 0) || (dstrect->y < 0) ||
-            ((dstrect->x + dstrect->w) > dst->w) ||
-            ((dstrect->y + dstrect->h) > dst->h)) {
-            return SDL_SetError("Invalid destination blit rectangle");
-        }
-    } else {
+    if (!dstrect) {
         full_dst.x = 0;
         full_dst.y = 0;
         full_dst.w = dst->w;
         full_dst.h = dst->h;
         dstrect = &full_dst;
     }
+    if (!cliprect) {
+        cliprect = dstrect;
+    }
+    // Only the clipped part of the destination rectangle needs to be inside the surface
+    if ((cliprect->x < 0) || (cliprect->y < 0) ||
+        ((cliprect->x + cliprect->w) > dst->w) ||
+        ((cliprect->y + cliprect->h) > dst->h)) {
+        return SDL_SetError("Invalid destination blit rectangle");
+    }
 
-    if (dstrect->w <= 0 || dstrect->h <= 0) {
+    if (cliprect->w <= 0 || cliprect->h <= 0) {
         return true;
     }
 
@@ -155,10 +207,33 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         src_locked = 1;
     }
 
-    if (scaleMode == SDL_SCALEMODE_NEAREST) {
-        result = SDL_StretchSurfaceUncheckedNearest(src, srcrect, dst, dstrect);
-    } else {
-        result = SDL_StretchSurfaceUncheckedLinear(src, srcrect, dst, dstrect);
+    // The kernels work relative to the destination rectangle
+    clip.x = cliprect->x - dstrect->x;
+    clip.y = cliprect->y - dstrect->y;
+    clip.w = cliprect->w;
+    clip.h = cliprect->h;
+
+    banded = false;
+    if (SDL_UseSurfaceThreads(clip.w, clip.h) && !SDL_SurfacePixelsOverlap(src, dst)) {
+        SDL_StretchBandData data;
+
+        data.src = src;
+        data.srcrect = srcrect;
+        data.dst = dst;
+        data.dstrect = dstrect;
+        data.clip = &clip;
+        data.scaleMode = scaleMode;
+        SDL_SetAtomicInt(&data.failed, 0);
+        banded = SDL_RunSurfaceBands(clip.w, clip.h, SDL_StretchSurfaceBand, &data);
+        result = !SDL_GetAtomicInt(&data.failed);
+    }
+
+    if (!banded) {
+        if (scaleMode == SDL_SCALEMODE_NEAREST) {
+            result = SDL_StretchSurfaceUncheckedNearest(src, srcrect, dst, dstrect, &clip);
+        } else {
+            result = SDL_StretchSurfaceUncheckedLinear(src, srcrect, dst, dstrect, &clip);
+        }
     }
 
     // We need to unlock the surfaces if they're locked
@@ -196,11 +271,12 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
     int left_pad_w_init, right_pad_w_init, dst_gap, middle_init;                      \
     get_scaler_datas(src_h, dst_h, &fp_sum_h, &fp_step_h, &left_pad_h, &right_pad_h); \
     get_scaler_datas(src_w, dst_w, &fp_sum_w, &fp_step_w, &left_pad_w, &right_pad_w); \
-    fp_sum_w_init = fp_sum_w + left_pad_w * fp_step_w;                                \
-    left_pad_w_init = left_pad_w;                                                     \
-    right_pad_w_init = right_pad_w;                                                   \
-    dst_gap = dst_pitch - 4 * dst_w;                                                  \
-    middle_init = dst_w - left_pad_w - right_pad_w;
+    fp_sum_h += (Sint64)clip->y * fp_step_h;                                          \
+    fp_sum_w_init = fp_sum_w + (Sint64)SDL_max(clip->x, left_pad_w) * fp_step_w;      \
+    left_pad_w_init = SDL_clamp(left_pad_w - clip->x, 0, clip->w);                    \
+    right_pad_w_init = SDL_clamp(clip->x + clip->w + right_pad_w - dst_w, 0, clip->w); \
+    dst_gap = dst_pitch - 4 * clip->w;                                                \
+    middle_init = clip->w - left_pad_w_init - right_pad_w_init;
 
 #define BILINEAR___HEIGHT                                              \
     int index_h, frac_h0, frac_h1, middle;                             \
@@ -327,11 +403,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
     INTERPOL(tmp, tmp + 1, frac_w0, frac_w1, dst);
 }
 
-static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
 
         BILINEAR___HEIGHT
 
@@ -447,11 +523,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -611,11 +687,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -829,7 +905,7 @@ static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitc
 }
 #endif
 
-bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
+bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect, const SDL_Rect *clip)
 {
     bool result = false;
     int src_w = srcrect->w;
@@ -839,22 +915,22 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     int src_pitch = s->pitch;
     int dst_pitch = d->pitch;
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + (dstrect->x + clip->x) * 4 + (dstrect->y + clip->y) * dst_pitch);
 
 #ifdef SDL_NEON_INTRINSICS
     if (!result && hasNEON()) {
-        result = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
     if (!result && hasSSE2()) {
-        result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     }
 #endif
 
     if (!result) {
-        result = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        result = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     }
 
     return result;
@@ -869,21 +945,21 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     const Uint32 *src_h0;                 \
     incy = ((Uint64)src_h << 16) / dst_h; \
     incx = ((Uint64)src_w << 16) / dst_w; \
-    dst_gap = dst_pitch - bpp * dst_w;    \
-    posy = incy / 2;
+    dst_gap = dst_pitch - bpp * clip->w;  \
+    posy = incy / 2 + clip->y * incy;
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
     src_h0 = (const Uint32 *)((const Uint8 *)src_ptr + srcy * src_pitch); \
     posy += incy;                                                         \
-    posx = incx / 2;                                                      \
-    n = dst_w;
+    posx = incx / 2 + clip->x * incx;                                     \
+    n = clip->w;
 
-static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -898,11 +974,11 @@ static bool scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -917,11 +993,11 @@ static bool scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -938,11 +1014,11 @@ static bool scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, const SDL_Rect *clip)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = clip->y; i < clip->y + clip->h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -957,7 +1033,7 @@ static bool scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int
     return true;
 }
 
-bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
+bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect, const SDL_Rect *clip)
 {
     int src_w = srcrect->w;
     int src_h = srcrect->h;
@@ -968,15 +1044,15 @@ bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect,
     int bpp = SDL_BYTESPERPIXEL(d->format);
 
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + (dstrect->x + clip->x) * bpp + (dstrect->y + clip->y) * dst_pitch);
 
     if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, clip);
     }
 }
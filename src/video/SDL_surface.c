@@ -1095,7 +1095,7 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
     SDL_Rect *clip_rect;
     double src_x0, src_y0, src_x1, src_y1;
     double dst_x0, dst_y0, dst_x1, dst_y1;
-    SDL_Rect final_src, final_dst;
+    SDL_Rect final_src, final_dst, visible_dst;
     double scaling_w, scaling_h;
     int src_w, src_h;
     int dst_w, dst_h;
@@ -1198,9 +1198,31 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
         }
     }
 
-    // Clip destination rectangle to the clip rectangle
     clip_rect = &dst->clip_rect;
 
+    final_src.x = (int)SDL_round(src_x0);
+    final_src.y = (int)SDL_round(src_y0);
+    final_src.w = (int)SDL_round(src_x1 - src_x0);
+    final_src.h = (int)SDL_round(src_y1 - src_y0);
+
+    final_dst.x = (int)SDL_round(dst_x0);
+    final_dst.y = (int)SDL_round(dst_y0);
+    final_dst.w = (int)SDL_round(dst_x1 - dst_x0);
+    final_dst.h = (int)SDL_round(dst_y1 - dst_y0);
+
+    if (final_dst.w <= SDL_MAX_UINT16 && final_dst.h <= SDL_MAX_UINT16) {
+        /* Scale the whole rectangle and only write the part inside the clip rectangle,
+           so the source is sampled at the same positions however much of it is visible */
+        if (!SDL_GetRectIntersection(clip_rect, &final_dst, &visible_dst) ||
+            final_src.w < 0 || final_src.h < 0) {
+            // No-op.
+            return true;
+        }
+        return SDL_BlitSurfaceUncheckedScaledClipped(src, &final_src, dst, &final_dst, &visible_dst, scaleMode);
+    }
+
+    // Clip destination rectangle to the clip rectangle
+
     // Translate to clip space for easier calculations
     dst_x0 -= clip_rect->x;
     dst_x1 -= clip_rect->x;
@@ -1270,6 +1292,15 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
  *  scaled blitting only.
  */
 bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    return SDL_BlitSurfaceUncheckedScaledClipped(src, srcrect, dst, dstrect, dstrect, scaleMode);
+}
+
+/**
+ *  Scale srcrect to dstrect, writing only the part inside cliprect.
+ *  dstrect may extend past the destination surface, cliprect must be inside both.
+ */
+bool SDL_BlitSurfaceUncheckedScaledClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect, SDL_ScaleMode scaleMode)
 {
     static const Uint32 complex_copy_flags = (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY);
 
@@ -1288,18 +1319,18 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             src->format == dst->format &&
             !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
             SDL_BYTESPERPIXEL(src->format) <= 4) {
-            return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
+            return SDL_StretchSurfaceClipped(src, srcrect, dst, dstrect, cliprect, SDL_SCALEMODE_NEAREST);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
             SDL_Surface *tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
             if (tmp) {
-                result = SDL_BlitSurfaceUncheckedScaled(tmp, srcrect, dst, dstrect, SDL_SCALEMODE_NEAREST);
+                result = SDL_BlitSurfaceUncheckedScaledClipped(tmp, srcrect, dst, dstrect, cliprect, SDL_SCALEMODE_NEAREST);
                 SDL_DestroySurface(tmp);
             }
             return result;
         } else {
-            return SDL_BlitSurfaceUnchecked(src, srcrect, dst, dstrect);
+            return SDL_BlitSurfaceUncheckedClipped(src, srcrect, dst, dstrect, cliprect);
         }
     } else {
         if (!(src->map.info.flags & complex_copy_flags) &&
@@ -1308,13 +1339,13 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             SDL_BYTESPERPIXEL(src->format) == 4 &&
             src->format != SDL_PIXELFORMAT_ARGB2101010) {
             // fast path
-            return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            return SDL_StretchSurfaceClipped(src, srcrect, dst, dstrect, cliprect, SDL_SCALEMODE_LINEAR);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
             SDL_Surface *tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_ARGB8888);
             if (tmp) {
-                result = SDL_BlitSurfaceUncheckedScaled(tmp, srcrect, dst, dstrect, scaleMode);
+                result = SDL_BlitSurfaceUncheckedScaledClipped(tmp, srcrect, dst, dstrect, cliprect, scaleMode);
                 SDL_DestroySurface(tmp);
             }
             return result;
@@ -1366,8 +1397,14 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             // Intermediate scaling
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
-                SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_StretchSurface(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_Surface *tmp2 = SDL_CreateSurface(cliprect->w, cliprect->h, src->format);
+
+                // Only the visible part of the scaled image is needed
+                tmprect.x = dstrect->x - cliprect->x;
+                tmprect.y = dstrect->y - cliprect->y;
+                tmprect.w = dstrect->w;
+                tmprect.h = dstrect->h;
+                SDL_StretchSurfaceClipped(src, &srcrect2, tmp2, &tmprect, &tmp2->clip_rect, SDL_SCALEMODE_LINEAR);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1375,12 +1412,12 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
 
                 tmprect.x = 0;
                 tmprect.y = 0;
-                tmprect.w = dstrect->w;
-                tmprect.h = dstrect->h;
-                result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
+                tmprect.w = cliprect->w;
+                tmprect.h = cliprect->h;
+                result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, cliprect);
                 SDL_DestroySurface(tmp2);
             } else {
-                result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                result = SDL_StretchSurfaceClipped(src, &srcrect2, dst, dstrect, cliprect, SDL_SCALEMODE_LINEAR);
             }
 
             SDL_DestroySurface(tmp1);
@@ -3035,3 +3072,238 @@ void SDL_DestroySurface(SDL_Surface *surface)
         SDL_free(surface);
     }
 }
+
+/* Splitting large surface operations into row bands. See SDL_HINT_SURFACE_THREADS.
+ *
+ * The operation is cut into horizontal bands of whole rows, which the calling thread and a pool of workers take
+ * in turn until there are none left. Each band writes its own rows of the destination, so the bands don't need
+ * to be synchronized with each other, only with the caller, which waits for all of them before it returns.
+ */
+
+#define SDL_SURFACE_MAX_THREADS         64
+#define SDL_SURFACE_THREADS_MIN_PIXELS  (256 * 256)
+// A few bands per thread, so the threads finish together even if some bands are slower than others
+#define SDL_SURFACE_BANDS_PER_THREAD    4
+#define SDL_SURFACE_BAND_MIN_ROWS       8
+
+typedef struct SDL_SurfaceBandPool
+{
+    int num_threads;
+    SDL_Thread **workers;
+    SDL_Semaphore *go;
+    SDL_Semaphore *done;
+    SDL_AtomicInt quit;
+
+    // The operation being split
+    SDL_SurfaceBandFunc func;
+    void *userdata;
+    int h;
+    int band_h;
+    int num_bands;
+    SDL_AtomicInt next_band;
+} SDL_SurfaceBandPool;
+
+static SDL_InitState SDL_surface_threads_init;
+static SDL_Mutex *SDL_surface_threads_lock; // held while an operation is using the pool
+static SDL_SurfaceBandPool *SDL_surface_band_pool;
+static bool SDL_surface_threads_busy; // the lock is recursive, this catches a band that starts another operation
+static SDL_AtomicInt SDL_surface_threads;
+static SDL_AtomicInt SDL_surface_threads_min_pixels;
+
+static void SDLCALL SDL_SurfaceThreadsChanged(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+    const int value = newValue ? SDL_atoi(newValue) : 0;
+
+    if (SDL_strcmp(name, SDL_HINT_SURFACE_THREADS) == 0) {
+        SDL_SetAtomicInt(&SDL_surface_threads, SDL_clamp(value, 0, SDL_SURFACE_MAX_THREADS));
+    } else {
+        SDL_SetAtomicInt(&SDL_surface_threads_min_pixels, (newValue && *newValue) ? SDL_max(value, 0) : SDL_SURFACE_THREADS_MIN_PIXELS);
+    }
+}
+
+static void SDL_RunSurfaceBandPool(SDL_SurfaceBandPool *pool)
+{
+    while (true) {
+        const int band = SDL_AddAtomicInt(&pool->next_band, 1);
+        int y;
+
+        if (band >= pool->num_bands) {
+            break;
+        }
+        y = band * pool->band_h;
+        pool->func(pool->userdata, y, SDL_min(pool->band_h, pool->h - y));
+    }
+}
+
+static int SDLCALL SDL_SurfaceBandWorker(void *data)
+{
+    SDL_SurfaceBandPool *pool = (SDL_SurfaceBandPool *)data;
+
+    while (true) {
+        SDL_WaitSemaphore(pool->go);
+        if (SDL_GetAtomicInt(&pool->quit)) {
+            break;
+        }
+        SDL_RunSurfaceBandPool(pool);
+        SDL_SignalSemaphore(pool->done);
+    }
+
+    return 0;
+}
+
+static void SDL_DestroySurfaceBandPool(SDL_SurfaceBandPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&pool->quit, 1);
+    if (pool->workers) {
+        for (i = 1; i < pool->num_threads; i++) {
+            if (pool->workers[i]) {
+                SDL_SignalSemaphore(pool->go);
+            }
+        }
+        for (i = 1; i < pool->num_threads; i++) {
+            SDL_WaitThread(pool->workers[i], NULL);
+        }
+    }
+
+    SDL_DestroySemaphore(pool->go);
+    SDL_DestroySemaphore(pool->done);
+    SDL_free(pool->workers);
+    SDL_free(pool);
+}
+
+// Returns NULL if we failed to start the threads
+static SDL_SurfaceBandPool *SDL_CreateSurfaceBandPool(int num_threads)
+{
+    SDL_SurfaceBandPool *pool;
+    int i;
+
+    pool = (SDL_SurfaceBandPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->num_threads = num_threads;
+    pool->workers = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*pool->workers));
+    pool->go = SDL_CreateSemaphore(0);
+    pool->done = SDL_CreateSemaphore(0);
+    if (!pool->workers || !pool->go || !pool->done) {
+        SDL_DestroySurfaceBandPool(pool);
+        return NULL;
+    }
+
+    // The calling thread works too, so it doesn't get a worker
+    for (i = 1; i < num_threads; i++) {
+        pool->workers[i] = SDL_CreateThread(SDL_SurfaceBandWorker, "SDLSurface", pool);
+        if (!pool->workers[i]) {
+            SDL_DestroySurfaceBandPool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+bool SDL_UseSurfaceThreads(int w, int h)
+{
+    if (SDL_ShouldInit(&SDL_surface_threads_init)) {
+        SDL_surface_threads_lock = SDL_CreateMutex();
+        if (!SDL_surface_threads_lock) {
+            SDL_SetInitialized(&SDL_surface_threads_init, false);
+            return false;
+        }
+        SDL_AddHintCallback(SDL_HINT_SURFACE_THREADS, SDL_SurfaceThreadsChanged, NULL);
+        SDL_AddHintCallback(SDL_HINT_SURFACE_THREADS_MIN_PIXELS, SDL_SurfaceThreadsChanged, NULL);
+        SDL_SetInitialized(&SDL_surface_threads_init, true);
+    }
+
+    if (SDL_GetAtomicInt(&SDL_surface_threads) < 2 || h < 2 * SDL_SURFACE_BAND_MIN_ROWS) {
+        return false;
+    }
+    return ((Sint64)w * h >= SDL_GetAtomicInt(&SDL_surface_threads_min_pixels));
+}
+
+bool SDL_RunSurfaceBands(int w, int h, SDL_SurfaceBandFunc func, void *userdata)
+{
+    SDL_SurfaceBandPool *pool;
+    int num_threads;
+    int i;
+
+    if (!SDL_UseSurfaceThreads(w, h)) {
+        return false;
+    }
+
+    // If another operation is using the threads, this one runs on the calling thread instead of waiting
+    if (!SDL_TryLockMutex(SDL_surface_threads_lock)) {
+        return false;
+    }
+    if (SDL_surface_threads_busy) {
+        SDL_UnlockMutex(SDL_surface_threads_lock);
+        return false;
+    }
+
+    num_threads = SDL_GetAtomicInt(&SDL_surface_threads);
+    pool = SDL_surface_band_pool;
+    if (pool && pool->num_threads != num_threads) {
+        SDL_DestroySurfaceBandPool(pool);
+        pool = NULL;
+    }
+    if (!pool && num_threads >= 2) {
+        pool = SDL_CreateSurfaceBandPool(num_threads);
+    }
+    SDL_surface_band_pool = pool;
+    if (!pool) {
+        SDL_UnlockMutex(SDL_surface_threads_lock);
+        return false;
+    }
+
+    pool->func = func;
+    pool->userdata = userdata;
+    pool->h = h;
+    pool->band_h = SDL_max((h + num_threads * SDL_SURFACE_BANDS_PER_THREAD - 1) / (num_threads * SDL_SURFACE_BANDS_PER_THREAD), SDL_SURFACE_BAND_MIN_ROWS);
+    pool->num_bands = (h + pool->band_h - 1) / pool->band_h;
+    SDL_SetAtomicInt(&pool->next_band, 0);
+    SDL_surface_threads_busy = true;
+
+    for (i = 1; i < num_threads; i++) {
+        SDL_SignalSemaphore(pool->go);
+    }
+
+    SDL_RunSurfaceBandPool(pool);
+
+    for (i = 1; i < num_threads; i++) {
+        SDL_WaitSemaphore(pool->done);
+    }
+
+    SDL_surface_threads_busy = false;
+    SDL_UnlockMutex(SDL_surface_threads_lock);
+    return true;
+}
+
+bool SDL_SurfacePixelsOverlap(SDL_Surface *a, SDL_Surface *b)
+{
+    const Uint8 *a_start = (const Uint8 *)a->pixels;
+    const Uint8 *a_end = a_start + (size_t)a->h * a->pitch;
+    const Uint8 *b_start = (const Uint8 *)b->pixels;
+    const Uint8 *b_end = b_start + (size_t)b->h * b->pitch;
+
+    return (a_start < b_end && b_start < a_end);
+}
+
+void SDL_QuitSurfaceThreads(void)
+{
+    if (SDL_ShouldQuit(&SDL_surface_threads_init)) {
+        SDL_RemoveHintCallback(SDL_HINT_SURFACE_THREADS, SDL_SurfaceThreadsChanged, NULL);
+        SDL_RemoveHintCallback(SDL_HINT_SURFACE_THREADS_MIN_PIXELS, SDL_SurfaceThreadsChanged, NULL);
+        SDL_DestroySurfaceBandPool(SDL_surface_band_pool);
+        SDL_surface_band_pool = NULL;
+        SDL_DestroyMutex(SDL_surface_threads_lock);
+        SDL_surface_threads_lock = NULL;
+        SDL_SetInitialized(&SDL_surface_threads_init, false);
+    }
+}
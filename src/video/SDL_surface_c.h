@@ -89,5 +89,14 @@ extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace co
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceHDRHeadroom(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale);
+extern bool SDL_BlitSurfaceUncheckedScaledClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect, SDL_ScaleMode scaleMode);
+extern bool SDL_StretchSurfaceClipped(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, const SDL_Rect *cliprect, SDL_ScaleMode scaleMode);
+
+// Splitting large surface operations into row bands, see SDL_HINT_SURFACE_THREADS
+typedef void (*SDL_SurfaceBandFunc)(void *userdata, int y, int h);
+extern bool SDL_UseSurfaceThreads(int w, int h);
+extern bool SDL_RunSurfaceBands(int w, int h, SDL_SurfaceBandFunc func, void *userdata);
+extern bool SDL_SurfacePixelsOverlap(SDL_Surface *a, SDL_Surface *b);
+extern void SDL_QuitSurfaceThreads(void);
 
 #endif // SDL_surface_c_h_
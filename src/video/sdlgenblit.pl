@@ -33,12 +33,29 @@ my @src_formats = (
     "RGBA8888",
     "ABGR8888",
     "BGRA8888",
+    "RGB565",
+    "ARGB1555",
+    "ARGB4444",
+    "RGB24",
 );
 my @dst_formats = (
     "XRGB8888",
     "XBGR8888",
     "ARGB8888",
     "ABGR8888",
+    "RGB565",
+    "ARGB1555",
+    "ARGB4444",
+    "RGB24",
+);
+
+# The blitters for formats other than 32-bit ones are only compiled if the
+# build asks for them, see SDL_HAVE_BLIT_AUTO_16BIT and SDL_HAVE_BLIT_AUTO_24BIT.
+my %format_guard = (
+    "RGB565" => "SDL_HAVE_BLIT_AUTO_16BIT",
+    "ARGB1555" => "SDL_HAVE_BLIT_AUTO_16BIT",
+    "ARGB4444" => "SDL_HAVE_BLIT_AUTO_16BIT",
+    "RGB24" => "SDL_HAVE_BLIT_AUTO_24BIT",
 );
 
 my %format_size = (
@@ -48,6 +65,10 @@ my %format_size = (
     "RGBA8888" => 4,
     "ABGR8888" => 4,
     "BGRA8888" => 4,
+    "RGB565" => 2,
+    "ARGB1555" => 2,
+    "ARGB4444" => 2,
+    "RGB24" => 3,
 );
 
 my %format_type = (
@@ -57,6 +78,10 @@ my %format_type = (
     "RGBA8888" => "Uint32",
     "ABGR8888" => "Uint32",
     "BGRA8888" => "Uint32",
+    "RGB565" => "Uint16",
+    "ARGB1555" => "Uint16",
+    "ARGB4444" => "Uint16",
+    "RGB24" => "Uint8",
 );
 
 my %get_rgba_string_ignore_alpha = (
@@ -66,6 +91,10 @@ my %get_rgba_string_ignore_alpha = (
     "RGBA8888" => "__R = (Uint8)(__pixel_ >> 24); __G = (Uint8)(__pixel_ >> 16); __B = (Uint8)(__pixel_ >> 8);",
     "ABGR8888" => "__B = (Uint8)(__pixel_ >> 16); __G = (Uint8)(__pixel_ >> 8); __R = (Uint8)__pixel_;",
     "BGRA8888" => "__B = (Uint8)(__pixel_ >> 24); __G = (Uint8)(__pixel_ >> 16); __R = (Uint8)(__pixel_ >> 8);",
+    "RGB565" => "__R = SDL_expand_byte[5][__pixel_ >> 11]; __G = SDL_expand_byte[6][(__pixel_ >> 5) & 0x3F]; __B = SDL_expand_byte[5][__pixel_ & 0x1F];",
+    "ARGB1555" => "__R = SDL_expand_byte[5][(__pixel_ >> 10) & 0x1F]; __G = SDL_expand_byte[5][(__pixel_ >> 5) & 0x1F]; __B = SDL_expand_byte[5][__pixel_ & 0x1F];",
+    "ARGB4444" => "__R = SDL_expand_byte[4][(__pixel_ >> 8) & 0xF]; __G = SDL_expand_byte[4][(__pixel_ >> 4) & 0xF]; __B = SDL_expand_byte[4][__pixel_ & 0xF];",
+    "RGB24" => "__R = __ptr[0]; __G = __ptr[1]; __B = __ptr[2];",
 );
 
 my %get_rgba_string = (
@@ -75,6 +104,10 @@ my %get_rgba_string = (
     "RGBA8888" => $get_rgba_string_ignore_alpha{"RGBA8888"} . " __A = (Uint8)__pixel_;",
     "ABGR8888" => $get_rgba_string_ignore_alpha{"ABGR8888"} . " __A = (Uint8)(__pixel_ >> 24);",
     "BGRA8888" => $get_rgba_string_ignore_alpha{"BGRA8888"} . " __A = (Uint8)__pixel_;",
+    "RGB565" => $get_rgba_string_ignore_alpha{"RGB565"},
+    "ARGB1555" => $get_rgba_string_ignore_alpha{"ARGB1555"} . " __A = SDL_expand_byte[1][__pixel_ >> 15];",
+    "ARGB4444" => $get_rgba_string_ignore_alpha{"ARGB4444"} . " __A = SDL_expand_byte[4][__pixel_ >> 12];",
+    "RGB24" => $get_rgba_string_ignore_alpha{"RGB24"},
 );
 
 my %set_rgba_string = (
@@ -84,6 +117,10 @@ my %set_rgba_string = (
     "RGBA8888" => "__pixel_ = (__R << 24) | (__G << 16) | (__B << 8) | __A;",
     "ABGR8888" => "__pixel_ = (__A << 24) | (__B << 16) | (__G << 8) | __R;",
     "BGRA8888" => "__pixel_ = (__B << 24) | (__G << 16) | (__R << 8) | __A;",
+    "RGB565" => "__pixel_ = ((__R >> 3) << 11) | ((__G >> 2) << 5) | (__B >> 3);",
+    "ARGB1555" => "__pixel_ = ((__A >> 7) << 15) | ((__R >> 3) << 10) | ((__G >> 3) << 5) | (__B >> 3);",
+    "ARGB4444" => "__pixel_ = ((__A >> 4) << 12) | ((__R >> 4) << 8) | ((__G >> 4) << 4) | (__B >> 4);",
+    "RGB24" => "__ptr[0] = (Uint8)__R; __ptr[1] = (Uint8)__G; __ptr[2] = (Uint8)__B;",
 );
 
 sub open_file {
@@ -183,13 +220,18 @@ sub get_rgba
         $string = $get_rgba_string{$format};
     }
 
-    $string =~ s/__/$prefix/g;
+    # 24-bit formats are read a byte at a time instead of through a pixel value
     if ( $prefix eq "" ) {
-        $string =~ s/_/value/g;
+        $string =~ s/__pixel_/pixelvalue/g;
+        $string =~ s/__ptr/src/g;
     } else {
-        $string =~ s/_//g;
+        $string =~ s/__pixel_/${prefix}pixel/g;
+        $string =~ s/__ptr/$prefix/g;
     }
-    if ( $prefix ne "" ) {
+    $string =~ s/__/$prefix/g;
+    if ( $format_size{$format} == 3 ) {
+        # No pixel value to load
+    } elsif ( $prefix ne "" ) {
         print FILE <<__EOF__;
             ${prefix}pixel = *$prefix;
 __EOF__
@@ -208,17 +250,26 @@ sub set_rgba
     my $prefix = shift;
     my $format = shift;
     my $suffix = "";
+    my $cast = "";
     my $string = $set_rgba_string{$format};
-    $string =~ s/__/$prefix/g;
     if ( $prefix eq "" ) {
         $suffix = "value";
-        $string =~ s/_/value/g;
-    } else {
-        $string =~ s/_//g;
+    }
+    $string =~ s/__pixel_/${prefix}pixel${suffix}/g;
+    $string =~ s/__ptr/dst/g;
+    $string =~ s/__/$prefix/g;
+    if ( $format_size{$format} == 3 ) {
+        print FILE <<__EOF__;
+            $string
+__EOF__
+        return;
+    }
+    if ( $format_type{$format} ne "Uint32" ) {
+        $cast = "($format_type{$format})";
     }
     print FILE <<__EOF__;
             $string
-            *dst = ${prefix}pixel${suffix};
+            *dst = $cast${prefix}pixel${suffix};
 __EOF__
 }
 
@@ -240,9 +291,15 @@ sub output_copycore
     if (!$modulate && !$blend) {
         # Nice and easy...
         if ( $src eq $dst ) {
-            print FILE <<__EOF__;
+            if ( $format_size{$src} == 3 ) {
+                print FILE <<__EOF__;
+            dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+__EOF__
+            } else {
+                print FILE <<__EOF__;
             *dst = *src;
 __EOF__
+            }
             return;
         }
 
@@ -251,7 +308,7 @@ __EOF__
         $sa =~ s/[XA8]//g;
         $da = $dst;
         $da =~ s/[XA8]//g;
-        if ($sa eq $da) {
+        if ($sa eq $da && $format_size{$src} == 4 && $format_size{$dst} == 4) {
             if ($dst_has_alpha && $src_has_alpha) {
                 $da = substr $dst, 0, 1;
                 if ($da eq "A") {
@@ -468,6 +525,53 @@ __EOF__
     }
 }
 
+sub step_pointer
+{
+    my $pointer = shift;
+    my $format = shift;
+
+    # 24-bit pixels are walked as bytes
+    if ( $format_size{$format} == 3 ) {
+        return "$pointer += 3;";
+    }
+    return "++$pointer;";
+}
+
+sub output_guard_begin
+{
+    my $src = shift;
+    my $dst = shift;
+    my @guards = ();
+
+    foreach my $format ($src, $dst) {
+        my $guard = $format_guard{$format};
+        if ( defined($guard) && !grep { $_ eq $guard } @guards ) {
+            push(@guards, $guard);
+        }
+    }
+    if ( @guards ) {
+        print FILE "#if " . join(" && ", @guards) . "\n";
+        if ( !$_[0] ) {
+            print FILE "\n";
+        }
+        return 1;
+    }
+    return 0;
+}
+
+sub output_guard_end
+{
+    my $guarded = shift;
+    my $in_table = shift;
+
+    if ( $guarded ) {
+        print FILE "#endif\n";
+        if ( !$in_table ) {
+            print FILE "\n";
+        }
+    }
+}
+
 sub output_copyfunc
 {
     my $src = shift;
@@ -490,7 +594,7 @@ sub output_copyfunc
 
     $sa =~ s/[XA8]//g;
     $da =~ s/[XA8]//g;
-    $matching_colors = (!$modulate && !$blend && ($sa eq $da)) ? 1 : 0;
+    $matching_colors = (!$modulate && !$blend && ($sa eq $da) && $format_size{$src} == 4 && $format_size{$dst} == 4) ? 1 : 0;
 
     output_copyfuncname("static void", $src, $dst, $modulate, $blend, $scale, 1, "\n");
     print FILE <<__EOF__;
@@ -514,9 +618,11 @@ __EOF__
         }
     }
     if ( $blend ) {
-        print FILE <<__EOF__;
+        if ( $format_size{$src} != 3 ) {
+            print FILE <<__EOF__;
     Uint32 srcpixel;
 __EOF__
+        }
         if (!$ignore_dst_alpha && !$src_has_alpha) {
             if ($modulate){
                 $is_modulateA_done = 1;
@@ -534,9 +640,11 @@ __EOF__
     Uint32 srcR, srcG, srcB, srcA;
 __EOF__
         }
-        print FILE <<__EOF__;
+        if ( $format_size{$dst} != 3 ) {
+            print FILE <<__EOF__;
     Uint32 dstpixel;
 __EOF__
+        }
         if ($dst_has_alpha) {
             print FILE <<__EOF__;
     Uint32 dstR, dstG, dstB, dstA;
@@ -547,9 +655,11 @@ __EOF__
 __EOF__
         }
     } elsif ( $modulate || $src ne $dst ) {
-        print FILE <<__EOF__;
+        if ( $format_size{$src} != 3 || $format_size{$dst} != 3 ) {
+            print FILE <<__EOF__;
     Uint32 pixelvalue;
 __EOF__
+        }
         if ( !$ignore_dst_alpha && !$src_has_alpha ) {
             if ( $modulate ) {
                 $is_modulateA_done = 1;
@@ -588,15 +698,15 @@ __EOF__
 
     print FILE <<__EOF__;
 
-    incy = ((Uint64)info->src_h << 16) / info->dst_h;
-    incx = ((Uint64)info->src_w << 16) / info->dst_w;
-    posy = incy / 2;
+    incy = info->scale_incy;
+    incx = info->scale_incx;
+    posy = info->scale_posy;
 
     while (info->dst_h--) {
         $format_type{$src} *src = 0;
         $format_type{$dst} *dst = ($format_type{$dst} *)info->dst;
         int n = info->dst_w;
-        posx = incx / 2;
+        posx = info->scale_posx;
 
         srcy = posy >> 16;
         while (n--) {
@@ -608,7 +718,7 @@ __EOF__
         output_copycore($src, $dst, $modulate, $blend, $is_modulateA_done, $A_is_const_FF);
         print FILE <<__EOF__;
             posx += incx;
-            ++dst;
+            ${\ step_pointer("dst", $dst)}
         }
         posy += incy;
         info->dst += info->dst_pitch;
@@ -625,8 +735,8 @@ __EOF__
 __EOF__
         output_copycore($src, $dst, $modulate, $blend, $is_modulateA_done, $A_is_const_FF);
         print FILE <<__EOF__;
-            ++src;
-            ++dst;
+            ${\ step_pointer("src", $src)}
+            ${\ step_pointer("dst", $dst)}
         }
         info->src += info->src_pitch;
         info->dst += info->dst_pitch;
@@ -669,6 +779,7 @@ __EOF__
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
             my $dst = $dst_formats[$j];
+            my $guarded = output_guard_begin($src, $dst, 1);
             for (my $modulate = 0; $modulate <= 1; ++$modulate) {
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
@@ -709,6 +820,7 @@ __EOF__
                     }
                 }
             }
+            output_guard_end($guarded, 1);
         }
     }
     print FILE <<__EOF__;
@@ -722,6 +834,7 @@ sub output_copyfunc_c
 {
     my $src = shift;
     my $dst = shift;
+    my $guarded = output_guard_begin($src, $dst, 0);
 
     for (my $modulate = 0; $modulate <= 1; ++$modulate) {
         for (my $blend = 0; $blend <= 1; ++$blend) {
@@ -732,6 +845,7 @@ sub output_copyfunc_c
             }
         }
     }
+    output_guard_end($guarded, 0);
 }
 
 open_file("SDL_blit_auto.h");
@@ -0,0 +1,230 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how long the audio device thread takes to mix many bound streams.
+   This uses the dummy audio driver with no delay between iterations, so the device
+   thread runs as fast as it can, and we count iterations with a postmix callback.
+
+   With --fused both, each run is done twice: once through the general path (convert,
+   resample and gain into a work buffer, then mix), and once with the single pass mix
+   (SDL_HINT_AUDIO_DEVICE_FUSED_MIX), reporting how much source audio each gets through. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAX_STREAMS 1024
+
+static SDL_AtomicInt iterations;
+static float source_data[4096 * 2];  /* big enough for either sample format. */
+static int source_data_len = 0;
+
+static void SDLCALL count_iteration(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    SDL_AddAtomicInt(&iterations, 1);
+}
+
+static void SDLCALL feed_stream(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, source_data_len);
+        SDL_PutAudioStreamData(stream, source_data, len);
+        additional_amount -= len;
+    }
+}
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--streams N,N,...]", "[--mix-threads N]", "[--seconds N]", "[--format s16|f32]", "[--fused 0|1|both]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static bool bench_mix(SDL_AudioDeviceID devid, const SDL_AudioSpec *srcspec, int num_streams, int seconds, const char *label)
+{
+    SDL_AudioStream *streams[MAX_STREAMS];
+    SDL_AudioSpec devspec;
+    int sample_frames = 0;
+    Uint64 start, elapsed;
+    int count;
+    double per_iteration_us, budget_us, source_mbps;
+    int i;
+
+    SDL_PauseAudioDevice(devid);
+
+    for (i = 0; i < num_streams; i++) {
+        streams[i] = SDL_CreateAudioStream(srcspec, NULL);
+        if (!streams[i]) {
+            SDL_Log("Failed to create audio stream: %s", SDL_GetError());
+            num_streams = i;
+            break;
+        }
+        SDL_SetAudioStreamGetCallback(streams[i], feed_stream, NULL);
+    }
+
+    if (!SDL_BindAudioStreams(devid, streams, num_streams)) {
+        SDL_Log("Failed to bind audio streams: %s", SDL_GetError());
+    }
+
+    SDL_GetAudioDeviceFormat(devid, &devspec, &sample_frames);
+
+    SDL_SetAtomicInt(&iterations, 0);
+    start = SDL_GetTicksNS();
+    SDL_ResumeAudioDevice(devid);
+    SDL_Delay(seconds * 1000);
+    SDL_PauseAudioDevice(devid);
+    elapsed = SDL_GetTicksNS() - start;
+    count = SDL_GetAtomicInt(&iterations);
+
+    per_iteration_us = count ? (((double) elapsed) / 1000.0) / count : 0.0;
+    budget_us = (((double) sample_frames) * 1000000.0) / devspec.freq;
+    /* source bytes each stream consumes per device iteration, across all streams, per second of wallclock time. */
+    source_mbps = per_iteration_us ? ((((double) sample_frames) * srcspec->freq / devspec.freq) * SDL_AUDIO_FRAMESIZE(*srcspec) * num_streams) / per_iteration_us : 0.0;
+    SDL_Log("%-7s %4d streams: %8d iterations, %10.2f us per iteration (%5.1f%% of a %d-frame device buffer), %9.1f MB/s of source audio",
+            label, num_streams, count, per_iteration_us, (per_iteration_us / budget_us) * 100.0, sample_frames, source_mbps);
+
+    for (i = 0; i < num_streams; i++) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+
+    return count > 0;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_AudioSpec devspec;
+    SDL_AudioSpec srcspec;
+    SDL_AudioDeviceID devid = 0;
+    const char *stream_counts = "1,8,32,64,128,200";
+    const char *mix_threads = NULL;
+    const char *fused = "both";
+    SDL_AudioFormat format = SDL_AUDIO_S16;
+    int seconds = 1;
+    char *counts = NULL;
+    char *saveptr = NULL;
+    char *token;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--streams") == 0 && argv[i + 1]) {
+                stream_counts = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--mix-threads") == 0 && argv[i + 1]) {
+                mix_threads = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+                seconds = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--format") == 0 && argv[i + 1]) {
+                if (SDL_strcasecmp(argv[i + 1], "s16") == 0) {
+                    format = SDL_AUDIO_S16;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "f32") == 0) {
+                    format = SDL_AUDIO_F32;
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--fused") == 0 && argv[i + 1]) {
+                if ((SDL_strcmp(argv[i + 1], "0") == 0) || (SDL_strcmp(argv[i + 1], "1") == 0) || (SDL_strcmp(argv[i + 1], "both") == 0)) {
+                    fused = argv[i + 1];
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_AUDIO_DUMMY_TIMESCALE, "0");
+    if (mix_threads) {
+        SDL_SetHint(SDL_HINT_AUDIO_DEVICE_MIX_THREADS, mix_threads);
+    }
+
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    /* fill the source with noise, so nothing can take a shortcut on silence. */
+    for (i = 0; i < (int) SDL_arraysize(source_data); i++) {
+        const Sint16 sample = (Sint16) (SDL_rand(0x10000) - 0x8000) / 8;
+        if (format == SDL_AUDIO_S16) {
+            ((Sint16 *) source_data)[i] = sample;
+        } else {
+            source_data[i] = sample / 32768.0f;
+        }
+    }
+    source_data_len = (int) SDL_arraysize(source_data) * SDL_AUDIO_BYTESIZE(format);
+
+    SDL_zero(devspec);
+    devspec.format = SDL_AUDIO_F32;
+    devspec.channels = 2;
+    devspec.freq = 48000;
+
+    /* the common "game asset" case: 44.1kHz 16-bit stereo, resampled and converted for a 48kHz float device. */
+    SDL_zero(srcspec);
+    srcspec.format = format;
+    srcspec.channels = 2;
+    srcspec.freq = 44100;
+
+    SDL_Log("Mixing %s streams with %s mix thread(s), %d second(s) per run", SDL_GetAudioFormatName(format), mix_threads ? mix_threads : "default", seconds);
+
+    counts = SDL_strdup(stream_counts);
+    for (token = SDL_strtok_r(counts, ",", &saveptr); token; token = SDL_strtok_r(NULL, ",", &saveptr)) {
+        const int num_streams = SDL_clamp(SDL_atoi(token), 1, MAX_STREAMS);
+        int mode;
+        for (mode = 0; mode < 2; mode++) {
+            if ((SDL_strcmp(fused, "both") != 0) && (SDL_atoi(fused) != mode)) {
+                continue;
+            }
+
+            /* the hint is checked when the device opens, so reopen it for each mode. */
+            SDL_SetHint(SDL_HINT_AUDIO_DEVICE_FUSED_MIX, mode ? "1" : "0");
+            devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &devspec);
+            if (!devid) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open audio device: %s", SDL_GetError());
+                ret = 3;
+                goto end;
+            }
+
+            /* the postmix callback runs once per device iteration, after all the streams are mixed. */
+            SDL_SetAudioPostmixCallback(devid, count_iteration, NULL);
+
+            if (!bench_mix(devid, &srcspec, num_streams, seconds, mode ? "fused" : "general")) {
+                ret = 4;
+            }
+
+            SDL_CloseAudioDevice(devid);
+            devid = 0;
+        }
+    }
+
+end:
+    SDL_free(counts);
+    SDL_CloseAudioDevice(devid);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,195 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how much audio gets copied on its way from an app to the audio device.
+   This plays a few seconds of float32 audio through the disk audio driver, with no delay
+   between iterations, from one stream whose format matches the device. The stream is fed
+   in a few different ways:
+
+   - put:    SDL_PutAudioStreamData, which copies the data into the stream's queue first.
+   - nocopy: SDL_PutAudioStreamDataNoCopy, so the stream uses the app's buffer directly.
+   - gain:   like nocopy, but with a stream gain of 0.5, so the data has to be processed.
+
+   For each, it reports how many bytes were copied per second of audio: when queueing, and
+   by the device thread, which can hand data that needs no processing straight to the disk
+   driver without copying it into a device buffer first. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    FEED_PUT,
+    FEED_NOCOPY,
+    FEED_GAIN
+} FeedMode;
+
+static const char *feed_names[] = { "put", "nocopy", "gain" };
+
+static bool bench_feed(FeedMode mode, const SDL_AudioSpec *spec, const Uint8 *audio, int audio_len)
+{
+    const double bytes_per_second = (double) spec->freq * SDL_AUDIO_FRAMESIZE(*spec);
+    SDL_AudioDeviceStats devstats;
+    SDL_AudioStreamStats streamstats;
+    SDL_AudioDeviceID devid;
+    SDL_AudioStream *stream;
+    Uint64 queue_copied, device_copied;
+    Uint64 start, elapsed;
+    double audio_seconds;
+    bool result;
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, spec);
+    if (!devid) {
+        SDL_Log("Failed to open audio device: %s", SDL_GetError());
+        return false;
+    }
+
+    stream = SDL_CreateAudioStream(spec, spec);
+    if (!stream) {
+        SDL_Log("Failed to create audio stream: %s", SDL_GetError());
+        SDL_CloseAudioDevice(devid);
+        return false;
+    }
+
+    if (mode == FEED_GAIN) {
+        SDL_SetAudioStreamGain(stream, 0.5f);
+    }
+
+    if (mode == FEED_PUT) {
+        result = SDL_PutAudioStreamData(stream, audio, audio_len);
+        queue_copied = audio_len;
+    } else {
+        result = SDL_PutAudioStreamDataNoCopy(stream, audio, audio_len, NULL, NULL);
+        queue_copied = 0;
+    }
+    SDL_FlushAudioStream(stream);
+
+    if (!result) {
+        SDL_Log("Failed to queue audio: %s", SDL_GetError());
+        SDL_DestroyAudioStream(stream);
+        SDL_CloseAudioDevice(devid);
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    SDL_BindAudioStream(devid, stream);
+    while (SDL_GetAudioStreamQueued(stream) > 0) {
+        SDL_Delay(1);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_UnbindAudioStream(stream);
+    SDL_GetAudioDeviceStats(devid, &devstats);
+    SDL_GetAudioStreamStats(stream, &streamstats);
+
+    /* everything the stream handed out that wasn't played in place got copied into the device buffer. */
+    device_copied = streamstats.bytes - devstats.zero_copy_bytes;
+    audio_seconds = streamstats.bytes / bytes_per_second;
+
+    SDL_Log("%-6s %5.1f s of audio in %7.1f ms: %10.0f bytes copied per second of audio when queueing, %10.0f by the device thread (%5.1f%% played without a copy)",
+            feed_names[mode], audio_seconds, elapsed / 1000000.0,
+            audio_seconds ? queue_copied / audio_seconds : 0.0,
+            audio_seconds ? device_copied / audio_seconds : 0.0,
+            streamstats.bytes ? (devstats.zero_copy_bytes * 100.0) / streamstats.bytes : 0.0);
+
+    SDL_DestroyAudioStream(stream);
+    SDL_CloseAudioDevice(devid);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_AudioSpec spec;
+    const char *output = "testaudiozerocopy.raw";
+    const char *frames = NULL;
+    float *audio = NULL;
+    int audio_len;
+    int seconds = 10;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+                seconds = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = argv[i + 1];
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--output") == 0 && argv[i + 1]) {
+                output = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--seconds N]", "[--frames N]", "[--output FILE]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "disk");
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_OUTPUT_FILE, output);
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_TIMESCALE, "0");
+    if (frames) {
+        SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, frames);
+    }
+
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = 2;
+    spec.freq = 48000;
+
+    /* fill the buffer with noise, so nothing can take a shortcut on silence. */
+    audio_len = spec.freq * SDL_AUDIO_FRAMESIZE(spec) * seconds;
+    audio = (float *) SDL_malloc(audio_len);
+    if (!audio) {
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < audio_len / (int) sizeof (float); i++) {
+        audio[i] = (SDL_randf() - 0.5f) * 0.25f;
+    }
+
+    SDL_Log("Playing %d second(s) of %d Hz stereo float32 audio to %s, %s sample frames per device buffer", seconds, spec.freq, output, frames ? frames : "default");
+
+    for (i = 0; i < (int) SDL_arraysize(feed_names); i++) {
+        if (!bench_feed((FeedMode) i, &spec, (const Uint8 *) audio, audio_len)) {
+            ret = 4;
+            break;
+        }
+    }
+
+    SDL_RemovePath(output);
+
+end:
+    SDL_free(audio);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -1047,6 +1047,8 @@ static int SDLCALL audio_resampleLoss(void *arg)
     { 50, 5000, SDL_PI_D / 2, 20000, 10000, 999, 0.0001 },
     { 50, 440, 0, 22050, 96000, 79, 0.0120 },
     { 50, 440, 0, 96000, 22050, 80, 0.0002 },
+    { 50, 440, 0, 48000, 44100, 80, 0.0010 },
+    { 50, 440, 0, 22050, 48000, 79, 0.0120 },
     { 0 }
   };
 
@@ -1460,6 +1462,1339 @@ cleanup:
 
     return status;
 }
+
+/* A straightforward sample-at-a-time reference for SDL_MixAudio, to check the optimized paths against. */
+static void mixAudioReference(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, float fvolume)
+{
+    const int volume = (int)SDL_roundf(fvolume * 128);
+    const bool swap = ((SDL_AUDIO_ISBIGENDIAN(format) != 0) != (SDL_BYTEORDER == SDL_BIG_ENDIAN));
+    Uint32 i;
+
+    if (volume == 0) {
+        return;
+    }
+
+    switch (SDL_AUDIO_BITSIZE(format)) {
+    case 8:
+        for (i = 0; i < len; i++) {
+            if (format == SDL_AUDIO_U8) {
+                const Uint8 s = (Uint8)(((((int)src[i] - 128) * volume) / 128) + 128);
+                dst[i] = (Uint8)SDL_clamp((int)dst[i] + s - 128, 0, 255);
+            } else {
+                const Sint8 s = (Sint8)((((Sint8)src[i]) * volume) / 128);
+                dst[i] = (Uint8)(Sint8)SDL_clamp((Sint8)dst[i] + s, SDL_MIN_SINT8, SDL_MAX_SINT8);
+            }
+        }
+        break;
+
+    case 16:
+        for (i = 0; i < len / 2; i++) {
+            Sint16 s, d;
+            SDL_memcpy(&s, src + (i * 2), 2);
+            SDL_memcpy(&d, dst + (i * 2), 2);
+            if (swap) {
+                s = (Sint16)SDL_Swap16((Uint16)s);
+                d = (Sint16)SDL_Swap16((Uint16)d);
+            }
+            s = (Sint16)((s * volume) / 128);
+            d = (Sint16)SDL_clamp(d + s, SDL_MIN_SINT16, SDL_MAX_SINT16);
+            if (swap) {
+                d = (Sint16)SDL_Swap16((Uint16)d);
+            }
+            SDL_memcpy(dst + (i * 2), &d, 2);
+        }
+        break;
+
+    case 32:
+        for (i = 0; i < len / 4; i++) {
+            Uint32 s, d;
+            SDL_memcpy(&s, src + (i * 4), 4);
+            SDL_memcpy(&d, dst + (i * 4), 4);
+            if (swap) {
+                s = SDL_Swap32(s);
+                d = SDL_Swap32(d);
+            }
+            if (SDL_AUDIO_ISFLOAT(format)) {
+                float fs, fd;
+                SDL_memcpy(&fs, &s, 4);
+                SDL_memcpy(&fd, &d, 4);
+                fd = (fs * fvolume) + fd;
+                fd = (fd > 1.0f) ? 1.0f : ((fd < -1.0f) ? -1.0f : fd);
+                SDL_memcpy(&d, &fd, 4);
+            } else {
+                const Sint64 s64 = (((Sint64)(Sint32)s) * volume) / 128;
+                d = (Uint32)(Sint32)SDL_clamp((Sint32)d + s64, SDL_MIN_SINT32, SDL_MAX_SINT32);
+            }
+            if (swap) {
+                d = SDL_Swap32(d);
+            }
+            SDL_memcpy(dst + (i * 4), &d, 4);
+        }
+        break;
+    }
+}
+
+/**
+ * Check that SDL_MixAudio matches a simple reference mixer, and compare their speed.
+ *
+ * \sa SDL_MixAudio
+ */
+static int SDLCALL audio_mixAudio(void *arg)
+{
+    static const SDL_AudioFormat formats[] = {
+        SDL_AUDIO_U8, SDL_AUDIO_S8, SDL_AUDIO_S16LE, SDL_AUDIO_S16BE,
+        SDL_AUDIO_S32LE, SDL_AUDIO_S32BE, SDL_AUDIO_F32LE, SDL_AUDIO_F32BE
+    };
+    static const float volumes[] = { 1.0f, 0.5f, 0.3f, 0.999f, 1.5f, -0.75f };
+    const int num_samples = 48000 + 13; /* not a multiple of any vector size, to exercise the leftovers. */
+    const int bench_iterations = 100;
+    Uint8 *src_data, *dst_data, *expected;
+    int i, j, k;
+
+    src_data = (Uint8 *)SDL_malloc(num_samples * 4 + 1);
+    dst_data = (Uint8 *)SDL_malloc(num_samples * 4 + 1);
+    expected = (Uint8 *)SDL_malloc(num_samples * 4 + 1);
+    SDLTest_AssertCheck(src_data && dst_data && expected, "Expected buffers to be allocated.");
+    if (!src_data || !dst_data || !expected) {
+        SDL_free(src_data);
+        SDL_free(dst_data);
+        SDL_free(expected);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        const SDL_AudioFormat format = formats[i];
+        const int sample_size = SDL_AUDIO_BYTESIZE(format);
+        const Uint32 len = (Uint32)(num_samples * sample_size);
+        Uint64 start, mix_ticks, reference_ticks;
+
+        for (j = 0; j < SDL_arraysize(volumes); j++) {
+            /* Use an odd offset, since apps can hand us unaligned buffers. */
+            Uint8 *src = src_data + 1;
+            Uint8 *dst = dst_data + 1;
+            int mismatches = 0;
+
+            for (k = 0; k < num_samples; k++) {
+                if (SDL_AUDIO_ISFLOAT(format)) {
+                    /* Mostly in range, but enough that sums will clip. */
+                    float fsrc = SDLTest_RandomUnitFloat() * 2.4f - 1.2f;
+                    float fdst = SDLTest_RandomUnitFloat() * 2.4f - 1.2f;
+                    if (SDL_AUDIO_ISBIGENDIAN(format)) {
+                        fsrc = SDL_SwapFloatBE(fsrc);
+                        fdst = SDL_SwapFloatBE(fdst);
+                    }
+                    SDL_memcpy(src + (k * 4), &fsrc, 4);
+                    SDL_memcpy(dst + (k * 4), &fdst, 4);
+                } else {
+                    int b;
+                    for (b = 0; b < sample_size; b++) {
+                        src[(k * sample_size) + b] = SDLTest_RandomUint8();
+                        dst[(k * sample_size) + b] = SDLTest_RandomUint8();
+                    }
+                }
+            }
+
+            SDL_memcpy(expected, dst, len);
+            mixAudioReference(expected, src, format, len, volumes[j]);
+            SDLTest_AssertCheck(SDL_MixAudio(dst, src, format, len, volumes[j]), "SDL_MixAudio(%s, volume=%f)", SDL_GetAudioFormatName(format), volumes[j]);
+
+            for (k = 0; k < num_samples; k++) {
+                if (SDL_AUDIO_ISFLOAT(format)) {
+                    float a, b;
+                    SDL_memcpy(&a, dst + (k * 4), 4);
+                    SDL_memcpy(&b, expected + (k * 4), 4);
+                    if (SDL_AUDIO_ISBIGENDIAN(format)) {
+                        a = SDL_SwapFloatBE(a);
+                        b = SDL_SwapFloatBE(b);
+                    }
+                    /* allow for a compiler fusing the reference's multiply-add. */
+                    if (SDL_fabsf(a - b) > ((volumes[j] == 1.0f) ? 0.0f : 1e-6f)) {
+                        mismatches++;
+                    }
+                } else if (SDL_memcmp(dst + (k * sample_size), expected + (k * sample_size), sample_size) != 0) {
+                    mismatches++;
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Expected %s at volume %f to match the reference mixer, %d samples differ",
+                                SDL_GetAudioFormatName(format), volumes[j], mismatches);
+        }
+
+        /* Compare speeds for the common unity-gain case. */
+        start = SDL_GetPerformanceCounter();
+        for (k = 0; k < bench_iterations; k++) {
+            SDL_MixAudio(dst_data, src_data, format, len, 1.0f);
+        }
+        mix_ticks = SDL_GetPerformanceCounter() - start;
+
+        start = SDL_GetPerformanceCounter();
+        for (k = 0; k < bench_iterations; k++) {
+            mixAudioReference(dst_data, src_data, format, len, 1.0f);
+        }
+        reference_ticks = SDL_GetPerformanceCounter() - start;
+
+        SDLTest_Log("Mixing %s: SDL_MixAudio %.1f Msamples/sec, reference %.1f Msamples/sec",
+                    SDL_GetAudioFormatName(format),
+                    ((double)num_samples * bench_iterations / 1000000.0) / ((double)SDL_max(mix_ticks, 1) / SDL_GetPerformanceFrequency()),
+                    ((double)num_samples * bench_iterations / 1000000.0) / ((double)SDL_max(reference_ticks, 1) / SDL_GetPerformanceFrequency()));
+    }
+
+    SDL_free(src_data);
+    SDL_free(dst_data);
+    SDL_free(expected);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Check that every resampling quality produces the right amount of output, with reasonable quality.
+ *
+ * \sa SDL_GetAudioStreamProperties
+ */
+static int SDLCALL audio_resampleQuality(void *arg)
+{
+  const struct {
+    SDL_AudioResampleQuality quality;
+    const char *name;
+    double min_snr;
+  } qualities[] = {
+    { SDL_AUDIO_RESAMPLE_NEAREST, "nearest", 30.0 },
+    { SDL_AUDIO_RESAMPLE_LINEAR, "linear", 60.0 },
+    { SDL_AUDIO_RESAMPLE_CUBIC, "cubic", 80.0 },
+    { SDL_AUDIO_RESAMPLE_SINC, "sinc", 80.0 },
+    { (SDL_AudioResampleQuality)1000, "invalid (sinc)", 80.0 }
+  };
+  const int rate_in = 44100;
+  const int rate_out = 48000;
+  const int tone = 440;
+  const int seconds = 10;
+  const int frames_in = seconds * rate_in;
+  const int frames_target = seconds * rate_out;
+  const int len_in = frames_in * (int)sizeof(float);
+  const int len_target = frames_target * (int)sizeof(float);
+  SDL_AudioSpec spec_in, spec_out;
+  float *buf_in;
+  float *buf_out;
+  int i, q;
+
+  SDL_zero(spec_in);
+  spec_in.format = SDL_AUDIO_F32;
+  spec_in.channels = 1;
+  spec_in.freq = rate_in;
+  SDL_copyp(&spec_out, &spec_in);
+  spec_out.freq = rate_out;
+
+  buf_in = (float *)SDL_malloc(len_in);
+  buf_out = (float *)SDL_malloc(len_target * 2);
+  SDLTest_AssertCheck(buf_in != NULL && buf_out != NULL, "Expected buffers to be created.");
+  if (!buf_in || !buf_out) {
+    SDL_free(buf_in);
+    SDL_free(buf_out);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < frames_in; ++i) {
+    buf_in[i] = (float)sine_wave_sample(i, rate_in, tone, 0);
+  }
+
+  for (q = 0; q < (int)SDL_arraysize(qualities); ++q) {
+    SDL_AudioStream *stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+    double sum_squared_error = 0;
+    double sum_squared_value = 0;
+    double signal_to_noise;
+    int len_out;
+
+    SDLTest_AssertCheck(stream != NULL, "Expected SDL_CreateAudioStream to succeed.");
+    if (!stream) {
+      break;
+    }
+
+    SDL_SetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, qualities[q].quality);
+    SDLTest_AssertPass("Call to SDL_SetNumberProperty(SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, %s)", qualities[q].name);
+
+    len_out = convert_audio_chunks(stream, buf_in, len_in, buf_out, len_target * 2);
+    SDL_DestroyAudioStream(stream);
+    SDLTest_AssertCheck(len_out == len_target, "Expected output length to be %i, got %i.", len_target, len_out);
+    if (len_out != len_target) {
+      continue;
+    }
+
+    for (i = 0; i < frames_target; ++i) {
+      const double target = sine_wave_sample(i, rate_out, tone, 0);
+      const double error = buf_out[i] - target;
+      sum_squared_value += target * target;
+      sum_squared_error += error * error;
+    }
+
+    signal_to_noise = 10 * SDL_log10(sum_squared_value / sum_squared_error);
+    SDLTest_AssertCheck(signal_to_noise >= qualities[q].min_snr, "Expected %s signal-to-noise ratio %f dB to be no less than %f dB.",
+                        qualities[q].name, signal_to_noise, qualities[q].min_snr);
+  }
+
+  SDL_free(buf_in);
+  SDL_free(buf_out);
+
+  return TEST_COMPLETED;
+}
+
+/* Resample `frames` of mono float input from rate_in to rate_out and return how many bytes came out.
+   If `plain` is set, the stream's source format is changed to an unrelated rate after the data is queued,
+   so the resampler phases no longer match the queued data and it is resampled with plain sinc. */
+static int resample_through_stream(const float *buf_in, int frames, int rate_in, int rate_out, bool plain, float *buf_out, int len_out)
+{
+  SDL_AudioSpec spec_in, spec_out;
+  SDL_AudioStream *stream;
+  int total = 0;
+
+  SDL_zero(spec_in);
+  spec_in.format = SDL_AUDIO_F32;
+  spec_in.channels = 1;
+  spec_in.freq = rate_in;
+  SDL_copyp(&spec_out, &spec_in);
+  spec_out.freq = rate_out;
+
+  stream = SDL_CreateAudioStream(&spec_in, &spec_out);
+  if (!stream) {
+    return -1;
+  }
+  SDL_PutAudioStreamData(stream, buf_in, frames * (int)sizeof(float));
+  if (plain) {
+    spec_in.freq = 12347;
+    SDL_SetAudioStreamFormat(stream, &spec_in, NULL);
+  }
+  SDL_FlushAudioStream(stream);
+  while (total < len_out) {
+    const int got = SDL_GetAudioStreamData(stream, ((Uint8 *)buf_out) + total, len_out - total);
+    if (got <= 0) {
+      break;
+    }
+    total += got;
+  }
+  SDL_DestroyAudioStream(stream);
+  return total;
+}
+
+/**
+ * Check that resampling with precomputed filter phases matches plain sinc resampling for simple ratios.
+ */
+static int SDLCALL audio_resamplePhases(void *arg)
+{
+  const struct {
+    int rate_in;
+    int rate_out;
+  } ratios[] = {
+    { 44100, 48000 },
+    { 48000, 44100 },
+    { 22050, 48000 },
+    { 16000, 48000 },
+    { 48000, 32000 },
+    { 8000, 44100 }
+  };
+  const int frames_in = 20000;
+  const int len_max = 4 * frames_in * (int)sizeof(float);
+  float *buf_in = (float *)SDL_malloc(frames_in * sizeof(float));
+  float *buf_phases = (float *)SDL_malloc(len_max);
+  float *buf_plain = (float *)SDL_malloc(len_max);
+  int i, r;
+
+  SDLTest_AssertCheck(buf_in && buf_phases && buf_plain, "Expected buffers to be created.");
+  if (!buf_in || !buf_phases || !buf_plain) {
+    SDL_free(buf_in);
+    SDL_free(buf_phases);
+    SDL_free(buf_plain);
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < frames_in; ++i) {
+    buf_in[i] = (float)(0.5 * sine_wave_sample(i, 44100, 440, 0) + 0.25 * sine_wave_sample(i, 44100, 3000, 1.0));
+  }
+
+  for (r = 0; r < (int)SDL_arraysize(ratios); ++r) {
+    const int rate_in = ratios[r].rate_in;
+    const int rate_out = ratios[r].rate_out;
+    const int len_phases = resample_through_stream(buf_in, frames_in, rate_in, rate_out, false, buf_phases, len_max);
+    const int len_plain = resample_through_stream(buf_in, frames_in, rate_in, rate_out, true, buf_plain, len_max);
+    float max_error = 0.0f;
+
+    SDLTest_AssertCheck(len_phases > 0 && len_phases == len_plain, "Expected %d->%d Hz output lengths to match, got %d and %d.",
+                        rate_in, rate_out, len_phases, len_plain);
+    if (len_phases <= 0 || len_phases != len_plain) {
+      continue;
+    }
+    for (i = 0; i < len_phases / (int)sizeof(float); ++i) {
+      max_error = SDL_max(max_error, SDL_fabsf(buf_phases[i] - buf_plain[i]));
+    }
+    SDLTest_AssertCheck(max_error <= 0.0001f, "Expected %d->%d Hz resampling with filter phases to match plain sinc, max error %f.",
+                        rate_in, rate_out, max_error);
+  }
+
+  SDL_free(buf_in);
+  SDL_free(buf_phases);
+  SDL_free(buf_plain);
+
+  return TEST_COMPLETED;
+}
+
+/* Capture the first few device iterations of a playback device's mix. */
+typedef struct
+{
+  float *buffer;
+  int len;
+  SDL_AtomicInt filled;
+} FusedMixCapture;
+
+static void SDLCALL fusedMixPostmix(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+  FusedMixCapture *capture = (FusedMixCapture *)userdata;
+  const int filled = SDL_GetAtomicInt(&capture->filled);
+  const int len = SDL_min(buflen, capture->len - filled);
+  if (len > 0) {
+    SDL_memcpy(((Uint8 *)capture->buffer) + filled, buffer, len);
+    SDL_SetAtomicInt(&capture->filled, filled + len);
+  }
+}
+
+static bool mixThroughDevice(bool fused, FusedMixCapture *capture)
+{
+  const struct {
+    SDL_AudioFormat format;
+    int freq;
+    float gain;
+  } inputs[] = {
+    { SDL_AUDIO_S16, 44100, 1.0f },
+    { SDL_AUDIO_F32, 44100, 0.5f },
+    { SDL_AUDIO_F32, 48000, 0.75f },
+    { SDL_AUDIO_S16, 22050, 0.25f },
+    { SDL_AUDIO_S16, 48000, 1.0f },
+    { SDL_AUDIO_S16, 11025, 1.0f }
+  };
+  SDL_AudioStream *streams[SDL_arraysize(inputs)];
+  float *source;
+  SDL_AudioSpec spec;
+  SDL_AudioDeviceID devid;
+  Uint64 timeout;
+  int i, j;
+
+  SDL_SetHint(SDL_HINT_AUDIO_DEVICE_FUSED_MIX, fused ? "1" : "0");
+
+  spec.format = SDL_AUDIO_F32;
+  spec.channels = 2;
+  spec.freq = 48000;
+  devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec);
+  SDL_ResetHint(SDL_HINT_AUDIO_DEVICE_FUSED_MIX);
+  SDLTest_AssertCheck(devid != 0, "Validate that SDL_OpenAudioDevice succeeded (fused=%d)", fused);
+  if (!devid) {
+    return false;
+  }
+
+  source = (float *)SDL_malloc(48000 * 2 * sizeof(float));
+  SDLTest_AssertCheck(source != NULL, "Expected source buffer to be created.");
+  if (!source) {
+    SDL_CloseAudioDevice(devid);
+    return false;
+  }
+
+  SDL_PauseAudioDevice(devid);
+  SDL_GetAudioDeviceFormat(devid, &spec, NULL);
+  SDL_SetAudioPostmixCallback(devid, fusedMixPostmix, capture);
+  SDL_SetAtomicInt(&capture->filled, 0);
+
+  for (i = 0; i < (int)SDL_arraysize(inputs); ++i) {
+    const int frames = inputs[i].freq; /* a second of audio is plenty. */
+    SDL_AudioSpec src;
+    src.format = inputs[i].format;
+    src.channels = 2;
+    src.freq = inputs[i].freq;
+    streams[i] = SDL_CreateAudioStream(&src, &spec);
+    SDLTest_AssertCheck(streams[i] != NULL, "Validate that SDL_CreateAudioStream succeeded");
+    if (!streams[i]) {
+      break;
+    }
+    SDL_SetAudioStreamGain(streams[i], inputs[i].gain);
+    for (j = 0; j < frames * 2; ++j) {
+      /* deterministic, quiet noise, so nothing clips and nothing is silent. */
+      const int noise = (int)(((Uint32)(j + i) * 2654435761u) >> 20) - 2048;
+      if (inputs[i].format == SDL_AUDIO_S16) {
+        ((Sint16 *)source)[j] = (Sint16)noise;
+      } else {
+        source[j] = noise / 32768.0f;
+      }
+    }
+    SDLTest_AssertCheck(SDL_PutAudioStreamData(streams[i], source, frames * SDL_AUDIO_FRAMESIZE(src)), "Validate that SDL_PutAudioStreamData succeeded");
+  }
+
+  if (i == (int)SDL_arraysize(inputs)) {
+    SDL_BindAudioStreams(devid, streams, i);
+    SDL_ResumeAudioDevice(devid);
+    timeout = SDL_GetTicks() + 5000;
+    while ((SDL_GetAtomicInt(&capture->filled) < capture->len) && (SDL_GetTicks() < timeout)) {
+      SDL_Delay(10);
+    }
+  }
+
+  SDL_CloseAudioDevice(devid);
+  while (--i >= 0) {
+    SDL_DestroyAudioStream(streams[i]);
+  }
+  SDL_free(source);
+
+  return SDL_GetAtomicInt(&capture->filled) == capture->len;
+}
+
+/**
+ * Check that mixing streams in a single pass on a playback device matches the general path.
+ *
+ * \sa SDL_HINT_AUDIO_DEVICE_FUSED_MIX
+ */
+static int SDLCALL audio_fusedMix(void *arg)
+{
+  const int num_samples = 48000; /* half a second of stereo */
+  FusedMixCapture general, fused;
+  double max_error = 0.0;
+  bool ok;
+  int i;
+
+  SDL_zero(general);
+  SDL_zero(fused);
+  general.len = fused.len = num_samples * (int)sizeof(float);
+  general.buffer = (float *)SDL_malloc(general.len);
+  fused.buffer = (float *)SDL_malloc(fused.len);
+  SDLTest_AssertCheck(general.buffer && fused.buffer, "Expected capture buffers to be created.");
+  if (!general.buffer || !fused.buffer) {
+    SDL_free(general.buffer);
+    SDL_free(fused.buffer);
+    return TEST_ABORTED;
+  }
+
+  ok = mixThroughDevice(false, &general);
+  SDLTest_AssertCheck(ok, "Expected to capture %d bytes of mixed audio without fusing, got %d", general.len, SDL_GetAtomicInt(&general.filled));
+  ok = ok && mixThroughDevice(true, &fused);
+  SDLTest_AssertCheck(ok, "Expected to capture %d bytes of fused mixed audio, got %d", fused.len, SDL_GetAtomicInt(&fused.filled));
+
+  if (ok) {
+    for (i = 0; i < num_samples; ++i) {
+      max_error = SDL_max(max_error, SDL_fabs(general.buffer[i] - fused.buffer[i]));
+    }
+    for (i = 0; i < num_samples; ++i) {
+      if (general.buffer[i] != 0.0f) {
+        break;
+      }
+    }
+    SDLTest_AssertCheck(i < num_samples, "Expected the mixed audio not to be silent.");
+    SDLTest_AssertCheck(max_error <= 1e-5, "Expected fused mixing to match the general path, max error %g", max_error);
+  }
+
+  SDL_free(general.buffer);
+  SDL_free(fused.buffer);
+
+  return ok ? TEST_COMPLETED : TEST_ABORTED;
+}
+
+/* A producer thread pushes a known sequence through a lock-free stream, and the device's postmix checks it arrives intact. */
+#define RING_TEST_FRAMES 24000
+#define RING_TEST_PACKET_FRAMES 37 /* an odd size, so packets don't line up with the ring or the device buffer. */
+
+typedef struct
+{
+  SDL_AudioStream *stream;
+  int channels;
+  SDL_AtomicInt produced;  /* frames put */
+  SDL_AtomicInt full;      /* times the ring was full */
+  SDL_AtomicInt verified;  /* frames seen in order on the device */
+  SDL_AtomicInt errors;    /* frames seen out of order */
+  SDL_AtomicInt done;
+} RingTestData;
+
+static float ringTestSample(int frame)
+{
+  /* never zero, so silence from an underrun can't be mistaken for data, and exact as a float. */
+  return (float)((frame % 1000) + 1) / 1024.0f;
+}
+
+static int SDLCALL ringTestProducer(void *arg)
+{
+  RingTestData *data = (RingTestData *)arg;
+  float packet[RING_TEST_PACKET_FRAMES * 8];
+  int frame = 0;
+  int i, j;
+
+  while (frame < RING_TEST_FRAMES && !SDL_GetAtomicInt(&data->done)) {
+    const int frames = SDL_min(RING_TEST_PACKET_FRAMES, RING_TEST_FRAMES - frame);
+    for (i = 0; i < frames; ++i) {
+      for (j = 0; j < data->channels; ++j) {
+        packet[i * data->channels + j] = ringTestSample(frame + i);
+      }
+    }
+
+    if (SDL_PutAudioStreamData(data->stream, packet, frames * data->channels * (int)sizeof(float))) {
+      frame += frames;
+      SDL_SetAtomicInt(&data->produced, frame);
+    } else {
+      SDL_AddAtomicInt(&data->full, 1);
+      SDL_Delay(1);
+    }
+  }
+
+  return 0;
+}
+
+static void SDLCALL ringTestPostmix(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+  RingTestData *data = (RingTestData *)userdata;
+  const int frames = buflen / (int)(sizeof(float) * spec->channels);
+  int verified = SDL_GetAtomicInt(&data->verified);
+  int i, j;
+
+  for (i = 0; i < frames; ++i) {
+    const float *sample = buffer + (i * spec->channels);
+    if (sample[0] == 0.0f) {
+      continue; /* the producer fell behind, that's okay. */
+    }
+    for (j = 0; j < spec->channels; ++j) {
+      if (sample[j] != ringTestSample(verified)) {
+        SDL_AddAtomicInt(&data->errors, 1);
+        break;
+      }
+    }
+    verified++;
+  }
+
+  SDL_SetAtomicInt(&data->verified, verified);
+}
+
+/**
+ * Stress a stream's lock-free ring, with a producer thread and a playback device.
+ *
+ * \sa SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER
+ */
+static int SDLCALL audio_lockFreeRing(void *arg)
+{
+  RingTestData data;
+  SDL_AudioSpec spec;
+  SDL_AudioSpec other;
+  SDL_AudioDeviceID devid;
+  SDL_Thread *thread;
+  Uint64 timeout;
+  float frame[8];
+  bool result;
+  int queued;
+
+  SDL_zero(data);
+  SDL_zero(frame);
+
+  devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+  SDLTest_AssertCheck(devid != 0, "Validate that SDL_OpenAudioDevice succeeded");
+  if (!devid) {
+    return TEST_ABORTED;
+  }
+
+  /* float data at the device's rate comes out of the postmix bit-exact. */
+  SDL_GetAudioDeviceFormat(devid, &spec, NULL);
+  spec.format = SDL_AUDIO_F32;
+  data.channels = SDL_min(spec.channels, (int)SDL_arraysize(frame));
+  spec.channels = data.channels;
+  data.stream = SDL_CreateAudioStream(&spec, NULL);
+  SDLTest_AssertCheck(data.stream != NULL, "Validate that SDL_CreateAudioStream succeeded");
+  if (!data.stream) {
+    SDL_CloseAudioDevice(devid);
+    return TEST_ABORTED;
+  }
+
+  SDL_SetNumberProperty(SDL_GetAudioStreamProperties(data.stream), SDL_PROP_AUDIOSTREAM_LOCKFREE_RING_FRAMES_NUMBER, 1024);
+
+  SDL_PauseAudioDevice(devid);
+  result = SDL_BindAudioStream(devid, data.stream);
+  SDLTest_AssertCheck(result, "Validate that SDL_BindAudioStream succeeded");
+  SDL_SetAudioPostmixCallback(devid, ringTestPostmix, &data);
+
+  /* the first put sets up the ring, and the next one goes into it. */
+  result = SDL_PutAudioStreamData(data.stream, frame, data.channels * (int)sizeof(float));
+  SDLTest_AssertCheck(result, "Validate that the first SDL_PutAudioStreamData succeeded");
+  result = SDL_PutAudioStreamData(data.stream, frame, data.channels * (int)sizeof(float));
+  SDLTest_AssertCheck(result, "Validate that SDL_PutAudioStreamData into the ring succeeded");
+  queued = SDL_GetAudioStreamQueued(data.stream);
+  SDLTest_AssertCheck(queued == 2 * data.channels * (int)sizeof(float), "Expected both frames to be queued, got %d bytes", queued);
+  result = SDL_PutAudioStreamData(data.stream, frame, sizeof(float) * 1024 * 8);
+  SDLTest_AssertCheck(!result, "Expected SDL_PutAudioStreamData to fail when the ring is full");
+
+  other = spec;
+  other.freq = spec.freq / 2;
+  result = SDL_SetAudioStreamFormat(data.stream, &other, NULL);
+  SDLTest_AssertCheck(!result, "Expected SDL_SetAudioStreamFormat to refuse to change the input format");
+  result = SDL_SetAudioStreamFormat(data.stream, &spec, NULL);
+  SDLTest_AssertCheck(result, "Expected SDL_SetAudioStreamFormat to accept the same input format");
+
+  /* start over with an empty stream, so the postmix sees the sequence from the beginning. */
+  SDL_ClearAudioStream(data.stream);
+  queued = SDL_GetAudioStreamQueued(data.stream);
+  SDLTest_AssertCheck(queued == 0, "Expected SDL_ClearAudioStream to empty the ring, got %d bytes", queued);
+
+  thread = SDL_CreateThread(ringTestProducer, "ringTestProducer", &data);
+  SDLTest_AssertCheck(thread != NULL, "Validate that SDL_CreateThread succeeded");
+  SDL_ResumeAudioDevice(devid);
+
+  timeout = SDL_GetTicks() + 10000;
+  while ((SDL_GetAtomicInt(&data.verified) < RING_TEST_FRAMES) && (SDL_GetTicks() < timeout)) {
+    /* this competes with the device thread to drain the ring. */
+    (void)SDL_GetAudioStreamAvailable(data.stream);
+    SDL_Delay(10);
+  }
+
+  SDL_SetAtomicInt(&data.done, 1);
+  SDL_WaitThread(thread, NULL);
+  SDL_CloseAudioDevice(devid);
+  SDL_DestroyAudioStream(data.stream);
+
+  SDLTest_Log("Producer found the ring full %d times", SDL_GetAtomicInt(&data.full));
+  SDLTest_AssertCheck(SDL_GetAtomicInt(&data.produced) == RING_TEST_FRAMES, "Expected %d frames to be put, got %d", RING_TEST_FRAMES, SDL_GetAtomicInt(&data.produced));
+  SDLTest_AssertCheck(SDL_GetAtomicInt(&data.verified) == RING_TEST_FRAMES, "Expected %d frames to be played, got %d", RING_TEST_FRAMES, SDL_GetAtomicInt(&data.verified));
+  SDLTest_AssertCheck(SDL_GetAtomicInt(&data.errors) == 0, "Expected every frame to be played in order, got %d errors", SDL_GetAtomicInt(&data.errors));
+
+  return TEST_COMPLETED;
+}
+
+/**
+ * Check that an audio device and its bound stream collect timing statistics.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_GetAudioStreamStats
+ */
+static int SDLCALL audio_deviceStats(void *arg)
+{
+  SDL_AudioDeviceStats before;
+  SDL_AudioDeviceStats after;
+  SDL_AudioStreamStats stream_stats;
+  SDL_AudioSpec spec;
+  SDL_AudioDeviceID devid;
+  SDL_AudioStream *stream;
+  Uint64 bucketed;
+  Uint64 timeout;
+  float *data;
+  int data_len;
+  bool result;
+  int i;
+
+  result = SDL_GetAudioDeviceStats(0, &before);
+  SDLTest_AssertCheck(!result, "Expected SDL_GetAudioDeviceStats to fail with an invalid device");
+
+  devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+  SDLTest_AssertCheck(devid != 0, "Validate that SDL_OpenAudioDevice succeeded");
+  if (!devid) {
+    return TEST_ABORTED;
+  }
+
+  result = SDL_GetAudioDeviceStats(devid, NULL);
+  SDLTest_AssertCheck(!result, "Expected SDL_GetAudioDeviceStats to fail with NULL stats");
+
+  SDL_GetAudioDeviceFormat(devid, &spec, NULL);
+  spec.format = SDL_AUDIO_F32;
+  stream = SDL_CreateAudioStream(&spec, &spec);
+  SDLTest_AssertCheck(stream != NULL, "Validate that SDL_CreateAudioStream succeeded");
+  if (!stream) {
+    SDL_CloseAudioDevice(devid);
+    return TEST_ABORTED;
+  }
+
+  result = SDL_GetAudioStreamStats(stream, &stream_stats);
+  SDLTest_AssertCheck(result, "Validate that SDL_GetAudioStreamStats succeeded");
+  SDLTest_AssertCheck(stream_stats.gets == 0, "Expected a new stream to have no gets, got %d", (int)stream_stats.gets);
+  SDLTest_AssertCheck(stream_stats.min_queued_bytes == -1, "Expected a new stream's min_queued_bytes to be -1, got %d", stream_stats.min_queued_bytes);
+
+  /* a tenth of a second of audio, so the stream runs dry while we wait. */
+  data_len = (spec.freq / 10) * SDL_AUDIO_FRAMESIZE(spec);
+  data = (float *)SDL_calloc(1, data_len);
+  SDLTest_AssertCheck(data != NULL, "Validate that SDL_calloc succeeded");
+  if (!data) {
+    SDL_DestroyAudioStream(stream);
+    SDL_CloseAudioDevice(devid);
+    return TEST_ABORTED;
+  }
+  SDL_PutAudioStreamData(stream, data, data_len);
+
+  SDL_PauseAudioDevice(devid);
+  result = SDL_BindAudioStream(devid, stream);
+  SDLTest_AssertCheck(result, "Validate that SDL_BindAudioStream succeeded");
+
+  result = SDL_GetAudioDeviceStats(devid, &before);
+  SDLTest_AssertCheck(result, "Validate that SDL_GetAudioDeviceStats succeeded");
+  SDLTest_AssertCheck(before.queued_bytes == data_len, "Expected %d bytes queued in bound streams, got %d", data_len, before.queued_bytes);
+
+  SDL_ResumeAudioDevice(devid);
+  timeout = SDL_GetTicks() + 5000;
+  do {
+    SDL_Delay(10);
+    SDL_GetAudioDeviceStats(devid, &after);
+  } while (((after.iterations - before.iterations) < 20 || (after.short_stream_reads == before.short_stream_reads)) && (SDL_GetTicks() < timeout));
+  SDL_PauseAudioDevice(devid);
+  SDL_GetAudioDeviceStats(devid, &after);
+
+  SDLTest_AssertCheck(after.iterations > before.iterations, "Expected the device to have iterated");
+  SDLTest_AssertCheck(after.deadline_ns > 0, "Expected a nonzero deadline");
+  SDLTest_AssertCheck(after.max_iteration_ns >= after.last_iteration_ns, "Expected max_iteration_ns >= last_iteration_ns");
+  SDLTest_AssertCheck(after.total_iteration_ns >= after.max_iteration_ns, "Expected total_iteration_ns >= max_iteration_ns");
+  SDLTest_AssertCheck(after.missed_deadlines <= after.iterations, "Expected no more missed deadlines than iterations");
+  SDLTest_AssertCheck(after.short_stream_reads > before.short_stream_reads, "Expected the stream to run dry");
+  SDLTest_AssertCheck(after.queued_bytes == 0, "Expected the bound stream to be drained, got %d bytes", after.queued_bytes);
+  bucketed = 0;
+  for (i = 0; i < SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS; i++) {
+    bucketed += after.histogram[i];
+  }
+  SDLTest_AssertCheck(bucketed == after.iterations, "Expected every iteration to land in the histogram");
+
+  result = SDL_GetAudioStreamStats(stream, &stream_stats);
+  SDLTest_AssertCheck(result, "Validate that SDL_GetAudioStreamStats succeeded");
+  SDLTest_AssertCheck(stream_stats.gets > 0, "Expected the device to have read from the stream");
+  SDLTest_AssertCheck(stream_stats.short_gets > 0, "Expected some short reads from the stream");
+  SDLTest_AssertCheck(stream_stats.bytes == (Uint64)data_len, "Expected %d bytes read from the stream, got %d", data_len, (int)stream_stats.bytes);
+  SDLTest_AssertCheck(stream_stats.max_ns <= stream_stats.total_ns, "Expected max_ns <= total_ns");
+  SDLTest_AssertCheck(stream_stats.min_queued_bytes == 0, "Expected the stream's queue to have run empty, got %d", stream_stats.min_queued_bytes);
+
+  result = SDL_GetAudioStreamStats(NULL, &stream_stats);
+  SDLTest_AssertCheck(!result, "Expected SDL_GetAudioStreamStats to fail with a NULL stream");
+
+  SDL_DestroyAudioStream(stream);
+  SDL_CloseAudioDevice(devid);
+  SDL_free(data);
+
+  return TEST_COMPLETED;
+}
+
+typedef struct WavReaderTestFormat
+{
+  Uint16 formattag;
+  Uint16 channels;
+  Uint16 bitspersample;
+  Uint16 blockalign;
+  Uint16 samplesperblock; /* only for the ADPCM formats. */
+} WavReaderTestFormat;
+
+static const Sint16 wav_ms_coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+
+static void wavPut16(Uint8 *p, Uint16 v)
+{
+  p[0] = (Uint8)(v & 0xff);
+  p[1] = (Uint8)(v >> 8);
+}
+
+static void wavPut32(Uint8 *p, Uint32 v)
+{
+  wavPut16(p, (Uint16)(v & 0xffff));
+  wavPut16(p + 2, (Uint16)(v >> 16));
+}
+
+/* Builds a .WAV file with random data in `buf`, returning its size. */
+static size_t buildTestWAV(Uint8 *buf, const WavReaderTestFormat *fmt, Uint32 datalen)
+{
+  Uint16 extsize = 0;
+  Uint32 fmtlen;
+  Uint8 *p;
+  Uint32 i;
+  int c;
+
+  if (fmt->formattag == 0x0002) {
+    extsize = 4 + 7 * 4;
+  } else if (fmt->formattag == 0x0011) {
+    extsize = 2;
+  }
+  fmtlen = (fmt->formattag == 0x0001) ? 16 : (18 + extsize);
+
+  SDL_memcpy(buf, "RIFF", 4);
+  wavPut32(buf + 4, 4 + 8 + fmtlen + 8 + datalen + (datalen & 1));
+  SDL_memcpy(buf + 8, "WAVEfmt ", 8);
+  wavPut32(buf + 16, fmtlen);
+  p = buf + 20;
+  wavPut16(p, fmt->formattag);
+  wavPut16(p + 2, fmt->channels);
+  wavPut32(p + 4, 22050);
+  wavPut32(p + 8, 22050 * fmt->blockalign);
+  wavPut16(p + 12, fmt->blockalign);
+  wavPut16(p + 14, fmt->bitspersample);
+  if (fmt->formattag != 0x0001) {
+    wavPut16(p + 16, extsize);
+    wavPut16(p + 18, fmt->samplesperblock);
+    if (fmt->formattag == 0x0002) {
+      wavPut16(p + 20, 7);
+      for (i = 0; i < SDL_arraysize(wav_ms_coeffs); i++) {
+        wavPut16(p + 22 + i * 2, (Uint16)wav_ms_coeffs[i]);
+      }
+    }
+  }
+  p += fmtlen;
+  SDL_memcpy(p, "data", 4);
+  wavPut32(p + 4, datalen);
+  p += 8;
+
+  for (i = 0; i < datalen; i++) {
+    p[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+  }
+
+  /* MS ADPCM block headers need a valid coefficient index and a sane delta. */
+  if (fmt->formattag == 0x0002) {
+    for (i = 0; i + 7 * fmt->channels <= datalen; i += fmt->blockalign) {
+      for (c = 0; c < fmt->channels; c++) {
+        p[i + c] = (Uint8)SDLTest_RandomIntegerInRange(0, 6);
+        wavPut16(p + i + fmt->channels + c * 2, (Uint16)SDLTest_RandomIntegerInRange(16, 1024));
+      }
+    }
+  }
+
+  return (size_t)(p - buf) + datalen;
+}
+
+/**
+ * Check that SDL_WAVReader decodes exactly what SDL_LoadWAV_IO does, in pieces and after seeking.
+ *
+ * \sa SDL_OpenWAVReader_IO
+ * \sa SDL_ReadWAVReader
+ * \sa SDL_SeekWAVReader
+ * \sa SDL_SetAudioStreamWAVReader
+ */
+static int SDLCALL audio_wavReader(void *arg)
+{
+  static const WavReaderTestFormat formats[] = {
+    { 0x0001, 2, 16, 4, 0 },      /* PCM */
+    { 0x0001, 1, 8, 1, 0 },
+    { 0x0001, 2, 24, 6, 0 },
+    { 0x0003, 1, 32, 4, 0 },      /* IEEE float */
+    { 0x0006, 1, 8, 1, 0 },       /* A-law */
+    { 0x0007, 2, 8, 2, 0 },       /* mu-law */
+    { 0x0002, 1, 4, 256, 500 },   /* MS ADPCM */
+    { 0x0002, 2, 4, 512, 500 },
+    { 0x0011, 1, 4, 256, 505 },   /* IMA ADPCM */
+    { 0x0011, 2, 4, 512, 505 }
+  };
+  const Uint32 datalen = 20000; /* not a multiple of any block size, so the last block is truncated. */
+  Uint8 *wav = (Uint8 *)SDL_malloc(datalen + 1024);
+  Uint8 *decoded = NULL;
+  size_t i;
+
+  SDLTest_AssertCheck(wav != NULL, "Validate that SDL_malloc succeeded");
+  if (!wav) {
+    return TEST_ABORTED;
+  }
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    const WavReaderTestFormat *fmt = &formats[i];
+    const size_t wavlen = buildTestWAV(wav, fmt, datalen);
+    SDL_AudioSpec spec, rspec;
+    SDL_WAVReader *reader;
+    SDL_AudioStream *stream;
+    Uint8 *audio = NULL;
+    Uint32 audio_len = 0;
+    Sint64 frames = 0;
+    Sint64 frame;
+    int framesize;
+    int total;
+    int br;
+    bool result;
+
+    result = SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wavlen), true, &spec, &audio, &audio_len);
+    SDLTest_AssertCheck(result, "Validate that SDL_LoadWAV_IO succeeded with format 0x%04x, %d channels", fmt->formattag, fmt->channels);
+    reader = SDL_OpenWAVReader_IO(SDL_IOFromConstMem(wav, wavlen), true, &rspec, &frames);
+    SDLTest_AssertCheck(reader != NULL, "Validate that SDL_OpenWAVReader_IO succeeded");
+    if (!result || !reader) {
+      SDL_free(audio);
+      SDL_CloseWAVReader(reader);
+      continue;
+    }
+
+    framesize = SDL_AUDIO_FRAMESIZE(spec);
+    SDLTest_AssertCheck(SDL_memcmp(&spec, &rspec, sizeof(spec)) == 0, "Expected the reader to report the same format as SDL_LoadWAV_IO");
+    SDLTest_AssertCheck(frames * framesize == audio_len, "Expected the reader to report %d bytes of audio, got %d", (int)audio_len, (int)(frames * framesize));
+
+    /* read the whole thing in uneven pieces. */
+    decoded = (Uint8 *)SDL_realloc(decoded, audio_len + framesize * 64);
+    total = 0;
+    do {
+      br = SDL_ReadWAVReader(reader, decoded + total, framesize * SDLTest_RandomIntegerInRange(1, 64) + (framesize - 1));
+      total += SDL_max(br, 0);
+    } while (br > 0);
+    SDLTest_AssertCheck(br == 0, "Expected the reader to end without an error");
+    SDLTest_AssertCheck(total == (int)audio_len && SDL_memcmp(decoded, audio, audio_len) == 0, "Expected the reader to decode the same %d bytes as SDL_LoadWAV_IO, got %d", (int)audio_len, total);
+    SDLTest_AssertCheck(SDL_TellWAVReader(reader) == frames, "Expected the reader to be at the end");
+
+    /* seeking lands on the same data. */
+    frame = SDLTest_RandomIntegerInRange(0, (Sint32)frames - 1);
+    result = SDL_SeekWAVReader(reader, frame);
+    SDLTest_AssertCheck(result, "Validate that SDL_SeekWAVReader succeeded");
+    br = SDL_ReadWAVReader(reader, decoded, framesize * 100);
+    SDLTest_AssertCheck(br == (int)SDL_min(100, frames - frame) * framesize, "Expected %d bytes after seeking, got %d", (int)SDL_min(100, frames - frame) * framesize, br);
+    SDLTest_AssertCheck(br > 0 && SDL_memcmp(decoded, audio + frame * framesize, br) == 0, "Expected the data after seeking to frame %d to match", (int)frame);
+    result = SDL_SeekWAVReader(reader, frames + 1);
+    SDLTest_AssertCheck(!result, "Expected SDL_SeekWAVReader to refuse to seek past the end");
+
+    /* and it can feed a stream. */
+    SDL_SeekWAVReader(reader, 0);
+    stream = SDL_CreateAudioStream(NULL, &spec);
+    result = SDL_SetAudioStreamWAVReader(stream, reader);
+    SDLTest_AssertCheck(result, "Validate that SDL_SetAudioStreamWAVReader succeeded");
+    total = 0;
+    do {
+      br = SDL_GetAudioStreamData(stream, decoded + total, framesize * 333);
+      total += SDL_max(br, 0);
+    } while (br > 0);
+    SDLTest_AssertCheck(total == (int)audio_len && SDL_memcmp(decoded, audio, audio_len) == 0, "Expected the stream to play the same %d bytes as SDL_LoadWAV_IO, got %d", (int)audio_len, total);
+    SDL_DestroyAudioStream(stream);
+
+    SDL_CloseWAVReader(reader);
+    SDL_free(audio);
+  }
+
+  SDL_free(decoded);
+  SDL_free(wav);
+
+  return TEST_COMPLETED;
+}
+
+/* The nibble decoders as SDL_wave.c had them before it got its table driven decoders. */
+static Sint16 refMSNibble(Uint16 *delta, Sint32 coeff1, Sint32 coeff2, Sint32 sample1, Sint32 sample2, Uint8 nybble)
+{
+  static const Uint16 adaptive[] = { 230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230 };
+  Sint32 new_sample = (sample1 * coeff1 + sample2 * coeff2) / 256;
+  Uint32 d = *delta;
+
+  new_sample += (Sint32)d * ((Sint32)nybble - (nybble >= 0x08 ? 0x10 : 0));
+  if (new_sample < -32768) {
+    new_sample = -32768;
+  } else if (new_sample > 32767) {
+    new_sample = 32767;
+  }
+  d = (d * adaptive[nybble]) / 256;
+  if (d < 16) {
+    d = 16;
+  } else if (d > 65535) {
+    d = 65535;
+  }
+  *delta = (Uint16)d;
+  return (Sint16)new_sample;
+}
+
+static Sint16 refIMANibble(Sint8 *cindex, Sint16 lastsample, Uint8 nybble)
+{
+  static const Sint8 index_table_4b[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+  static const Uint16 step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+  };
+  Sint8 index = *cindex;
+  Uint32 step;
+  Sint32 sample, delta;
+
+  if (index > 88) {
+    index = 88;
+  } else if (index < 0) {
+    index = 0;
+  }
+  step = step_table[(size_t)index];
+  *cindex = index + index_table_4b[nybble];
+
+  delta = step >> 3;
+  if (nybble & 0x04) {
+    delta += step;
+  }
+  if (nybble & 0x02) {
+    delta += step >> 1;
+  }
+  if (nybble & 0x01) {
+    delta += step >> 2;
+  }
+  if (nybble & 0x08) {
+    delta = -delta;
+  }
+
+  sample = lastsample + delta;
+  if (sample > 32767) {
+    sample = 32767;
+  } else if (sample < -32768) {
+    sample = -32768;
+  }
+  return (Sint16)sample;
+}
+
+static Sint16 refGet16(const Uint8 *p)
+{
+  return (Sint16)(p[0] | (p[1] << 8));
+}
+
+/* Decodes the data chunk block by block, one nibble at a time. A truncated
+   last block is decoded as far as complete frames go, and only kept with
+   dropframe. Returns the number of decoded frames. */
+static Uint32 refDecodeADPCM(const WavReaderTestFormat *fmt, const Uint8 *data, Uint32 datalen, Sint16 *out, bool dropframe)
+{
+  const bool ms = (fmt->formattag == 0x0002);
+  const Uint32 channels = fmt->channels;
+  const Uint32 headersize = channels * (ms ? 7 : 4);
+  const Uint32 spb = fmt->samplesperblock;
+  Uint32 frames = 0;
+  Uint32 pos;
+
+  for (pos = 0; pos + headersize <= datalen; pos += fmt->blockalign) {
+    const Uint8 *block = data + pos;
+    const Uint32 blocklen = SDL_min(fmt->blockalign, datalen - pos);
+    Sint16 *o = out + frames * channels;
+    Uint16 delta[2];
+    Sint8 index[16];
+    Uint32 f, c;
+
+    if (ms) {
+      for (c = 0; c < channels; c++) {
+        delta[c] = (Uint16)refGet16(block + channels + c * 2);
+        o[channels + c] = refGet16(block + channels * 3 + c * 2);
+        o[c] = refGet16(block + channels * 5 + c * 2);
+      }
+      for (f = 2; f < spb; f++) {
+        if (headersize + ((f - 2) * channels + channels - 1) / 2 >= blocklen) {
+          break;
+        }
+        for (c = 0; c < channels; c++) {
+          const Uint32 n = (f - 2) * channels + c;
+          const Uint8 byte = block[headersize + n / 2];
+          o[f * channels + c] = refMSNibble(&delta[c], wav_ms_coeffs[block[c] * 2], wav_ms_coeffs[block[c] * 2 + 1],
+                                            o[(f - 1) * channels + c], o[(f - 2) * channels + c], (n & 1) ? (byte & 0x0f) : (byte >> 4));
+        }
+      }
+    } else {
+      for (c = 0; c < channels; c++) {
+        o[c] = refGet16(block + c * 4);
+        index[c] = (Sint8)block[c * 4 + 2];
+      }
+      /* Every channel has its nibbles in 32-bit words, also in a final group of less than 8 samples. */
+      for (f = 1; f < spb; f++) {
+        const Uint32 group = (f - 1) / 8, i = (f - 1) % 8;
+        if (headersize + (group * channels + channels - 1) * 4 + i / 2 >= blocklen) {
+          break;
+        }
+        for (c = 0; c < channels; c++) {
+          const Uint8 byte = block[headersize + (group * channels + c) * 4 + i / 2];
+          o[f * channels + c] = refIMANibble(&index[c], o[(f - 1) * channels + c], (i & 1) ? (byte >> 4) : (byte & 0x0f));
+        }
+      }
+    }
+
+    if (f < spb || blocklen < fmt->blockalign) {
+      if (dropframe) {
+        frames += f;
+      }
+      break;
+    }
+    frames += spb;
+  }
+  return frames;
+}
+
+/**
+ * Check that the ADPCM decoders produce exactly what a one nibble at a time reference decoder does,
+ * on one thread and on several.
+ *
+ * \sa SDL_LoadWAV_IO
+ */
+static int SDLCALL audio_adpcmDecode(void *arg)
+{
+  static const WavReaderTestFormat formats[] = {
+    { 0x0002, 1, 4, 256, 500 },   /* MS ADPCM */
+    { 0x0002, 2, 4, 512, 500 },
+    { 0x0011, 1, 4, 256, 505 },   /* IMA ADPCM */
+    { 0x0011, 2, 4, 512, 505 },
+    { 0x0011, 3, 4, 516, 337 },
+    { 0x0011, 2, 4, 512, 500 },   /* blocks end with a group of less than 8 samples. */
+    { 0x0011, 3, 4, 516, 334 }
+  };
+  static const char *threads[] = { "1", "4" };
+  static const char *truncations[] = { "dropblock", "dropframe" };
+  const Uint32 numblocks = 1100; /* enough for 4 threads. */
+  size_t i, j, k;
+
+  for (i = 0; i < SDL_arraysize(formats); i++) {
+    const WavReaderTestFormat *fmt = &formats[i];
+    const Uint32 headersize = fmt->channels * (fmt->formattag == 0x0002 ? 7 : 4);
+    /* The last block is cut off in the middle of its data. */
+    const Uint32 datalen = numblocks * fmt->blockalign + headersize + 37;
+    Uint8 *wav = (Uint8 *)SDL_malloc(datalen + 1024);
+    Sint16 *expected = (Sint16 *)SDL_malloc((numblocks + 1) * fmt->samplesperblock * fmt->channels * sizeof(Sint16));
+    size_t wavlen;
+
+    SDLTest_AssertCheck(wav && expected, "Validate that SDL_malloc succeeded");
+    if (!wav || !expected) {
+      SDL_free(wav);
+      SDL_free(expected);
+      return TEST_ABORTED;
+    }
+    wavlen = buildTestWAV(wav, fmt, datalen);
+
+    for (j = 0; j < SDL_arraysize(truncations); j++) {
+      const Uint32 frames = refDecodeADPCM(fmt, wav + wavlen - datalen, datalen, expected, j == 1);
+
+      SDL_SetHint(SDL_HINT_WAVE_TRUNCATION, truncations[j]);
+      for (k = 0; k < SDL_arraysize(threads); k++) {
+        SDL_AudioSpec spec;
+        Uint8 *audio = NULL;
+        Uint32 audio_len = 0;
+        bool result;
+
+        SDL_SetHint(SDL_HINT_WAVE_DECODE_THREADS, threads[k]);
+        result = SDL_LoadWAV_IO(SDL_IOFromConstMem(wav, wavlen), true, &spec, &audio, &audio_len);
+        SDLTest_AssertCheck(result, "Validate that SDL_LoadWAV_IO succeeded with format 0x%04x, %d channels, %s, %s thread(s)",
+                            fmt->formattag, fmt->channels, truncations[j], threads[k]);
+        if (result) {
+          SDLTest_AssertCheck(audio_len == frames * fmt->channels * sizeof(Sint16), "Expected %d bytes, got %d", (int)(frames * fmt->channels * sizeof(Sint16)), (int)audio_len);
+          SDLTest_AssertCheck(audio_len <= frames * fmt->channels * sizeof(Sint16) && SDL_memcmp(audio, expected, audio_len) == 0,
+                              "Expected the decoded samples to match the reference decoder");
+        }
+        SDL_free(audio);
+      }
+    }
+
+    SDL_free(wav);
+    SDL_free(expected);
+  }
+
+  SDL_ResetHint(SDL_HINT_WAVE_DECODE_THREADS);
+  SDL_ResetHint(SDL_HINT_WAVE_TRUNCATION);
+  return TEST_COMPLETED;
+}
+
+/**
+ * Check that a playback stream which needs no processing is handed to the
+ * device without being copied, and that the device still plays it exactly.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+static int SDLCALL audio_zeroCopy(void *arg)
+{
+  const char *tmpdir;
+  char *filename = NULL;
+  SDL_AudioDeviceStats stats;
+  SDL_AudioSpec spec;
+  SDL_AudioDeviceID devid;
+  SDL_AudioStream *stream;
+  Uint64 zero_copy_bytes;
+  Uint64 timeout;
+  Uint8 *data;
+  Uint8 *file;
+  size_t file_len;
+  size_t start;
+  int data_len;
+  bool result;
+  int inits;
+  int i;
+
+  /* the disk driver lets us check what was actually played, in a file that's out of the way. */
+  tmpdir = SDL_getenv("TMPDIR");
+  if (!tmpdir) {
+    tmpdir = SDL_getenv("TEMP");
+  }
+  if (tmpdir) {
+    SDL_asprintf(&filename, "%s/sdlaudio_zerocopy.raw", tmpdir);
+  } else {
+    filename = SDL_strdup("sdlaudio_zerocopy.raw");
+  }
+  SDLTest_AssertCheck(filename != NULL, "Validate that the output file name was allocated");
+  if (!filename) {
+    return TEST_ABORTED;
+  }
+
+  /* the harness holds a reference to audio, too. */
+  for (inits = 0; SDL_WasInit(SDL_INIT_AUDIO); inits++) {
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+  }
+  SDLTest_AssertPass("Call to SDL_QuitSubSystem(SDL_INIT_AUDIO) %d time(s)", inits);
+  SDL_SetHintWithPriority(SDL_HINT_AUDIO_DRIVER, "disk", SDL_HINT_OVERRIDE);
+  SDL_SetHintWithPriority(SDL_HINT_AUDIO_DISK_OUTPUT_FILE, filename, SDL_HINT_OVERRIDE);
+  SDL_SetHintWithPriority(SDL_HINT_AUDIO_DISK_TIMESCALE, "0", SDL_HINT_OVERRIDE);
+  result = SDL_InitSubSystem(SDL_INIT_AUDIO);
+  SDLTest_AssertPass("Call to SDL_InitSubSystem(SDL_INIT_AUDIO) with driver='disk'");
+  if (!result || SDL_strcmp(SDL_GetCurrentAudioDriver(), "disk") != 0) {
+    SDLTest_Log("Disk audio driver not available, skipping test");
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_ResetHint(SDL_HINT_AUDIO_DRIVER);
+    SDL_ResetHint(SDL_HINT_AUDIO_DISK_OUTPUT_FILE);
+    SDL_ResetHint(SDL_HINT_AUDIO_DISK_TIMESCALE);
+    for (i = 0; i < inits; i++) {
+      audioSetUp(NULL);
+    }
+    SDL_free(filename);
+    return TEST_SKIPPED;
+  }
+
+  devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, NULL);
+  SDLTest_AssertCheck(devid != 0, "Validate that SDL_OpenAudioDevice succeeded");
+  SDL_GetAudioDeviceFormat(devid, &spec, NULL);
+
+  /* a tenth of a second of audio with no zero bytes, so we can find its start in the output. */
+  data_len = (spec.freq / 10) * SDL_AUDIO_FRAMESIZE(spec);
+  data = (Uint8 *)SDL_malloc(data_len);
+  SDLTest_AssertCheck(data != NULL, "Validate that SDL_malloc succeeded");
+  for (i = 0; data && i < data_len; i++) {
+    data[i] = (Uint8)(SDLTest_RandomIntegerInRange(1, 255));
+  }
+
+  stream = SDL_CreateAudioStream(&spec, &spec);
+  SDLTest_AssertCheck(stream != NULL, "Validate that SDL_CreateAudioStream succeeded");
+  if (devid && data && stream) {
+    result = SDL_PutAudioStreamDataNoCopy(stream, data, data_len, NULL, NULL);
+    SDLTest_AssertCheck(result, "Validate that SDL_PutAudioStreamDataNoCopy succeeded");
+    SDL_FlushAudioStream(stream);
+    result = SDL_BindAudioStream(devid, stream);
+    SDLTest_AssertCheck(result, "Validate that SDL_BindAudioStream succeeded");
+
+    timeout = SDL_GetTicks() + 5000;
+    while (SDL_GetAudioStreamQueued(stream) > 0 && SDL_GetTicks() < timeout) {
+      SDL_Delay(1);
+    }
+    SDL_PauseAudioDevice(devid);
+    SDL_UnbindAudioStream(stream);
+
+    SDL_GetAudioDeviceStats(devid, &stats);
+    SDLTest_AssertCheck(SDL_GetAudioStreamQueued(stream) == 0, "Expected the stream to be drained");
+    SDLTest_AssertCheck(stats.zero_copy_bytes > 0, "Expected some of the stream to be played without a copy");
+    SDLTest_AssertCheck(stats.zero_copy_bytes <= (Uint64)data_len, "Expected no more than %d bytes played without a copy, got %d", data_len, (int)stats.zero_copy_bytes);
+    SDLTest_AssertCheck(stats.zero_copy_bytes <= stats.played_bytes, "Expected zero_copy_bytes <= played_bytes");
+
+    /* a stream with gain has to be processed, so it can't be played in place. */
+    zero_copy_bytes = stats.zero_copy_bytes;
+    SDL_SetAudioStreamGain(stream, 0.5f);
+    SDL_PutAudioStreamData(stream, data, data_len);
+    SDL_FlushAudioStream(stream);
+    SDL_BindAudioStream(devid, stream);
+    SDL_ResumeAudioDevice(devid);
+    timeout = SDL_GetTicks() + 5000;
+    while (SDL_GetAudioStreamQueued(stream) > 0 && SDL_GetTicks() < timeout) {
+      SDL_Delay(1);
+    }
+    SDL_PauseAudioDevice(devid);
+    SDL_GetAudioDeviceStats(devid, &stats);
+    SDLTest_AssertCheck(stats.zero_copy_bytes == zero_copy_bytes, "Expected a stream with gain to be copied, got %d more bytes played without a copy", (int)(stats.zero_copy_bytes - zero_copy_bytes));
+  }
+
+  SDL_DestroyAudioStream(stream);
+  SDL_CloseAudioDevice(devid);
+
+  /* the device plays silence around our data; it has to be in the file untouched. */
+  file = (Uint8 *)SDL_LoadFile(filename, &file_len);
+  SDLTest_AssertCheck(file != NULL, "Validate that SDL_LoadFile('%s') succeeded", filename);
+  if (file && data) {
+    for (start = 0; start < file_len && file[start] == 0; start++) {
+    }
+    SDLTest_AssertCheck(file_len - start >= (size_t)data_len && SDL_memcmp(file + start, data, data_len) == 0,
+                        "Expected the played data to match what was queued");
+  }
+  SDL_free(file);
+  SDL_free(data);
+
+  SDL_QuitSubSystem(SDL_INIT_AUDIO);
+  SDL_ResetHint(SDL_HINT_AUDIO_DRIVER);
+  SDL_ResetHint(SDL_HINT_AUDIO_DISK_OUTPUT_FILE);
+  SDL_ResetHint(SDL_HINT_AUDIO_DISK_TIMESCALE);
+  for (i = 0; i < inits; i++) {
+    audioSetUp(NULL);
+  }
+  SDL_RemovePath(filename);
+  SDL_free(filename);
+  return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1541,13 +2876,49 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_mixAudio, "audio_mixAudio", "Check SDL_MixAudio against a reference mixer, and benchmark it.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_resampleQuality, "audio_resampleQuality", "Check each resampling quality of audio streams.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_fusedMix, "audio_fusedMix", "Check single pass mixing of bound streams against the general path.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_lockFreeRing, "audio_lockFreeRing", "Stress an audio stream's lock-free ring with a producer thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest23 = {
+    audio_deviceStats, "audio_deviceStats", "Check audio device and stream timing statistics.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest24 = {
+    audio_wavReader, "audio_wavReader", "Compare streaming WAV decoding against SDL_LoadWAV_IO.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest25 = {
+    audio_adpcmDecode, "audio_adpcmDecode", "Check the ADPCM decoders against a reference, on one and several threads.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest26 = {
+    audio_zeroCopy, "audio_zeroCopy", "Check that streams needing no processing are played without a copy.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest27 = {
+    audio_resamplePhases, "audio_resamplePhases", "Check that resampling with filter phases matches plain sinc resampling.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTestGetAudioFormatName,
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22, &audioTest23, &audioTest24, &audioTest25, &audioTest26, &audioTest27, NULL
 };
 
 /* Audio test suite (global) */
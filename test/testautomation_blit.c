@@ -190,6 +190,113 @@ static int SDLCALL blit_testRandomToRandomSVGAMultipleIterations(void *arg) {
     SDL_free(buf);
     return TEST_COMPLETED;
 }
+/*
+ * Fills a 16-bit surface with PRNG pixel data
+ */
+static void fillRandom16Surface(SDL_Surface *surface) {
+    int x, y;
+    for (y = 0; y < surface->h; y++) {
+        Uint16 *row = (Uint16 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; x++) {
+            row[x] = (Uint16)getRandomUint32();
+        }
+    }
+}
+/**
+ * Tests blending ARGB4444 and ARGB1555 sprites into 16-bit surfaces, with and without a color key. The results must
+ * match blending the same sprite in an alpha-last format, which goes through the general per-pixel alpha blitter.
+ * The odd sizes and offsets cover the leftover pixels of each row.
+ */
+static int SDLCALL blit_testPixelAlpha16(void *arg) {
+    static const struct {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat reference_format;
+        SDL_PixelFormat dst_format;
+    } cases[] = {
+        { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_ABGR4444, SDL_PIXELFORMAT_BGRA4444, SDL_PIXELFORMAT_BGR565 },
+        { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_ARGB4444 },
+        { SDL_PIXELFORMAT_ABGR4444, SDL_PIXELFORMAT_BGRA4444, SDL_PIXELFORMAT_ABGR4444 },
+        { SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_ABGR1555, SDL_PIXELFORMAT_BGRA5551, SDL_PIXELFORMAT_BGR565 },
+        { SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_ARGB1555 },
+    };
+    const int width = 61;
+    const int height = 17;
+    SDL_Rect src_rect = { 3, 1, width - 5, height - 2 };
+    SDL_Rect dst_rect = { 5, 2, 0, 0 };
+    int i, x, y;
+
+    for (i = 0; i < SDL_arraysize(cases); i++) {
+        const char *name = SDL_GetPixelFormatName(cases[i].src_format);
+        const char *dst_name = SDL_GetPixelFormatName(cases[i].dst_format);
+        SDL_Surface *src = SDL_CreateSurface(width, height, cases[i].src_format);
+        SDL_Surface *reference_src = NULL;
+        SDL_Surface *keyed_src = NULL;
+        SDL_Surface *dst = SDL_CreateSurface(width, height, cases[i].dst_format);
+        SDL_Surface *expected = SDL_CreateSurface(width, height, cases[i].dst_format);
+        const SDL_PixelFormatDetails *details;
+        Uint32 key;
+
+        SDLTest_AssertCheck(src && dst && expected, "Create %s and %s surfaces", name, dst_name);
+        if (!src || !dst || !expected) {
+            goto next;
+        }
+        details = SDL_GetPixelFormatDetails(cases[i].src_format);
+        fillRandom16Surface(src);
+        fillRandom16Surface(dst);
+        SDL_memcpy(expected->pixels, dst->pixels, (size_t)dst->pitch * height);
+
+        reference_src = SDL_ConvertSurface(src, cases[i].reference_format);
+        SDLTest_AssertCheck(reference_src != NULL, "Convert %s sprite to %s", name, SDL_GetPixelFormatName(cases[i].reference_format));
+        if (!reference_src) {
+            goto next;
+        }
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceBlendMode(reference_src, SDL_BLENDMODE_BLEND);
+        SDL_BlitSurface(src, &src_rect, dst, &dst_rect);
+        SDL_BlitSurface(reference_src, &src_rect, expected, &dst_rect);
+        SDLTest_AssertCheck(SDL_memcmp(dst->pixels, expected->pixels, (size_t)dst->pitch * height) == 0,
+                            "Blend %s into %s like the general blitter", name, dst_name);
+
+        /* A color keyed sprite must match the same sprite with the keyed pixels made transparent */
+        key = ((const Uint16 *)src->pixels)[0] & ~details->Amask;
+        for (y = 0; y < height; y++) {
+            Uint16 *row = (Uint16 *)((Uint8 *)src->pixels + y * src->pitch);
+            for (x = y % 3; x < width; x += 3) {
+                row[x] = (Uint16)((row[x] & details->Amask) | key);
+            }
+        }
+        keyed_src = SDL_DuplicateSurface(src);
+        SDLTest_AssertCheck(keyed_src != NULL, "Duplicate %s sprite", name);
+        if (!keyed_src) {
+            goto next;
+        }
+        for (y = 0; y < height; y++) {
+            Uint16 *row = (Uint16 *)((Uint8 *)src->pixels + y * src->pitch);
+            for (x = 0; x < width; x++) {
+                if ((row[x] & ~details->Amask) == key) {
+                    row[x] = (Uint16)key;
+                }
+            }
+        }
+        SDL_SetSurfaceColorKey(keyed_src, true, key | details->Amask);
+        SDL_SetSurfaceBlendMode(keyed_src, SDL_BLENDMODE_BLEND);
+        SDL_memcpy(expected->pixels, dst->pixels, (size_t)dst->pitch * height);
+        SDL_BlitSurface(keyed_src, &src_rect, dst, &dst_rect);
+        SDL_BlitSurface(src, &src_rect, expected, &dst_rect);
+        SDLTest_AssertCheck(SDL_memcmp(dst->pixels, expected->pixels, (size_t)dst->pitch * height) == 0,
+                            "Blend color keyed %s into %s", name, dst_name);
+
+next:
+        SDL_DestroySurface(keyed_src);
+        SDL_DestroySurface(reference_src);
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+        SDL_DestroySurface(expected);
+    }
+    return TEST_COMPLETED;
+}
 
 static const SDLTest_TestCaseReference blitTest1 = {
         blit_testExampleApplicationRender, "blit_testExampleApplicationRender",
@@ -203,8 +310,12 @@ static const SDLTest_TestCaseReference blitTest3 = {
         blit_testRandomToRandomSVGAMultipleIterations, "blit_testRandomToRandomSVGAMultipleIterations",
         "Test SVGA noise render (250k iterations).", TEST_ENABLED
 };
+static const SDLTest_TestCaseReference blitTest4 = {
+        blit_testPixelAlpha16, "blit_testPixelAlpha16",
+        "Test 16-bit sprites with pixel alpha blended into 16-bit surfaces.", TEST_ENABLED
+};
 static const SDLTest_TestCaseReference *blitTests[] = {
-        &blitTest1, &blitTest2, &blitTest3, NULL
+        &blitTest1, &blitTest2, &blitTest3, &blitTest4, NULL
 };
 
 SDLTest_TestSuiteReference blitTestSuite = {
@@ -1984,6 +1984,1020 @@ static int SDLCALL render_testTextureState(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Draws a random scene with a bit of everything, the same way for any seed.
+ */
+static void drawThreadedScene(SDL_Renderer *target, SDL_Texture *face, SDL_Texture *opaque, Uint64 seed)
+{
+    static const SDL_BlendMode blend_modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    int w, h, i, j;
+
+    SDL_GetRenderOutputSize(target, &w, &h);
+
+    SDL_SetRenderDrawColor(target, 40, 60, 80, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(target);
+
+    for (i = 0; i < 200; i++) {
+        const int op = SDL_rand_r(&seed, 10);
+        const SDL_BlendMode blend = blend_modes[SDL_rand_r(&seed, SDL_arraysize(blend_modes))];
+        SDL_Texture *texture = SDL_rand_r(&seed, 2) ? face : opaque;
+        SDL_FRect rect;
+        SDL_FRect src;
+
+        rect.x = (float)(SDL_rand_r(&seed, w + 40) - 20);
+        rect.y = (float)(SDL_rand_r(&seed, h + 40) - 20);
+        rect.w = (float)(1 + SDL_rand_r(&seed, 60));
+        rect.h = (float)(1 + SDL_rand_r(&seed, 60));
+
+        SDL_SetRenderDrawColor(target, (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256));
+        SDL_SetRenderDrawBlendMode(target, blend);
+        SDL_SetTextureBlendMode(texture, blend);
+        SDL_SetTextureColorMod(texture, (Uint8)SDL_rand_r(&seed, 256), (Uint8)SDL_rand_r(&seed, 256), 255);
+        SDL_SetTextureAlphaMod(texture, (Uint8)(128 + SDL_rand_r(&seed, 128)));
+
+        switch (op) {
+        case 0:
+        {
+            SDL_Rect clip;
+            clip.x = SDL_rand_r(&seed, w);
+            clip.y = SDL_rand_r(&seed, h);
+            clip.w = 1 + SDL_rand_r(&seed, w);
+            clip.h = 1 + SDL_rand_r(&seed, h);
+            SDL_SetRenderClipRect(target, SDL_rand_r(&seed, 3) ? &clip : NULL);
+            break;
+        }
+        case 1:
+        {
+            SDL_Rect viewport;
+            viewport.x = SDL_rand_r(&seed, w / 2) - w / 8;
+            viewport.y = SDL_rand_r(&seed, h / 2) - h / 8;
+            viewport.w = w / 2 + SDL_rand_r(&seed, w / 2);
+            viewport.h = h / 2 + SDL_rand_r(&seed, h / 2);
+            SDL_SetRenderViewport(target, SDL_rand_r(&seed, 3) ? &viewport : NULL);
+            break;
+        }
+        case 2:
+        {
+            SDL_FRect rects[4];
+            for (j = 0; j < SDL_arraysize(rects); j++) {
+                rects[j] = rect;
+                rects[j].x += (float)(j * 7);
+                rects[j].y += (float)(j * 13);
+            }
+            SDL_RenderFillRects(target, rects, SDL_arraysize(rects));
+            break;
+        }
+        case 3:
+        {
+            SDL_FPoint points[16];
+            for (j = 0; j < SDL_arraysize(points); j++) {
+                points[j].x = rect.x + (float)SDL_rand_r(&seed, 60);
+                points[j].y = rect.y + (float)SDL_rand_r(&seed, 60);
+            }
+            SDL_RenderPoints(target, points, SDL_arraysize(points));
+            break;
+        }
+        case 4:
+            SDL_RenderLine(target, rect.x, rect.y, rect.x + rect.w * 3.0f, rect.y + rect.h * 2.0f);
+            break;
+        case 5:
+        case 6:
+            src.x = (float)SDL_rand_r(&seed, texture->w / 2);
+            src.y = (float)SDL_rand_r(&seed, texture->h / 2);
+            src.w = (float)texture->w - src.x;
+            src.h = (float)texture->h - src.y;
+            rect.w = src.w;
+            rect.h = src.h;
+            SDL_RenderTexture(target, texture, &src, &rect);
+            break;
+        case 7:
+            if (SDL_rand_r(&seed, 2)) {
+                SDL_RenderTexture(target, texture, NULL, &rect);
+            } else {
+                SDL_RenderTextureRotated(target, texture, NULL, &rect, (double)SDL_rand_r(&seed, 360), NULL, SDL_FLIP_HORIZONTAL);
+            }
+            break;
+        case 8:
+        case 9:
+        {
+            SDL_Vertex verts[6];
+            for (j = 0; j < SDL_arraysize(verts); j++) {
+                verts[j].position.x = rect.x + (float)SDL_rand_r(&seed, 120) - 30.0f;
+                verts[j].position.y = rect.y + (float)SDL_rand_r(&seed, 120) - 30.0f;
+                verts[j].color.r = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].color.g = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].color.b = 1.0f;
+                verts[j].color.a = (float)SDL_rand_r(&seed, 256) / 255.0f;
+                verts[j].tex_coord.x = (float)SDL_rand_r(&seed, 300) / 100.0f - 1.0f;
+                verts[j].tex_coord.y = (float)SDL_rand_r(&seed, 300) / 100.0f - 1.0f;
+            }
+            SDL_SetRenderTextureAddressMode(target, SDL_TEXTURE_ADDRESS_WRAP, SDL_TEXTURE_ADDRESS_WRAP);
+            SDL_RenderGeometry(target, (op == 8) ? texture : NULL, verts, SDL_arraysize(verts), NULL, 0);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * Tests that drawing with several threads matches drawing on one
+ *
+ * \sa SDL_CreateSoftwareRenderer
+ */
+static int SDLCALL render_testSoftwareThreads(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24
+    };
+    static const char *threads[] = { "1", "4" };
+    int f, i, y;
+
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        SDL_Surface *targets[SDL_arraysize(threads)];
+        Uint64 seed = SDLTest_RandomUint64();
+
+        for (i = 0; i < SDL_arraysize(threads); i++) {
+            SDL_Renderer *sw;
+            SDL_Surface *face = SDLTest_ImageFace();
+            SDL_Surface *opaque;
+            SDL_Texture *face_texture = NULL;
+            SDL_Texture *opaque_texture = NULL;
+
+            targets[i] = SDL_CreateSurface(333, 211, formats[f]);
+            SDLTest_AssertCheck(targets[i] != NULL, "Verify SDL_CreateSurface() result");
+
+            SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads[i]);
+            sw = SDL_CreateSoftwareRenderer(targets[i]);
+            SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+            SDLTest_AssertCheck(sw != NULL, "Verify SDL_CreateSoftwareRenderer() with %s thread(s)", threads[i]);
+
+            opaque = face ? SDL_ConvertSurface(face, SDL_PIXELFORMAT_XRGB8888) : NULL;
+            if (sw && face && opaque) {
+                face_texture = SDL_CreateTextureFromSurface(sw, face);
+                opaque_texture = SDL_CreateTextureFromSurface(sw, opaque);
+            }
+            SDLTest_AssertCheck(face_texture && opaque_texture, "Verify SDL_CreateTextureFromSurface() results");
+            if (face_texture && opaque_texture) {
+                drawThreadedScene(sw, face_texture, opaque_texture, seed);
+                SDL_RenderPresent(sw);
+            }
+
+            SDL_DestroyTexture(face_texture);
+            SDL_DestroyTexture(opaque_texture);
+            SDL_DestroySurface(opaque);
+            SDL_DestroySurface(face);
+            SDL_DestroyRenderer(sw);
+        }
+
+        if (targets[0] && targets[1]) {
+            const int row_bytes = targets[0]->w * SDL_BYTESPERPIXEL(formats[f]);
+            int mismatched_rows = 0;
+            for (y = 0; y < targets[0]->h; y++) {
+                if (SDL_memcmp((Uint8 *)targets[0]->pixels + y * targets[0]->pitch, (Uint8 *)targets[1]->pixels + y * targets[1]->pitch, row_bytes) != 0) {
+                    mismatched_rows++;
+                }
+            }
+            SDLTest_AssertCheck(mismatched_rows == 0, "Verify %s output with several threads matches one thread, %d row(s) differ", SDL_GetPixelFormatName(formats[f]), mismatched_rows);
+        }
+
+        for (i = 0; i < SDL_arraysize(threads); i++) {
+            SDL_DestroySurface(targets[i]);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that blended rectangles and horizontal lines, which are filled several pixels at a time,
+ * match the same pixels blended one point at a time.
+ *
+ * \sa SDL_RenderFillRect
+ * \sa SDL_RenderLine
+ * \sa SDL_RenderPoints
+ */
+static int SDLCALL render_testBlendedSpans(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB1555, SDL_PIXELFORMAT_ABGR8888
+    };
+    static const SDL_BlendMode blend_modes[] = {
+        SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED, SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_ADD_PREMULTIPLIED, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    const SDL_FRect rect = { 3.0f, 2.0f, 37.0f, 5.0f };
+    const int line_y = 10;
+    SDL_FPoint points[37 * 6];
+    int f, m, i, x, y;
+
+    for (y = 0; y < 5; y++) {
+        for (x = 0; x < 37; x++) {
+            points[y * 37 + x].x = rect.x + x + 0.5f;
+            points[y * 37 + x].y = rect.y + y + 0.5f;
+        }
+    }
+    for (x = 0; x < 37; x++) {
+        points[5 * 37 + x].x = rect.x + x + 0.5f;
+        points[5 * 37 + x].y = line_y + 0.5f;
+    }
+
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        for (m = 0; m < SDL_arraysize(blend_modes); m++) {
+            SDL_Surface *targets[2];
+            Uint64 seed = SDLTest_RandomUint64();
+            const Uint8 r = (Uint8)SDL_rand_r(&seed, 256), g = (Uint8)SDL_rand_r(&seed, 256);
+            const Uint8 b = (Uint8)SDL_rand_r(&seed, 256), a = (Uint8)SDL_rand_r(&seed, 256);
+
+            for (i = 0; i < SDL_arraysize(targets); i++) {
+                SDL_Renderer *sw;
+                Uint64 fill_seed = seed;
+
+                targets[i] = SDL_CreateSurface(48, 16, formats[f]);
+                SDLTest_AssertCheck(targets[i] != NULL, "Verify SDL_CreateSurface() result");
+                if (!targets[i]) {
+                    continue;
+                }
+                for (y = 0; y < targets[i]->h; y++) {
+                    Uint8 *row = (Uint8 *)targets[i]->pixels + y * targets[i]->pitch;
+                    for (x = 0; x < targets[i]->pitch; x++) {
+                        row[x] = (Uint8)SDL_rand_r(&fill_seed, 256);
+                    }
+                }
+
+                sw = SDL_CreateSoftwareRenderer(targets[i]);
+                SDLTest_AssertCheck(sw != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+                if (!sw) {
+                    continue;
+                }
+                CHECK_FUNC(SDL_SetRenderDrawBlendMode, (sw, blend_modes[m]));
+                CHECK_FUNC(SDL_SetRenderDrawColor, (sw, r, g, b, a));
+                if (i == 0) {
+                    CHECK_FUNC(SDL_RenderPoints, (sw, points, SDL_arraysize(points)));
+                } else {
+                    CHECK_FUNC(SDL_RenderFillRect, (sw, &rect));
+                    CHECK_FUNC(SDL_RenderLine, (sw, rect.x, (float)line_y, rect.x + rect.w - 1.0f, (float)line_y));
+                }
+                CHECK_FUNC(SDL_RenderPresent, (sw));
+                SDL_DestroyRenderer(sw);
+            }
+
+            if (targets[0] && targets[1]) {
+                const int row_bytes = targets[0]->w * SDL_BYTESPERPIXEL(formats[f]);
+                int mismatched_rows = 0;
+                for (y = 0; y < targets[0]->h; y++) {
+                    if (SDL_memcmp((Uint8 *)targets[0]->pixels + y * targets[0]->pitch, (Uint8 *)targets[1]->pixels + y * targets[1]->pitch, row_bytes) != 0) {
+                        mismatched_rows++;
+                    }
+                }
+                SDLTest_AssertCheck(mismatched_rows == 0, "Verify %s spans with blend mode 0x%x match points, %d row(s) differ",
+                                    SDL_GetPixelFormatName(formats[f]), (unsigned int)blend_modes[m], mismatched_rows);
+            }
+
+            for (i = 0; i < SDL_arraysize(targets); i++) {
+                SDL_DestroySurface(targets[i]);
+            }
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that drawing on a render thread matches drawing on the application thread,
+ * including textures that are changed while the render thread may still be using them.
+ *
+ * \sa SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN
+ */
+static int SDLCALL render_testRenderThread(void *arg)
+{
+    const int num_frames = 8;
+    SDL_Surface *targets[2];
+    SDL_Surface *readback[2];
+    Uint64 seed = SDLTest_RandomUint64();
+    int i, frame, y;
+
+    for (i = 0; i < SDL_arraysize(targets); i++) {
+        const bool threaded = (i == 1);
+        SDL_PropertiesID props = SDL_CreateProperties();
+        SDL_Renderer *sw;
+        SDL_Surface *face = SDLTest_ImageFace();
+        SDL_Texture *face_texture = NULL;
+        SDL_Texture *opaque_texture = NULL;
+        Uint32 pixels[16 * 16];
+
+        readback[i] = NULL;
+        targets[i] = SDL_CreateSurface(333, 211, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(targets[i] != NULL, "Verify SDL_CreateSurface() result");
+
+        SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_SURFACE_POINTER, targets[i]);
+        SDL_SetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN, threaded);
+        sw = SDL_CreateRendererWithProperties(props);
+        SDL_DestroyProperties(props);
+        SDLTest_AssertCheck(sw != NULL, "Verify SDL_CreateRendererWithProperties() with threaded %s", threaded ? "on" : "off");
+        if (sw) {
+            const bool result = SDL_GetBooleanProperty(SDL_GetRendererProperties(sw), SDL_PROP_RENDERER_THREADED_BOOLEAN, !threaded);
+            SDLTest_AssertCheck(result == threaded, "Verify SDL_PROP_RENDERER_THREADED_BOOLEAN, expected %s, got %s", threaded ? "true" : "false", result ? "true" : "false");
+
+            if (face) {
+                face_texture = SDL_CreateTextureFromSurface(sw, face);
+            }
+            opaque_texture = SDL_CreateTexture(sw, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STREAMING, 16, 16);
+        }
+        SDLTest_AssertCheck(face_texture && opaque_texture, "Verify texture creation results");
+        if (face_texture && opaque_texture) {
+            for (frame = 0; frame < num_frames; frame++) {
+                /* Change the texture the last frame drew with, which has to wait for the render thread */
+                for (y = 0; y < SDL_arraysize(pixels); y++) {
+                    pixels[y] = (Uint32)(y * 0x010203 + frame * 0x201000);
+                }
+                CHECK_FUNC(SDL_UpdateTexture, (opaque_texture, NULL, pixels, 16 * sizeof(Uint32)));
+                drawThreadedScene(sw, face_texture, opaque_texture, seed + frame);
+                CHECK_FUNC(SDL_RenderPresent, (sw));
+            }
+            drawThreadedScene(sw, face_texture, opaque_texture, seed);
+            CHECK_FUNC(SDL_SetRenderViewport, (sw, NULL));
+            readback[i] = SDL_RenderReadPixels(sw, NULL);
+            SDLTest_AssertCheck(readback[i] != NULL, "Verify SDL_RenderReadPixels() result");
+        }
+
+        SDL_DestroyTexture(face_texture);
+        SDL_DestroyTexture(opaque_texture);
+        SDL_DestroySurface(face);
+        SDL_DestroyRenderer(sw);
+    }
+
+    if (readback[0] && readback[1]) {
+        SDLTest_AssertCheck(SDLTest_CompareSurfaces(readback[1], readback[0], 0) == 0, "Verify pixels read back with a render thread match");
+    }
+    if (targets[0] && targets[1]) {
+        SDLTest_AssertCheck(SDLTest_CompareSurfaces(targets[1], targets[0], 0) == 0, "Verify drawing with a render thread matches");
+    }
+
+    for (i = 0; i < SDL_arraysize(targets); i++) {
+        SDL_DestroySurface(readback[i]);
+        SDL_DestroySurface(targets[i]);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that the command queue gives back memory after a busy frame.
+ *
+ * \sa SDL_GetRendererProperties
+ */
+static int SDLCALL render_testQueueMemory(void *arg)
+{
+    const int num_points = 20000;
+    const int num_rects = 2000;
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_FPoint *points;
+    SDL_FRect rect;
+    Sint64 vertex_bytes, queued_commands, busy_memory, memory;
+    int i;
+
+    points = (SDL_FPoint *)SDL_malloc(num_points * sizeof(*points));
+    SDLTest_AssertCheck(points != NULL, "Verify the points were allocated");
+    if (!points) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < num_points; i++) {
+        points[i].x = (float)(i % TESTRENDER_SCREEN_W);
+        points[i].y = (float)(i / TESTRENDER_SCREEN_W);
+    }
+
+    /* A busy frame */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderClear, (renderer));
+    CHECK_FUNC(SDL_RenderPoints, (renderer, points, num_points));
+    for (i = 0; i < num_rects; i++) {
+        rect.x = (float)(i % TESTRENDER_SCREEN_W);
+        rect.y = (float)(i % TESTRENDER_SCREEN_H);
+        rect.w = 4.0f;
+        rect.h = 4.0f;
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, (Uint8)i, 255, 0, SDL_ALPHA_OPAQUE));
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect));
+    }
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    SDL_free(points);
+
+    vertex_bytes = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, -1);
+    queued_commands = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_QUEUED_COMMANDS_NUMBER, -1);
+    busy_memory = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_QUEUE_MEMORY_NUMBER, -1);
+    SDLTest_AssertCheck(vertex_bytes > 0, "Verify the busy frame queued vertex data, got %" SDL_PRIs64 " bytes", vertex_bytes);
+    SDLTest_AssertCheck(queued_commands > num_rects, "Verify the busy frame queued more than %d commands, got %" SDL_PRIs64, num_rects, queued_commands);
+    SDLTest_AssertCheck(busy_memory >= vertex_bytes, "Verify the queue memory covers the vertex data, got %" SDL_PRIs64 " bytes", busy_memory);
+
+    /* Quiet frames, until the memory is given back */
+    memory = busy_memory;
+    for (i = 0; i < 1000 && memory == busy_memory; i++) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE));
+        CHECK_FUNC(SDL_RenderClear, (renderer));
+        rect.x = 10.0f;
+        rect.y = 10.0f;
+        rect.w = 10.0f;
+        rect.h = 10.0f;
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 255, 255, SDL_ALPHA_OPAQUE));
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect));
+        CHECK_FUNC(SDL_RenderPresent, (renderer));
+        memory = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_QUEUE_MEMORY_NUMBER, -1);
+    }
+    SDLTest_AssertCheck(memory > 0 && memory < busy_memory / 4, "Verify the queue memory shrank from %" SDL_PRIs64 " bytes, got %" SDL_PRIs64 " after %d frames", busy_memory, memory, i);
+
+    queued_commands = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_QUEUED_COMMANDS_NUMBER, -1);
+    SDLTest_AssertCheck(queued_commands > 0 && queued_commands < 10, "Verify a quiet frame queued a few commands, got %" SDL_PRIs64, queued_commands);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Draws interleaved sprites, geometry and rectangles, with a later layer on top.
+ */
+static void drawBatchModeScene(SDL_Texture **textures)
+{
+    SDL_Vertex vertices[3];
+    SDL_FRect dst;
+    int i, j;
+
+    for (i = 0; i < 8; i++) {
+        dst.x = 10.0f + i * 20.0f;
+        dst.y = 10.0f;
+        dst.w = 16.0f;
+        dst.h = 16.0f;
+        CHECK_FUNC(SDL_RenderTexture, (renderer, textures[i % 2], NULL, &dst));
+    }
+
+    /* Triangles rather than quads, which the software renderer would draw as copies */
+    for (i = 0; i < 8; i++) {
+        for (j = 0; j < 3; j++) {
+            vertices[j].position.x = 10.0f + i * 20.0f + ((j == 1) ? 16.0f : 0.0f);
+            vertices[j].position.y = 40.0f + ((j == 2) ? 16.0f : 0.0f);
+            vertices[j].color.r = vertices[j].color.g = vertices[j].color.b = vertices[j].color.a = 1.0f;
+            vertices[j].tex_coord.x = (j == 1) ? 1.0f : 0.0f;
+            vertices[j].tex_coord.y = (j == 2) ? 1.0f : 0.0f;
+        }
+        CHECK_FUNC(SDL_RenderGeometry, (renderer, textures[i % 2], vertices, 3, NULL, 0));
+    }
+
+    for (i = 0; i < 4; i++) {
+        dst.x = 10.0f + i * 20.0f;
+        dst.y = 70.0f;
+        dst.w = 16.0f;
+        dst.h = 16.0f;
+        if (i % 2) {
+            CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 255, 255, SDL_ALPHA_OPAQUE));
+        } else {
+            CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 255, 0, SDL_ALPHA_OPAQUE));
+        }
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, &dst));
+    }
+
+    /* Covers the first sprite, so it has to stay on top */
+    CHECK_FUNC(SDL_StartRenderLayer, (renderer));
+    dst.x = 10.0f;
+    dst.y = 10.0f;
+    dst.w = 8.0f;
+    dst.h = 8.0f;
+    CHECK_FUNC(SDL_RenderTexture, (renderer, textures[1], NULL, &dst));
+}
+
+/**
+ * Tests that unordered batching draws the same as ordered batching, and merges draws.
+ *
+ * \sa SDL_SetRenderBatchMode
+ * \sa SDL_StartRenderLayer
+ */
+static int SDLCALL render_testBatchMode(void *arg)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_Texture *textures[2] = { NULL, NULL };
+    SDL_Surface *reference = NULL;
+    SDL_Surface *surface = NULL;
+    SDL_RenderBatchMode mode;
+    Sint64 ordered_commands, unordered_commands, merged;
+    int i, ret;
+
+    CHECK_FUNC(SDL_GetRenderBatchMode, (renderer, &mode));
+    SDLTest_AssertCheck(mode == SDL_RENDER_BATCH_ORDERED, "Verify the default batch mode is ordered, got %d", (int)mode);
+    SDLTest_AssertCheck(!SDL_SetRenderBatchMode(renderer, (SDL_RenderBatchMode)42), "Verify an invalid batch mode is rejected");
+
+    for (i = 0; i < 2; i++) {
+        SDL_Surface *sprite = SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(sprite != NULL, "Verify the sprite surface was created");
+        if (!sprite) {
+            goto done;
+        }
+        SDL_FillSurfaceRect(sprite, NULL, i ? SDL_MapSurfaceRGB(sprite, 0, 0, 255) : SDL_MapSurfaceRGB(sprite, 255, 0, 0));
+        textures[i] = SDL_CreateTextureFromSurface(renderer, sprite);
+        SDL_DestroySurface(sprite);
+        SDLTest_AssertCheck(textures[i] != NULL, "Verify the sprite texture was created");
+        if (!textures[i]) {
+            goto done;
+        }
+    }
+
+    /* Draw in queue order for the reference */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderClear, (renderer));
+    drawBatchModeScene(textures);
+    reference = SDL_RenderReadPixels(renderer, NULL);
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    ordered_commands = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, -1);
+    merged = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER, -1);
+    SDLTest_AssertCheck(merged == 0, "Verify nothing is merged in ordered mode, got %" SDL_PRIs64, merged);
+
+    CHECK_FUNC(SDL_SetRenderBatchMode, (renderer, SDL_RENDER_BATCH_UNORDERED));
+    CHECK_FUNC(SDL_GetRenderBatchMode, (renderer, &mode));
+    SDLTest_AssertCheck(mode == SDL_RENDER_BATCH_UNORDERED, "Verify the batch mode is unordered, got %d", (int)mode);
+
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderClear, (renderer));
+    drawBatchModeScene(textures);
+    surface = SDL_RenderReadPixels(renderer, NULL);
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    unordered_commands = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, -1);
+    merged = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER, -1);
+
+    SDLTest_AssertCheck(reference && surface, "Verify both frames were read back");
+    if (reference && surface) {
+        ret = SDLTest_CompareSurfaces(surface, reference, 0);
+        SDLTest_AssertCheck(ret == 0, "Validate unordered batching draws the same, expected: 0, got: %i", ret);
+    }
+    SDLTest_AssertCheck(unordered_commands > 0 && unordered_commands < ordered_commands,
+                        "Verify fewer commands were submitted, got %" SDL_PRIs64 " instead of %" SDL_PRIs64, unordered_commands, ordered_commands);
+    /* The triangles for each texture become one draw, and renderers that draw everything as geometry merge more */
+    SDLTest_AssertCheck(merged >= 6, "Verify at least 6 draws were merged, got %" SDL_PRIs64, merged);
+
+done:
+    SDL_SetRenderBatchMode(renderer, SDL_RENDER_BATCH_ORDERED);
+    SDL_DestroySurface(reference);
+    SDL_DestroySurface(surface);
+    SDL_DestroyTexture(textures[0]);
+    SDL_DestroyTexture(textures[1]);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that the software renderer only presents the parts of the window that were drawn to
+ *
+ * \sa SDL_RenderPresent
+ * \sa SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT
+ */
+static int SDLCALL render_testPartialPresent(void *arg)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_FRect rects[2];
+    Sint64 full, presented;
+    int w, h, bpp;
+
+    if (SDL_strcmp(SDL_GetRendererName(renderer), SDL_SOFTWARE_RENDERER) != 0) {
+        SDLTest_Log("Skipping partial present test, the renderer is %s", SDL_GetRendererName(renderer));
+        return TEST_SKIPPED;
+    }
+    CHECK_FUNC(SDL_GetCurrentRenderOutputSize, (renderer, &w, &h));
+
+    /* Clearing updates the whole window */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderClear, (renderer));
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    full = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, -1);
+    bpp = (int)(full / ((Sint64)w * h));
+    SDLTest_AssertCheck(bpp > 0 && full == (Sint64)w * h * bpp, "Verify a clear presents the whole window, got %" SDL_PRIs64 " bytes", full);
+
+    /* Nothing drawn, nothing sent */
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    presented = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, -1);
+    SDLTest_AssertCheck(presented == 0, "Verify an empty frame presents nothing, got %" SDL_PRIs64 " bytes", presented);
+
+    /* Rectangles far apart are sent separately */
+    rects[0].x = 10.0f;
+    rects[0].y = 10.0f;
+    rects[0].w = 20.0f;
+    rects[0].h = 10.0f;
+    rects[1].x = (float)(w - 40);
+    rects[1].y = (float)(h - 40);
+    rects[1].w = 30.0f;
+    rects[1].h = 30.0f;
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rects[0]));
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rects[1]));
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    presented = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, -1);
+    SDLTest_AssertCheck(presented == (20 * 10 + 30 * 30) * bpp, "Verify two rectangles present %d bytes, got %" SDL_PRIs64, (20 * 10 + 30 * 30) * bpp, presented);
+
+    /* Overlapping rectangles are merged, and drawing is clipped to the viewport */
+    rects[1].x = 15.0f;
+    rects[1].y = 5.0f;
+    rects[1].w = 20.0f;
+    rects[1].h = 10.0f;
+    CHECK_FUNC(SDL_RenderFillRects, (renderer, rects, 2));
+    rects[0].x = -10.0f;
+    rects[0].y = 100.0f;
+    rects[0].w = 20.0f;
+    rects[0].h = 20.0f;
+    CHECK_FUNC(SDL_RenderFillRect, (renderer, &rects[0]));
+    CHECK_FUNC(SDL_RenderPresent, (renderer));
+    presented = SDL_GetNumberProperty(props, SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, -1);
+    SDLTest_AssertCheck(presented == (25 * 15 + 10 * 20) * bpp, "Verify clipped and merged rectangles present %d bytes, got %" SDL_PRIs64, (25 * 15 + 10 * 20) * bpp, presented);
+
+    return TEST_COMPLETED;
+}
+
+/* Draws solid, gradient, textured and blended triangles into a target of the given format, returning the CRC32 of its pixels */
+static Uint32 render_geometrySceneCRC(SDL_PixelFormat format)
+{
+    const int w = 160, h = 120;
+    SDL_Surface *target = SDL_CreateSurface(w, h, format);
+    SDL_Surface *pattern = SDL_CreateSurface(17, 13, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer *sw = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    SDL_Texture *texture = NULL;
+    SDLTest_Crc32Context context;
+    SDL_Vertex vertices[3 * 40];
+    Uint64 seed = 0x5eed;
+    Uint32 crc = 0;
+    int pass, i, x, y;
+
+    if (!sw || !pattern) {
+        goto done;
+    }
+    for (y = 0; y < pattern->h; y++) {
+        for (x = 0; x < pattern->w; x++) {
+            SDL_WriteSurfacePixel(pattern, x, y, (Uint8)(x * 15), (Uint8)(y * 19), (Uint8)((x ^ y) * 16), (Uint8)(128 + x * 7));
+        }
+    }
+    texture = SDL_CreateTextureFromSurface(sw, pattern);
+    if (!texture) {
+        goto done;
+    }
+
+    SDL_SetRenderDrawColor(sw, 0x10, 0x20, 0x30, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(sw);
+    for (pass = 0; pass < 4; pass++) {
+        for (i = 0; i < SDL_arraysize(vertices); i++) {
+            SDL_Vertex *v = &vertices[i];
+            v->position.x = (SDL_rand_r(&seed, (w + 40) * 16) - 20 * 16) / 16.0f;
+            v->position.y = (SDL_rand_r(&seed, (h + 40) * 16) - 20 * 16) / 16.0f;
+            if (pass == 0) {
+                /* solid: the same color at every corner */
+                v->color = vertices[i - i % 3].color;
+                if (i % 3 == 0) {
+                    v->color.r = SDL_rand_r(&seed, 256) / 255.0f;
+                    v->color.g = SDL_rand_r(&seed, 256) / 255.0f;
+                    v->color.b = SDL_rand_r(&seed, 256) / 255.0f;
+                    v->color.a = 1.0f;
+                }
+            } else {
+                v->color.r = SDL_rand_r(&seed, 256) / 255.0f;
+                v->color.g = SDL_rand_r(&seed, 256) / 255.0f;
+                v->color.b = SDL_rand_r(&seed, 256) / 255.0f;
+                v->color.a = (pass == 3) ? SDL_rand_r(&seed, 256) / 255.0f : 1.0f;
+            }
+            if (pass == 2) {
+                /* textured, within the texture */
+                v->color.r = v->color.g = v->color.b = 1.0f;
+                v->tex_coord.x = SDL_rand_r(&seed, 257) / 256.0f;
+                v->tex_coord.y = SDL_rand_r(&seed, 257) / 256.0f;
+            } else {
+                /* modulated, and wrapping around the texture */
+                v->tex_coord.x = (SDL_rand_r(&seed, 769) - 256) / 256.0f;
+                v->tex_coord.y = (SDL_rand_r(&seed, 769) - 256) / 256.0f;
+            }
+        }
+        SDL_SetRenderDrawBlendMode(sw, (pass == 3) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_SetTextureBlendMode(texture, (pass == 3) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        SDL_RenderGeometry(sw, (pass >= 2) ? texture : NULL, vertices, SDL_arraysize(vertices), NULL, 0);
+    }
+    SDL_RenderPresent(sw);
+
+    SDLTest_Crc32Init(&context);
+    SDLTest_Crc32CalcStart(&context, &crc);
+    for (y = 0; y < h; y++) {
+        SDLTest_Crc32CalcBuffer(&context, (Uint8 *)target->pixels + y * target->pitch, w * SDL_BYTESPERPIXEL(format), &crc);
+    }
+    SDLTest_Crc32CalcEnd(&context, &crc);
+    SDLTest_Crc32Done(&context);
+
+done:
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(sw);
+    SDL_DestroySurface(pattern);
+    SDL_DestroySurface(target);
+    return crc;
+}
+
+/**
+ * Tests that triangles sharing edges cover each pixel exactly once, and that
+ * triangles draw the same as the old per-pixel rasterizer did
+ */
+static int SDLCALL render_testGeometryFillRule(void *arg)
+{
+    static const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24
+    };
+    static const struct
+    {
+        SDL_PixelFormat format;
+        Uint32 crc;
+    } scenes[] = {
+        { SDL_PIXELFORMAT_XRGB8888, 0x26cef430 },
+        { SDL_PIXELFORMAT_ARGB8888, 0x3bcb361b },
+        { SDL_PIXELFORMAT_ABGR8888, 0x98dcd7b3 },
+        { SDL_PIXELFORMAT_RGB565, 0x944eefdc },
+        { SDL_PIXELFORMAT_RGB24, 0x66bab99d }
+    };
+    const int cells_x = 13, cells_y = 9;
+    const int w = 301, h = 203;
+    SDL_FPoint points[(13 + 1) * (9 + 1)];
+    SDL_Vertex vertices[13 * 9 * 6];
+    SDL_FColor color = { 64.0f / 255.0f, 0.0f, 0.0f, 1.0f };
+    int f, i, x, y;
+
+    /* A mesh of jittered cells, covering the whole target and a bit more */
+    for (y = 0; y <= cells_y; y++) {
+        for (x = 0; x <= cells_x; x++) {
+            SDL_FPoint *p = &points[y * (cells_x + 1) + x];
+            p->x = -4.0f + x * (w + 8.0f) / cells_x;
+            p->y = -4.0f + y * (h + 8.0f) / cells_y;
+            if (x > 0 && x < cells_x && y > 0 && y < cells_y) {
+                p->x += SDLTest_RandomIntegerInRange(-700, 700) / 100.0f;
+                p->y += SDLTest_RandomIntegerInRange(-700, 700) / 100.0f;
+            }
+        }
+    }
+
+    /* Two triangles per cell, with both diagonals and both windings */
+    i = 0;
+    for (y = 0; y < cells_y; y++) {
+        for (x = 0; x < cells_x; x++) {
+            const SDL_FPoint *p00 = &points[y * (cells_x + 1) + x];
+            const SDL_FPoint *p10 = p00 + 1;
+            const SDL_FPoint *p01 = p00 + (cells_x + 1);
+            const SDL_FPoint *p11 = p01 + 1;
+            const SDL_FPoint *corners[6];
+            int k;
+            if ((x + y) & 1) {
+                corners[0] = p00; corners[1] = p10; corners[2] = p11;
+                corners[3] = p00; corners[4] = p01; corners[5] = p11;
+            } else {
+                corners[0] = p10; corners[1] = p01; corners[2] = p00;
+                corners[3] = p10; corners[4] = p11; corners[5] = p01;
+            }
+            for (k = 0; k < 6; k++) {
+                vertices[i].position = *corners[k];
+                vertices[i].color = color;
+                vertices[i].tex_coord.x = 0.0f;
+                vertices[i].tex_coord.y = 0.0f;
+                i++;
+            }
+        }
+    }
+
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        SDL_Surface *target = SDL_CreateSurface(w, h, formats[f]);
+        SDL_Renderer *sw = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+        int wrong = 0;
+
+        SDLTest_AssertCheck(sw != NULL, "Verify SDL_CreateSoftwareRenderer() for %s", SDL_GetPixelFormatName(formats[f]));
+        if (sw) {
+            SDL_SetRenderDrawColor(sw, 0, 0, 0, SDL_ALPHA_OPAQUE);
+            SDL_RenderClear(sw);
+            SDL_SetRenderDrawBlendMode(sw, SDL_BLENDMODE_ADD);
+            SDL_RenderGeometry(sw, NULL, vertices, SDL_arraysize(vertices), NULL, 0);
+            SDL_RenderPresent(sw);
+
+            for (y = 0; y < h; y++) {
+                for (x = 0; x < w; x++) {
+                    Uint8 r, g, b;
+                    SDL_ReadSurfacePixel(target, x, y, &r, &g, &b, NULL);
+                    /* 64 when drawn once, a little more in RGB565 */
+                    if (r < 64 || r >= 128) {
+                        wrong++;
+                    }
+                }
+            }
+            SDLTest_AssertCheck(wrong == 0, "Verify every %s pixel is drawn exactly once, %d pixel(s) wrong", SDL_GetPixelFormatName(formats[f]), wrong);
+        }
+
+        SDL_DestroyRenderer(sw);
+        SDL_DestroySurface(target);
+    }
+
+    /* CRCs of the scene as the rasterizer that tested every pixel of the bounding rect drew it */
+    for (f = 0; f < SDL_arraysize(scenes); f++) {
+        const Uint32 crc = render_geometrySceneCRC(scenes[f].format);
+        SDLTest_AssertCheck(crc == scenes[f].crc, "Verify the %s scene CRC, expected 0x%08" SDL_PRIx32 ", got 0x%08" SDL_PRIx32,
+                            SDL_GetPixelFormatName(scenes[f].format), scenes[f].crc, crc);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that cached debug text and text runs draw the same as one character at a time
+ */
+static int SDLCALL render_testDebugTextRun(void *arg)
+{
+    /* Blanks, a character from the upper half of Latin-1 and one the font doesn't have */
+    const char *text = "Debug text: 42 \xc3\xa9t\xc3\xa9 \xe2\x82\xac~";
+    const float x = 17.0f, y = 23.0f;
+    const SDL_Rect rect = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    SDL_DebugTextRun *run;
+    SDL_Surface *reference;
+    SDL_Surface *surface;
+    const char *s;
+    char ch[5];
+    float curx;
+    int i;
+
+    /* Draw the reference one character at a time */
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE));
+    CHECK_FUNC(SDL_RenderClear, (renderer));
+    CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0xFF, 0xC0, 0x40, 0xA0));
+    for (s = text, curx = x; *s; curx += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE) {
+        const char *start = s;
+        SDL_StepUTF8(&s, NULL);
+        SDL_memcpy(ch, start, s - start);
+        ch[s - start] = '\0';
+        CHECK_FUNC(SDL_RenderDebugText, (renderer, curx, y, ch));
+    }
+    surface = SDL_RenderReadPixels(renderer, &rect);
+    SDLTest_AssertCheck(surface != NULL, "Verify SDL_RenderReadPixels() result");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    reference = SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT);
+    SDL_DestroySurface(surface);
+    SDLTest_AssertCheck(reference != NULL, "Verify SDL_ConvertSurface() result");
+    if (!reference) {
+        return TEST_ABORTED;
+    }
+
+    /* The first time the string is drawn directly, then from the cache */
+    for (i = 0; i < 3; i++) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE));
+        CHECK_FUNC(SDL_RenderClear, (renderer));
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0xFF, 0xC0, 0x40, 0xA0));
+        CHECK_FUNC(SDL_RenderDebugText, (renderer, x, y, text));
+        compare(reference, 0);
+    }
+
+    /* A text run moved back to where the reference was drawn */
+    run = SDL_CreateDebugTextRun(renderer, text);
+    SDLTest_AssertCheck(run != NULL, "Verify SDL_CreateDebugTextRun() result: %s", run ? "success" : SDL_GetError());
+    if (run) {
+        CHECK_FUNC(SDL_RenderDebugTextRun, (renderer, run, 0.0f, 0.0f));
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE));
+        CHECK_FUNC(SDL_RenderClear, (renderer));
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0xFF, 0xC0, 0x40, 0xA0));
+        CHECK_FUNC(SDL_RenderDebugTextRun, (renderer, run, x, y));
+        compare(reference, 0);
+        SDL_DestroyDebugTextRun(run);
+    }
+
+    /* Text without any glyphs draws nothing */
+    run = SDL_CreateDebugTextRun(renderer, "   ");
+    SDLTest_AssertCheck(run != NULL, "Verify SDL_CreateDebugTextRun() with blank text result");
+    CHECK_FUNC(SDL_RenderDebugTextRun, (renderer, run, x, y));
+    SDL_DestroyDebugTextRun(run);
+
+    run = SDL_CreateDebugTextRun(renderer, NULL);
+    SDLTest_AssertCheck(run == NULL, "Verify SDL_CreateDebugTextRun() fails without text");
+
+    SDL_DestroySurface(reference);
+
+    return TEST_COMPLETED;
+}
+
+/* Checks that a renderer draws the debug text like the reference, directly, from the cache and as a moved text run */
+static void checkDebugTextGeometry(SDL_Renderer *r, SDL_Surface *reference, const char *text, float x, float y)
+{
+    const SDL_Rect rect = { 0, 0, reference->w, reference->h };
+    SDL_DebugTextRun *run;
+    int i;
+
+    run = SDL_CreateDebugTextRun(r, text);
+    SDLTest_AssertCheck(run != NULL, "Verify SDL_CreateDebugTextRun() result: %s", run ? "success" : SDL_GetError());
+
+    /* The first time the string is drawn directly, then from the cache, then as a run moved from the origin */
+    for (i = 0; i < 4; i++) {
+        SDL_Surface *surface, *converted;
+        int ret;
+
+        if (i == 3 && run) {
+            SDL_RenderDebugTextRun(r, run, 0.0f, 0.0f);
+        }
+        SDL_SetRenderDrawColor(r, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(r);
+        SDL_SetRenderDrawColor(r, 0xFF, 0xC0, 0x40, 0xA0);
+        if (i < 3) {
+            SDL_RenderDebugText(r, x, y, text);
+        } else if (run) {
+            SDL_RenderDebugTextRun(r, run, x, y);
+        }
+
+        surface = SDL_RenderReadPixels(r, &rect);
+        converted = surface ? SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT) : NULL;
+        SDL_DestroySurface(surface);
+        SDLTest_AssertCheck(converted != NULL, "Verify SDL_RenderReadPixels() result: %s", converted ? "success" : SDL_GetError());
+        if (converted) {
+            /* blending may round differently than the software renderer */
+            ret = SDLTest_CompareSurfaces(converted, reference, 3);
+            SDLTest_AssertCheck(ret == 0, "Verify %s draws debug text %s like the software renderer, %d pixel(s) differ",
+                                SDL_GetRendererName(r), (i == 0) ? "directly" : (i < 3) ? "from the cache" : "as a moved run", ret);
+            SDL_DestroySurface(converted);
+        }
+    }
+
+    SDL_DestroyDebugTextRun(run);
+}
+
+/* Runs checkDebugTextGeometry() with every renderer but the software one, returning how many could be created */
+static int checkDebugTextGeometryRenderers(SDL_Surface *reference, const char *text, float x, float y)
+{
+    int tested = 0;
+    int i;
+
+    for (i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+        const char *name = SDL_GetRenderDriver(i);
+        SDL_Window *win;
+        SDL_Renderer *r;
+
+        if (SDL_strcmp(name, SDL_SOFTWARE_RENDERER) == 0) {
+            continue;
+        }
+        win = SDL_CreateWindow("render_testDebugTextGeometry", reference->w, reference->h, SDL_WINDOW_HIDDEN);
+        r = win ? SDL_CreateRenderer(win, name) : NULL;
+        if (r) {
+            SDLTest_Log("Drawing debug text with the %s renderer", name);
+            checkDebugTextGeometry(r, reference, text, x, y);
+            SDL_DestroyRenderer(r);
+            tested++;
+        }
+        SDL_DestroyWindow(win);
+    }
+    return tested;
+}
+
+/**
+ * Tests that renderers which draw debug text as geometry, with a quad for each
+ * glyph in the font atlas, draw the same as the software renderer, which copies
+ * each glyph's rect
+ */
+static int SDLCALL render_testDebugTextGeometry(void *arg)
+{
+    /* Blanks, a character from the upper half of Latin-1 and one the font doesn't have */
+    const char *text = "Debug text: 42 \xc3\xa9t\xc3\xa9 \xe2\x82\xac~";
+    const float x = 5.0f, y = 7.0f;
+    SDL_Surface *reference = SDL_CreateSurface(180, 24, RENDER_COMPARE_FORMAT);
+    SDL_Renderer *sw = reference ? SDL_CreateSoftwareRenderer(reference) : NULL;
+    int tested;
+    int inits;
+    int i;
+
+    SDLTest_AssertCheck(sw != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+    if (!sw) {
+        SDL_DestroySurface(reference);
+        return TEST_ABORTED;
+    }
+    SDL_SetRenderDrawColor(sw, 0x20, 0x40, 0x60, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(sw);
+    SDL_SetRenderDrawColor(sw, 0xFF, 0xC0, 0x40, 0xA0);
+    SDL_RenderDebugText(sw, x, y, text);
+    SDL_RenderPresent(sw);
+    SDL_DestroyRenderer(sw);
+
+    tested = checkDebugTextGeometryRenderers(reference, text, x, y);
+    if (tested == 0 && SDL_strcmp(SDL_GetCurrentVideoDriver(), "offscreen") != 0) {
+        /* the offscreen driver can often create OpenGL renderers without a display; the harness holds a reference to video, too. */
+        CleanupDestroyRenderer(NULL);
+        for (inits = 0; SDL_WasInit(SDL_INIT_VIDEO); inits++) {
+            SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        }
+        SDL_SetHintWithPriority(SDL_HINT_VIDEO_DRIVER, "offscreen", SDL_HINT_OVERRIDE);
+        if (SDL_InitSubSystem(SDL_INIT_VIDEO)) {
+            tested = checkDebugTextGeometryRenderers(reference, text, x, y);
+            SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        }
+        SDL_ResetHint(SDL_HINT_VIDEO_DRIVER);
+        for (i = 0; i < inits; i++) {
+            SDL_InitSubSystem(SDL_INIT_VIDEO);
+        }
+        InitCreateRenderer(NULL);
+    }
+    SDL_DestroySurface(reference);
+
+    if (tested == 0) {
+        SDLTest_Log("No renderer that draws debug text as geometry is available, skipping test");
+        return TEST_SKIPPED;
+    }
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -2051,6 +3065,42 @@ static const SDLTest_TestCaseReference renderTestRGBSurfaceNoAlpha = {
     render_testRGBSurfaceNoAlpha, "render_testRGBSurfaceNoAlpha", "Tests RGB surface with no alpha using software renderer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestGeometryFillRule = {
+    render_testGeometryFillRule, "render_testGeometryFillRule", "Tests that triangles sharing edges cover each pixel exactly once, and draw as before", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestPartialPresent = {
+    render_testPartialPresent, "render_testPartialPresent", "Tests the software renderer only presents what was drawn", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBatchMode = {
+    render_testBatchMode, "render_testBatchMode", "Tests that unordered batching keeps layers and merges draws", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestQueueMemory = {
+    render_testQueueMemory, "render_testQueueMemory", "Tests the command queue gives back memory after a busy frame", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestBlendedSpans = {
+    render_testBlendedSpans, "render_testBlendedSpans", "Tests that blended rectangles and lines match blended points", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderThread = {
+    render_testRenderThread, "render_testRenderThread", "Tests that drawing on a render thread matches drawing on the application thread", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestDebugTextRun = {
+    render_testDebugTextRun, "render_testDebugTextRun", "Tests that cached debug text and text runs match drawing one character at a time", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestDebugTextGeometry = {
+    render_testDebugTextGeometry, "render_testDebugTextGeometry", "Tests that debug text drawn as geometry matches the software renderer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareThreads = {
+    render_testSoftwareThreads, "render_testSoftwareThreads", "Tests that the software renderer draws the same with several threads", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
@@ -2069,6 +3119,15 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestTextureState,
     &renderTestGetSetTextureScaleMode,
     &renderTestRGBSurfaceNoAlpha,
+    &renderTestSoftwareThreads,
+    &renderTestGeometryFillRule,
+    &renderTestPartialPresent,
+    &renderTestBatchMode,
+    &renderTestQueueMemory,
+    &renderTestRenderThread,
+    &renderTestBlendedSpans,
+    &renderTestDebugTextRun,
+    &renderTestDebugTextGeometry,
     NULL
 };
 
@@ -311,6 +311,65 @@ static void AssertFileExist(const char *filename)
     SDLTest_AssertCheck(ret == 0, "Verify file '%s' exists", filename);
 }
 
+/* Helper to count the rows that differ between two surfaces of the same size and format.
+   With a tolerance, only the color channels are compared, and each may be off by that much. */
+static int compare_surface_rows(SDL_Surface *expected, SDL_Surface *actual, int tolerance)
+{
+    const SDL_PixelFormatDetails *fmt = SDL_GetPixelFormatDetails(expected->format);
+    const int bpp = SDL_BYTESPERPIXEL(expected->format);
+    int x, y, wrong = 0;
+
+    for (y = 0; y < expected->h; y++) {
+        const Uint8 *row0 = (const Uint8 *)expected->pixels + y * expected->pitch;
+        const Uint8 *row1 = (const Uint8 *)actual->pixels + y * actual->pitch;
+
+        if (SDL_memcmp(row0, row1, expected->w * bpp) == 0) {
+            continue;
+        }
+        if (tolerance == 0 || !fmt || SDL_ISPIXELFORMAT_INDEXED(expected->format) || bpp > 4) {
+            wrong++;
+            continue;
+        }
+        for (x = 0; x < expected->w; x++) {
+            const Uint32 masks[4] = { fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask };
+            const Uint8 shifts[4] = { fmt->Rshift, fmt->Gshift, fmt->Bshift, fmt->Ashift };
+            Uint32 pixel0 = 0, pixel1 = 0;
+            int c;
+
+            if (bpp == 3) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+                pixel0 = row0[x * 3] | (row0[x * 3 + 1] << 8) | (row0[x * 3 + 2] << 16);
+                pixel1 = row1[x * 3] | (row1[x * 3 + 1] << 8) | (row1[x * 3 + 2] << 16);
+#else
+                pixel0 = (row0[x * 3] << 16) | (row0[x * 3 + 1] << 8) | row0[x * 3 + 2];
+                pixel1 = (row1[x * 3] << 16) | (row1[x * 3 + 1] << 8) | row1[x * 3 + 2];
+#endif
+            } else if (bpp == 4) {
+                pixel0 = ((const Uint32 *)row0)[x];
+                pixel1 = ((const Uint32 *)row1)[x];
+            } else if (bpp == 2) {
+                pixel0 = ((const Uint16 *)row0)[x];
+                pixel1 = ((const Uint16 *)row1)[x];
+            } else {
+                pixel0 = row0[x];
+                pixel1 = row1[x];
+            }
+            for (c = 0; c < 4; c++) {
+                if (SDL_abs((int)((pixel0 & masks[c]) >> shifts[c]) - (int)((pixel1 & masks[c]) >> shifts[c])) > tolerance) {
+                    break;
+                }
+            }
+            if (c < 4) {
+                break;
+            }
+        }
+        if (x < expected->w) {
+            wrong++;
+        }
+    }
+    return wrong;
+}
+
 /* Test case functions */
 
 /**
@@ -1586,6 +1645,796 @@ static int SDLCALL surface_testScale(void *arg)
     return TEST_COMPLETED;
 }
 
+static int SDLCALL surface_testColorspaceRoundTrip(void *arg)
+{
+    SDL_Surface *surface, *linear, *result;
+    int x, y, wrong;
+    float max_error;
+
+    /* Every 8-bit sRGB value, in a surface large enough for the transfer function tables */
+    surface = SDL_CreateSurface(256, 16, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < surface->h; y++) {
+        for (x = 0; x < surface->w; x++) {
+            SDL_WriteSurfacePixel(surface, x, y, (Uint8)x, (Uint8)(255 - x), (Uint8)(x ^ y), (Uint8)(y * 16));
+        }
+    }
+
+    linear = SDL_ConvertSurfaceAndColorspace(surface, SDL_PIXELFORMAT_RGBA128_FLOAT, NULL, SDL_COLORSPACE_SRGB_LINEAR, 0);
+    SDLTest_AssertCheck(linear != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_COLORSPACE_SRGB_LINEAR)");
+    if (linear) {
+        max_error = 0.0f;
+        for (x = 0; x < linear->w; x++) {
+            const float v = (float)x / 255.0f;
+            const float expected = (v <= 0.04045f) ? (v / 12.92f) : SDL_powf((v + 0.055f) / 1.055f, 2.4f);
+            const float actual = ((const float *)linear->pixels)[x * 4 + 0];
+            max_error = SDL_max(max_error, SDL_fabsf(actual - expected));
+        }
+        SDLTest_AssertCheck(max_error <= 0.000001f, "Verify sRGB values are converted to linear, maximum error %g", max_error);
+
+        result = SDL_ConvertSurfaceAndColorspace(linear, SDL_PIXELFORMAT_ARGB8888, NULL, SDL_COLORSPACE_SRGB, 0);
+        SDLTest_AssertCheck(result != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_COLORSPACE_SRGB)");
+        if (result) {
+            wrong = compare_surface_rows(surface, result, 0);
+            SDLTest_AssertCheck(wrong == 0, "Verify sRGB values survive a round trip through linear colors, %d row(s) differ", wrong);
+            SDL_DestroySurface(result);
+        }
+        SDL_DestroySurface(linear);
+    }
+    SDL_DestroySurface(surface);
+
+    /* Every 10-bit HDR10 value, as grays so they're inside the sRGB gamut */
+    surface = SDL_CreateSurface(1024, 4, SDL_PIXELFORMAT_XRGB2101010);
+    SDLTest_AssertCheck(surface != NULL, "SDL_CreateSurface()");
+    if (!surface) {
+        return TEST_ABORTED;
+    }
+    SDL_SetSurfaceColorspace(surface, SDL_COLORSPACE_HDR10);
+    for (y = 0; y < surface->h; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; x++) {
+            const Uint32 v = (Uint32)x;
+            row[x] = (3u << 30) | (v << 20) | (v << 10) | v;
+        }
+    }
+
+    linear = SDL_ConvertSurfaceAndColorspace(surface, SDL_PIXELFORMAT_RGBA128_FLOAT, NULL, SDL_COLORSPACE_SRGB_LINEAR, 0);
+    SDLTest_AssertCheck(linear != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_COLORSPACE_SRGB_LINEAR)");
+    if (linear) {
+        result = SDL_ConvertSurfaceAndColorspace(linear, SDL_PIXELFORMAT_XRGB2101010, NULL, SDL_COLORSPACE_HDR10, 0);
+        SDLTest_AssertCheck(result != NULL, "SDL_ConvertSurfaceAndColorspace(SDL_COLORSPACE_HDR10)");
+        if (result) {
+            wrong = compare_surface_rows(surface, result, 1);
+            SDLTest_AssertCheck(wrong == 0, "Verify HDR10 values survive a round trip through linear colors within one step, %d row(s) differ", wrong);
+            SDL_DestroySurface(result);
+        }
+        SDL_DestroySurface(linear);
+    }
+    SDL_DestroySurface(surface);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testTransferTables(void *arg)
+{
+    SDL_Surface *linear, *expected, *actual;
+    int x, y, wrong;
+
+    /* Linear colors from black to well above SDR white, closely spaced so most 10-bit values are hit */
+    linear = SDL_CreateSurface(1024, 8, SDL_PIXELFORMAT_RGBA128_FLOAT);
+    expected = SDL_CreateSurface(1024, 8, SDL_PIXELFORMAT_XRGB2101010);
+    actual = SDL_CreateSurface(1024, 8, SDL_PIXELFORMAT_XRGB2101010);
+    SDLTest_AssertCheck(linear && expected && actual, "SDL_CreateSurface()");
+    if (!linear || !expected || !actual) {
+        SDL_DestroySurface(linear);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < linear->h; y++) {
+        float *row = (float *)((Uint8 *)linear->pixels + y * linear->pitch);
+        for (x = 0; x < linear->w; x++) {
+            const float v = (float)(y * linear->w + x) / (float)(linear->w * linear->h - 1);
+            row[x * 4 + 0] = v;
+            row[x * 4 + 1] = 0.1f + v * 0.1f;
+            row[x * 4 + 2] = v * v * 50.0f;
+            row[x * 4 + 3] = 1.0f;
+        }
+    }
+
+    /* Rows converted one at a time are too small for the transfer function tables */
+    for (y = 0; y < linear->h; y++) {
+        SDL_ConvertPixelsAndColorspace(linear->w, 1, linear->format, SDL_COLORSPACE_SRGB_LINEAR, 0,
+                                       (Uint8 *)linear->pixels + y * linear->pitch, linear->pitch,
+                                       expected->format, SDL_COLORSPACE_HDR10, 0,
+                                       (Uint8 *)expected->pixels + y * expected->pitch, expected->pitch);
+    }
+    SDL_ConvertPixelsAndColorspace(linear->w, linear->h, linear->format, SDL_COLORSPACE_SRGB_LINEAR, 0, linear->pixels, linear->pitch,
+                                   actual->format, SDL_COLORSPACE_HDR10, 0, actual->pixels, actual->pitch);
+
+    wrong = compare_surface_rows(expected, actual, 0);
+    SDLTest_AssertCheck(wrong == 0, "Verify HDR10 colors don't depend on the size of the conversion, %d row(s) differ", wrong);
+
+    SDL_DestroySurface(linear);
+    SDL_DestroySurface(expected);
+    SDL_DestroySurface(actual);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testBlitScaledClipped(void *arg)
+{
+    const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24
+    };
+    const SDL_ScaleMode modes[] = { SDL_SCALEMODE_NEAREST, SDL_SCALEMODE_LINEAR };
+    const SDL_BlendMode blend_modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD };
+    const char *blend_names[] = { "unblended", "blended", "added" };
+    SDL_Surface *src;
+    int f, m, b, i, x, y;
+
+    /* A gradient with varying alpha, so that every sample position shows */
+    src = SDL_CreateSurface(61, 47, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "SDL_CreateSurface()");
+    if (!src) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < src->h; y++) {
+        for (x = 0; x < src->w; x++) {
+            SDL_WriteSurfacePixel(src, x, y, (Uint8)(x * 4), (Uint8)(y * 5), (Uint8)((x ^ y) * 9), (Uint8)(40 + x * 3 + y));
+        }
+    }
+
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        for (m = 0; m < SDL_arraysize(modes); m++) {
+            for (b = 0; b < SDL_arraysize(blend_modes); b++) {
+                const Uint8 gmod = (b > 0) ? 200 : 255;
+                const Uint8 bmod = (b > 0) ? 150 : 255;
+                const Uint8 amod = (b > 0) ? 180 : 255;
+                int wrong = 0;
+
+                for (i = 0; i < 20; i++) {
+                    SDL_Surface *actual = SDL_CreateSurface(97, 83, formats[f]);
+                    SDL_Surface *expected = SDL_CreateSurface(97, 83, formats[f]);
+                    SDL_Surface *tmp;
+                    SDL_Rect srcrect, dstrect;
+
+                    SDLTest_AssertCheck(actual && expected, "SDL_CreateSurface()");
+                    if (!actual || !expected) {
+                        SDL_DestroySurface(actual);
+                        SDL_DestroySurface(expected);
+                        continue;
+                    }
+                    SDL_FillSurfaceRect(actual, NULL, SDL_MapSurfaceRGB(actual, 30, 60, 90));
+                    SDL_FillSurfaceRect(expected, NULL, SDL_MapSurfaceRGB(expected, 30, 60, 90));
+
+                    /* Scaled rectangles crossing the edges of the surface, and sometimes its clip rectangle */
+                    srcrect.x = SDLTest_RandomIntegerInRange(0, 19);
+                    srcrect.y = SDLTest_RandomIntegerInRange(0, 19);
+                    srcrect.w = SDLTest_RandomIntegerInRange(1, src->w - srcrect.x);
+                    srcrect.h = SDLTest_RandomIntegerInRange(1, src->h - srcrect.y);
+                    dstrect.w = SDLTest_RandomIntegerInRange(1, 200);
+                    dstrect.h = SDLTest_RandomIntegerInRange(1, 200);
+                    dstrect.x = SDLTest_RandomIntegerInRange(1 - dstrect.w, actual->w - 1);
+                    dstrect.y = SDLTest_RandomIntegerInRange(1 - dstrect.h, actual->h - 1);
+                    if (SDLTest_RandomIntegerInRange(0, 1)) {
+                        SDL_Rect clip;
+                        clip.x = SDLTest_RandomIntegerInRange(0, 39);
+                        clip.y = SDLTest_RandomIntegerInRange(0, 39);
+                        clip.w = SDLTest_RandomIntegerInRange(20, 76);
+                        clip.h = SDLTest_RandomIntegerInRange(20, 62);
+                        SDL_SetSurfaceClipRect(actual, &clip);
+                        SDL_SetSurfaceClipRect(expected, &clip);
+                    }
+
+                    SDL_SetSurfaceColorMod(src, 255, gmod, bmod);
+                    SDL_SetSurfaceAlphaMod(src, amod);
+                    SDL_SetSurfaceBlendMode(src, blend_modes[b]);
+                    SDL_BlitSurfaceScaled(src, &srcrect, actual, &dstrect, modes[m]);
+
+                    /* The same copy, scaled whole into a temporary surface and then clipped */
+                    tmp = SDL_CreateSurface(dstrect.w, dstrect.h, src->format);
+                    SDLTest_AssertCheck(tmp != NULL, "SDL_CreateSurface()");
+                    if (tmp) {
+                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                        SDL_SetSurfaceAlphaMod(src, 255);
+                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                        SDL_BlitSurfaceScaled(src, &srcrect, tmp, NULL, modes[m]);
+                        SDL_SetSurfaceColorMod(tmp, 255, gmod, bmod);
+                        SDL_SetSurfaceAlphaMod(tmp, amod);
+                        SDL_SetSurfaceBlendMode(tmp, blend_modes[b]);
+                        SDL_BlitSurface(tmp, NULL, expected, &dstrect);
+                        SDL_DestroySurface(tmp);
+                    }
+
+                    /* Compare colors, the padding byte of XRGB8888 isn't written the same way by every blitter */
+                    for (y = 0; y < actual->h; y++) {
+                        for (x = 0; x < actual->w; x++) {
+                            Uint8 r0, g0, b0, a0, r1, g1, b1, a1;
+                            SDL_ReadSurfacePixel(actual, x, y, &r0, &g0, &b0, &a0);
+                            SDL_ReadSurfacePixel(expected, x, y, &r1, &g1, &b1, &a1);
+                            if (r0 != r1 || g0 != g1 || b0 != b1 || a0 != a1) {
+                                wrong++;
+                            }
+                        }
+                    }
+                    SDL_DestroySurface(actual);
+                    SDL_DestroySurface(expected);
+                }
+                SDLTest_AssertCheck(wrong == 0, "Verify clipped %s %s blits to %s match scaling the whole rectangle, %d pixel(s) differ",
+                                    modes[m] == SDL_SCALEMODE_NEAREST ? "nearest" : "linear",
+                                    blend_names[b], SDL_GetPixelFormatName(formats[f]), wrong);
+            }
+        }
+    }
+    SDL_DestroySurface(src);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testBlitGenerated(void *arg)
+{
+    /* The formats in sdlgenblit.pl */
+    const SDL_PixelFormat src_formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB1555,
+        SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGB24
+    };
+    const SDL_PixelFormat dst_formats[] = {
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGB24
+    };
+    const SDL_BlendMode blend_modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_BLEND_PREMULTIPLIED, SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_ADD_PREMULTIPLIED, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    Uint64 seed = 0x6E4B117;
+    int s, d, b, modulate, scaled, x, y;
+
+    for (s = 0; s < SDL_arraysize(src_formats); s++) {
+        for (d = 0; d < SDL_arraysize(dst_formats); d++) {
+            SDL_Surface *src, *dst, *actual, *expected;
+            Uint8 kr, kg, kb;
+            Uint32 key;
+            int wrong = 0;
+
+            src = SDL_CreateSurface(23, 19, src_formats[s]);
+            dst = SDL_CreateSurface(41, 37, dst_formats[d]);
+            actual = SDL_CreateSurface(41, 37, dst_formats[d]);
+            expected = SDL_CreateSurface(41, 37, dst_formats[d]);
+            SDLTest_AssertCheck(src && dst && actual && expected, "SDL_CreateSurface()");
+            if (!src || !dst || !actual || !expected) {
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+                SDL_DestroySurface(actual);
+                SDL_DestroySurface(expected);
+                continue;
+            }
+            for (y = 0; y < src->h; y++) {
+                Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+                for (x = 0; x < src->w * SDL_BYTESPERPIXEL(src->format); x++) {
+                    row[x] = (Uint8)SDL_rand_bits_r(&seed);
+                }
+            }
+            for (y = 0; y < dst->h; y++) {
+                Uint8 *row = (Uint8 *)dst->pixels + y * dst->pitch;
+                for (x = 0; x < dst->w * SDL_BYTESPERPIXEL(dst->format); x++) {
+                    row[x] = (Uint8)SDL_rand_bits_r(&seed);
+                }
+            }
+            /* Each blit starts from a plain copy of the destination */
+            SDL_SetSurfaceBlendMode(dst, SDL_BLENDMODE_NONE);
+
+            /* A color key that matches no source pixel doesn't change the result, but no
+               specialized blitter handles it, so the expected image comes from SDL_Blit_Slow */
+            key = SDL_MapSurfaceRGB(src, 0x12, 0x34, 0x56);
+            SDL_GetRGB(key, SDL_GetPixelFormatDetails(src->format), NULL, &kr, &kg, &kb);
+            for (y = 0; y < src->h; y++) {
+                for (x = 0; x < src->w; x++) {
+                    Uint8 cr, cg, cb, ca;
+                    SDL_ReadSurfacePixel(src, x, y, &cr, &cg, &cb, &ca);
+                    if (cr == kr && cg == kg && cb == kb) {
+                        SDL_WriteSurfacePixel(src, x, y, cr ^ 0x80, cg, cb, ca);
+                    }
+                }
+            }
+
+            for (b = 0; b < SDL_arraysize(blend_modes); b++) {
+                for (modulate = 0; modulate <= 1; modulate++) {
+                    for (scaled = 0; scaled <= 1; scaled++) {
+                        SDL_Rect dstrect;
+
+                        /* Plain copies and blends without modulation have their own blitters,
+                           which round differently, and same format copies are stretched directly */
+                        if (!modulate && blend_modes[b] == SDL_BLENDMODE_NONE &&
+                            (!scaled || src->format == dst->format)) {
+                            continue;
+                        }
+                        if (!modulate && !scaled && blend_modes[b] == SDL_BLENDMODE_BLEND) {
+                            continue;
+                        }
+
+                        if (scaled) {
+                            dstrect.x = 1;
+                            dstrect.y = 2;
+                            dstrect.w = 37;
+                            dstrect.h = 13;
+                        } else {
+                            dstrect.x = 3;
+                            dstrect.y = 5;
+                            dstrect.w = src->w;
+                            dstrect.h = src->h;
+                        }
+
+                        SDL_SetSurfaceColorMod(src, modulate ? 200 : 255, modulate ? 150 : 255, modulate ? 100 : 255);
+                        SDL_SetSurfaceAlphaMod(src, modulate ? 180 : 255);
+                        SDL_SetSurfaceBlendMode(src, blend_modes[b]);
+
+                        SDL_BlitSurface(dst, NULL, actual, NULL);
+                        SDL_BlitSurface(dst, NULL, expected, NULL);
+                        SDL_SetSurfaceColorKey(src, false, 0);
+                        SDL_BlitSurfaceScaled(src, NULL, actual, &dstrect, SDL_SCALEMODE_NEAREST);
+                        SDL_SetSurfaceColorKey(src, true, key);
+                        SDL_BlitSurfaceScaled(src, NULL, expected, &dstrect, SDL_SCALEMODE_NEAREST);
+
+                        /* The generated blitters round the two terms of SDL_BLENDMODE_MUL separately */
+                        wrong += compare_surface_rows(expected, actual, (blend_modes[b] == SDL_BLENDMODE_MUL) ? 1 : 0);
+                    }
+                }
+            }
+            SDLTest_AssertCheck(wrong == 0, "Verify blits from %s to %s match the general blitter, %d row(s) differ",
+                                SDL_GetPixelFormatName(src_formats[s]), SDL_GetPixelFormatName(dst_formats[d]), wrong);
+
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            SDL_DestroySurface(actual);
+            SDL_DestroySurface(expected);
+        }
+    }
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL surface_testBlitMapCache(void *arg)
+{
+    const Uint8 mods[][4] = {
+        { 255, 255, 255, 255 },
+        { 255, 128, 64, 255 },
+        { 255, 255, 255, 128 },
+    };
+    SDL_SurfaceBlitStats stats;
+    SDL_Surface *src, *actual, *expected;
+    int i, y, wrong = 0;
+    bool result;
+
+    src = SDLTest_ImageFace();
+    actual = SDL_CreateSurface(src ? src->w : 1, src ? src->h : 1, SDL_PIXELFORMAT_XRGB8888);
+    expected = SDL_CreateSurface(src ? src->w : 1, src ? src->h : 1, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(src && actual && expected, "Verify surfaces were created");
+    if (!src || !actual || !expected) {
+        goto done;
+    }
+
+    result = SDL_GetSurfaceBlitStats(src, &stats);
+    SDLTest_AssertCheck(result && stats.cache_hits == 0 && stats.cache_misses == 0, "Verify a new surface has no blit statistics");
+
+    /* Switching between a few modulation states should only choose each blitter once */
+    for (i = 0; i < 12; i++) {
+        const Uint8 *mod = mods[i % SDL_arraysize(mods)];
+        SDL_Surface *fresh = SDLTest_ImageFace();
+
+        SDL_SetSurfaceColorMod(src, mod[0], mod[1], mod[2]);
+        SDL_SetSurfaceAlphaMod(src, mod[3]);
+        SDL_BlitSurface(src, NULL, actual, NULL);
+
+        /* A surface that hasn't blitted before picks its blitter from scratch */
+        SDLTest_AssertCheck(fresh != NULL, "Verify SDLTest_ImageFace() result");
+        if (fresh) {
+            SDL_SetSurfaceColorMod(fresh, mod[0], mod[1], mod[2]);
+            SDL_SetSurfaceAlphaMod(fresh, mod[3]);
+            SDL_BlitSurface(fresh, NULL, expected, NULL);
+            SDL_DestroySurface(fresh);
+        }
+        for (y = 0; y < actual->h; y++) {
+            if (SDL_memcmp((Uint8 *)actual->pixels + y * actual->pitch, (Uint8 *)expected->pixels + y * expected->pitch, actual->w * 4) != 0) {
+                wrong++;
+            }
+        }
+    }
+    SDLTest_AssertCheck(wrong == 0, "Verify blits with remembered blitters match, %d row(s) differ", wrong);
+
+    result = SDL_GetSurfaceBlitStats(src, &stats);
+    SDLTest_AssertCheck(result, "SDL_GetSurfaceBlitStats()");
+    SDLTest_AssertCheck(stats.cache_misses == SDL_arraysize(mods), "Verify blitters were chosen %d times, got %" SDL_PRIu64, (int)SDL_arraysize(mods), stats.cache_misses);
+    SDLTest_AssertCheck(stats.cache_hits == 12 - SDL_arraysize(mods), "Verify blitters were reused %d times, got %" SDL_PRIu64, (int)(12 - SDL_arraysize(mods)), stats.cache_hits);
+
+    /* A different destination format needs a different blitter */
+    SDL_DestroySurface(expected);
+    expected = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_RGB565);
+    SDL_BlitSurface(src, NULL, expected, NULL);
+    SDL_GetSurfaceBlitStats(src, &stats);
+    SDLTest_AssertCheck(stats.cache_misses == SDL_arraysize(mods) + 1, "Verify a new destination format chooses a blitter");
+
+    result = SDL_GetSurfaceBlitStats(NULL, &stats);
+    SDLTest_AssertCheck(!result, "Verify SDL_GetSurfaceBlitStats(NULL) fails");
+
+done:
+    SDL_DestroySurface(src);
+    SDL_DestroySurface(actual);
+    SDL_DestroySurface(expected);
+
+    return TEST_COMPLETED;
+}
+
+
+/* The operations that can be split across threads, each writing a new surface */
+static const char *threaded_operation_names[] = {
+    "blended blit", "converting blit", "scaled blit", "linear scaled blit", "colorspace conversion",
+    "fill", "nearest stretch", "linear stretch", "overlapping blit"
+};
+
+static SDL_Surface *run_threaded_operation(int operation, SDL_Surface *src)
+{
+    SDL_Surface *dst = NULL;
+    SDL_Rect rect;
+
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+    SDL_SetSurfaceAlphaMod(src, 255);
+
+    switch (operation) {
+    case 0:
+        dst = SDL_CreateSurface(293, 277, SDL_PIXELFORMAT_XRGB8888);
+        if (dst) {
+            SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 30, 60, 90));
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+            SDL_SetSurfaceColorMod(src, 250, 200, 150);
+            rect.x = -7;
+            rect.y = 5;
+            SDL_BlitSurface(src, NULL, dst, &rect);
+        }
+        break;
+    case 1:
+        dst = SDL_CreateSurface(293, 277, SDL_PIXELFORMAT_RGB565);
+        if (dst) {
+            SDL_BlitSurface(src, NULL, dst, NULL);
+        }
+        break;
+    case 2:
+    case 3:
+        dst = SDL_CreateSurface(293, 277, SDL_PIXELFORMAT_RGB24);
+        if (dst) {
+            SDL_FillSurfaceRect(dst, NULL, SDL_MapSurfaceRGB(dst, 30, 60, 90));
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+            rect.x = 11;
+            rect.y = -13;
+            rect.w = 401;
+            rect.h = 317;
+            SDL_BlitSurfaceScaled(src, NULL, dst, &rect, (operation == 2) ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+        }
+        break;
+    case 4:
+        dst = SDL_CreateSurface(src->w, src->h, SDL_PIXELFORMAT_XRGB2101010);
+        if (dst) {
+            SDL_SetSurfaceColorspace(dst, SDL_COLORSPACE_HDR10);
+            SDL_ConvertPixelsAndColorspace(src->w, src->h, src->format, SDL_COLORSPACE_SRGB, 0, src->pixels, src->pitch,
+                                           dst->format, SDL_COLORSPACE_HDR10, 0, dst->pixels, dst->pitch);
+        }
+        break;
+    case 5:
+        dst = SDL_CreateSurface(293, 277, SDL_PIXELFORMAT_ARGB8888);
+        if (dst) {
+            SDL_Rect rects[3] = { { 0, 0, 293, 277 }, { 17, 3, 250, 260 }, { 100, -10, 400, 50 } };
+            SDL_FillSurfaceRects(dst, &rects[0], 1, SDL_MapSurfaceRGBA(dst, 30, 60, 90, 120));
+            SDL_FillSurfaceRects(dst, &rects[1], 2, SDL_MapSurfaceRGBA(dst, 200, 100, 50, 255));
+        }
+        break;
+    case 6:
+    case 7:
+        dst = SDL_CreateSurface(293, 277, src->format);
+        if (dst) {
+            rect.x = 3;
+            rect.y = 9;
+            rect.w = 270;
+            rect.h = 251;
+            SDL_StretchSurface(src, NULL, dst, &rect, (operation == 6) ? SDL_SCALEMODE_NEAREST : SDL_SCALEMODE_LINEAR);
+        }
+        break;
+    case 8:
+        dst = SDL_DuplicateSurface(src);
+        if (dst) {
+            SDL_Rect srcrect = { 0, 0, 250, 180 };
+            rect.x = 5;
+            rect.y = 19;
+            SDL_BlitSurface(dst, &srcrect, dst, &rect);
+        }
+        break;
+    default:
+        break;
+    }
+    return dst;
+}
+
+static int SDLCALL surface_testThreadedOperations(void *arg)
+{
+    SDL_Surface *src;
+    int operation, x, y;
+
+    /* Colors that change from pixel to pixel, so every band's pixels are different */
+    src = SDL_CreateSurface(311, 203, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src != NULL, "SDL_CreateSurface()");
+    if (!src) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < src->h; y++) {
+        for (x = 0; x < src->w; x++) {
+            SDL_WriteSurfacePixel(src, x, y, (Uint8)(x * 7 + y), (Uint8)(y * 3), (Uint8)(x ^ y), (Uint8)(x + y * 5));
+        }
+    }
+
+    for (operation = 0; operation < SDL_arraysize(threaded_operation_names); operation++) {
+        SDL_Surface *expected, *actual;
+        int wrong = 0;
+
+        SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+        expected = run_threaded_operation(operation, src);
+
+        SDL_SetHint(SDL_HINT_SURFACE_THREADS, "4");
+        SDL_SetHint(SDL_HINT_SURFACE_THREADS_MIN_PIXELS, "1");
+        actual = run_threaded_operation(operation, src);
+        SDL_ResetHint(SDL_HINT_SURFACE_THREADS_MIN_PIXELS);
+
+        SDLTest_AssertCheck(expected && actual, "Run %s", threaded_operation_names[operation]);
+        if (expected && actual) {
+            wrong = compare_surface_rows(expected, actual, 0);
+        }
+        SDLTest_AssertCheck(wrong == 0, "Verify %s on several threads matches one thread, %d row(s) differ", threaded_operation_names[operation], wrong);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+    SDL_DestroySurface(src);
+
+    return TEST_COMPLETED;
+}
+
+/* Fill a surface with runs of color keyed pixels of many lengths, the key being every byte set to 0x5a */
+static void fill_rle_colorkey_source(SDL_Surface *surface, Uint32 *key)
+{
+    const SDL_PixelFormatDetails *fmt = SDL_GetPixelFormatDetails(surface->format);
+    const int bpp = SDL_BYTESPERPIXEL(surface->format);
+    Uint64 seed = 0x41e;
+    int x, y;
+
+    *key = 0x5a5a5a5a >> (32 - bpp * 8);
+    for (y = 0; y < surface->h; y++) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w; x++) {
+            const bool keyed = ((x * (y % 5 + 1) / 7 + y) % 3) == 0;
+            /* Unkeyed pixels leave the padding bits clear, which other blits don't copy */
+            Uint32 pixel = SDL_rand_bits_r(&seed) & (fmt->Rmask | fmt->Gmask | fmt->Bmask | fmt->Amask);
+            if (keyed) {
+                pixel = (*key & ~fmt->Amask) | (pixel & fmt->Amask);
+            }
+            switch (bpp) {
+            case 1:
+                row[x] = (Uint8)pixel;
+                break;
+            case 2:
+                ((Uint16 *)row)[x] = (Uint16)pixel;
+                break;
+            case 3:
+                row[x * 3 + 0] = keyed ? 0x5a : (Uint8)pixel;
+                row[x * 3 + 1] = keyed ? 0x5a : (Uint8)(pixel >> 8);
+                row[x * 3 + 2] = keyed ? 0x5a : (Uint8)(pixel >> 16);
+                break;
+            default:
+                ((Uint32 *)row)[x] = pixel;
+                break;
+            }
+        }
+    }
+}
+
+/* Destination positions for the RLE tests, clipped at each edge or not at all */
+static const SDL_Point rle_positions[] = { { 20, 10 }, { -13, -5 }, { 150, 30 } };
+
+static int SDLCALL surface_testRLEColorkey(void *arg)
+{
+    const SDL_PixelFormat formats[] = {
+        SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB4444,
+        SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888
+    };
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        SDL_Surface *plain = SDL_CreateSurface(157, 61, formats[i]);
+        SDL_Surface *rle = SDL_CreateSurface(157, 61, formats[i]);
+        SDL_Surface *expected = SDL_CreateSurface(200, 80, formats[i]);
+        SDL_Surface *actual = SDL_CreateSurface(200, 80, formats[i]);
+        Uint32 key;
+
+        SDLTest_AssertCheck(plain && rle && expected && actual, "Create %s surfaces", SDL_GetPixelFormatName(formats[i]));
+        if (plain && rle && expected && actual) {
+            fill_rle_colorkey_source(plain, &key);
+            fill_rle_colorkey_source(rle, &key);
+            SDL_SetSurfaceBlendMode(plain, SDL_BLENDMODE_NONE);
+            SDL_SetSurfaceBlendMode(rle, SDL_BLENDMODE_NONE);
+            SDL_SetSurfaceColorKey(plain, true, key);
+            SDL_SetSurfaceColorKey(rle, true, key);
+            SDL_SetSurfaceRLE(rle, true);
+
+            for (j = 0; j < SDL_arraysize(rle_positions); j++) {
+                SDL_Rect rect = { rle_positions[j].x, rle_positions[j].y, 0, 0 };
+                int wrong;
+
+                SDL_FillSurfaceRect(expected, NULL, 0x12345678);
+                SDL_FillSurfaceRect(actual, NULL, 0x12345678);
+                SDL_BlitSurface(plain, NULL, expected, &rect);
+                SDL_BlitSurface(rle, NULL, actual, &rect);
+                SDLTest_AssertCheck(rle->pixels == NULL, "Verify the %s surface was RLE encoded", SDL_GetPixelFormatName(formats[i]));
+                wrong = compare_surface_rows(expected, actual, 0);
+                SDLTest_AssertCheck(wrong == 0, "Verify RLE color key blit of %s at %d,%d matches, %d row(s) differ",
+                                    SDL_GetPixelFormatName(formats[i]), rect.x, rect.y, wrong);
+            }
+        }
+        SDL_DestroySurface(plain);
+        SDL_DestroySurface(rle);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+    return TEST_COMPLETED;
+}
+
+/* The blend used by RLE blits into 0x00rrggbb pixels */
+static Uint32 rle_blend_888(Uint32 s, Uint32 d, Uint32 alpha)
+{
+    Uint32 s1 = s & 0xff00ff;
+    Uint32 d1 = d & 0xff00ff;
+    d1 = (d1 + ((s1 - d1) * alpha >> 8)) & 0xff00ff;
+    s &= 0xff00;
+    d &= 0xff00;
+    d = (d + ((s - d) * alpha >> 8)) & 0xff00;
+    return d1 | d;
+}
+
+/* The blend used by RLE blits into 565 and 555 pixels, with 5 bits of alpha */
+static Uint16 rle_blend_16(Uint32 s, Uint32 d, Uint32 alpha, Uint32 mask)
+{
+    s = (s | s << 16) & mask;
+    d = (d | d << 16) & mask;
+    d += (s - d) * alpha >> 5;
+    d &= mask;
+    return (Uint16)(d | d >> 16);
+}
+
+static Uint32 rle_reference_pixel(SDL_Surface *src, int x, int y, SDL_Surface *dst, Uint32 d)
+{
+    const SDL_PixelFormatDetails *fmt = SDL_GetPixelFormatDetails(dst->format);
+    const Uint32 mask = (fmt->Gmask == 0x07e0) ? 0x07e0f81f : 0x03e07c1f;
+    Uint8 r, g, b, a;
+    Uint32 s;
+
+    SDL_ReadSurfacePixel(src, x, y, &r, &g, &b, &a);
+    s = SDL_MapSurfaceRGB(dst, r, g, b);
+    if (SDL_ISPIXELFORMAT_ALPHA(src->format)) {
+        /* Per-pixel alpha, opaque pixels are copied and translucent ones get an opaque top byte */
+        if (a == 0) {
+            return d;
+        } else if (fmt->bytes_per_pixel == 4) {
+            return (a == 255) ? (s | 0xff000000) : (rle_blend_888(s, d, a) | 0xff000000);
+        } else {
+            return (a == 255) ? s : rle_blend_16(s, d, a >> 3, mask);
+        }
+    } else {
+        /* Per-surface alpha, the color key is 0 */
+        if (r == 0 && g == 0 && b == 0) {
+            return d;
+        }
+        SDL_GetSurfaceAlphaMod(src, &a);
+        if (fmt->bytes_per_pixel == 4) {
+            return rle_blend_888(s, d, a);
+        } else {
+            return rle_blend_16(s, d, a >> 3, mask);
+        }
+    }
+}
+
+static int SDLCALL surface_testRLEAlpha(void *arg)
+{
+    const struct
+    {
+        SDL_PixelFormat src_format;
+        SDL_PixelFormat dst_format;
+    } combinations[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB1555 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_XRGB1555, SDL_PIXELFORMAT_XRGB1555 }
+    };
+    Uint64 seed = 0xa1fa;
+    int i, j, x, y;
+
+    for (i = 0; i < SDL_arraysize(combinations); i++) {
+        SDL_Surface *src = SDL_CreateSurface(157, 61, combinations[i].src_format);
+        SDL_Surface *expected = SDL_CreateSurface(200, 80, combinations[i].dst_format);
+        SDL_Surface *actual = SDL_CreateSurface(200, 80, combinations[i].dst_format);
+        SDL_Surface *reference = NULL;
+        const char *src_name = SDL_GetPixelFormatName(combinations[i].src_format);
+        const char *dst_name = SDL_GetPixelFormatName(combinations[i].dst_format);
+
+        SDLTest_AssertCheck(src && expected && actual, "Create %s and %s surfaces", src_name, dst_name);
+        if (!src || !expected || !actual) {
+            goto next;
+        }
+
+        /* Runs of transparent, translucent and opaque pixels of many lengths */
+        for (y = 0; y < src->h; y++) {
+            for (x = 0; x < src->w; x++) {
+                const Uint32 bits = SDL_rand_bits_r(&seed);
+                const int kind = (x * (y % 5 + 1) / 7 + y) % 3;
+                Uint8 a = (kind == 0) ? 0 : (kind == 1) ? (Uint8)(1 + (bits >> 24) % 254) : 255;
+                if (!SDL_ISPIXELFORMAT_ALPHA(src->format) && kind == 0) {
+                    SDL_WriteSurfacePixel(src, x, y, 0, 0, 0, 255);
+                } else {
+                    SDL_WriteSurfacePixel(src, x, y, (Uint8)bits, (Uint8)(bits >> 8), (Uint8)(bits >> 16) | 1, a);
+                }
+            }
+        }
+        if (SDL_ISPIXELFORMAT_ALPHA(src->format)) {
+            SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        } else {
+            SDL_SetSurfaceColorKey(src, true, 0);
+            SDL_SetSurfaceAlphaMod(src, 100);
+        }
+        reference = SDL_DuplicateSurface(src);
+        SDL_SetSurfaceRLE(src, true);
+
+        for (j = 0; j < SDL_arraysize(rle_positions); j++) {
+            const SDL_Rect rect = { rle_positions[j].x, rle_positions[j].y, src->w, src->h };
+            SDL_Rect blit_rect = rect;
+            int wrong;
+
+            for (y = 0; y < expected->h; y++) {
+                for (x = 0; x < expected->w; x++) {
+                    SDL_WriteSurfacePixel(expected, x, y, (Uint8)(x * 5), (Uint8)(y * 3), (Uint8)(x ^ y), 255);
+                }
+            }
+            SDL_BlitSurface(expected, NULL, actual, NULL);
+            SDL_BlitSurface(src, NULL, actual, &blit_rect);
+            SDLTest_AssertCheck(src->pixels == NULL, "Verify the %s surface was RLE encoded", src_name);
+
+            for (y = SDL_max(rect.y, 0); y < SDL_min(rect.y + rect.h, expected->h); y++) {
+                Uint8 *row = (Uint8 *)expected->pixels + y * expected->pitch;
+                for (x = SDL_max(rect.x, 0); x < SDL_min(rect.x + rect.w, expected->w); x++) {
+                    if (SDL_BYTESPERPIXEL(expected->format) == 4) {
+                        Uint32 *pixel = (Uint32 *)row + x;
+                        *pixel = rle_reference_pixel(reference, x - rect.x, y - rect.y, expected, *pixel);
+                    } else {
+                        Uint16 *pixel = (Uint16 *)row + x;
+                        *pixel = (Uint16)rle_reference_pixel(reference, x - rect.x, y - rect.y, expected, *pixel);
+                    }
+                }
+            }
+            wrong = compare_surface_rows(expected, actual, 0);
+            SDLTest_AssertCheck(wrong == 0, "Verify RLE alpha blit of %s into %s at %d,%d matches, %d row(s) differ",
+                                src_name, dst_name, rect.x, rect.y, wrong);
+        }
+next:
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(reference);
+        SDL_DestroySurface(expected);
+        SDL_DestroySurface(actual);
+    }
+    return TEST_COMPLETED;
+}
 
 /* ================= Test References ================== */
 
@@ -1694,6 +2543,38 @@ static const SDLTest_TestCaseReference surfaceTestScale = {
     surface_testScale, "surface_testScale", "Test scaling operations.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitMapCache = {
+    surface_testBlitMapCache, "surface_testBlitMapCache", "Test surfaces reuse blitters chosen for earlier states.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitScaledClipped = {
+    surface_testBlitScaledClipped, "surface_testBlitScaledClipped", "Test clipped scaled blits sample the same pixels as unclipped ones.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitGenerated = {
+    surface_testBlitGenerated, "surface_testBlitGenerated", "Test generated blitters against the general blitter.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestColorspaceRoundTrip = {
+    surface_testColorspaceRoundTrip, "surface_testColorspaceRoundTrip", "Test colors survive a round trip through linear colorspaces.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestTransferTables = {
+    surface_testTransferTables, "surface_testTransferTables", "Test large color conversions match small ones, which don't use the transfer function tables.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestThreadedOperations = {
+    surface_testThreadedOperations, "surface_testThreadedOperations", "Test surface operations split across threads match running them on one thread.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRLEColorkey = {
+    surface_testRLEColorkey, "surface_testRLEColorkey", "Test RLE encoded color key blits match unencoded ones.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestRLEAlpha = {
+    surface_testRLEAlpha, "surface_testRLEAlpha", "Test RLE encoded alpha blits match the blending they're defined by.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestInvalidFormat,
@@ -1722,6 +2603,14 @@ static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTestClearSurface,
     &surfaceTestPremultiplyAlpha,
     &surfaceTestScale,
+    &surfaceTestBlitScaledClipped,
+    &surfaceTestBlitMapCache,
+    &surfaceTestBlitGenerated,
+    &surfaceTestColorspaceRoundTrip,
+    &surfaceTestTransferTables,
+    &surfaceTestThreadedOperations,
+    &surfaceTestRLEColorkey,
+    &surfaceTestRLEAlpha,
     NULL
 };
 
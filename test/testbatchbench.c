@@ -0,0 +1,157 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how much unordered batching saves when sprites from several textures are interleaved.
+   Every frame draws the same sprites, cycling through the textures from one sprite to the next, the way
+   a scene sorted by depth rather than by texture would.
+
+   The scene is drawn with SDL_RENDER_BATCH_ORDERED and SDL_RENDER_BATCH_UNORDERED, and the commands
+   submitted and draws merged per frame are printed with the timing. Use --renderer to pick the renderer. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAX_TEXTURES 16
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--sprites N]", "[--textures 1-16]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static SDL_Texture *create_texture(SDL_Renderer *renderer, int index)
+{
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Texture *texture;
+
+    if (!surface) {
+        return NULL;
+    }
+    SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGB(surface, (Uint8)(index * 53), (Uint8)(255 - index * 31), (Uint8)(index * 97)));
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+static void bench(SDL_Renderer *renderer, SDL_Texture **textures, int num_textures,
+                  const SDL_FRect *positions, int num_sprites, SDL_RenderBatchMode mode, int frames)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    Sint64 commands = 0, merged = 0;
+    Uint64 start, elapsed;
+    int i, j;
+
+    SDL_SetRenderBatchMode(renderer, mode);
+
+    start = SDL_GetTicksNS();
+    for (j = 0; j < frames; j++) {
+        SDL_SetRenderDrawColor(renderer, 0x20, 0x30, 0x40, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+        for (i = 0; i < num_sprites; i++) {
+            SDL_RenderTexture(renderer, textures[i % num_textures], NULL, &positions[i]);
+        }
+        SDL_RenderPresent(renderer);
+        commands += SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, 0);
+        merged += SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_MERGED_DRAWS_NUMBER, 0);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-9s: %9.3f ms per frame, %8.1f commands per frame, %8.1f draws merged per frame",
+            (mode == SDL_RENDER_BATCH_UNORDERED) ? "unordered" : "ordered",
+            (((double)elapsed) / 1000000.0) / frames, ((double)commands) / frames, ((double)merged) / frames);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Renderer *renderer;
+    SDL_Texture *textures[MAX_TEXTURES];
+    SDL_FRect *positions = NULL;
+    int num_sprites = 10000;
+    int num_textures = 4;
+    int frames = 100;
+    Uint64 seed = 0x5D1;
+    int w, h;
+    int ret = 0;
+    int i;
+
+    SDL_zeroa(textures);
+
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--sprites") == 0 && argv[i + 1]) {
+                num_sprites = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--textures") == 0 && argv[i + 1]) {
+                num_textures = SDL_clamp(SDL_atoi(argv[i + 1]), 1, MAX_TEXTURES);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDLTest_CommonInit(state)) {
+        ret = 2;
+        goto end;
+    }
+    renderer = state->renderers[0];
+    SDL_GetCurrentRenderOutputSize(renderer, &w, &h);
+
+    positions = (SDL_FRect *)SDL_malloc(num_sprites * sizeof(*positions));
+    if (!positions) {
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < num_sprites; i++) {
+        positions[i].x = (float)SDL_rand_r(&seed, w) - 16.0f;
+        positions[i].y = (float)SDL_rand_r(&seed, h) - 16.0f;
+        positions[i].w = 32.0f;
+        positions[i].h = 32.0f;
+    }
+    for (i = 0; i < num_textures; i++) {
+        textures[i] = create_texture(renderer, i);
+        if (!textures[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create texture: %s", SDL_GetError());
+            ret = 3;
+            goto end;
+        }
+    }
+
+    SDL_Log("Drawing %d sprites from %d interleaved texture(s) with the %s renderer, %d frame(s)",
+            num_sprites, num_textures, SDL_GetRendererName(renderer), frames);
+
+    bench(renderer, textures, num_textures, positions, num_sprites, SDL_RENDER_BATCH_ORDERED, frames);
+    bench(renderer, textures, num_textures, positions, num_sprites, SDL_RENDER_BATCH_UNORDERED, frames);
+
+end:
+    for (i = 0; i < MAX_TEXTURES; i++) {
+        SDL_DestroyTexture(textures[i]);
+    }
+    SDL_free(positions);
+    SDLTest_CommonQuit(state);
+    return ret;
+}
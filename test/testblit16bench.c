@@ -0,0 +1,305 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how fast 16-bit sprites with pixel alpha are blended into 16-bit surfaces.
+   Every frame blits a few thousand ARGB4444 or ARGB1555 sprites with soft edges into an RGB565
+   or same format target, the way a game that keeps all of its graphics in 16 bits would.
+
+   Each combination is also timed with the sprite in the alpha-last format with the same bits
+   (RGBA4444 or RGBA5551), which is blended by the general per-pixel alpha blitter, and with a
+   color key. The time per frame is printed for each.
+
+   With --rle, RLE accelerated sprites are measured instead. Sprites are either color keyed, color
+   keyed with a surface alpha, or have pixel alpha with soft edges, and are blitted into a target
+   of the format they're encoded for. The encoding time is measured by blitting many fresh RLE
+   sprites once each into a 1x1 target, which encodes each of them and then blits a single pixel.
+   The blitting time is measured with and without RLE acceleration. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    SPRITE_PIXEL_ALPHA,
+    SPRITE_PIXEL_ALPHA_COLORKEY,
+    SPRITE_COLORKEY,
+    SPRITE_COLORKEY_ALPHA
+} SpriteKind;
+
+static const char *kind_names[] = {
+    "pixel alpha", "pixel alpha+keyed", "keyed", "keyed+alpha"
+};
+
+static const struct
+{
+    SDL_PixelFormat sprite_format;
+    SDL_PixelFormat general_format;
+    SDL_PixelFormat target_format;
+} combinations[] = {
+    { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_RGB565 },
+    { SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_RGB565 },
+    { SDL_PIXELFORMAT_ARGB4444, SDL_PIXELFORMAT_RGBA4444, SDL_PIXELFORMAT_ARGB4444 },
+    { SDL_PIXELFORMAT_ARGB1555, SDL_PIXELFORMAT_RGBA5551, SDL_PIXELFORMAT_ARGB1555 }
+};
+
+static const struct
+{
+    SpriteKind kind;
+    SDL_PixelFormat sprite_format;
+    SDL_PixelFormat target_format;
+} rle_combinations[] = {
+    { SPRITE_COLORKEY, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565 },
+    { SPRITE_COLORKEY, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888 },
+    { SPRITE_COLORKEY_ALPHA, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565 },
+    { SPRITE_COLORKEY_ALPHA, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888 },
+    { SPRITE_PIXEL_ALPHA, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565 },
+    { SPRITE_PIXEL_ALPHA, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888 }
+};
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--target WxH]", "[--sprites N]", "[--sprite-size N]", "[--frames N]", "[--rle]", "[--encodes N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static SDL_Surface *create_sprite(int size, SpriteKind kind, SDL_PixelFormat format, bool rle)
+{
+    SDL_Surface *sprite = SDL_CreateSurface(size, size, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Surface *converted;
+    int x, y;
+
+    if (!sprite) {
+        return NULL;
+    }
+    for (y = 0; y < size; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)sprite->pixels + y * sprite->pitch);
+        for (x = 0; x < size; x++) {
+            const int dx = 2 * x - size, dy = 2 * y - size;
+            const int d = dx * dx + dy * dy;
+            Uint32 alpha = 0xFF;
+            if (d >= size * size) {
+                alpha = 0x00;
+            } else if (d >= size * size / 2) {
+                alpha = (Uint32)(0xFF * 2 * (size * size - d) / (size * size));
+            }
+            if (kind == SPRITE_PIXEL_ALPHA || kind == SPRITE_PIXEL_ALPHA_COLORKEY) {
+                row[x] = (alpha << 24) | ((Uint32)(x * 255 / size) << 16) | ((Uint32)(y * 255 / size) << 8) | 0x80;
+            } else if (alpha == 0x00) {
+                row[x] = 0xFF000000;
+            } else {
+                row[x] = 0xFF000000 | ((Uint32)(x * 255 / size) << 16) | ((Uint32)(y * 255 / size) << 8) | 0x80;
+            }
+        }
+    }
+    converted = SDL_ConvertSurface(sprite, format);
+    SDL_DestroySurface(sprite);
+    if (!converted) {
+        return NULL;
+    }
+    switch (kind) {
+    case SPRITE_PIXEL_ALPHA:
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_BLEND);
+        break;
+    case SPRITE_PIXEL_ALPHA_COLORKEY:
+        SDL_SetSurfaceColorKey(converted, true, SDL_MapSurfaceRGB(converted, 0, 0, 0x80));
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_BLEND);
+        break;
+    case SPRITE_COLORKEY:
+        SDL_SetSurfaceColorKey(converted, true, SDL_MapSurfaceRGB(converted, 0, 0, 0));
+        break;
+    case SPRITE_COLORKEY_ALPHA:
+        SDL_SetSurfaceColorKey(converted, true, SDL_MapSurfaceRGB(converted, 0, 0, 0));
+        SDL_SetSurfaceAlphaMod(converted, 100);
+        break;
+    }
+    SDL_SetSurfaceRLE(converted, rle);
+    return converted;
+}
+
+/* Returns the time in milliseconds to encode one RLE sprite */
+static double bench_encode(SpriteKind kind, SDL_PixelFormat sprite_format, SDL_PixelFormat target_format, int sprite_size, int encodes)
+{
+    SDL_Surface *target = SDL_CreateSurface(1, 1, target_format);
+    SDL_Surface **sprites = (SDL_Surface **)SDL_calloc(encodes, sizeof(*sprites));
+    Uint64 start, elapsed = 0;
+    int i;
+
+    if (!target || !sprites) {
+        goto done;
+    }
+    for (i = 0; i < encodes; i++) {
+        sprites[i] = create_sprite(sprite_size, kind, sprite_format, true);
+        if (!sprites[i]) {
+            SDL_Log("Failed to set up: %s", SDL_GetError());
+            goto done;
+        }
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < encodes; i++) {
+        SDL_BlitSurface(sprites[i], NULL, target, NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+done:
+    if (sprites) {
+        for (i = 0; i < encodes; i++) {
+            SDL_DestroySurface(sprites[i]);
+        }
+        SDL_free(sprites);
+    }
+    SDL_DestroySurface(target);
+    return (((double)elapsed) / 1000000.0) / encodes;
+}
+
+/* Returns the time in milliseconds to blit one frame of sprites */
+static double bench_blit(SpriteKind kind, SDL_PixelFormat sprite_format, SDL_PixelFormat target_format, bool rle, int w, int h, const SDL_Point *positions, int num_sprites, int sprite_size, int frames)
+{
+    SDL_Surface *target = SDL_CreateSurface(w, h, target_format);
+    SDL_Surface *sprite = create_sprite(sprite_size, kind, sprite_format, rle);
+    Uint64 start, elapsed = 0;
+    int i, j;
+
+    if (!target || !sprite) {
+        SDL_Log("Failed to set up: %s", SDL_GetError());
+        goto done;
+    }
+
+    /* The first blit encodes an RLE sprite */
+    SDL_BlitSurface(sprite, NULL, target, NULL);
+
+    start = SDL_GetTicksNS();
+    for (j = 0; j < frames; j++) {
+        SDL_FillSurfaceRect(target, NULL, SDL_MapSurfaceRGB(target, 0x20, 0x30, 0x40));
+        for (i = 0; i < num_sprites; i++) {
+            SDL_Rect dst = { positions[i].x, positions[i].y, 0, 0 };
+            SDL_BlitSurface(sprite, NULL, target, &dst);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+done:
+    SDL_DestroySurface(sprite);
+    SDL_DestroySurface(target);
+    return (((double)elapsed) / 1000000.0) / frames;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Point *positions = NULL;
+    int w = 640, h = 480;
+    int num_sprites = 2000;
+    int sprite_size = 32;
+    int frames = 50;
+    int encodes = 500;
+    bool rle = false;
+    Uint64 seed = 0x5D1;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--target") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--sprites") == 0 && argv[i + 1]) {
+                num_sprites = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--sprite-size") == 0 && argv[i + 1]) {
+                sprite_size = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--rle") == 0) {
+                rle = true;
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--encodes") == 0 && argv[i + 1]) {
+                encodes = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    positions = (SDL_Point *)SDL_malloc(num_sprites * sizeof(*positions));
+    if (!positions) {
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < num_sprites; i++) {
+        positions[i].x = SDL_rand_r(&seed, w) - sprite_size / 2;
+        positions[i].y = SDL_rand_r(&seed, h) - sprite_size / 2;
+    }
+
+    if (rle) {
+        SDL_Log("Encoding %d sprites of %dx%d pixels, and blitting %d of them per frame into a %dx%d surface, %d frame(s)",
+                encodes, sprite_size, sprite_size, num_sprites, w, h, frames);
+
+        for (i = 0; i < SDL_arraysize(rle_combinations); i++) {
+            const SpriteKind kind = rle_combinations[i].kind;
+            const SDL_PixelFormat sprite_format = rle_combinations[i].sprite_format;
+            const SDL_PixelFormat target_format = rle_combinations[i].target_format;
+            const double encode = bench_encode(kind, sprite_format, target_format, sprite_size, encodes);
+            const double plain = bench_blit(kind, sprite_format, target_format, false, w, h, positions, num_sprites, sprite_size, frames);
+            const double accelerated = bench_blit(kind, sprite_format, target_format, true, w, h, positions, num_sprites, sprite_size, frames);
+
+            SDL_Log("%-24s -> %-24s %-11s: encode %7.4f ms, blit %8.3f ms per frame (%8.3f ms without RLE)",
+                    SDL_GetPixelFormatName(sprite_format), SDL_GetPixelFormatName(target_format),
+                    kind_names[kind], encode, accelerated, plain);
+        }
+    } else {
+        SDL_Log("Blending %d sprites of %dx%d pixels per frame into a %dx%d surface, %d frame(s)",
+                num_sprites, sprite_size, sprite_size, w, h, frames);
+
+        for (i = 0; i < SDL_arraysize(combinations); i++) {
+            const SDL_PixelFormat target_format = combinations[i].target_format;
+            const SDL_PixelFormat formats[3] = { combinations[i].general_format, combinations[i].sprite_format, combinations[i].sprite_format };
+            const SpriteKind kinds[3] = { SPRITE_PIXEL_ALPHA, SPRITE_PIXEL_ALPHA, SPRITE_PIXEL_ALPHA_COLORKEY };
+            int j;
+
+            for (j = 0; j < SDL_arraysize(formats); j++) {
+                const double blit = bench_blit(kinds[j], formats[j], target_format, false, w, h, positions, num_sprites, sprite_size, frames);
+
+                SDL_Log("%-24s -> %-24s%s: %9.3f ms per frame",
+                        SDL_GetPixelFormatName(formats[j]), SDL_GetPixelFormatName(target_format),
+                        (kinds[j] == SPRITE_PIXEL_ALPHA_COLORKEY) ? " keyed" : "      ", blit);
+            }
+        }
+    }
+
+end:
+    SDL_free(positions);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,174 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how fast SDL_RenderDebugText() draws an overlay of labels and values.
+   Every frame draws a column of lines, the way a debug overlay full of statistics would.
+
+   The overlay is drawn one character per call, the way the text used to be drawn one glyph at a time,
+   then with text that changes every frame, text that stays the same, and prepared SDL_DebugTextRun
+   objects. The time and commands submitted per frame are printed for each. Use --renderer to pick
+   the renderer. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define LINE_LENGTH 48
+
+typedef enum
+{
+    DRAW_PER_CHARACTER,
+    DRAW_CHANGING,
+    DRAW_UNCHANGED,
+    DRAW_RUNS
+} DrawMethod;
+
+static const char *method_names[] = { "per character", "changing", "unchanged", "text runs" };
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--lines N]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static void format_line(char *text, int line, int frame)
+{
+    (void)SDL_snprintf(text, LINE_LENGTH, "stat %2d: %8d samples, %6.2f ms", line, frame * 31 + line, (frame % 1000) / 100.0f);
+}
+
+static void bench(SDL_Renderer *renderer, DrawMethod method, int num_lines, int frames)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    SDL_DebugTextRun **runs = NULL;
+    char text[LINE_LENGTH];
+    Sint64 commands = 0;
+    Uint64 start, elapsed;
+    int i, j;
+
+    if (method == DRAW_RUNS) {
+        runs = (SDL_DebugTextRun **)SDL_calloc(num_lines, sizeof(*runs));
+        if (!runs) {
+            return;
+        }
+        for (i = 0; i < num_lines; i++) {
+            format_line(text, i, 0);
+            runs[i] = SDL_CreateDebugTextRun(renderer, text);
+            if (!runs[i]) {
+                SDL_Log("Failed to create text run: %s", SDL_GetError());
+                goto done;
+            }
+        }
+    }
+
+    start = SDL_GetTicksNS();
+    for (j = 0; j < frames; j++) {
+        SDL_SetRenderDrawColor(renderer, 0x20, 0x30, 0x40, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE);
+        for (i = 0; i < num_lines; i++) {
+            const float x = 8.0f + (i / 64) * (LINE_LENGTH * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+            const float y = 8.0f + (i % 64) * (SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 2);
+
+            switch (method) {
+            case DRAW_PER_CHARACTER:
+            {
+                char ch[2] = { 0, 0 };
+                int k;
+
+                format_line(text, i, j);
+                for (k = 0; text[k]; k++) {
+                    ch[0] = text[k];
+                    SDL_RenderDebugText(renderer, x + k * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE, y, ch);
+                }
+                break;
+            }
+            case DRAW_CHANGING:
+                format_line(text, i, j);
+                SDL_RenderDebugText(renderer, x, y, text);
+                break;
+            case DRAW_UNCHANGED:
+                format_line(text, i, 0);
+                SDL_RenderDebugText(renderer, x, y, text);
+                break;
+            case DRAW_RUNS:
+                SDL_RenderDebugTextRun(renderer, runs[i], x, y);
+                break;
+            }
+        }
+        SDL_RenderPresent(renderer);
+        commands += SDL_GetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, 0);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-13s: %9.3f ms per frame, %8.1f commands per frame",
+            method_names[method], (((double)elapsed) / 1000000.0) / frames, ((double)commands) / frames);
+
+done:
+    if (runs) {
+        for (i = 0; i < num_lines; i++) {
+            SDL_DestroyDebugTextRun(runs[i]);
+        }
+        SDL_free(runs);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Renderer *renderer;
+    int num_lines = 24;
+    int frames = 200;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--lines") == 0 && argv[i + 1]) {
+                num_lines = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDLTest_CommonInit(state)) {
+        ret = 2;
+        goto end;
+    }
+    renderer = state->renderers[0];
+
+    SDL_Log("Drawing %d lines of debug text with the %s renderer, %d frame(s)",
+            num_lines, SDL_GetRendererName(renderer), frames);
+
+    bench(renderer, DRAW_PER_CHARACTER, num_lines, frames);
+    bench(renderer, DRAW_CHANGING, num_lines, frames);
+    bench(renderer, DRAW_UNCHANGED, num_lines, frames);
+    bench(renderer, DRAW_RUNS, num_lines, frames);
+
+end:
+    SDLTest_CommonQuit(state);
+    return ret;
+}
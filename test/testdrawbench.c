@@ -0,0 +1,167 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how fast the software renderer draws points, lines and rectangles.
+   Like testdraw, every frame draws random objects, but in a single call per kind of object
+   the way a particle system or a debug overlay would, into a surface of the chosen format.
+
+   The time per frame is printed for each kind of object. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static const struct
+{
+    const char *name;
+    SDL_BlendMode mode;
+} blend_modes[] = {
+    { "none", SDL_BLENDMODE_NONE },
+    { "blend", SDL_BLENDMODE_BLEND },
+    { "add", SDL_BLENDMODE_ADD },
+    { "mod", SDL_BLENDMODE_MOD },
+    { "mul", SDL_BLENDMODE_MUL }
+};
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--target WxH]", "[--format XRGB8888|ARGB8888|RGB565]", "[--blend none|blend|add|mod|mul]", "[--objects N]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static void bench(SDL_Renderer *renderer, const char *what, const SDL_FPoint *points, const SDL_FRect *rects, int num_objects, int frames)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames; i++) {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xC0, 0x40, 0xA0);
+        if (SDL_strcmp(what, "points") == 0) {
+            SDL_RenderPoints(renderer, points, num_objects);
+        } else if (SDL_strcmp(what, "lines") == 0) {
+            SDL_RenderLines(renderer, points, num_objects);
+        } else {
+            SDL_RenderFillRects(renderer, rects, num_objects);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-6s: %9.3f ms per frame, %7.1f ns per object",
+            what, (((double)elapsed) / 1000000.0) / frames, ((double)elapsed) / ((double)frames * num_objects));
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *target = NULL;
+    SDL_Renderer *renderer = NULL;
+    SDL_FPoint *points = NULL;
+    SDL_FRect *rects = NULL;
+    SDL_PixelFormat format = SDL_PIXELFORMAT_XRGB8888;
+    int blend = 1;
+    int w = 1280, h = 720;
+    int num_objects = 100000;
+    int frames = 20;
+    Uint64 seed = 0x5D1;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--target") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--format") == 0 && argv[i + 1]) {
+                if (SDL_strcasecmp(argv[i + 1], "XRGB8888") == 0) {
+                    format = SDL_PIXELFORMAT_XRGB8888;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "ARGB8888") == 0) {
+                    format = SDL_PIXELFORMAT_ARGB8888;
+                    consumed = 2;
+                } else if (SDL_strcasecmp(argv[i + 1], "RGB565") == 0) {
+                    format = SDL_PIXELFORMAT_RGB565;
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--blend") == 0 && argv[i + 1]) {
+                int j;
+                for (j = 0; j < SDL_arraysize(blend_modes); j++) {
+                    if (SDL_strcasecmp(argv[i + 1], blend_modes[j].name) == 0) {
+                        blend = j;
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--objects") == 0 && argv[i + 1]) {
+                num_objects = SDL_max(2, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    target = SDL_CreateSurface(w, h, format);
+    renderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    points = (SDL_FPoint *)SDL_malloc(num_objects * sizeof(*points));
+    rects = (SDL_FRect *)SDL_malloc(num_objects * sizeof(*rects));
+    if (!renderer || !points || !rects) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to set up: %s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < num_objects; i++) {
+        points[i].x = (float)SDL_rand_r(&seed, w);
+        points[i].y = (float)SDL_rand_r(&seed, h);
+        rects[i].x = (float)SDL_rand_r(&seed, w);
+        rects[i].y = (float)SDL_rand_r(&seed, h);
+        rects[i].w = (float)(1 + SDL_rand_r(&seed, 64));
+        rects[i].h = (float)(1 + SDL_rand_r(&seed, 16));
+    }
+    SDL_SetRenderDrawBlendMode(renderer, blend_modes[blend].mode);
+
+    SDL_Log("Drawing %d objects per frame into a %dx%d %s surface with blend mode %s, %d frame(s)",
+            num_objects, w, h, SDL_GetPixelFormatName(format), blend_modes[blend].name, frames);
+
+    bench(renderer, "points", points, rects, num_objects, frames);
+    bench(renderer, "lines", points, rects, num_objects / 10, frames);
+    bench(renderer, "rects", points, rects, num_objects / 10, frames);
+
+end:
+    SDL_free(rects);
+    SDL_free(points);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,276 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how fast the software renderer draws SDL_RenderGeometry() triangles.
+   This draws into a surface with no window, so only the rasterizer is measured.
+
+   Each case draws the same pseudo-random triangles every run, and the CRC of the target
+   is printed with the timing, so two builds can be checked for identical output. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    CASE_SOLID,
+    CASE_GOURAUD,
+    CASE_TEXTURED,
+    CASE_MODULATED,
+    CASE_BLENDED,
+    CASE_WRAPPED,
+    NUM_CASES
+} BenchCase;
+
+static const char *case_names[NUM_CASES] = { "solid", "gouraud", "textured", "modulated", "blended", "wrapped" };
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--target WxH]", "[--format name]", "[--triangles N]", "[--triangle-size N]", "[--frames N]", "[--case solid|gouraud|textured|modulated|blended|wrapped|all]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static SDL_Texture *create_texture(SDL_Renderer *renderer)
+{
+    SDL_Surface *surface = SDL_CreateSurface(256, 256, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Texture *texture;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    for (y = 0; y < surface->h; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; x++) {
+            const Uint32 checker = ((x / 16) ^ (y / 16)) & 1 ? 0xFF : 0x40;
+            row[x] = ((Uint32)(0x80 + (x ^ y) / 2) << 24) | (checker << 16) | ((Uint32)x << 8) | (Uint32)y;
+        }
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+static float random_float(Uint64 *seed, float min, float max)
+{
+    return min + (max - min) * (SDL_rand_r(seed, 0x10000) / 65536.0f);
+}
+
+static void generate_triangles(SDL_Vertex *vertices, int num_triangles, int w, int h, int size, BenchCase which)
+{
+    Uint64 seed = 0x5D1;
+    int i, j;
+
+    for (i = 0; i < num_triangles; i++) {
+        const float cx = random_float(&seed, 0.0f, (float)w);
+        const float cy = random_float(&seed, 0.0f, (float)h);
+        SDL_FColor color;
+
+        color.r = random_float(&seed, 0.0f, 1.0f);
+        color.g = random_float(&seed, 0.0f, 1.0f);
+        color.b = random_float(&seed, 0.0f, 1.0f);
+        color.a = random_float(&seed, 0.25f, 1.0f);
+
+        for (j = 0; j < 3; j++) {
+            SDL_Vertex *v = &vertices[i * 3 + j];
+            v->position.x = cx + random_float(&seed, -size / 2.0f, size / 2.0f);
+            v->position.y = cy + random_float(&seed, -size / 2.0f, size / 2.0f);
+            switch (which) {
+            case CASE_SOLID:
+            case CASE_TEXTURED:
+                v->color.r = v->color.g = v->color.b = v->color.a = 1.0f;
+                if (which == CASE_SOLID) {
+                    v->color = color;
+                    v->color.a = 1.0f;
+                }
+                break;
+            case CASE_BLENDED:
+                v->color = color;
+                break;
+            default:
+                v->color.r = random_float(&seed, 0.0f, 1.0f);
+                v->color.g = random_float(&seed, 0.0f, 1.0f);
+                v->color.b = random_float(&seed, 0.0f, 1.0f);
+                v->color.a = (which == CASE_GOURAUD) ? 1.0f : random_float(&seed, 0.25f, 1.0f);
+                break;
+            }
+            if (which == CASE_WRAPPED) {
+                v->tex_coord.x = random_float(&seed, -1.0f, 2.0f);
+                v->tex_coord.y = random_float(&seed, -1.0f, 2.0f);
+            } else {
+                v->tex_coord.x = random_float(&seed, 0.0f, 1.0f);
+                v->tex_coord.y = random_float(&seed, 0.0f, 1.0f);
+            }
+        }
+    }
+}
+
+static void bench_case(SDL_Surface *target, BenchCase which, int num_triangles, int triangle_size, int frames)
+{
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(target);
+    SDL_Texture *texture = NULL;
+    SDL_Vertex *vertices = NULL;
+    double covered = 0.0;
+    Uint64 start, elapsed;
+    double ms_per_frame;
+    Uint32 crc;
+    int i;
+
+    if (!renderer) {
+        SDL_Log("Failed to create software renderer: %s", SDL_GetError());
+        return;
+    }
+
+    vertices = (SDL_Vertex *)SDL_malloc(num_triangles * 3 * sizeof(*vertices));
+    if (!vertices) {
+        goto done;
+    }
+    generate_triangles(vertices, num_triangles, target->w, target->h, triangle_size, which);
+
+    if (which != CASE_SOLID && which != CASE_GOURAUD) {
+        texture = create_texture(renderer);
+        if (!texture) {
+            SDL_Log("Failed to create texture: %s", SDL_GetError());
+            goto done;
+        }
+        SDL_SetTextureBlendMode(texture, (which == CASE_TEXTURED) ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+    }
+    if (which == CASE_WRAPPED) {
+        SDL_SetRenderTextureAddressMode(renderer, SDL_TEXTURE_ADDRESS_WRAP, SDL_TEXTURE_ADDRESS_WRAP);
+    }
+
+    for (i = 0; i < num_triangles; i++) {
+        const SDL_FPoint *a = &vertices[i * 3 + 0].position;
+        const SDL_FPoint *b = &vertices[i * 3 + 1].position;
+        const SDL_FPoint *c = &vertices[i * 3 + 2].position;
+        covered += SDL_fabs((b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x)) / 2.0;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames; i++) {
+        SDL_SetRenderDrawColor(renderer, 0x20, 0x30, 0x40, 0xFF);
+        SDL_RenderClear(renderer);
+        SDL_RenderGeometry(renderer, texture, vertices, num_triangles * 3, NULL, 0);
+        SDL_RenderPresent(renderer);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    ms_per_frame = (((double)elapsed) / 1000000.0) / frames;
+    crc = SDL_crc32(0, target->pixels, (size_t)target->pitch * target->h);
+    SDL_Log("%-9s %6d triangles: %9.3f ms per frame, %8.1f Mpixels/s, crc %08" SDL_PRIx32,
+            case_names[which], num_triangles, ms_per_frame, (covered / 1000000.0) / (ms_per_frame / 1000.0), crc);
+
+done:
+    SDL_free(vertices);
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *target = NULL;
+    SDL_PixelFormat format = SDL_PIXELFORMAT_XRGB8888;
+    int w = 1920, h = 1080;
+    int num_triangles = 10000;
+    int triangle_size = 64;
+    int frames = 10;
+    int only_case = -1;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--target") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--format") == 0 && argv[i + 1]) {
+                static const SDL_PixelFormat formats[] = {
+                    SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+                    SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24
+                };
+                int f;
+                /* accept either "XRGB8888" or "SDL_PIXELFORMAT_XRGB8888" */
+                for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+                    const char *name = SDL_GetPixelFormatName(formats[f]);
+                    if (SDL_strcasecmp(argv[i + 1], name) == 0 ||
+                        SDL_strcasecmp(argv[i + 1], name + SDL_strlen("SDL_PIXELFORMAT_")) == 0) {
+                        format = formats[f];
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--triangles") == 0 && argv[i + 1]) {
+                num_triangles = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--triangle-size") == 0 && argv[i + 1]) {
+                triangle_size = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--case") == 0 && argv[i + 1]) {
+                int c;
+                if (SDL_strcmp(argv[i + 1], "all") == 0) {
+                    only_case = -1;
+                    consumed = 2;
+                }
+                for (c = 0; c < NUM_CASES; c++) {
+                    if (SDL_strcmp(argv[i + 1], case_names[c]) == 0) {
+                        only_case = c;
+                        consumed = 2;
+                    }
+                }
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    target = SDL_CreateSurface(w, h, format);
+    if (!target) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create %dx%d target: %s", w, h, SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+
+    SDL_Log("Drawing %d-pixel triangles into a %dx%d %s surface, %d frame(s) per case",
+            triangle_size, w, h, SDL_GetPixelFormatName(format), frames);
+
+    for (i = 0; i < NUM_CASES; i++) {
+        if (only_case < 0 || only_case == i) {
+            bench_case(target, (BenchCase)i, num_triangles, triangle_size, frames);
+        }
+    }
+
+end:
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
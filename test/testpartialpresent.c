@@ -0,0 +1,191 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how much the software renderer sends to the window for a mostly static UI.
+   The first frame draws the whole scene, and every frame after that only redraws a blinking cursor,
+   a progress bar and a frame counter, the way an application that doesn't clear every frame would.
+
+   The scene is drawn with and without SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT, and the bytes sent to
+   the window per frame are printed with the timing. Run it with SDL_VIDEO_DRIVER=dummy or offscreen
+   to leave the window system out of the timing. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--size WxH]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static void draw_static_scene(SDL_Renderer *renderer, int w, int h)
+{
+    SDL_FRect rect;
+    int i;
+
+    SDL_SetRenderDrawColor(renderer, 0x20, 0x30, 0x40, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    /* a title bar, a side panel and a grid of buttons */
+    SDL_SetRenderDrawColor(renderer, 0x40, 0x50, 0x70, SDL_ALPHA_OPAQUE);
+    rect.x = 0.0f;
+    rect.y = 0.0f;
+    rect.w = (float)w;
+    rect.h = 32.0f;
+    SDL_RenderFillRect(renderer, &rect);
+    rect.y = 32.0f;
+    rect.w = 200.0f;
+    rect.h = (float)(h - 32);
+    SDL_RenderFillRect(renderer, &rect);
+
+    SDL_SetRenderDrawColor(renderer, 0x60, 0x70, 0x90, SDL_ALPHA_OPAQUE);
+    for (i = 0; i < 24; i++) {
+        rect.x = 220.0f + (i % 6) * 120.0f;
+        rect.y = 60.0f + (i / 6) * 60.0f;
+        rect.w = 100.0f;
+        rect.h = 40.0f;
+        SDL_RenderFillRect(renderer, &rect);
+    }
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE);
+    SDL_RenderDebugText(renderer, 8.0f, 12.0f, "Partial present benchmark");
+}
+
+static void draw_changes(SDL_Renderer *renderer, int w, int h, int frame)
+{
+    SDL_FRect rect;
+    char text[32];
+
+    /* blinking text cursor */
+    if (frame & 8) {
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE);
+    } else {
+        SDL_SetRenderDrawColor(renderer, 0x40, 0x50, 0x70, SDL_ALPHA_OPAQUE);
+    }
+    rect.x = 20.0f;
+    rect.y = 60.0f;
+    rect.w = 2.0f;
+    rect.h = 16.0f;
+    SDL_RenderFillRect(renderer, &rect);
+
+    /* progress bar along the bottom */
+    SDL_SetRenderDrawColor(renderer, 0x40, 0xC0, 0x40, SDL_ALPHA_OPAQUE);
+    rect.x = 220.0f;
+    rect.y = (float)(h - 40);
+    rect.w = (float)((frame * 4) % (w - 240));
+    rect.h = 16.0f;
+    SDL_RenderFillRect(renderer, &rect);
+
+    /* frame counter in the title bar */
+    SDL_SetRenderDrawColor(renderer, 0x40, 0x50, 0x70, SDL_ALPHA_OPAQUE);
+    rect.x = (float)(w - 120);
+    rect.y = 8.0f;
+    rect.w = 112.0f;
+    rect.h = 16.0f;
+    SDL_RenderFillRect(renderer, &rect);
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, SDL_ALPHA_OPAQUE);
+    (void)SDL_snprintf(text, sizeof(text), "frame %d", frame);
+    SDL_RenderDebugText(renderer, (float)(w - 112), 12.0f, text);
+}
+
+static void bench(SDL_Window *window, bool partial, int frames)
+{
+    SDL_Renderer *renderer;
+    Sint64 bytes = 0;
+    Uint64 start, elapsed;
+    int w, h, i;
+
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT, partial ? "1" : "0");
+    renderer = SDL_CreateRenderer(window, SDL_SOFTWARE_RENDERER);
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_PARTIAL_PRESENT);
+    if (!renderer) {
+        SDL_Log("Failed to create software renderer: %s", SDL_GetError());
+        return;
+    }
+    SDL_GetCurrentRenderOutputSize(renderer, &w, &h);
+
+    draw_static_scene(renderer, w, h);
+    SDL_RenderPresent(renderer);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames; i++) {
+        draw_changes(renderer, w, h, i);
+        SDL_RenderPresent(renderer);
+        bytes += SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_SOFTWARE_PRESENTED_BYTES_NUMBER, 0);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("partial present %-3s: %9.3f ms per frame, %10.1f bytes sent per frame",
+            partial ? "on" : "off", (((double)elapsed) / 1000000.0) / frames, ((double)bytes) / frames);
+
+    SDL_DestroyRenderer(renderer);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Window *window = NULL;
+    int w = 1280, h = 720;
+    int frames = 200;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 240 && h > 40) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    window = SDL_CreateWindow("testpartialpresent", w, h, 0);
+    if (!window) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create window: %s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+
+    SDL_Log("Presenting a %dx%d static scene with a few changes per frame on the %s video driver, %d frame(s)",
+            w, h, SDL_GetCurrentVideoDriver(), frames);
+
+    bench(window, false, frames);
+    bench(window, true, frames);
+
+end:
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,187 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure how much drawing on a render thread overlaps with the application's own work.
+   Every frame spends some time on simulated game logic and then draws a few thousand sprites with
+   the software renderer, the way a game's update and draw would.
+
+   The scene is drawn with SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN off and on, and the time per frame
+   is printed for each. Run it with SDL_VIDEO_DRIVER=dummy or offscreen to leave the window system out
+   of the timing. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--size WxH]", "[--sprites N]", "[--work-us N]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+/* Stand-in for the application's per-frame work, which has to happen on the application thread */
+static void simulate_work(Uint64 ns)
+{
+    const Uint64 end = SDL_GetTicksNS() + ns;
+    while (SDL_GetTicksNS() < end) {
+    }
+}
+
+static SDL_Texture *create_sprite(SDL_Renderer *renderer)
+{
+    SDL_Surface *surface = SDL_CreateSurface(32, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Texture *texture;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    for (y = 0; y < surface->h; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; x++) {
+            const int dx = 2 * x - 32, dy = 2 * y - 32;
+            const Uint32 alpha = (dx * dx + dy * dy < 32 * 32) ? 0xFF : 0x00;
+            row[x] = (alpha << 24) | ((Uint32)(x * 8) << 16) | ((Uint32)(y * 8) << 8) | 0x80;
+        }
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    return texture;
+}
+
+static void bench(SDL_Window *window, bool threaded, const SDL_FRect *positions, int num_sprites, Uint64 work_ns, int frames)
+{
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    Uint64 start, elapsed;
+    int i, j;
+
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, window);
+    SDL_SetStringProperty(props, SDL_PROP_RENDERER_CREATE_NAME_STRING, SDL_SOFTWARE_RENDERER);
+    SDL_SetBooleanProperty(props, SDL_PROP_RENDERER_CREATE_THREADED_BOOLEAN, threaded);
+    renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    if (!renderer) {
+        SDL_Log("Failed to create software renderer: %s", SDL_GetError());
+        return;
+    }
+    if (SDL_GetBooleanProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_THREADED_BOOLEAN, false) != threaded) {
+        SDL_Log("Couldn't create a software renderer with threaded %s", threaded ? "on" : "off");
+        SDL_DestroyRenderer(renderer);
+        return;
+    }
+    sprite = create_sprite(renderer);
+    if (!sprite) {
+        SDL_Log("Failed to create texture: %s", SDL_GetError());
+        SDL_DestroyRenderer(renderer);
+        return;
+    }
+    SDL_SetTextureBlendMode(sprite, SDL_BLENDMODE_BLEND);
+
+    start = SDL_GetTicksNS();
+    for (j = 0; j < frames; j++) {
+        simulate_work(work_ns);
+
+        SDL_SetRenderDrawColor(renderer, 0x20, 0x30, 0x40, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+        for (i = 0; i < num_sprites; i++) {
+            SDL_RenderTexture(renderer, sprite, NULL, &positions[i]);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    SDL_FlushRenderer(renderer);
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("render thread %-3s: %9.3f ms per frame", threaded ? "on" : "off", (((double)elapsed) / 1000000.0) / frames);
+
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyRenderer(renderer);
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Window *window = NULL;
+    SDL_FRect *positions = NULL;
+    int w = 1280, h = 720;
+    int num_sprites = 5000;
+    int work_us = 4000;
+    int frames = 100;
+    Uint64 seed = 0x5D1;
+    int ret = 0;
+    int i;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--sprites") == 0 && argv[i + 1]) {
+                num_sprites = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--work-us") == 0 && argv[i + 1]) {
+                work_us = SDL_max(0, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    window = SDL_CreateWindow("testrenderthread", w, h, 0);
+    positions = (SDL_FRect *)SDL_malloc(num_sprites * sizeof(*positions));
+    if (!window || !positions) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to set up: %s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < num_sprites; i++) {
+        positions[i].x = (float)SDL_rand_r(&seed, w) - 16.0f;
+        positions[i].y = (float)SDL_rand_r(&seed, h) - 16.0f;
+        positions[i].w = 32.0f;
+        positions[i].h = 32.0f;
+    }
+
+    SDL_Log("Drawing %d sprites in a %dx%d window after %d us of work per frame on the %s video driver, %d frame(s)",
+            num_sprites, w, h, work_us, SDL_GetCurrentVideoDriver(), frames);
+
+    bench(window, false, positions, num_sprites, (Uint64)work_us * 1000, frames);
+    bench(window, true, positions, num_sprites, (Uint64)work_us * 1000, frames);
+
+end:
+    SDL_free(positions);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -14,9 +14,130 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_test.h>
 
+static const struct
+{
+    const char *name;
+    SDL_AudioResampleQuality quality;
+} qualities[] = {
+    { "nearest", SDL_AUDIO_RESAMPLE_NEAREST },
+    { "linear", SDL_AUDIO_RESAMPLE_LINEAR },
+    { "cubic", SDL_AUDIO_RESAMPLE_CUBIC },
+    { "sinc", SDL_AUDIO_RESAMPLE_SINC }
+};
+
 static void log_usage(char *progname, SDLTest_CommonState *state) {
-    static const char *options[] = { "in.wav", "out.wav", "newfreq", "newchan", NULL };
+    static const char *options[] = { "[--quality nearest|linear|cubic|sinc]", "in.wav", "out.wav", "newfreq", "newchan", NULL };
+    static const char *benchmark_options[] = { "--benchmark", "[--from freq]", "[--to freq]", "[--channels N]", "[--seconds N]", NULL };
     SDLTest_CommonLogUsage(state, progname, options);
+    SDLTest_CommonLogUsage(state, progname, benchmark_options);
+}
+
+static int parse_quality(const char *name)
+{
+    int i;
+    for (i = 0; i < (int)SDL_arraysize(qualities); i++) {
+        if (SDL_strcasecmp(name, qualities[i].name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static SDL_AudioStream *create_stream(const SDL_AudioSpec *src, const SDL_AudioSpec *dst, SDL_AudioResampleQuality quality)
+{
+    SDL_AudioStream *stream = SDL_CreateAudioStream(src, dst);
+    if (stream) {
+        SDL_SetNumberProperty(SDL_GetAudioStreamProperties(stream), SDL_PROP_AUDIOSTREAM_RESAMPLE_QUALITY_NUMBER, quality);
+    }
+    return stream;
+}
+
+/* Resample a pure tone with each quality, and report how fast it went and how close it got to the ideal output. */
+static double bench_quality(SDL_AudioResampleQuality quality, const SDL_AudioSpec *src, const SDL_AudioSpec *dst, int seconds, double tone, double *out_snr)
+{
+    const int frames_in = src->freq * seconds;
+    const int frames_out = (int)(((Sint64)frames_in * dst->freq) / src->freq);
+    const int chunk_frames = 1024;
+    const int skip = 64; /* ignore the edges, where the resampler has no history */
+    float *buf_in = (float *)SDL_malloc(sizeof(float) * frames_in * src->channels);
+    float *buf_out = (float *)SDL_calloc(frames_out + chunk_frames, sizeof(float) * dst->channels);
+    SDL_AudioStream *stream = create_stream(src, dst, quality);
+    double signal = 0.0;
+    double noise = 0.0;
+    Uint64 start, elapsed;
+    int got = 0;
+    int i, j;
+
+    *out_snr = 0.0;
+
+    if (!buf_in || !buf_out || !stream) {
+        SDL_Log("Out of memory: %s", SDL_GetError());
+        SDL_free(buf_in);
+        SDL_free(buf_out);
+        SDL_DestroyAudioStream(stream);
+        return 0.0;
+    }
+
+    for (i = 0; i < frames_in; i++) {
+        const float sample = (float)(0.5 * SDL_sin((2.0 * SDL_PI_D * tone * i) / src->freq));
+        for (j = 0; j < src->channels; j++) {
+            buf_in[(i * src->channels) + j] = sample;
+        }
+    }
+
+    /* feed it in chunks, like a real application would. */
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames_in; i += chunk_frames) {
+        const int frames = SDL_min(chunk_frames, frames_in - i);
+        SDL_PutAudioStreamData(stream, buf_in + (i * src->channels), frames * src->channels * (int)sizeof(float));
+        got += SDL_GetAudioStreamData(stream, buf_out + (got * dst->channels), (frames_out + chunk_frames - got) * dst->channels * (int)sizeof(float)) / (dst->channels * (int)sizeof(float));
+    }
+    SDL_FlushAudioStream(stream);
+    got += SDL_GetAudioStreamData(stream, buf_out + (got * dst->channels), (frames_out + chunk_frames - got) * dst->channels * (int)sizeof(float)) / (dst->channels * (int)sizeof(float));
+    elapsed = SDL_GetTicksNS() - start;
+
+    got = SDL_min(got, frames_out);
+    for (i = skip; i < got - skip; i++) {
+        const double target = 0.5 * SDL_sin((2.0 * SDL_PI_D * tone * i) / dst->freq);
+        const double error = buf_out[i * dst->channels] - target;
+        signal += target * target;
+        noise += error * error;
+    }
+
+    *out_snr = (noise > 0.0) ? 10.0 * SDL_log10(signal / noise) : 999.0;
+
+    SDL_free(buf_in);
+    SDL_free(buf_out);
+    SDL_DestroyAudioStream(stream);
+
+    /* millions of output frames per second */
+    return elapsed ? (((double)got) * 1000.0) / ((double)elapsed) : 0.0;
+}
+
+static void run_benchmark(const SDL_AudioSpec *src, const SDL_AudioSpec *dst, int seconds)
+{
+    static const double tones[] = { 440.0, 5000.0, 15000.0 };
+    const double nyquist = SDL_min(src->freq, dst->freq) / 2.0;
+    char snr_text[SDL_arraysize(tones)][32];
+    int i, j;
+
+    SDL_Log("Resampling %d second(s) of %d channel audio from %d Hz to %d Hz", seconds, src->channels, src->freq, dst->freq);
+    SDL_Log("%-8s %12s %12s %12s %12s", "quality", "Mframes/s", "SNR 440Hz", "SNR 5kHz", "SNR 15kHz");
+
+    for (i = 0; i < (int)SDL_arraysize(qualities); i++) {
+        double speed = 0.0;
+        for (j = 0; j < (int)SDL_arraysize(tones); j++) {
+            double snr = 0.0;
+            if (tones[j] >= nyquist) {
+                SDL_strlcpy(snr_text[j], "-", sizeof(snr_text[j]));
+                continue;
+            }
+            /* all the tones cost the same, so keep the best time to filter out noise. */
+            speed = SDL_max(speed, bench_quality(qualities[i].quality, src, dst, seconds, tones[j], &snr));
+            SDL_snprintf(snr_text[j], sizeof(snr_text[j]), "%.1f dB", snr);
+        }
+        SDL_Log("%-8s %12.2f %12s %12s %12s", qualities[i].name, speed, snr_text[0], snr_text[1], snr_text[2]);
+    }
 }
 
 int main(int argc, char **argv)
@@ -38,6 +159,11 @@ int main(int argc, char **argv)
     SDLTest_CommonState *state;
     char *file_in = NULL;
     char *file_out = NULL;
+    int quality = (int)SDL_arraysize(qualities) - 1;
+    bool benchmark = false;
+    int seconds = 5;
+    SDL_AudioSpec benchspec_in;
+    SDL_AudioSpec benchspec_out;
 
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, 0);
@@ -47,13 +173,38 @@ int main(int argc, char **argv)
 
     SDL_zero(cvtspec);
 
+    benchspec_in.format = SDL_AUDIO_F32;
+    benchspec_in.channels = 2;
+    benchspec_in.freq = 44100;
+    benchspec_out.format = SDL_AUDIO_F32;
+    benchspec_out.channels = 2;
+    benchspec_out.freq = 48000;
+
     /* Parse commandline */
     for (i = 1; i < argc;) {
         int consumed;
 
         consumed = SDLTest_CommonArg(state, i);
         if (!consumed) {
-            if (argpos == 0) {
+            if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                benchmark = true;
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--quality") == 0 && argv[i + 1]) {
+                quality = parse_quality(argv[i + 1]);
+                consumed = (quality >= 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--from") == 0 && argv[i + 1]) {
+                benchspec_in.freq = SDL_atoi(argv[i + 1]);
+                consumed = (benchspec_in.freq > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--to") == 0 && argv[i + 1]) {
+                benchspec_out.freq = SDL_atoi(argv[i + 1]);
+                consumed = (benchspec_out.freq > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--channels") == 0 && argv[i + 1]) {
+                benchspec_in.channels = benchspec_out.channels = SDL_atoi(argv[i + 1]);
+                consumed = (benchspec_in.channels > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+                seconds = SDL_atoi(argv[i + 1]);
+                consumed = (seconds > 0) ? 2 : -1;
+            } else if (argpos == 0) {
                 file_in = argv[i];
                 argpos++;
                 consumed = 1;
@@ -86,7 +237,7 @@ int main(int argc, char **argv)
         i += consumed;
     }
 
-    if (argpos != 4) {
+    if (!benchmark && argpos != 4) {
         log_usage(argv[0], state);
         ret = 1;
         goto end;
@@ -98,6 +249,11 @@ int main(int argc, char **argv)
         goto end;
     }
 
+    if (benchmark) {
+        run_benchmark(&benchspec_in, &benchspec_out, seconds);
+        goto end;
+    }
+
     if (!SDL_LoadWAV(file_in, &spec, &data, &len)) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to load %s: %s", file_in, SDL_GetError());
         ret = 3;
@@ -105,7 +261,13 @@ int main(int argc, char **argv)
     }
 
     cvtspec.format = spec.format;
-    if (!SDL_ConvertAudioSamples(&spec, data, len, &cvtspec, &dst_buf, &dst_len)) {
+    stream = create_stream(&spec, &cvtspec, qualities[quality].quality);
+    if (!stream ||
+        !SDL_PutAudioStreamData(stream, data, (int)len) ||
+        !SDL_FlushAudioStream(stream) ||
+        (dst_len = SDL_GetAudioStreamAvailable(stream)) < 0 ||
+        (dst_buf = (Uint8 *)SDL_malloc(dst_len)) == NULL ||
+        SDL_GetAudioStreamData(stream, dst_buf, dst_len) != dst_len) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "failed to convert samples: %s", SDL_GetError());
         ret = 4;
         goto end;
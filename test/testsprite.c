@@ -43,6 +43,11 @@ static bool suspend_when_occluded;
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
 static int iterations = -1;
 
+/* Number of frames to render before reporting the average frame time and quitting, 0 to run until closed. */
+static int benchmark_frames = 0;
+static int benchmark_frame;
+static Uint64 benchmark_start;
+
 void SDL_AppQuit(void *appstate, SDL_AppResult result)
 {
     SDL_free(sprites);
@@ -448,6 +453,11 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                     }
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--benchmark") == 0) {
+                if (argv[i + 1]) {
+                    benchmark_frames = SDL_max(SDL_atoi(argv[i + 1]), 0);
+                    consumed = 2;
+                }
             } else if (SDL_strcasecmp(argv[i], "--cyclecolor") == 0) {
                 cycle_color = true;
                 consumed = 1;
@@ -486,6 +496,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                 "[--cyclealpha]",
                 "[--suspend-when-occluded]",
                 "[--iterations N]",
+                "[--benchmark N]",
                 "[--use-rendergeometry mode1|mode2]",
                 "[num_sprites]",
                 "[icon.bmp]",
@@ -551,6 +562,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
     /* Main render loop in SDL_AppIterate will begin when this function returns. */
     frames = 0;
     next_fps_check = SDL_GetTicks() + fps_check_delay;
+    benchmark_start = SDL_GetTicksNS();
 
     return SDL_APP_CONTINUE;
 }
@@ -595,5 +607,11 @@ SDL_AppResult SDL_AppIterate(void *appstate)
         frames = 0;
     }
 
+    if (benchmark_frames > 0 && ++benchmark_frame == benchmark_frames) {
+        const double elapsed = (double)(SDL_GetTicksNS() - benchmark_start) / SDL_NS_PER_MS;
+        SDL_Log("Rendered %d frames in %.1f ms, %.3f ms per frame", benchmark_frames, elapsed, elapsed / benchmark_frames);
+        return SDL_APP_SUCCESS;
+    }
+
     return SDL_APP_CONTINUE;
 }
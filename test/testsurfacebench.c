@@ -0,0 +1,193 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure the throughput of large surface operations on several threads.
+   Each operation covers a whole target surface: format converting and blended blits, a scaled blit,
+   a colorspace conversion, a fill and a linear stretch. Every operation is timed on one thread and
+   then with SDL_HINT_SURFACE_THREADS set to each requested thread count, and the time per operation
+   and the number of megapixels per second are printed for each. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef enum
+{
+    OPERATION_CONVERT,
+    OPERATION_BLEND,
+    OPERATION_SCALE,
+    OPERATION_COLORSPACE,
+    OPERATION_FILL,
+    OPERATION_STRETCH,
+    NUM_OPERATIONS
+} Operation;
+
+static const char *operation_names[] = {
+    "ARGB8888 -> RGB565 blit",
+    "ARGB8888 blended blit",
+    "scaled blended blit",
+    "sRGB -> HDR10 conversion",
+    "fill",
+    "linear stretch"
+};
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--target WxH]", "[--threads N]", "[--iterations N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static void run_operation(Operation operation, SDL_Surface *src, SDL_Surface *targets[])
+{
+    SDL_Surface *target;
+
+    switch (operation) {
+    case OPERATION_CONVERT:
+        SDL_BlitSurface(src, NULL, targets[0], NULL);
+        break;
+    case OPERATION_BLEND:
+        SDL_BlitSurface(src, NULL, targets[1], NULL);
+        break;
+    case OPERATION_SCALE:
+        SDL_BlitSurfaceScaled(src, NULL, targets[1], NULL, SDL_SCALEMODE_NEAREST);
+        break;
+    case OPERATION_COLORSPACE:
+        target = targets[2];
+        SDL_ConvertPixelsAndColorspace(target->w, target->h, src->format, SDL_COLORSPACE_SRGB, 0, src->pixels, src->pitch,
+                                       target->format, SDL_COLORSPACE_HDR10, 0, target->pixels, target->pitch);
+        break;
+    case OPERATION_FILL:
+        SDL_FillSurfaceRect(targets[1], NULL, SDL_MapSurfaceRGB(targets[1], 0x20, 0x30, 0x40));
+        break;
+    case OPERATION_STRETCH:
+        SDL_StretchSurface(src, NULL, targets[3], NULL, SDL_SCALEMODE_LINEAR);
+        break;
+    default:
+        break;
+    }
+}
+
+static double bench(Operation operation, SDL_Surface *src, SDL_Surface *targets[], int threads, int iterations)
+{
+    char value[16];
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_snprintf(value, sizeof(value), "%d", threads);
+    SDL_SetHint(SDL_HINT_SURFACE_THREADS, value);
+
+    /* The first run starts the threads and builds any tables the operation uses */
+    run_operation(operation, src, targets);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; i++) {
+        run_operation(operation, src, targets);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    return (((double)elapsed) / 1000000.0) / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *src = NULL;
+    SDL_Surface *targets[4] = { NULL, NULL, NULL, NULL };
+    int w = 1920, h = 1080;
+    int max_threads = 0;
+    int iterations = 20;
+    int ret = 0;
+    int i, threads;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--target") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    if (max_threads == 0) {
+        max_threads = SDL_max(SDL_GetNumLogicalCPUCores(), 2);
+    }
+
+    src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    targets[0] = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGB565);
+    targets[1] = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    targets[2] = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB2101010);
+    targets[3] = SDL_CreateSurface(w + w / 3, h + h / 3, SDL_PIXELFORMAT_ARGB8888);
+    if (!src || !targets[0] || !targets[1] || !targets[2] || !targets[3]) {
+        SDL_Log("Failed to set up: %s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < h; i++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + i * src->pitch);
+        int x;
+        for (x = 0; x < w; x++) {
+            row[x] = ((Uint32)(x + i) << 24) | ((Uint32)(x * 255 / w) << 16) | ((Uint32)(i * 255 / h) << 8) | 0x80;
+        }
+    }
+    SDL_SetSurfaceColorspace(targets[2], SDL_COLORSPACE_HDR10);
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    SDL_SetHint(SDL_HINT_SURFACE_THREADS_MIN_PIXELS, "0");
+
+    SDL_Log("Running each operation over a %dx%d surface, %d iteration(s), with 1 to %d thread(s)",
+            w, h, iterations, max_threads);
+
+    for (i = 0; i < NUM_OPERATIONS; i++) {
+        const SDL_Surface *written = (i == OPERATION_STRETCH) ? targets[3] : src;
+        const double pixels = (double)written->w * written->h;
+        const double serial = bench((Operation)i, src, targets, 1, iterations);
+
+        SDL_Log("%-28s  1 thread : %9.3f ms, %8.1f Mpixels/s", operation_names[i], serial, pixels / (serial * 1000.0));
+        for (threads = 2; threads <= max_threads; threads = (threads < max_threads) ? SDL_min(threads * 2, max_threads) : threads + 1) {
+            const double elapsed = bench((Operation)i, src, targets, threads, iterations);
+            SDL_Log("%-28s %2d threads: %9.3f ms, %8.1f Mpixels/s, %.2fx", "", threads, elapsed, pixels / (elapsed * 1000.0), serial / elapsed);
+        }
+    }
+
+end:
+    for (i = 0; i < SDL_arraysize(targets); i++) {
+        SDL_DestroySurface(targets[i]);
+    }
+    SDL_DestroySurface(src);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
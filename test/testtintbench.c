@@ -0,0 +1,166 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to measure the cost of changing a sprite's tint between blits.
+   Each sprite is drawn with SDL_BlitSurface() after setting its color and alpha modulation,
+   the way the software renderer draws textures, cycling through a few tints so the
+   surface's blit function has to be chosen again for most blits.
+
+   The number of times the blit function was reused or chosen from scratch is printed
+   with the timing. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    Uint8 r, g, b, a;
+} Tint;
+
+/* white, then tinted, then faded: each one needs different blit flags */
+static const Tint tints[] = {
+    { 255, 255, 255, 255 },
+    { 255, 128, 64, 255 },
+    { 255, 255, 255, 128 },
+    { 64, 128, 255, 192 }
+};
+
+static void log_usage(char *progname, SDLTest_CommonState *state)
+{
+    static const char *options[] = { "[--target WxH]", "[--sprites N]", "[--sprite-size N]", "[--tints 1-4]", "[--frames N]", NULL };
+    SDLTest_CommonLogUsage(state, progname, options);
+}
+
+static SDL_Surface *create_sprite(int size)
+{
+    SDL_Surface *sprite = SDL_CreateSurface(size, size, SDL_PIXELFORMAT_ARGB8888);
+    int x, y;
+
+    if (!sprite) {
+        return NULL;
+    }
+    for (y = 0; y < size; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)sprite->pixels + y * sprite->pitch);
+        for (x = 0; x < size; x++) {
+            const int dx = 2 * x - size, dy = 2 * y - size;
+            const Uint32 alpha = (dx * dx + dy * dy < size * size) ? 0xFF : 0x00;
+            row[x] = (alpha << 24) | ((Uint32)(x * 255 / size) << 16) | ((Uint32)(y * 255 / size) << 8) | 0x80;
+        }
+    }
+    SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_BLEND);
+    return sprite;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *target = NULL;
+    SDL_Surface *sprite = NULL;
+    SDL_Point *positions = NULL;
+    SDL_SurfaceBlitStats stats;
+    int w = 1280, h = 720;
+    int num_sprites = 5000;
+    int sprite_size = 16;
+    int num_tints = SDL_arraysize(tints);
+    int frames = 20;
+    Uint64 seed = 0x5D1;
+    Uint64 start, elapsed;
+    int ret = 0;
+    int i, j;
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--target") == 0 && argv[i + 1]) {
+                if (SDL_sscanf(argv[i + 1], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--sprites") == 0 && argv[i + 1]) {
+                num_sprites = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--sprite-size") == 0 && argv[i + 1]) {
+                sprite_size = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--tints") == 0 && argv[i + 1]) {
+                num_tints = SDL_clamp(SDL_atoi(argv[i + 1]), 1, (int)SDL_arraysize(tints));
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            log_usage(argv[0], state);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    target = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    sprite = create_sprite(sprite_size);
+    positions = (SDL_Point *)SDL_malloc(num_sprites * sizeof(*positions));
+    if (!target || !sprite || !positions) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to set up: %s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+    for (i = 0; i < num_sprites; i++) {
+        positions[i].x = SDL_rand_r(&seed, w) - sprite_size / 2;
+        positions[i].y = SDL_rand_r(&seed, h) - sprite_size / 2;
+    }
+
+    SDL_Log("Blitting %d %dx%d sprites into a %dx%d surface with %d tint(s), %d frame(s)",
+            num_sprites, sprite_size, sprite_size, w, h, num_tints, frames);
+
+    start = SDL_GetTicksNS();
+    for (j = 0; j < frames; j++) {
+        SDL_FillSurfaceRect(target, NULL, SDL_MapSurfaceRGB(target, 0x20, 0x30, 0x40));
+        for (i = 0; i < num_sprites; i++) {
+            const Tint *tint = &tints[i % num_tints];
+            SDL_Rect dstrect;
+            dstrect.x = positions[i].x;
+            dstrect.y = positions[i].y;
+            dstrect.w = sprite_size;
+            dstrect.h = sprite_size;
+            SDL_SetSurfaceColorMod(sprite, tint->r, tint->g, tint->b);
+            SDL_SetSurfaceAlphaMod(sprite, tint->a);
+            SDL_BlitSurface(sprite, NULL, target, &dstrect);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_GetSurfaceBlitStats(sprite, &stats);
+    SDL_Log("%9.3f ms per frame, %7.1f ns per sprite, blit function reused %" SDL_PRIu64 " times, chosen %" SDL_PRIu64 " times",
+            (((double)elapsed) / 1000000.0) / frames, ((double)elapsed) / ((double)frames * num_sprites),
+            stats.cache_hits, stats.cache_misses);
+
+end:
+    SDL_free(positions);
+    SDL_DestroySurface(sprite);
+    SDL_DestroySurface(target);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}
@@ -0,0 +1,235 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Program to compare loading a wave file with SDL_LoadWAV against decoding it on demand
+   with SDL_WAVReader. For each, it reports how long it takes until the first sample is
+   ready to play, and the peak amount of memory SDL allocated along the way. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+#include "testutils.h"
+
+#define FIRST_READ_BYTES 4096  /* about what an audio device asks for at a time. */
+#define READ_BYTES (16 * 1024)
+
+/* Every allocation is prefixed with its size, so we can track how much is in use. */
+typedef union
+{
+    size_t size;
+    Uint64 align[2];
+} AllocHeader;
+
+static SDL_malloc_func orig_malloc;
+static SDL_calloc_func orig_calloc;
+static SDL_realloc_func orig_realloc;
+static SDL_free_func orig_free;
+static SDL_AtomicInt in_use;
+static SDL_AtomicInt peak;
+
+static void track(AllocHeader *header, size_t size)
+{
+    const int now = SDL_AddAtomicInt(&in_use, (int) size) + (int) size;
+    int old;
+    header->size = size;
+    do {
+        old = SDL_GetAtomicInt(&peak);
+    } while ((now > old) && !SDL_CompareAndSwapAtomicInt(&peak, old, now));
+}
+
+static void untrack(AllocHeader *header)
+{
+    SDL_AddAtomicInt(&in_use, -(int) header->size);
+}
+
+static void * SDLCALL tracked_malloc(size_t size)
+{
+    AllocHeader *header = (AllocHeader *) orig_malloc(sizeof (AllocHeader) + size);
+    if (!header) {
+        return NULL;
+    }
+    track(header, size);
+    return header + 1;
+}
+
+static void * SDLCALL tracked_calloc(size_t nmemb, size_t size)
+{
+    void *mem = tracked_malloc(nmemb * size);
+    if (mem) {
+        SDL_memset(mem, 0, nmemb * size);
+    }
+    return mem;
+}
+
+static void * SDLCALL tracked_realloc(void *mem, size_t size)
+{
+    AllocHeader *header = mem ? ((AllocHeader *) mem) - 1 : NULL;
+    if (header) {
+        untrack(header);
+    }
+    header = (AllocHeader *) orig_realloc(header, sizeof (AllocHeader) + size);
+    if (!header) {
+        return NULL;
+    }
+    track(header, size);
+    return header + 1;
+}
+
+static void SDLCALL tracked_free(void *mem)
+{
+    if (mem) {
+        AllocHeader *header = ((AllocHeader *) mem) - 1;
+        untrack(header);
+        orig_free(header);
+    }
+}
+
+static void reset_peak(void)
+{
+    SDL_SetAtomicInt(&peak, SDL_GetAtomicInt(&in_use));
+}
+
+static double peak_kb(int baseline)
+{
+    return (SDL_GetAtomicInt(&peak) - baseline) / 1024.0;
+}
+
+static bool bench_load(const char *filename)
+{
+    const int baseline = SDL_GetAtomicInt(&in_use);
+    SDL_AudioSpec spec;
+    Uint8 *buf = NULL;
+    Uint32 len = 0;
+    Uint64 start, first;
+
+    reset_peak();
+    start = SDL_GetTicksNS();
+    if (!SDL_LoadWAV(filename, &spec, &buf, &len)) {
+        SDL_Log("SDL_LoadWAV failed: %s", SDL_GetError());
+        return false;
+    }
+    first = SDL_GetTicksNS() - start;  /* everything is decoded before the first sample is available. */
+
+    SDL_Log("SDL_LoadWAV:  first sample after %8.3f ms, all %u bytes after %8.3f ms, peak memory %9.1f KiB",
+            first / 1000000.0, (unsigned int) len, first / 1000000.0, peak_kb(baseline));
+
+    SDL_free(buf);
+    return true;
+}
+
+static bool bench_reader(const char *filename)
+{
+    const int baseline = SDL_GetAtomicInt(&in_use);
+    SDL_AudioSpec spec;
+    SDL_WAVReader *reader;
+    Sint64 frames = 0;
+    Uint8 *buf;
+    Uint64 start, first, all;
+    Uint64 total = 0;
+    int br;
+
+    reset_peak();
+    start = SDL_GetTicksNS();
+    buf = (Uint8 *) SDL_malloc(READ_BYTES);  /* the app's buffer counts, too. */
+    reader = SDL_OpenWAVReader(filename, &spec, &frames);
+    if (!buf || !reader) {
+        SDL_Log("SDL_OpenWAVReader failed: %s", SDL_GetError());
+        SDL_free(buf);
+        return false;
+    }
+
+    br = SDL_ReadWAVReader(reader, buf, FIRST_READ_BYTES);
+    first = SDL_GetTicksNS() - start;
+
+    while (br > 0) {
+        total += br;
+        br = SDL_ReadWAVReader(reader, buf, READ_BYTES);
+    }
+    all = SDL_GetTicksNS() - start;
+
+    if (br < 0) {
+        SDL_Log("SDL_ReadWAVReader failed: %s", SDL_GetError());
+    }
+
+    SDL_Log("SDL_WAVReader: first sample after %8.3f ms, all %u bytes after %8.3f ms, peak memory %9.1f KiB",
+            first / 1000000.0, (unsigned int) total, all / 1000000.0, peak_kb(baseline));
+
+    SDL_CloseWAVReader(reader);
+    SDL_free(buf);
+    return br == 0;
+}
+
+int main(int argc, char **argv)
+{
+    SDLTest_CommonState *state;
+    const char *arg = NULL;
+    char *filename = NULL;
+    int loops = 3;
+    int ret = 0;
+    int i;
+
+    /* this has to happen before anything is allocated. */
+    SDL_GetOriginalMemoryFunctions(&orig_malloc, &orig_calloc, &orig_realloc, &orig_free);
+    SDL_SetMemoryFunctions(tracked_malloc, tracked_calloc, tracked_realloc, tracked_free);
+
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--loops") == 0 && argv[i + 1]) {
+                loops = SDL_max(1, SDL_atoi(argv[i + 1]));
+                consumed = 2;
+            } else if (!arg) {
+                arg = argv[i];
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--loops N]", "[sample.wav]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            ret = 1;
+            goto end;
+        }
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() failed: %s", SDL_GetError());
+        ret = 2;
+        goto end;
+    }
+
+    filename = GetResourceFilename(arg, "sample.wav");
+    if (!filename) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", SDL_GetError());
+        ret = 3;
+        goto end;
+    }
+
+    SDL_Log("Decoding %s, %d time(s) each", filename, loops);
+    for (i = 0; i < loops; i++) {
+        if (!bench_load(filename) || !bench_reader(filename)) {
+            ret = 4;
+            break;
+        }
+    }
+
+end:
+    SDL_free(filename);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return ret;
+}